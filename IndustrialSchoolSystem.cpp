@@ -1,6 +1,11 @@
 #include "IndustrialSchoolSystem.h"
 #include <algorithm>
 #include <cstdlib>
+#include <charconv>
+#include <iterator>
+#include <cmath>
+#include <filesystem>
+#include <new>
 
 // Enhanced Course class
 class Course {
@@ -11,18 +16,21 @@ private:
     int credits;
     int maxStudents;
     std::vector<int> enrolledStudents;
+    SeatCounter seats; // claims against maxStudents; see reserveSeat()
+    Waitlist waitlist; // students waiting for a seat, promoted on unenroll
     int assignedTeacherId;
     std::string startDate;
     std::string endDate;
-    bool isActive;
+    mutable bool isActive; // loaded and stored atomically, see reserveSeat()
     double fee;
+    RecordVersion version; // bumped by each committed edit, see commitEdit()
     
 public:
     Course(int id, const std::string& name, const std::string& description = "",
            int credits = 3, int maxStudents = 30, double fee = 0.0)
         : id(id), name(name), description(description), credits(credits), 
-          maxStudents(maxStudents), assignedTeacherId(-1), isActive(true), fee(fee) {
-        startDate = getCurrentDate();
+          maxStudents(maxStudents), seats(maxStudents), assignedTeacherId(-1), isActive(true), fee(fee) {
+        startDate = currentDate();
         endDate = ""; // Will be set when course ends
     }
     
@@ -31,26 +39,30 @@ public:
     const std::string& getName() const { return name; }
     const std::string& getDescription() const { return description; }
     int getCredits() const { return credits; }
-    int getMaxStudents() const { return maxStudents; }
-    int getCurrentEnrollment() const { return enrolledStudents.size(); }
+    int getMaxStudents() const { return seats.getCapacity(); } // same limit, read atomically
+    int getCurrentEnrollment() const { return seats.getCommitted(); }
     int getAssignedTeacherId() const { return assignedTeacherId; }
     const std::string& getStartDate() const { return startDate; }
     const std::string& getEndDate() const { return endDate; }
-    bool getIsActive() const { return isActive; }
+    bool getIsActive() const { return std::atomic_ref<bool>(isActive).load(std::memory_order_acquire); }
     double getFee() const { return fee; }
     const std::vector<int>& getEnrolledStudents() const { return enrolledStudents; }
+    Waitlist& getWaitlist() { return waitlist; }
+    const Waitlist& getWaitlist() const { return waitlist; }
+    uint64_t getVersion() const { return version.load(); }
+    RecordVersion& getVersionStamp() { return version; }
     
     // Setters with validation
     bool setName(const std::string& newName) {
         if (InputValidator::isValidName(newName)) {
-            name = InputValidator::sanitizeString(newName);
+            InputValidator::sanitizeInto(newName, name);
             return true;
         }
         return false;
     }
     
     bool setDescription(const std::string& newDescription) {
-        description = InputValidator::sanitizeString(newDescription);
+        InputValidator::sanitizeInto(newDescription, description);
         return true;
     }
     
@@ -62,8 +74,10 @@ public:
         return false;
     }
     
+    // Refused below the seats already claimed, counting enrollments still
+    // in flight: daemon edits run alongside them
     bool setMaxStudents(int newMaxStudents) {
-        if (newMaxStudents > 0 && newMaxStudents <= 500) {
+        if (newMaxStudents > 0 && newMaxStudents <= 500 && seats.tryResize(newMaxStudents)) {
             maxStudents = newMaxStudents;
             return true;
         }
@@ -71,7 +85,7 @@ public:
     }
     
     void setAssignedTeacherId(int teacherId) { assignedTeacherId = teacherId; }
-    void setIsActive(bool active) { isActive = active; }
+    void setIsActive(bool active) { std::atomic_ref<bool>(isActive).store(active, std::memory_order_release); }
     void setEndDate(const std::string& date) { endDate = date; }
     
     bool setFee(double newFee) {
@@ -82,20 +96,38 @@ public:
         return false;
     }
     
-    // Student management
-    bool enrollStudent(int studentId) {
-        if (isActive && getCurrentEnrollment() < maxStudents && 
-            std::find(enrolledStudents.begin(), enrolledStudents.end(), studentId) == enrolledStudents.end()) {
-            enrolledStudents.push_back(studentId);
-            return true;
+    // Student management. Enrollment is two-phase: reserveSeat() claims a
+    // seat with a compare-and-swap and is safe from any thread (the active
+    // flag it checks is read atomically, so a concurrent deactivation only
+    // decides whether this claim gets in first); commitSeat() adds the
+    // student to the roster, and needs the roster to itself (the daemon
+    // holds the course's lock stripe). An uncommitted reservation gives its
+    // seat back when destroyed.
+    SeatReservation reserveSeat() {
+        return getIsActive() ? SeatReservation(seats) : SeatReservation();
+    }
+    
+    // False (and the seat is rolled back) if the student is already enrolled
+    bool commitSeat(SeatReservation& seat, int studentId) {
+        if (!seat || isStudentEnrolled(studentId)) {
+            seat.rollback();
+            return false;
         }
-        return false;
+        enrolledStudents.push_back(studentId);
+        seat.commit();
+        return true;
+    }
+    
+    bool enrollStudent(int studentId) {
+        SeatReservation seat = reserveSeat();
+        return commitSeat(seat, studentId);
     }
     
     bool unenrollStudent(int studentId) {
         auto it = std::find(enrolledStudents.begin(), enrolledStudents.end(), studentId);
         if (it != enrolledStudents.end()) {
             enrolledStudents.erase(it);
+            seats.vacate();
             return true;
         }
         return false;
@@ -105,30 +137,30 @@ public:
         return std::find(enrolledStudents.begin(), enrolledStudents.end(), studentId) != enrolledStudents.end();
     }
     
-    bool isFull() const { return getCurrentEnrollment() >= maxStudents; }
+    bool isFull() const { return seats.getAvailable() <= 0; }
     bool hasTeacher() const { return assignedTeacherId != -1; }
     
-    // File operations
-    bool saveToFile(const std::string& filename) const {
-        std::ofstream file(filename, std::ios::app);
-        if (!file.is_open()) {
-            std::cerr << "❌ Error: Cannot open file " << filename << " for writing.\n";
-            return false;
-        }
-        
+    // One line of the data file
+    void writeRecord(std::ostream& file) const {
         file << id << "|" << name << "|" << description << "|" << credits << "|"
              << maxStudents << "|" << assignedTeacherId << "|" << startDate << "|"
-             << endDate << "|" << (isActive ? "1" : "0") << "|" << fee << "|";
+             << endDate << "|" << (getIsActive() ? "1" : "0") << "|" << fee << "|";
         
         // Save enrolled students
         for (size_t i = 0; i < enrolledStudents.size(); ++i) {
             file << enrolledStudents[i];
             if (i < enrolledStudents.size() - 1) file << ",";
         }
-        file << "\n";
         
-        file.close();
-        return true;
+        // Waitlist: studentId:priority:seniority:requestedAt:sequence;...
+        file << "|";
+        const std::vector<WaitlistEntry>& waiting = waitlist.entries();
+        for (size_t i = 0; i < waiting.size(); ++i) {
+            file << waiting[i].studentId << ":" << waiting[i].priority << ":" << waiting[i].seniority << ":"
+                 << waiting[i].requestedAt << ":" << waiting[i].sequence;
+            if (i < waiting.size() - 1) file << ";";
+        }
+        file << "\n";
     }
     
     static std::vector<Course> loadFromFile(const std::string& filename) {
@@ -165,6 +197,22 @@ public:
                                 course.enrolledStudents.push_back(std::stoi(studentId));
                             }
                         }
+                        course.seats.reset(static_cast<int>(course.enrolledStudents.size()));
+                    }
+                    
+                    // Waitlist (absent in files written before waitlists existed)
+                    if (parts.size() > 11 && !parts[11].empty()) {
+                        for (const auto& record : split(parts[11], ';')) {
+                            std::vector<std::string> values = split(record, ':');
+                            if (values.size() < 5) continue;
+                            WaitlistEntry entry;
+                            entry.studentId = std::stoi(values[0]);
+                            entry.priority = std::stoi(values[1]);
+                            entry.seniority = std::stoi(values[2]);
+                            entry.requestedAt = std::stoll(values[3]);
+                            entry.sequence = std::stoull(values[4]);
+                            course.waitlist.restore(entry);
+                        }
                     }
                     
                     courses.push_back(course);
@@ -191,7 +239,7 @@ public:
         std::cout << "   Teacher ID: " << (hasTeacher() ? std::to_string(assignedTeacherId) : "Not assigned") << "\n";
         std::cout << "   Start Date: " << startDate << "\n";
         std::cout << "   End Date: " << (endDate.empty() ? "Ongoing" : endDate) << "\n";
-        std::cout << "   Status: " << (isActive ? "Active" : "Inactive") << "\n";
+        std::cout << "   Status: " << (getIsActive() ? "Active" : "Inactive") << "\n";
         std::cout << "   Fee: $" << std::fixed << std::setprecision(2) << fee << "\n";
     }
     
@@ -200,18 +248,10 @@ public:
                   << std::setw(25) << name.substr(0, 25) << " | "
                   << std::setw(3) << credits << " | "
                   << std::setw(8) << (std::to_string(getCurrentEnrollment()) + "/" + std::to_string(maxStudents)) << " | "
-                  << std::setw(8) << (isActive ? "Active" : "Inactive") << "\n";
+                  << std::setw(8) << (getIsActive() ? "Active" : "Inactive") << "\n";
     }
     
 private:
-    static std::string getCurrentDate() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d");
-        return ss.str();
-    }
-    
     static std::vector<std::string> split(const std::string& str, char delimiter) {
         std::vector<std::string> tokens;
         std::stringstream ss(str);
@@ -238,7 +278,7 @@ public:
     Classroom(int id, const std::string& location, int capacity, 
               const std::string& building = "", const std::string& equipment = "")
         : id(id), location(location), capacity(capacity), building(building), 
-          equipment(equipment), isAvailable(true) {}
+          isAvailable(true), equipment(equipment) {}
     
     // Getters
     int getId() const { return id; }
@@ -251,7 +291,7 @@ public:
     
     // Setters
     void setLocation(const std::string& newLocation) { 
-        location = InputValidator::sanitizeString(newLocation); 
+        InputValidator::sanitizeInto(newLocation, location); 
     }
     
     bool setCapacity(int newCapacity) {
@@ -263,12 +303,12 @@ public:
     }
     
     void setBuilding(const std::string& newBuilding) { 
-        building = InputValidator::sanitizeString(newBuilding); 
+        InputValidator::sanitizeInto(newBuilding, building); 
     }
     
     void setIsAvailable(bool available) { isAvailable = available; }
     void setEquipment(const std::string& newEquipment) { 
-        equipment = InputValidator::sanitizeString(newEquipment); 
+        InputValidator::sanitizeInto(newEquipment, equipment); 
     }
     
     // Course scheduling
@@ -293,14 +333,8 @@ public:
         return std::find(scheduledCourses.begin(), scheduledCourses.end(), courseId) != scheduledCourses.end();
     }
     
-    // File operations
-    bool saveToFile(const std::string& filename) const {
-        std::ofstream file(filename, std::ios::app);
-        if (!file.is_open()) {
-            std::cerr << "❌ Error: Cannot open file " << filename << " for writing.\n";
-            return false;
-        }
-        
+    // One line of the data file
+    void writeRecord(std::ostream& file) const {
         file << id << "|" << location << "|" << capacity << "|" << building << "|"
              << (isAvailable ? "1" : "0") << "|" << equipment << "|";
         
@@ -310,9 +344,6 @@ public:
             if (i < scheduledCourses.size() - 1) file << ",";
         }
         file << "\n";
-        
-        file.close();
-        return true;
     }
     
     static std::vector<Classroom> loadFromFile(const std::string& filename) {
@@ -392,457 +423,3015 @@ private:
     }
 };
 
-// Main School Management System class
-class IndustrialSchoolManagementSystem {
-private:
-    std::vector<Student> students;
-    std::vector<Teacher> teachers;
-    std::vector<Course> courses;
-    std::vector<Classroom> classrooms;
+// One parsed CSV row in a format's canonical field order. mapped[f] is false
+// when the file has no column for field f, so updates leave it untouched.
+struct CsvImportRow {
+    const std::string* fields;
+    const bool* mapped;
     
-    const std::string STUDENTS_FILE = "industrial_students.txt";
-    const std::string TEACHERS_FILE = "industrial_teachers.txt";
-    const std::string COURSES_FILE = "industrial_courses.txt";
-    const std::string CLASSROOMS_FILE = "industrial_classrooms.txt";
-    const std::string BACKUP_DIR = "backups/";
+    bool has(int field) const { return mapped[field]; }
+    const std::string& operator[](int field) const { return fields[field]; }
     
-public:
-    IndustrialSchoolManagementSystem() {
-        loadAllData();
-        std::cout << "🎓 Industrial School Management System v3.0 Initialized\n";
-        std::cout << "======================================================\n";
-        displaySystemStatus();
+    // Empty or unmapped numeric fields take the default
+    bool getInt(int field, int defaultValue, int& value) const {
+        value = defaultValue;
+        if (!has(field) || fields[field].empty()) return true;
+        const std::string& text = fields[field];
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
     }
     
-    ~IndustrialSchoolManagementSystem() {
-        saveAllData();
-        createBackup();
+    bool getDouble(int field, double defaultValue, double& value) const {
+        value = defaultValue;
+        if (!has(field) || fields[field].empty()) return true;
+        char* end = nullptr;
+        value = std::strtod(fields[field].c_str(), &end);
+        return end == fields[field].c_str() + fields[field].size() && std::isfinite(value);
     }
+};
+
+// Field layouts for each importable record type. Each format maps header
+// names to its fields, applies the checks BatchValidator doesn't cover, and
+// knows how to create a record, compare one, and update only what changed.
+// update returns why the record refused the change, leaving it untouched.
+struct StudentCsvFormat {
+    typedef Student Record;
+    enum Field { Id, Name, Age, Email, Phone, Address, FieldCount };
+    static const int NameField = Name, AgeField = Age, EmailField = Email, PhoneField = Phone;
     
-    void run() {
-        int choice;
-        do {
-            showMainMenu();
-            choice = SafeInput::getInt("Enter your choice (0-9): ", 0, 9);
-            
-            try {
-                processChoice(choice);
-            } catch (const std::exception& e) {
-                std::cerr << "❌ Error: " << e.what() << "\n";
-                SafeInput::waitForEnter("Press Enter to continue...");
-            }
-            
-        } while (choice != 0);
-        
-        std::cout << "\n👋 Thank you for using Industrial School Management System!\n";
-        std::cout << "All data has been saved automatically.\n";
+    static const char* entityName() { return "students"; }
+    
+    static const char* fieldName(int field) {
+        static const char* names[FieldCount] = {"id", "name", "age", "email", "phone", "address"};
+        return names[field];
     }
     
-private:
-    void showMainMenu() {
-        clearScreen();
-        std::cout << "🎓 INDUSTRIAL SCHOOL MANAGEMENT SYSTEM v3.0\n";
-        std::cout << "============================================\n\n";
-        
-        displaySystemStatus();
-        
-        std::cout << "\n📋 MAIN MENU:\n";
-        std::cout << "==============\n";
-        std::cout << "1. 👨‍🎓 Student Management\n";
-        std::cout << "2. 👩‍🏫 Teacher Management\n";
-        std::cout << "3. 📚 Course Management\n";
-        std::cout << "4. 🏫 Classroom Management\n";
-        std::cout << "5. 📊 Reports & Analytics\n";
-        std::cout << "6. 🔄 Data Management\n";
-        std::cout << "7. 🎯 Quick Actions\n";
-        std::cout << "8. ⚙️  System Settings\n";
-        std::cout << "9. ℹ️  Help & About\n";
-        std::cout << "0. 🚪 Exit System\n";
-        std::cout << "==============\n";
+    static int mapColumn(const std::vector<std::string>& header, int field) {
+        switch (field) {
+            case Id: return CsvReader::findColumn(header, {"id", "studentid"});
+            case Name: return CsvReader::findColumn(header, {"name", "fullname", "studentname"});
+            case Age: return CsvReader::findColumn(header, {"age"});
+            case Email: return CsvReader::findColumn(header, {"email", "emailaddress"});
+            case Phone: return CsvReader::findColumn(header, {"phone", "phonenumber", "mobile"});
+            default: return CsvReader::findColumn(header, {"address", "homeaddress"});
+        }
     }
     
-    void processChoice(int choice) {
-        switch (choice) {
-            case 1: studentManagement(); break;
-            case 2: teacherManagement(); break;
-            case 3: courseManagement(); break;
-            case 4: classroomManagement(); break;
-            case 5: reportsAndAnalytics(); break;
-            case 6: dataManagement(); break;
-            case 7: quickActions(); break;
-            case 8: systemSettings(); break;
-            case 9: helpAndAbout(); break;
-            case 0: break;
-            default: 
-                std::cout << "❌ Invalid choice. Please try again.\n";
-                SafeInput::waitForEnter();
+    static bool isRequired(int field) { return field == Id || field == Name || field == Age; }
+    static const char* checkRow(const CsvImportRow&) { return nullptr; }
+    
+    static Record create(const CsvImportRow& row, int id) {
+        int age = 0;
+        row.getInt(Age, 0, age);
+        return Student(id, row[Name], age, row[Email], row[Phone], row[Address]);
+    }
+    
+    static bool matches(const Record& student, const CsvImportRow& row) {
+        int age = 0;
+        row.getInt(Age, student.getAge(), age);
+        return student.getName() == row[Name] && student.getAge() == age &&
+               (!row.has(Email) || student.getEmail() == row[Email]) &&
+               (!row.has(Phone) || student.getPhone() == row[Phone]) &&
+               (!row.has(Address) || student.getAddress() == row[Address]);
+    }
+    
+    static const char* update(Record& student, const CsvImportRow& row) {
+        int age = 0;
+        row.getInt(Age, student.getAge(), age);
+        if (student.getName() != row[Name]) student.setName(row[Name]);
+        if (student.getAge() != age) student.setAge(age);
+        if (row.has(Email) && student.getEmail() != row[Email]) student.setEmail(row[Email]);
+        if (row.has(Phone) && student.getPhone() != row[Phone]) student.setPhone(row[Phone]);
+        if (row.has(Address) && student.getAddress() != row[Address]) student.setAddress(row[Address]);
+        return nullptr;
+    }
+};
+
+struct TeacherCsvFormat {
+    typedef Teacher Record;
+    enum Field { Id, Name, Subject, Email, Phone, Department, Salary, FieldCount };
+    static const int NameField = Name, AgeField = -1, EmailField = Email, PhoneField = Phone;
+    
+    static const char* entityName() { return "teachers"; }
+    
+    static const char* fieldName(int field) {
+        static const char* names[FieldCount] = {"id", "name", "subject", "email", "phone", "department", "salary"};
+        return names[field];
+    }
+    
+    static int mapColumn(const std::vector<std::string>& header, int field) {
+        switch (field) {
+            case Id: return CsvReader::findColumn(header, {"id", "teacherid", "employeeid"});
+            case Name: return CsvReader::findColumn(header, {"name", "fullname", "teachername"});
+            case Subject: return CsvReader::findColumn(header, {"subject"});
+            case Email: return CsvReader::findColumn(header, {"email", "emailaddress"});
+            case Phone: return CsvReader::findColumn(header, {"phone", "phonenumber", "mobile"});
+            case Department: return CsvReader::findColumn(header, {"department", "dept"});
+            default: return CsvReader::findColumn(header, {"salary"});
         }
     }
     
-    void studentManagement() {
-        int choice;
-        do {
-            clearScreen();
-            std::cout << "👨‍🎓 STUDENT MANAGEMENT\n";
-            std::cout << "=======================\n\n";
-            
-            std::cout << "Current Students: " << students.size() << "\n";
-            std::cout << "Active Students: " << countActiveStudents() << "\n\n";
-            
-            std::cout << "1. ➕ Add New Student\n";
-            std::cout << "2. 📋 View All Students\n";
-            std::cout << "3. 🔍 Search Student\n";
-            std::cout << "4. ✏️  Edit Student\n";
-            std::cout << "5. ❌ Deactivate Student\n";
-            std::cout << "6. ✅ Reactivate Student\n";
-            std::cout << "7. 📚 Enroll in Course\n";
-            std::cout << "8. 📤 Unenroll from Course\n";
-            std::cout << "9. 📊 Student Report\n";
-            std::cout << "0. ⬅️  Back to Main Menu\n";
-            
-            choice = SafeInput::getInt("Enter your choice (0-9): ", 0, 9);
-            
-            switch (choice) {
-                case 1: addStudent(); break;
-                case 2: viewAllStudents(); break;
-                case 3: searchStudent(); break;
-                case 4: editStudent(); break;
-                case 5: deactivateStudent(); break;
-                case 6: reactivateStudent(); break;
-                case 7: enrollStudentInCourse(); break;
-                case 8: unenrollStudentFromCourse(); break;
-                case 9: generateStudentReport(); break;
-                case 0: break;
-                default: 
-                    std::cout << "❌ Invalid choice.\n";
-                    SafeInput::waitForEnter();
-            }
-        } while (choice != 0);
+    static bool isRequired(int field) { return field == Id || field == Name || field == Subject; }
+    
+    static const char* checkRow(const CsvImportRow& row) {
+        double salary = 0.0;
+        if (row[Subject].empty() || row[Subject].length() > 100) return "invalid subject";
+        if (!row.getDouble(Salary, 0.0, salary) || salary < 0) return "invalid salary";
+        return nullptr;
     }
     
-    void addStudent() {
-        clearScreen();
-        std::cout << "➕ ADD NEW STUDENT\n";
-        std::cout << "==================\n\n";
-        
-        // Get and validate student ID
-        int id;
-        while (true) {
-            id = SafeInput::getInt("Enter Student ID (1-999999): ", 1, 999999);
-            if (findStudentById(id) == nullptr) {
-                break;
-            }
-            std::cout << "❌ Student ID " << id << " already exists. Please choose a different ID.\n";
+    static Record create(const CsvImportRow& row, int id) {
+        double salary = 0.0;
+        row.getDouble(Salary, 0.0, salary);
+        return Teacher(id, row[Name], row[Subject], row[Email], row[Phone], row[Department], salary);
+    }
+    
+    static bool matches(const Record& teacher, const CsvImportRow& row) {
+        double salary = 0.0;
+        row.getDouble(Salary, teacher.getSalary(), salary);
+        return teacher.getName() == row[Name] && teacher.getSubject() == row[Subject] &&
+               teacher.getSalary() == salary &&
+               (!row.has(Email) || teacher.getEmail() == row[Email]) &&
+               (!row.has(Phone) || teacher.getPhone() == row[Phone]) &&
+               (!row.has(Department) || teacher.getDepartment() == row[Department]);
+    }
+    
+    static const char* update(Record& teacher, const CsvImportRow& row) {
+        double salary = 0.0;
+        row.getDouble(Salary, teacher.getSalary(), salary);
+        if (teacher.getName() != row[Name]) teacher.setName(row[Name]);
+        if (teacher.getSubject() != row[Subject]) teacher.setSubject(row[Subject]);
+        if (teacher.getSalary() != salary) teacher.setSalary(salary);
+        if (row.has(Email) && teacher.getEmail() != row[Email]) teacher.setEmail(row[Email]);
+        if (row.has(Phone) && teacher.getPhone() != row[Phone]) teacher.setPhone(row[Phone]);
+        if (row.has(Department) && teacher.getDepartment() != row[Department]) teacher.setDepartment(row[Department]);
+        return nullptr;
+    }
+};
+
+struct CourseCsvFormat {
+    typedef Course Record;
+    enum Field { Id, Name, Description, Credits, MaxStudents, Fee, FieldCount };
+    static const int NameField = Name, AgeField = -1, EmailField = -1, PhoneField = -1;
+    
+    static const char* entityName() { return "courses"; }
+    
+    static const char* fieldName(int field) {
+        static const char* names[FieldCount] = {"id", "name", "description", "credits", "max_students", "fee"};
+        return names[field];
+    }
+    
+    static int mapColumn(const std::vector<std::string>& header, int field) {
+        switch (field) {
+            case Id: return CsvReader::findColumn(header, {"id", "courseid"});
+            case Name: return CsvReader::findColumn(header, {"name", "coursename", "title"});
+            case Description: return CsvReader::findColumn(header, {"description"});
+            case Credits: return CsvReader::findColumn(header, {"credits"});
+            case MaxStudents: return CsvReader::findColumn(header, {"maxstudents", "capacity"});
+            default: return CsvReader::findColumn(header, {"fee"});
         }
-        
-        // Get student details with validation
-        std::string name = SafeInput::getString("Enter Student Name: ");
-        if (!InputValidator::isValidName(name)) {
-            std::cout << "❌ Invalid name format.\n";
-            SafeInput::waitForEnter();
-            return;
+    }
+    
+    static bool isRequired(int field) { return field == Id || field == Name; }
+    
+    static const char* checkRow(const CsvImportRow& row) {
+        int credits = 0, maxStudents = 0;
+        double fee = 0.0;
+        if (!row.getInt(Credits, 3, credits) || credits <= 0 || credits > 10) return "invalid credits";
+        if (!row.getInt(MaxStudents, 30, maxStudents) || maxStudents <= 0 || maxStudents > 500) return "invalid max students";
+        if (!row.getDouble(Fee, 0.0, fee) || fee < 0) return "invalid fee";
+        return nullptr;
+    }
+    
+    static Record create(const CsvImportRow& row, int id) {
+        int credits = 3, maxStudents = 30;
+        double fee = 0.0;
+        row.getInt(Credits, 3, credits);
+        row.getInt(MaxStudents, 30, maxStudents);
+        row.getDouble(Fee, 0.0, fee);
+        return Course(id, row[Name], row[Description], credits, maxStudents, fee);
+    }
+    
+    static bool matches(const Record& course, const CsvImportRow& row) {
+        int credits = 0, maxStudents = 0;
+        double fee = 0.0;
+        row.getInt(Credits, course.getCredits(), credits);
+        row.getInt(MaxStudents, course.getMaxStudents(), maxStudents);
+        row.getDouble(Fee, course.getFee(), fee);
+        return course.getName() == row[Name] && course.getCredits() == credits &&
+               course.getMaxStudents() == maxStudents && course.getFee() == fee &&
+               (!row.has(Description) || course.getDescription() == row[Description]);
+    }
+    
+    static const char* update(Record& course, const CsvImportRow& row) {
+        int credits = 0, maxStudents = 0;
+        double fee = 0.0;
+        row.getInt(Credits, course.getCredits(), credits);
+        row.getInt(MaxStudents, course.getMaxStudents(), maxStudents);
+        row.getDouble(Fee, course.getFee(), fee);
+        // The only change a course can refuse; checked before anything else is applied
+        if (course.getMaxStudents() != maxStudents &&
+            (maxStudents < course.getCurrentEnrollment() || !course.setMaxStudents(maxStudents))) {
+            return "max students below current enrollment";
         }
         
-        int age = SafeInput::getInt("Enter Student Age (16-100): ", 16, 100);
-        
-        std::string email = SafeInput::getString("Enter Email (optional): ", false);
-        if (!email.empty() && !InputValidator::isValidEmail(email)) {
-            std::cout << "❌ Invalid email format.\n";
-            SafeInput::waitForEnter();
+        if (course.getName() != row[Name]) course.setName(row[Name]);
+        if (course.getCredits() != credits) course.setCredits(credits);
+        if (course.getFee() != fee) course.setFee(fee);
+        if (row.has(Description) && course.getDescription() != row[Description]) course.setDescription(row[Description]);
+        return nullptr;
+    }
+};
+
+struct ClassroomCsvFormat {
+    typedef Classroom Record;
+    enum Field { Id, Location, Capacity, Building, Equipment, FieldCount };
+    static const int NameField = -1, AgeField = -1, EmailField = -1, PhoneField = -1;
+    
+    static const char* entityName() { return "classrooms"; }
+    
+    static const char* fieldName(int field) {
+        static const char* names[FieldCount] = {"id", "location", "capacity", "building", "equipment"};
+        return names[field];
+    }
+    
+    static int mapColumn(const std::vector<std::string>& header, int field) {
+        switch (field) {
+            case Id: return CsvReader::findColumn(header, {"id", "classroomid", "roomid"});
+            case Location: return CsvReader::findColumn(header, {"location", "room", "roomname"});
+            case Capacity: return CsvReader::findColumn(header, {"capacity", "seats"});
+            case Building: return CsvReader::findColumn(header, {"building"});
+            default: return CsvReader::findColumn(header, {"equipment"});
+        }
+    }
+    
+    static bool isRequired(int field) { return field == Id || field == Location || field == Capacity; }
+    
+    static const char* checkRow(const CsvImportRow& row) {
+        int capacity = 0;
+        if (row[Location].empty()) return "missing location";
+        if (!row.getInt(Capacity, 0, capacity) || capacity <= 0 || capacity > 1000) return "invalid capacity";
+        return nullptr;
+    }
+    
+    static Record create(const CsvImportRow& row, int id) {
+        int capacity = 0;
+        row.getInt(Capacity, 0, capacity);
+        return Classroom(id, row[Location], capacity, row[Building], row[Equipment]);
+    }
+    
+    static bool matches(const Record& classroom, const CsvImportRow& row) {
+        int capacity = 0;
+        row.getInt(Capacity, classroom.getCapacity(), capacity);
+        return classroom.getLocation() == row[Location] && classroom.getCapacity() == capacity &&
+               (!row.has(Building) || classroom.getBuilding() == row[Building]) &&
+               (!row.has(Equipment) || classroom.getEquipment() == row[Equipment]);
+    }
+    
+    static const char* update(Record& classroom, const CsvImportRow& row) {
+        int capacity = 0;
+        row.getInt(Capacity, classroom.getCapacity(), capacity);
+        if (classroom.getLocation() != row[Location]) classroom.setLocation(row[Location]);
+        if (classroom.getCapacity() != capacity) classroom.setCapacity(capacity);
+        if (row.has(Building) && classroom.getBuilding() != row[Building]) classroom.setBuilding(row[Building]);
+        if (row.has(Equipment) && classroom.getEquipment() != row[Equipment]) classroom.setEquipment(row[Equipment]);
+        return nullptr;
+    }
+};
+
+// Outcome and per-phase timings of one import
+struct CsvImportStats {
+    std::string entity;
+    std::string error;
+    size_t rows = 0;
+    size_t inserted = 0;
+    size_t updated = 0;
+    size_t unchanged = 0;
+    size_t rejected = 0;
+    size_t threads = 0;
+    double readSeconds = 0.0;
+    double parseSeconds = 0.0;
+    double validateSeconds = 0.0;
+    double upsertSeconds = 0.0;
+    std::vector<std::string> rejections; // first few, for display
+    
+    bool ok() const { return error.empty(); }
+    double totalSeconds() const { return readSeconds + parseSeconds + validateSeconds + upsertSeconds; }
+    double rowsPerSecond() const { return totalSeconds() > 0.0 ? rows / totalSeconds() : 0.0; }
+    
+    void display() const {
+        if (!ok()) {
+            std::cout << "❌ Import failed: " << error << "\n";
             return;
         }
+        std::cout << "📥 Imported " << rows << " " << entity << " rows in " << std::fixed << std::setprecision(3)
+                  << totalSeconds() << "s (" << static_cast<long long>(rowsPerSecond()) << " rows/sec, "
+                  << threads << " threads)\n";
+        std::cout << "   Inserted: " << inserted << "  Updated: " << updated << "  Unchanged: " << unchanged
+                  << "  Rejected: " << rejected << "\n";
+        std::cout << "   Phases (ms): read " << readSeconds * 1000.0 << ", parse " << parseSeconds * 1000.0
+                  << ", validate " << validateSeconds * 1000.0 << ", upsert " << upsertSeconds * 1000.0 << "\n";
+        for (const auto& rejection : rejections) {
+            std::cout << "   ⚠️  " << rejection << "\n";
+        }
+        if (rejected > rejections.size()) {
+            std::cout << "   ... and " << (rejected - rejections.size()) << " more rejected rows\n";
+        }
+    }
+};
+
+// Insert-or-update CSV import keyed by record ID. The file is read whole,
+// cut into record-aligned chunks and parsed in parallel; rows then go
+// through BatchValidator plus the format's own checks. Matching existing
+// records is also parallel and read-only, so re-importing unchanged data
+// only pays for the comparison; inserts and real updates are applied last.
+class CsvImporter {
+public:
+    static const size_t CHUNK_BYTES = 1 << 20;
+    static const size_t MAX_LISTED_REJECTIONS = 10;
+    
+    template <typename Format>
+    static CsvImportStats importFile(const std::string& filename, std::vector<typename Format::Record>& records,
+                                     size_t threadCount = 0) {
+        typedef std::chrono::steady_clock Clock;
+        const int fieldCount = Format::FieldCount;
+        CsvImportStats stats;
+        stats.entity = Format::entityName();
         
-        std::string phone = SafeInput::getString("Enter Phone (optional): ", false);
-        if (!phone.empty() && !InputValidator::isValidPhone(phone)) {
-            std::cout << "❌ Invalid phone format.\n";
-            SafeInput::waitForEnter();
-            return;
+        // Read
+        auto phaseStart = Clock::now();
+        std::string contents;
+        if (!CsvReader::readFile(filename, contents)) {
+            stats.error = "cannot open " + filename;
+            return stats;
         }
+        std::vector<std::string> header;
+        size_t dataStart = CsvReader::parseRecord(contents.data(), contents.size(), 0, header);
         
-        std::string address = SafeInput::getString("Enter Address (optional): ", false);
+        int columns[fieldCount];
+        bool mapped[fieldCount];
+        for (int field = 0; field < fieldCount; ++field) {
+            columns[field] = Format::mapColumn(header, field);
+            mapped[field] = columns[field] >= 0;
+            if (!mapped[field] && Format::isRequired(field)) {
+                stats.error = std::string("missing required column '") + Format::fieldName(field) + "' in header";
+                return stats;
+            }
+        }
+        stats.readSeconds = secondsSince(phaseStart);
         
-        // Create and add student
-        Student newStudent(id, name, age, email, phone, address);
-        students.push_back(newStudent);
+        // Parse: chunks are independent, so each thread fills its own row list
+        phaseStart = Clock::now();
+        std::vector<size_t> boundaries = CsvReader::chunkBoundaries(contents.data(), contents.size(), dataStart, CHUNK_BYTES);
+        size_t chunkCount = boundaries.size() - 1;
+        stats.threads = Parallel::threadCount(threadCount, chunkCount);
+        std::vector<std::vector<std::string>> chunkRows(chunkCount);
+        Parallel::forEach(chunkCount, stats.threads, [&](size_t chunk) {
+            std::vector<std::string> fields;
+            std::vector<std::string>& out = chunkRows[chunk];
+            size_t pos = boundaries[chunk];
+            size_t end = boundaries[chunk + 1];
+            while (pos < end) {
+                pos = CsvReader::parseRecord(contents.data(), end, pos, fields);
+                if (CsvReader::isBlankRecord(fields)) continue;
+                for (int field = 0; field < fieldCount; ++field) {
+                    out.emplace_back();
+                    int column = columns[field];
+                    if (column >= 0 && static_cast<size_t>(column) < fields.size()) {
+                        out.back().swap(fields[column]);
+                        InputValidator::sanitizeInPlace(out.back());
+                    }
+                }
+            }
+        });
         
-        // Save immediately
-        if (newStudent.saveToFile(STUDENTS_FILE)) {
-            std::cout << "\n✅ Student added successfully!\n";
-            newStudent.displayInfo();
-        } else {
-            std::cout << "\n❌ Error saving student to file.\n";
+        size_t totalFields = 0;
+        for (const auto& rows : chunkRows) totalFields += rows.size();
+        std::vector<std::string> rows;
+        rows.reserve(totalFields);
+        for (auto& chunk : chunkRows) {
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(rows));
+            std::vector<std::string>().swap(chunk);
         }
+        stats.parseSeconds = secondsSince(phaseStart);
         
-        SafeInput::waitForEnter();
+        importRows<Format>(rows, mapped, records, stats);
+        return stats;
     }
     
-    void viewAllStudents() {
-        clearScreen();
-        std::cout << "📋 ALL STUDENTS\n";
-        std::cout << "===============\n\n";
+    // JSON Lines with the same field names as the CSV header. A field is
+    // imported when any record has it; records without it leave it empty.
+    // Malformed lines are rejected on their own.
+    template <typename Format>
+    static CsvImportStats importJsonLinesFile(const std::string& filename, std::vector<typename Format::Record>& records,
+                                              size_t threadCount = 0) {
+        typedef std::chrono::steady_clock Clock;
+        const int fieldCount = Format::FieldCount;
+        CsvImportStats stats;
+        stats.entity = Format::entityName();
         
-        if (students.empty()) {
-            std::cout << "No students found.\n";
-            SafeInput::waitForEnter();
-            return;
+        auto phaseStart = Clock::now();
+        std::string contents;
+        if (!CsvReader::readFile(filename, contents)) {
+            stats.error = "cannot open " + filename;
+            return stats;
         }
+        stats.readSeconds = secondsSince(phaseStart);
         
-        // Display header
-        std::cout << std::setw(5) << "ID" << " | " 
-                  << std::setw(20) << "Name" << " | "
-                  << std::setw(3) << "Age" << " | "
-                  << std::setw(25) << "Email" << " | "
-                  << std::setw(8) << "Status" << "\n";
-        std::cout << std::string(70, '-') << "\n";
+        // Parse: each chunk is indexed and walked by its own JsonLinesReader pass
+        phaseStart = Clock::now();
+        std::vector<size_t> boundaries = JsonLinesReader::chunkBoundaries(contents.data(), contents.size(), CHUNK_BYTES);
+        size_t chunkCount = boundaries.size() - 1;
+        stats.threads = Parallel::threadCount(threadCount, chunkCount);
+        std::vector<JsonImportHandler<Format>> handlers(chunkCount);
+        std::vector<size_t> chunkLines(chunkCount + 1, 0);
+        Parallel::forEach(chunkCount, stats.threads, [&](size_t chunk) {
+            const char* data = contents.data() + boundaries[chunk];
+            size_t size = boundaries[chunk + 1] - boundaries[chunk];
+            std::vector<uint32_t> index;
+            std::string scratch;
+            JsonLinesReader::parse(data, size, handlers[chunk], index, scratch, 0);
+            chunkLines[chunk + 1] = std::count(data, data + size, '\n');
+        });
         
-        // Display students
-        for (const auto& student : students) {
-            student.displaySummary();
+        uint32_t seenFields = 0;
+        size_t totalFields = 0;
+        for (const auto& handler : handlers) {
+            seenFields |= handler.seenFields;
+            totalFields += handler.rows.size();
+        }
+        bool mapped[fieldCount];
+        for (int field = 0; field < fieldCount; ++field) {
+            mapped[field] = (seenFields >> field) & 1;
+            if (!mapped[field] && Format::isRequired(field) && totalFields > 0) {
+                stats.error = std::string("missing required field '") + Format::fieldName(field) + "'";
+                return stats;
+            }
         }
         
-        std::cout << "\nTotal Students: " << students.size() << "\n";
-        std::cout << "Active Students: " << countActiveStudents() << "\n";
+        std::vector<std::string> rows;
+        rows.reserve(totalFields);
+        size_t malformed = 0;
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            chunkLines[chunk + 1] += chunkLines[chunk];
+            for (const auto& error : handlers[chunk].errors) {
+                malformed++;
+                if (stats.rejections.size() < MAX_LISTED_REJECTIONS) {
+                    stats.rejections.push_back("line " + std::to_string(chunkLines[chunk] + error.first + 1) + ": " + error.second);
+                }
+            }
+            std::vector<std::string>& chunkRows = handlers[chunk].rows;
+            std::move(chunkRows.begin(), chunkRows.end(), std::back_inserter(rows));
+            std::vector<std::string>().swap(chunkRows);
+        }
+        stats.parseSeconds = secondsSince(phaseStart);
         
-        SafeInput::waitForEnter();
+        importRows<Format>(rows, mapped, records, stats);
+        stats.rows += malformed;
+        stats.rejected += malformed;
+        return stats;
     }
     
-    void searchStudent() {
-        clearScreen();
-        std::cout << "🔍 SEARCH STUDENT\n";
-        std::cout << "=================\n\n";
-        
-        std::cout << "Search by:\n";
-        std::cout << "1. Student ID\n";
-        std::cout << "2. Student Name\n";
+private:
+    // Collects one chunk's records in the flat row layout used by CSV
+    // import, remembering which key maps to which field
+    template <typename Format>
+    struct JsonImportHandler {
+        std::vector<std::string> rows;
+        std::vector<std::pair<size_t, const char*>> errors; // chunk-relative line, message
+        std::vector<std::pair<std::string, int>> keyFields;
+        size_t nextKey = 0;
+        uint32_t seenFields = 0;
+        size_t recordStart = 0;
+        bool inRecord = false;
         
-        int searchType = SafeInput::getInt("Enter search type (1-2): ", 1, 2);
+        void beginRecord() {
+            recordStart = rows.size();
+            rows.resize(recordStart + Format::FieldCount);
+            inRecord = true;
+        }
         
-        if (searchType == 1) {
-            int id = SafeInput::getInt("Enter Student ID: ");
-            Student* student = findStudentById(id);
-            if (student) {
-                std::cout << "\n✅ Student found:\n";
-                student->displayInfo();
+        void field(const char* key, size_t keyLength, JsonLinesReader::ValueType type, const char* value, size_t valueLength) {
+            int field = fieldFor(key, keyLength);
+            if (field < 0 || type == JsonLinesReader::Array || type == JsonLinesReader::Object) return;
+            std::string& text = rows[recordStart + field];
+            if (type == JsonLinesReader::Null) {
+                text.clear();
             } else {
-                std::cout << "\n❌ Student with ID " << id << " not found.\n";
+                text.assign(value, valueLength);
+                InputValidator::sanitizeInPlace(text);
             }
-        } else {
-            std::string name = SafeInput::getString("Enter Student Name (or part of name): ");
-            std::vector<Student*> foundStudents = searchStudentsByName(name);
-            
-            if (foundStudents.empty()) {
-                std::cout << "\n❌ No students found with name containing '" << name << "'.\n";
-            } else {
-                std::cout << "\n✅ Found " << foundStudents.size() << " student(s):\n\n";
-                for (Student* student : foundStudents) {
-                    student->displayInfo();
-                    std::cout << std::string(50, '-') << "\n";
+            seenFields |= uint32_t(1) << field;
+        }
+        
+        void endRecord() { inRecord = false; }
+        
+        void recordError(size_t line, const char* message) {
+            if (inRecord) rows.resize(recordStart);
+            inRecord = false;
+            errors.emplace_back(line, message);
+        }
+        
+        // Records usually repeat the same key order, so the key after the
+        // previous one is tried first
+        int fieldFor(const char* key, size_t keyLength) {
+            for (size_t probe = 0; probe < keyFields.size(); ++probe) {
+                size_t slot = (nextKey + probe) % keyFields.size();
+                const std::string& name = keyFields[slot].first;
+                if (name.size() == keyLength && std::memcmp(name.data(), key, keyLength) == 0) {
+                    nextKey = slot + 1;
+                    return keyFields[slot].second;
                 }
             }
+            std::vector<std::string> header(1, std::string(key, keyLength));
+            int match = -1;
+            for (int field = 0; field < Format::FieldCount && match < 0; ++field) {
+                if (Format::mapColumn(header, field) == 0) match = field;
+            }
+            keyFields.emplace_back(header[0], match);
+            nextKey = keyFields.size();
+            return match;
         }
+    };
+    
+    // Validate and upsert parsed rows (FieldCount strings each, in the
+    // format's field order)
+    template <typename Format>
+    static void importRows(std::vector<std::string>& rows, const bool* mapped,
+                           std::vector<typename Format::Record>& records, CsvImportStats& stats) {
+        typedef std::chrono::steady_clock Clock;
+        const int fieldCount = Format::FieldCount;
+        stats.rows = rows.size() / fieldCount;
         
-        SafeInput::waitForEnter();
+        // Validate: shared InputValidator rules, duplicate IDs, then format checks
+        auto phaseStart = Clock::now();
+        RecordColumns batch;
+        batch.ids.resize(stats.rows);
+        if (Format::NameField >= 0) batch.names.resize(stats.rows);
+        if (Format::AgeField >= 0) batch.ages.resize(stats.rows);
+        if (Format::EmailField >= 0) batch.emails.resize(stats.rows);
+        if (Format::PhoneField >= 0) batch.phones.resize(stats.rows);
+        
+        const size_t blockRows = 16384;
+        size_t blocks = (stats.rows + blockRows - 1) / blockRows;
+        std::vector<const char*> formatErrors(stats.rows, nullptr);
+        Parallel::forEach(blocks, stats.threads, [&](size_t block) {
+            size_t end = std::min(stats.rows, (block + 1) * blockRows);
+            for (size_t row = block * blockRows; row < end; ++row) {
+                CsvImportRow importRow = {rows.data() + row * fieldCount, mapped};
+                if (!importRow.getInt(0, 0, batch.ids[row])) batch.ids[row] = 0;
+                if (Format::AgeField >= 0 && !importRow.getInt(Format::AgeField, 0, batch.ages[row])) batch.ages[row] = -1;
+                formatErrors[row] = Format::checkRow(importRow);
+                borrowFields<Format>(rows.data() + row * fieldCount, batch, row);
+            }
+        });
+        BatchValidator::Report report = BatchValidator::validate(batch, stats.threads);
+        Parallel::forEach(blocks, stats.threads, [&](size_t block) {
+            size_t end = std::min(stats.rows, (block + 1) * blockRows);
+            for (size_t row = block * blockRows; row < end; ++row) {
+                borrowFields<Format>(rows.data() + row * fieldCount, batch, row);
+            }
+        });
+        stats.validateSeconds = secondsSince(phaseStart);
+        
+        // Upsert: classify against existing records in parallel, then apply
+        phaseStart = Clock::now();
+        std::unordered_map<int, size_t> index;
+        index.reserve(records.size() + stats.rows);
+        for (size_t i = 0; i < records.size(); ++i) index.emplace(records[i].getId(), i);
+        
+        enum Action : uint8_t { Reject, Insert, Update, Unchanged };
+        std::vector<uint8_t> actions(stats.rows);
+        std::vector<size_t> targets(stats.rows, 0);
+        Parallel::forEach(blocks, stats.threads, [&](size_t block) {
+            size_t end = std::min(stats.rows, (block + 1) * blockRows);
+            for (size_t row = block * blockRows; row < end; ++row) {
+                if (!report.isValid(row) || formatErrors[row]) {
+                    actions[row] = Reject;
+                    continue;
+                }
+                auto existing = index.find(batch.ids[row]);
+                if (existing == index.end()) {
+                    actions[row] = Insert;
+                    continue;
+                }
+                targets[row] = existing->second;
+                CsvImportRow importRow = {rows.data() + row * fieldCount, mapped};
+                actions[row] = Format::matches(records[existing->second], importRow) ? Unchanged : Update;
+            }
+        });
+        
+        auto reject = [&stats](size_t row, const std::string& reason) {
+            stats.rejected++;
+            if (stats.rejections.size() < MAX_LISTED_REJECTIONS) {
+                stats.rejections.push_back("row " + std::to_string(row + 1) + ": " + reason);
+            }
+        };
+        for (size_t row = 0; row < stats.rows; ++row) {
+            CsvImportRow importRow = {rows.data() + row * fieldCount, mapped};
+            switch (actions[row]) {
+                case Insert:
+                    records.push_back(Format::create(importRow, batch.ids[row]));
+                    stats.inserted++;
+                    break;
+                case Update:
+                    if (const char* refused = Format::update(records[targets[row]], importRow)) {
+                        reject(row, refused);
+                    } else {
+                        stats.updated++;
+                    }
+                    break;
+                case Unchanged:
+                    stats.unchanged++;
+                    break;
+                default:
+                    reject(row, report.errors[row] ? BatchValidator::describe(report.errors[row]) : formatErrors[row]);
+                    break;
+            }
+        }
+        stats.upsertSeconds = secondsSince(phaseStart);
     }
     
-    // Additional helper methods
-    void clearScreen() {
-        #ifdef _WIN32
-            system("cls");
-        #else
-            system("clear");
-        #endif
+    // Swaps the text fields between a parsed row and the validation columns;
+    // called once to lend them to BatchValidator and once to take them back
+    template <typename Format>
+    static void borrowFields(std::string* fields, RecordColumns& batch, size_t row) {
+        if (Format::NameField >= 0) fields[Format::NameField].swap(batch.names[row]);
+        if (Format::EmailField >= 0) fields[Format::EmailField].swap(batch.emails[row]);
+        if (Format::PhoneField >= 0) fields[Format::PhoneField].swap(batch.phones[row]);
     }
     
-    void displaySystemStatus() {
-        std::cout << "📊 System Status: ";
-        std::cout << students.size() << " Students | ";
-        std::cout << teachers.size() << " Teachers | ";
-        std::cout << courses.size() << " Courses | ";
-        std::cout << classrooms.size() << " Classrooms\n";
+    static double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Point-in-time copy of the collections that reports and exports read, so
+// edits to the live records carry on while they run. version is the model
+// version it was copied at.
+struct ModelSnapshot {
+    std::vector<Student> students;
+    std::vector<Teacher> teachers;
+    std::vector<Course> courses;
+    std::vector<Classroom> classrooms;
+    uint64_t version = 0;
+};
+
+struct ExportFileStats {
+    std::string filename;
+    size_t records = 0;
+    size_t bytes = 0;
+    bool failed = false;
+};
+
+struct ExportStats {
+    std::vector<ExportFileStats> files;
+    double seconds = 0.0;
+    size_t threads = 0;
+    
+    void display() const {
+        size_t records = 0, bytes = 0;
+        std::cout << "\n📤 Export finished in " << std::fixed << std::setprecision(1) << seconds * 1000.0
+                  << " ms (" << threads << " thread" << (threads == 1 ? "" : "s") << ")\n";
+        for (const auto& file : files) {
+            std::cout << "   " << (file.failed ? "❌ " : "✅ ") << file.filename << ": "
+                      << file.records << " records, " << file.bytes << " bytes\n";
+            records += file.records;
+            bytes += file.bytes;
+        }
+        std::cout << "   Total: " << records << " records, " << bytes << " bytes\n";
     }
+};
+
+// Streams every collection, plus the student x course enrollment view, to
+// CSV and/or JSON Lines. Each table is written by one worker through its
+// own OutputBuffer; fields go from the records straight into the buffer.
+class DataExporter {
+public:
+    enum Table { Students, Teachers, Courses, Classrooms, Enrollments, TableCount };
     
-    int countActiveStudents() {
-        return std::count_if(students.begin(), students.end(),
-            [](const Student& s) { return s.getIsActive(); });
+    static const char* tableName(int table) {
+        static const char* const names[TableCount] = {"students", "teachers", "courses", "classrooms", "enrollments"};
+        return names[table];
     }
     
-    int countActiveTeachers() {
-        return std::count_if(teachers.begin(), teachers.end(),
-            [](const Teacher& t) { return t.getIsActive(); });
+    // Writes <directory><table><extension> for every table and format
+    static ExportStats exportAll(const ModelSnapshot& snapshot, const std::string& directory,
+                                 const std::vector<RecordWriter::Format>& formats, size_t threadCount = 0) {
+        auto start = std::chrono::steady_clock::now();
+        ExportStats stats;
+        size_t jobs = TableCount * formats.size();
+        stats.files.resize(jobs);
+        stats.threads = Parallel::threadCount(threadCount, jobs);
+        Parallel::forEach(jobs, stats.threads, [&](size_t job) {
+            int table = static_cast<int>(job % TableCount);
+            RecordWriter::Format format = formats[job / TableCount];
+            ExportFileStats& file = stats.files[job];
+            file.filename = directory + tableName(table) + RecordWriter::extension(format);
+            
+            OutputBuffer out;
+            if (!out.open(file.filename)) {
+                file.failed = true;
+                return;
+            }
+            file.records = writeTable(table, snapshot, format, out);
+            file.bytes = out.getBytesWritten();
+            file.failed = !out.close();
+        });
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
     }
     
-    Student* findStudentById(int id) {
-        auto it = std::find_if(students.begin(), students.end(),
-            [id](const Student& s) { return s.getId() == id; });
-        return (it != students.end()) ? &(*it) : nullptr;
+    static size_t writeTable(int table, const ModelSnapshot& snapshot, RecordWriter::Format format, OutputBuffer& out) {
+        switch (table) {
+            case Students: return writeStudents(snapshot.students, format, out);
+            case Teachers: return writeTeachers(snapshot.teachers, format, out);
+            case Courses: return writeCourses(snapshot.courses, format, out);
+            case Classrooms: return writeClassrooms(snapshot.classrooms, format, out);
+            case Enrollments: return writeEnrollments(snapshot, format, out);
+        }
+        return 0;
     }
     
-    Teacher* findTeacherById(int id) {
-        auto it = std::find_if(teachers.begin(), teachers.end(),
-            [id](const Teacher& t) { return t.getId() == id; });
-        return (it != teachers.end()) ? &(*it) : nullptr;
+    static size_t writeStudents(const std::vector<Student>& students, RecordWriter::Format format, OutputBuffer& out) {
+        RecordWriter writer = studentWriter(out, format);
+        for (const auto& student : students) writeStudent(writer, student);
+        return writer.getRecordCount();
     }
     
-    Course* findCourseById(int id) {
-        auto it = std::find_if(courses.begin(), courses.end(),
-            [id](const Course& c) { return c.getId() == id; });
-        return (it != courses.end()) ? &(*it) : nullptr;
+    static size_t writeTeachers(const std::vector<Teacher>& teachers, RecordWriter::Format format, OutputBuffer& out) {
+        RecordWriter writer = teacherWriter(out, format);
+        for (const auto& teacher : teachers) writeTeacher(writer, teacher);
+        return writer.getRecordCount();
     }
     
-    std::vector<Student*> searchStudentsByName(const std::string& name) {
-        std::vector<Student*> results;
-        std::string lowerName = name;
-        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    static size_t writeCourses(const std::vector<Course>& courses, RecordWriter::Format format, OutputBuffer& out) {
+        RecordWriter writer = courseWriter(out, format);
+        for (const auto& course : courses) writeCourse(writer, course);
+        return writer.getRecordCount();
+    }
+    
+    // Single-record layouts, shared with the daemon's lookups
+    static RecordWriter studentWriter(OutputBuffer& out, RecordWriter::Format format) {
+        return RecordWriter(out, format, {"id", "name", "age", "email", "phone", "address",
+                                          "enrollment_date", "active", "course_ids"});
+    }
+    
+    static void writeStudent(RecordWriter& writer, const Student& student) {
+        writer.field(student.getId()).field(student.getName()).field(student.getAge())
+              .field(student.getEmail()).field(student.getPhone()).field(student.getAddress())
+              .field(student.getEnrollmentDate()).field(student.getIsActive())
+              .field(student.getEnrolledCourses());
+        writer.endRecord();
+    }
+    
+    static RecordWriter teacherWriter(OutputBuffer& out, RecordWriter::Format format) {
+        return RecordWriter(out, format, {"id", "name", "subject", "email", "phone", "department",
+                                          "hire_date", "salary", "active", "course_ids"});
+    }
+    
+    static void writeTeacher(RecordWriter& writer, const Teacher& teacher) {
+        writer.field(teacher.getId()).field(teacher.getName()).field(teacher.getSubject())
+              .field(teacher.getEmail()).field(teacher.getPhone()).field(teacher.getDepartment())
+              .field(teacher.getHireDate()).field(teacher.getSalary()).field(teacher.getIsActive())
+              .field(teacher.getAssignedCourses());
+        writer.endRecord();
+    }
+    
+    static RecordWriter courseWriter(OutputBuffer& out, RecordWriter::Format format) {
+        return RecordWriter(out, format, {"id", "name", "description", "credits", "max_students", "enrolled",
+                                          "teacher_id", "start_date", "end_date", "fee", "active"});
+    }
+    
+    static void writeCourse(RecordWriter& writer, const Course& course) {
+        writer.field(course.getId()).field(course.getName()).field(course.getDescription())
+              .field(course.getCredits()).field(course.getMaxStudents()).field(course.getCurrentEnrollment())
+              .field(course.getAssignedTeacherId()).field(course.getStartDate()).field(course.getEndDate())
+              .field(course.getFee()).field(course.getIsActive());
+        writer.endRecord();
+    }
+    
+    static size_t writeClassrooms(const std::vector<Classroom>& classrooms, RecordWriter::Format format, OutputBuffer& out) {
+        RecordWriter writer(out, format, {"id", "location", "building", "capacity", "equipment",
+                                          "available", "course_ids"});
+        for (const auto& classroom : classrooms) {
+            writer.field(classroom.getId()).field(classroom.getLocation()).field(classroom.getBuilding())
+                  .field(classroom.getCapacity()).field(classroom.getEquipment())
+                  .field(classroom.getIsAvailable()).field(classroom.getScheduledCourses());
+            writer.endRecord();
+        }
+        return writer.getRecordCount();
+    }
+    
+    // One row per (student, course) enrollment, joined with the course and
+    // its teacher; enrollments of courses that no longer exist are skipped
+    static size_t writeEnrollments(const ModelSnapshot& snapshot, RecordWriter::Format format, OutputBuffer& out) {
+        std::unordered_map<int, const Course*> courseById;
+        std::unordered_map<int, const Teacher*> teacherById;
+        courseById.reserve(snapshot.courses.size());
+        teacherById.reserve(snapshot.teachers.size());
+        for (const auto& course : snapshot.courses) courseById.emplace(course.getId(), &course);
+        for (const auto& teacher : snapshot.teachers) teacherById.emplace(teacher.getId(), &teacher);
         
-        for (auto& student : students) {
-            std::string studentName = student.getName();
-            std::transform(studentName.begin(), studentName.end(), studentName.begin(), ::tolower);
-            if (studentName.find(lowerName) != std::string::npos) {
-                results.push_back(&student);
+        static const std::string noTeacher;
+        RecordWriter writer(out, format, {"student_id", "student_name", "course_id", "course_name",
+                                          "credits", "teacher_id", "teacher_name"});
+        for (const auto& student : snapshot.students) {
+            for (int courseId : student.getEnrolledCourses()) {
+                auto course = courseById.find(courseId);
+                if (course == courseById.end()) continue;
+                auto teacher = teacherById.find(course->second->getAssignedTeacherId());
+                writer.field(student.getId()).field(student.getName())
+                      .field(courseId).field(course->second->getName()).field(course->second->getCredits())
+                      .field(course->second->getAssignedTeacherId())
+                      .field(teacher == teacherById.end() ? noTeacher : teacher->second->getName());
+                writer.endRecord();
             }
         }
-        
-        return results;
+        return writer.getRecordCount();
     }
+};
+
+// Columnar (.smcol) extracts for the analytics notebooks: students,
+// teachers, courses, the enrollment join and per-session attendance. Each
+// table is laid out as columns over the snapshot (strings are views, not
+// copies) and handed to the parallel ColumnarWriter.
+class ColumnarExporter {
+public:
+    static const char* extension() { return ".smcol"; }
     
-    void loadAllData() {
-        std::cout << "📂 Loading system data...\n";
-        students = Student::loadFromFile(STUDENTS_FILE);
-        teachers = Teacher::loadFromFile(TEACHERS_FILE);
-        courses = Course::loadFromFile(COURSES_FILE);
-        classrooms = Classroom::loadFromFile(CLASSROOMS_FILE);
-        std::cout << "✅ Data loading completed.\n\n";
+    static ExportStats exportAll(const ModelSnapshot& snapshot, const std::string& directory, size_t threadCount = 0) {
+        auto start = std::chrono::steady_clock::now();
+        ExportStats stats;
+        std::vector<ColumnarTable> tables;
+        tables.push_back(studentTable(snapshot.students));
+        tables.push_back(teacherTable(snapshot.teachers));
+        tables.push_back(courseTable(snapshot.courses));
+        tables.push_back(enrollmentTable(snapshot));
+        tables.push_back(attendanceTable(snapshot.students));
+        
+        for (const auto& table : tables) {
+            ExportFileStats file;
+            file.filename = directory + table.name + extension();
+            ColumnarWriteStats written;
+            std::string error;
+            file.failed = !ColumnarWriter::write(file.filename, table, written, error,
+                                                 ColumnarFile::DEFAULT_ROW_GROUP_ROWS, threadCount);
+            file.records = written.rows;
+            file.bytes = written.bytes;
+            stats.threads = std::max(stats.threads, written.threads);
+            stats.files.push_back(file);
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
     }
     
-    void saveAllData() {
-        std::cout << "💾 Saving all data...\n";
-        
-        // Clear files and save all data
-        clearFile(STUDENTS_FILE);
-        clearFile(TEACHERS_FILE);
-        clearFile(COURSES_FILE);
-        clearFile(CLASSROOMS_FILE);
-        
+    static ColumnarTable studentTable(const std::vector<Student>& students) {
+        ColumnarTable table("students");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        size_t name = table.addColumn("name", ColumnarFile::String);
+        size_t age = table.addColumn("age", ColumnarFile::Int);
+        size_t email = table.addColumn("email", ColumnarFile::String);
+        size_t phone = table.addColumn("phone", ColumnarFile::String);
+        size_t address = table.addColumn("address", ColumnarFile::String);
+        size_t enrolled = table.addColumn("enrollment_date", ColumnarFile::String);
+        size_t active = table.addColumn("active", ColumnarFile::Bool);
+        size_t courseCount = table.addColumn("course_count", ColumnarFile::Int);
+        table.reserve(students.size());
         for (const auto& student : students) {
-            student.saveToFile(STUDENTS_FILE);
+            table.columns[id].ints.push_back(student.getId());
+            table.columns[name].strings.push_back(student.getName());
+            table.columns[age].ints.push_back(student.getAge());
+            table.columns[email].strings.push_back(student.getEmail());
+            table.columns[phone].strings.push_back(student.getPhone());
+            table.columns[address].strings.push_back(student.getAddress());
+            table.columns[enrolled].strings.push_back(student.getEnrollmentDate());
+            table.columns[active].ints.push_back(student.getIsActive());
+            table.columns[courseCount].ints.push_back(student.getEnrolledCourses().size());
         }
-        
+        return table;
+    }
+    
+    static ColumnarTable teacherTable(const std::vector<Teacher>& teachers) {
+        ColumnarTable table("teachers");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        size_t name = table.addColumn("name", ColumnarFile::String);
+        size_t subject = table.addColumn("subject", ColumnarFile::String);
+        size_t email = table.addColumn("email", ColumnarFile::String);
+        size_t phone = table.addColumn("phone", ColumnarFile::String);
+        size_t department = table.addColumn("department", ColumnarFile::String);
+        size_t hired = table.addColumn("hire_date", ColumnarFile::String);
+        size_t salary = table.addColumn("salary", ColumnarFile::Double);
+        size_t active = table.addColumn("active", ColumnarFile::Bool);
+        size_t courseCount = table.addColumn("course_count", ColumnarFile::Int);
+        table.reserve(teachers.size());
         for (const auto& teacher : teachers) {
-            teacher.saveToFile(TEACHERS_FILE);
+            table.columns[id].ints.push_back(teacher.getId());
+            table.columns[name].strings.push_back(teacher.getName());
+            table.columns[subject].strings.push_back(teacher.getSubject());
+            table.columns[email].strings.push_back(teacher.getEmail());
+            table.columns[phone].strings.push_back(teacher.getPhone());
+            table.columns[department].strings.push_back(teacher.getDepartment());
+            table.columns[hired].strings.push_back(teacher.getHireDate());
+            table.columns[salary].doubles.push_back(teacher.getSalary());
+            table.columns[active].ints.push_back(teacher.getIsActive());
+            table.columns[courseCount].ints.push_back(teacher.getAssignedCourses().size());
         }
-        
+        return table;
+    }
+    
+    static ColumnarTable courseTable(const std::vector<Course>& courses) {
+        ColumnarTable table("courses");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        size_t name = table.addColumn("name", ColumnarFile::String);
+        size_t description = table.addColumn("description", ColumnarFile::String);
+        size_t credits = table.addColumn("credits", ColumnarFile::Int);
+        size_t maxStudents = table.addColumn("max_students", ColumnarFile::Int);
+        size_t enrolled = table.addColumn("enrolled", ColumnarFile::Int);
+        size_t teacher = table.addColumn("teacher_id", ColumnarFile::Int);
+        size_t startDate = table.addColumn("start_date", ColumnarFile::String);
+        size_t endDate = table.addColumn("end_date", ColumnarFile::String);
+        size_t fee = table.addColumn("fee", ColumnarFile::Double);
+        size_t active = table.addColumn("active", ColumnarFile::Bool);
+        table.reserve(courses.size());
         for (const auto& course : courses) {
-            course.saveToFile(COURSES_FILE);
+            table.columns[id].ints.push_back(course.getId());
+            table.columns[name].strings.push_back(course.getName());
+            table.columns[description].strings.push_back(course.getDescription());
+            table.columns[credits].ints.push_back(course.getCredits());
+            table.columns[maxStudents].ints.push_back(course.getMaxStudents());
+            table.columns[enrolled].ints.push_back(course.getCurrentEnrollment());
+            table.columns[teacher].ints.push_back(course.getAssignedTeacherId());
+            table.columns[startDate].strings.push_back(course.getStartDate());
+            table.columns[endDate].strings.push_back(course.getEndDate());
+            table.columns[fee].doubles.push_back(course.getFee());
+            table.columns[active].ints.push_back(course.getIsActive());
         }
+        return table;
+    }
+    
+    // Same join as the CSV enrollments view
+    static ColumnarTable enrollmentTable(const ModelSnapshot& snapshot) {
+        std::unordered_map<int, const Course*> courseById;
+        courseById.reserve(snapshot.courses.size());
+        for (const auto& course : snapshot.courses) courseById.emplace(course.getId(), &course);
         
-        for (const auto& classroom : classrooms) {
-            classroom.saveToFile(CLASSROOMS_FILE);
+        ColumnarTable table("enrollments");
+        size_t studentId = table.addColumn("student_id", ColumnarFile::Int);
+        size_t studentName = table.addColumn("student_name", ColumnarFile::String);
+        size_t courseId = table.addColumn("course_id", ColumnarFile::Int);
+        size_t courseName = table.addColumn("course_name", ColumnarFile::String);
+        size_t credits = table.addColumn("credits", ColumnarFile::Int);
+        size_t teacherId = table.addColumn("teacher_id", ColumnarFile::Int);
+        for (const auto& student : snapshot.students) {
+            for (int id : student.getEnrolledCourses()) {
+                auto course = courseById.find(id);
+                if (course == courseById.end()) continue;
+                table.columns[studentId].ints.push_back(student.getId());
+                table.columns[studentName].strings.push_back(student.getName());
+                table.columns[courseId].ints.push_back(id);
+                table.columns[courseName].strings.push_back(course->second->getName());
+                table.columns[credits].ints.push_back(course->second->getCredits());
+                table.columns[teacherId].ints.push_back(course->second->getAssignedTeacherId());
+            }
         }
-        
-        std::cout << "✅ All data saved successfully.\n";
+        return table;
     }
     
-    void clearFile(const std::string& filename) {
-        std::ofstream file(filename, std::ios::trunc);
-        file.close();
+    // One row per recorded session, in student then course order, so the
+    // ID columns compress to runs and present to one bit per row
+    static ColumnarTable attendanceTable(const std::vector<Student>& students) {
+        ColumnarTable table("attendance");
+        size_t studentId = table.addColumn("student_id", ColumnarFile::Int);
+        size_t courseId = table.addColumn("course_id", ColumnarFile::Int);
+        size_t session = table.addColumn("session", ColumnarFile::Int);
+        size_t present = table.addColumn("present", ColumnarFile::Bool);
+        for (const auto& student : students) {
+            for (const auto& record : student.getAttendance()) {
+                uint32_t sessions = record.second.getSessionCount();
+                for (uint32_t s = 0; s < sessions; ++s) {
+                    table.columns[studentId].ints.push_back(student.getId());
+                    table.columns[courseId].ints.push_back(record.first);
+                    table.columns[session].ints.push_back(s);
+                    table.columns[present].ints.push_back(record.second.wasPresent(s));
+                }
+            }
+        }
+        return table;
     }
+};
+
+// One student's picks for an all-or-nothing enrollment, and what became of
+// each course. A request either takes every seat or none: when any course
+// can't be joined, the others report RolledBack.
+struct EnrollmentRequest {
+    int studentId = 0;
+    std::vector<int> courseIds;
+};
+
+enum class EnrollmentOutcome { Enrolled, RolledBack, Full, CourseInactive, AlreadyEnrolled, CourseNotFound, Duplicate };
+
+struct EnrollmentResult {
+    bool committed = false;
+    std::vector<EnrollmentOutcome> outcomes; // parallel to courseIds
+    std::string message;                     // student=... committed=... course=outcome ...
     
-    void createBackup() {
-        // Create backup directory if it doesn't exist
-        #ifdef _WIN32
-            system(("mkdir " + BACKUP_DIR + " 2>nul").c_str());
-        #else
-            system(("mkdir -p " + BACKUP_DIR).c_str());
-        #endif
-        
-        // Copy files to backup directory with timestamp
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
-        std::string timestamp = ss.str();
-        
-        std::cout << "🔄 Creating backup with timestamp: " << timestamp << "\n";
-        // Backup implementation would go here
+    static const char* outcomeName(EnrollmentOutcome outcome) {
+        switch (outcome) {
+            case EnrollmentOutcome::Enrolled: return "enrolled";
+            case EnrollmentOutcome::RolledBack: return "rolled_back";
+            case EnrollmentOutcome::Full: return "full";
+            case EnrollmentOutcome::CourseInactive: return "inactive";
+            case EnrollmentOutcome::AlreadyEnrolled: return "already_enrolled";
+            case EnrollmentOutcome::CourseNotFound: return "not_found";
+            case EnrollmentOutcome::Duplicate: return "duplicate";
+        }
+        return "unknown";
     }
+};
     
-    // Placeholder methods for other functionalities
-    void teacherManagement() {
-        int choice;
-        do {
-            clearScreen();
-            std::cout << "👩‍🏫 TEACHER MANAGEMENT\n";
-            std::cout << "========================\n\n";
-            
-            std::cout << "Current Teachers: " << teachers.size() << "\n";
-            std::cout << "Active Teachers: " << countActiveTeachers() << "\n\n";
-            
-            std::cout << "1. ➕ Add New Teacher\n";
-            std::cout << "2. 📋 View All Teachers\n";
-            std::cout << "3. 🔍 Search Teacher\n";
-            std::cout << "4. ✏️  Edit Teacher\n";
-            std::cout << "5. ❌ Deactivate Teacher\n";
-            std::cout << "6. ✅ Reactivate Teacher\n";
-            std::cout << "7. 📚 Assign to Course\n";
-            std::cout << "8. 📤 Unassign from Course\n";
-            std::cout << "9. 📊 Teacher Report\n";
-            std::cout << "0. ⬅️  Back to Main Menu\n\n";
-            
-            choice = SafeInput::getInt("Enter your choice: ");
-            
-            switch (choice) {
-                case 1: addTeacher(); break;
-                case 2: viewAllTeachers(); break;
-                case 3: searchTeacher(); break;
-                case 4: editTeacher(); break;
-                case 5: deactivateTeacher(); break;
-                case 6: reactivateTeacher(); break;
-                case 7: assignTeacherToCourse(); break;
-                case 8: unassignTeacherFromCourse(); break;
-                case 9: generateTeacherReport(); break;
-                case 0: break;
-                default: 
-                    std::cout << "❌ Invalid choice. Please try again.\n";
-                    SafeInput::waitForEnter();
-            }
-        } while (choice != 0);
+// Outcome of a coroutine operation: whether it succeeded and a description
+// (or, for reports, the report itself)
+struct OperationResult {
+    bool ok = false;
+    std::string message;
+};
+    
+// ID -> position lookup over an append-only record collection. Records
+// added since the last lookup are indexed on demand, so adds and imports
+// need no bookkeeping; reset() after replacing the collection.
+struct IdIndex {
+    std::unordered_map<int, size_t> positions;
+    size_t indexed = 0;
+    
+    void reset() {
+        positions.clear();
+        indexed = 0;
     }
     
-    void addTeacher() {
-        clearScreen();
-        std::cout << "➕ ADD NEW TEACHER\n";
-        std::cout << "==================\n\n";
-        
-        int id = teachers.empty() ? 1 : 
-                 std::max_element(teachers.begin(), teachers.end(),
-                     [](const Teacher& a, const Teacher& b) { return a.getId() < b.getId(); })->getId() + 1;
-        
-        std::string name = SafeInput::getString("Enter teacher name: ");
-        std::string email = SafeInput::getString("Enter email address: ");
-        std::string phone = SafeInput::getString("Enter phone number: ");
-        std::string department = SafeInput::getString("Enter department: ");
-        std::string specialization = SafeInput::getString("Enter specialization: ");
-        
-        Teacher newTeacher(id, name, email, phone, department, specialization);
-        teachers.push_back(newTeacher);
-        newTeacher.saveToFile(TEACHERS_FILE);
-        
-        std::cout << "✅ Teacher added successfully! ID: " << id << "\n";
-        SafeInput::waitForEnter();
+    // Indexes records appended since the last call. Once synced, find()
+    // only reads, so concurrent lookups are safe until the next add.
+    template <typename Record>
+    void sync(const std::vector<Record>& records) {
+        if (records.size() < indexed) reset();
+        for (; indexed < records.size(); ++indexed) positions.emplace(records[indexed].getId(), indexed);
     }
     
-    void viewAllTeachers() {
-        clearScreen();
-        std::cout << "📋 ALL TEACHERS\n";
-        std::cout << "===============\n\n";
-        
-        if (teachers.empty()) {
-            std::cout << "No teachers found.\n";
-            SafeInput::waitForEnter();
-            return;
+    template <typename Record>
+    Record* find(std::vector<Record>& records, int id) {
+        sync(records);
+        auto it = positions.find(id);
+        return it != positions.end() ? &records[it->second] : nullptr;
+    }
+};
+
+// The counts behind the summary report, for one set of collections or
+// summed over shards
+struct ModelTotals {
+    size_t students = 0;
+    size_t activeStudents = 0;
+    size_t teachers = 0;
+    size_t activeTeachers = 0;
+    size_t courses = 0;
+    size_t classrooms = 0;
+    int enrollments = 0;
+    double revenue = 0.0;
+    
+    // With courseLocks, each fee is read under its course's stripe, since
+    // daemon edits change it holding only that
+    static ModelTotals of(const std::vector<Student>& students, const std::vector<Teacher>& teachers,
+                          const std::vector<Course>& courses, const std::vector<Classroom>& classrooms,
+                          LockStripes* courseLocks = nullptr) {
+        ModelTotals totals;
+        totals.students = students.size();
+        totals.activeStudents = std::count_if(students.begin(), students.end(), [](const Student& s) { return s.getIsActive(); });
+        totals.teachers = teachers.size();
+        totals.activeTeachers = std::count_if(teachers.begin(), teachers.end(), [](const Teacher& t) { return t.getIsActive(); });
+        totals.courses = courses.size();
+        totals.classrooms = classrooms.size();
+        for (const auto& course : courses) {
+            std::unique_lock<std::mutex> stripe;
+            if (courseLocks) stripe = std::unique_lock<std::mutex>(courseLocks->forId(course.getId()));
+            totals.enrollments += course.getCurrentEnrollment();
+            totals.revenue += course.getCurrentEnrollment() * course.getFee();
         }
-        
-        std::cout << std::setw(5) << "ID" << " | " << std::setw(25) << "Name" << " | " 
+        return totals;
+    }
+    
+    void add(const ModelTotals& other) {
+        students += other.students;
+        activeStudents += other.activeStudents;
+        teachers += other.teachers;
+        activeTeachers += other.activeTeachers;
+        courses += other.courses;
+        classrooms += other.classrooms;
+        enrollments += other.enrollments;
+        revenue += other.revenue;
+    }
+    
+    std::string describe() const {
+        std::ostringstream report;
+        report << "students=" << students << " active_students=" << activeStudents
+               << " teachers=" << teachers << " active_teachers=" << activeTeachers
+               << " courses=" << courses << " classrooms=" << classrooms
+               << " enrollments=" << enrollments << " revenue=" << std::fixed << std::setprecision(2) << revenue;
+        return report.str();
+    }
+};
+    
+// One partition of the records in sharded daemon mode, touched only by its
+// shard's thread. pendingEnrollments holds (student, course) pairs for this
+// shard's students whose enrollment is still on its way between shards.
+struct CampusShard {
+    std::vector<Student> students;
+    std::vector<Teacher> teachers;
+    std::vector<Course> courses;
+    std::vector<Classroom> classrooms;
+    IdIndex studentIndex;
+    IdIndex teacherIndex;
+    IdIndex courseIndex;
+    std::vector<size_t> studentPositions; // each student's place in file order
+    std::set<std::pair<int, int>> pendingEnrollments;
+    
+    Student* findStudent(int id) { return studentIndex.find(students, id); }
+    Teacher* findTeacher(int id) { return teacherIndex.find(teachers, id); }
+    Course* findCourse(int id) { return courseIndex.find(courses, id); }
+};
+    
+// One all-or-nothing enrollment travelling between shards. The student's
+// shard checks the student and decides; each course's shard prepares (checks
+// the course and reserves a seat) and then commits. Every step writes only
+// its own course's slots, and the countdown that hands over to the next step
+// orders those writes before it.
+struct ShardedEnrollment {
+    EnrollmentRequest request;
+    EnrollmentResult result;
+    bool studentFound = false;
+    bool studentActive = false;
+    std::vector<char> claimed;          // pair added to pendingEnrollments
+    std::vector<SeatReservation> seats; // held from prepare to commit
+    std::vector<int> enrolled;          // course enrollment seen by the last step
+    std::vector<int> capacity;
+    std::atomic<size_t> waiting{0};     // course steps still to answer
+    std::promise<void> done;
+};
+    
+// Main School Management System class
+class IndustrialSchoolManagementSystem {
+    friend class BatchModeTests;
+    friend class EnrollmentTests;
+    friend class ShardedDaemonTests;
+    friend class EditTests;
+    
+private:
+    std::vector<Student> students;
+    std::vector<Teacher> teachers;
+    std::vector<Course> courses;
+    std::vector<Classroom> classrooms;
+    
+    const std::string STUDENTS_FILE = "industrial_students.txt";
+    const std::string TEACHERS_FILE = "industrial_teachers.txt";
+    const std::string COURSES_FILE = "industrial_courses.txt";
+    const std::string CLASSROOMS_FILE = "industrial_classrooms.txt";
+    const std::string BACKUP_DIR = "backups/";
+    const std::string EXPORT_DIR = "exports/";
+    
+    // Background export: the worker owns its snapshot and publishes the
+    // result for the status line when it finishes
+    std::thread exportThread;
+    std::atomic<bool> exportRunning{false};
+    std::mutex exportMutex;
+    std::unique_ptr<ExportStats> lastExport;
+    
+    IdIndex studentIndex;
+    IdIndex teacherIndex;
+    IdIndex courseIndex;
+    IdIndex classroomIndex;
+    bool saveOnExit = true;
+    bool batchDryRun = false; // save commands in runBatch() are skipped
+    
+    // Daemon mode: requests share the model lock; enrollments claim seats
+    // lock-free and lock only the student and course rosters they change
+    // (stripes), edits commit under the edited record's stripe, and readers
+    // of a roster or an editable field take its stripe. A student or teacher
+    // stripe is taken before a course stripe, never after.
+    std::shared_mutex modelMutex;
+    LockStripes studentLocks;
+    LockStripes teacherLocks;
+    LockStripes courseLocks;
+    
+    // Field and status edits commit optimistically against record versions
+    // (see commitFieldEdit()); these count how that goes
+    EditMetrics editMetrics;
+    
+    // Copy-on-write snapshots for reports and exports: modelVersion counts
+    // changes to the records, and a new snapshot is copied only when it has
+    // moved since the last one
+    std::atomic<uint64_t> modelVersion{0};
+    Versioned<ModelSnapshot> snapshots;
+    
+    // Runs the coroutine operations (findStudentAsync() and the rest).
+    // Declared before persistence, so it outlives the write callbacks that
+    // resume them.
+    TaskExecutor tasks{2};
+    
+    // Data files, backups and the per-record appends are written off the
+    // calling thread; saving returns once the writes are queued
+    AsyncFileWriter persistence;
+    
+    // Sharded daemon mode (shard_count > 1 in config.txt): while serving,
+    // the records live in the shards and the vectors above are empty. The
+    // layouts keep each record's (shard, slot), to put the records back in
+    // file order when the shards stop.
+    std::unique_ptr<ShardedStore<CampusShard>> shardStore;
+    std::vector<std::pair<size_t, size_t>> studentLayout, teacherLayout, courseLayout, classroomLayout;
+    
+public:
+    // Headless runs (batch mode) pass interactive = false to skip the banner
+    explicit IndustrialSchoolManagementSystem(bool interactive = true) {
+        loadAllData();
+        if (interactive) {
+            std::cout << "🎓 Industrial School Management System v3.0 Initialized\n";
+            std::cout << "======================================================\n";
+            displaySystemStatus();
+        }
+    }
+    
+    ~IndustrialSchoolManagementSystem() {
+        waitForExport();
+        stopShards();
+        if (saveOnExit) {
+            std::vector<std::future<IoResult>> writes = saveAllData();
+            std::vector<std::future<IoResult>> copies;
+            bool backup = Config::getInstance()->backupEnabled();
+            if (backup) copies = createBackup();
+            waitForWrites(writes, "All data saved");
+            if (backup) waitForWrites(copies, "Backup written");
+        }
+    }
+    
+    // Dry runs leave the data files and backups untouched
+    void setSaveOnExit(bool save) { saveOnExit = save; }
+    
+    void run() {
+        int choice;
+        do {
+            showMainMenu();
+            choice = SafeInput::getInt("Enter your choice (0-9): ", 0, 9);
+            
+            try {
+                processChoice(choice);
+            } catch (const std::exception& e) {
+                std::cerr << "❌ Error: " << e.what() << "\n";
+                SafeInput::waitForEnter("Press Enter to continue...");
+            }
+        } while (choice != 0);
+        
+        std::cout << "\n👋 Thank you for using Industrial School Management System!\n";
+        std::cout << "All data has been saved automatically.\n";
+    }
+    
+    // Headless driver: runs a command file (one CSV record per command, '#'
+    // starts a comment line) against the in-memory model without menus or
+    // prompts. Writes one JSON Lines result per command, then per-command
+    // timing totals and a summary record. Returns false if the file can't be
+    // read; failed counts the commands that were rejected. With dryRun, save
+    // commands succeed without writing anything.
+    bool runBatch(const std::string& commandFile, OutputBuffer& out, size_t& failed, bool dryRun = false) {
+        typedef std::chrono::steady_clock Clock;
+        failed = 0;
+        batchDryRun = dryRun;
+        std::string contents;
+        if (!CsvReader::readFile(commandFile, contents)) return false;
+    
+        size_t commandCount = 0;
+        const BatchCommand* table = batchCommands(commandCount);
+        std::vector<std::string> labels;
+        for (size_t i = 0; i < commandCount; ++i) {
+            labels.push_back(table[i].target ? std::string(table[i].name) + " " + table[i].target : table[i].name);
+        }
+        std::vector<BatchTotals> totals(commandCount + 1); // last slot: unknown commands
+    
+        RecordWriter results(out, RecordWriter::JsonLines, {"type", "line", "command", "ok", "micros", "message"});
+        std::vector<std::string> fields;
+        std::string message;
+        size_t pos = 0, line = 1, commands = 0;
+        auto batchStart = Clock::now();
+        while (pos < contents.size()) {
+            size_t recordStart = pos, recordLine = line;
+            pos = CsvReader::parseRecord(contents.data(), contents.size(), pos, fields);
+            line += std::count(contents.begin() + recordStart, contents.begin() + pos, '\n');
+            for (auto& field : fields) InputValidator::sanitizeInPlace(field);
+            if (CsvReader::isBlankRecord(fields) || fields[0][0] == '#') continue;
+    
+            auto commandStart = Clock::now();
+            const BatchCommand* command = findBatchCommand(table, commandCount, fields);
+            bool ok = false;
+            if (!command) {
+                message = "unknown command";
+            } else {
+                size_t first = command->target ? 2 : 1;
+                size_t argCount = fields.size() - first;
+                if (argCount < command->minArgs || argCount > command->maxArgs) {
+                    message = std::string("usage: ") + command->usage;
+                } else {
+                    ok = (this->*command->handler)(fields.data() + first, argCount, message);
+                }
+            }
+            double micros = std::chrono::duration<double, std::micro>(Clock::now() - commandStart).count();
+    
+            size_t slot = command ? command - table : commandCount;
+            totals[slot].count++;
+            totals[slot].micros += micros;
+            if (!ok) {
+                totals[slot].failed++;
+                failed++;
+            }
+            commands++;
+            results.field("result", 6).field(recordLine).field(command ? labels[slot] : fields[0])
+                   .field(ok).field(std::round(micros * 1000.0) / 1000.0).field(message);
+            results.endRecord();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - batchStart).count();
+    
+        RecordWriter totalsWriter(out, RecordWriter::JsonLines, {"type", "command", "count", "failed", "total_micros", "mean_micros"});
+        for (size_t slot = 0; slot <= commandCount; ++slot) {
+            const BatchTotals& total = totals[slot];
+            if (total.count == 0) continue;
+            totalsWriter.field("totals", 6).field(slot < commandCount ? labels[slot] : std::string("unknown"))
+                        .field(total.count).field(total.failed).field(std::round(total.micros * 1000.0) / 1000.0)
+                        .field(std::round(total.micros / total.count * 1000.0) / 1000.0);
+            totalsWriter.endRecord();
+        }
+    
+        RecordWriter summary(out, RecordWriter::JsonLines, {"type", "commands", "succeeded", "failed", "seconds", "commands_per_second"});
+        summary.field("summary", 7).field(commands).field(commands - failed).field(failed).field(seconds)
+               .field(seconds > 0.0 ? std::round(commands / seconds) : 0.0);
+        summary.endRecord();
+        return true;
+    }
+    
+    // Daemon mode (--serve): answers one SchoolProtocol request payload.
+    // Runs on several server workers at once; call syncIndexes() (or
+    // startShards()) before serving so lookups under the shared lock never
+    // write. Nothing the daemon does adds or removes records, so every
+    // request shares the model.
+    void handleRequest(const char* request, size_t size, std::string& response) {
+        thread_local OutputBuffer body(4096);
+        body.clear();
+        FrameReader reader(request, size);
+        uint32_t requestId = reader.u32();
+        uint8_t op = reader.u8();
+        size_t start = response.size();
+        try {
+            SchoolProtocol::Status status = !reader.ok() ? SchoolProtocol::BadRequest
+                                          : shardStore ? answerShardedRequest(op, reader, body)
+                                          : answerRequest(op, reader, body);
+            SchoolProtocol::response(response, requestId, status, body.data(), body.size());
+        } catch (const std::bad_alloc&) {
+            // A huge report or batch shouldn't take the daemon down with it
+            static const char message[] = "out of memory";
+            response.resize(start);
+            body.clear();
+            SchoolProtocol::response(response, requestId, SchoolProtocol::Rejected, message, sizeof(message) - 1);
+        }
+    }
+    
+    void syncIndexes() {
+        studentIndex.sync(students);
+        teacherIndex.sync(teachers);
+        courseIndex.sync(courses);
+        classroomIndex.sync(classrooms);
+    }
+    
+    // Moves the records into count shards by ID hash and starts their
+    // threads; from here on handleRequest() answers through the shards
+    void startShards(size_t count) {
+        stopShards();
+        shardStore.reset(new ShardedStore<CampusShard>(count));
+        scatterRecords(students, &CampusShard::students, studentLayout);
+        scatterRecords(teachers, &CampusShard::teachers, teacherLayout);
+        scatterRecords(courses, &CampusShard::courses, courseLayout);
+        scatterRecords(classrooms, &CampusShard::classrooms, classroomLayout);
+        for (size_t i = 0; i < shardStore->size(); ++i) {
+            CampusShard& shard = shardStore->state(i);
+            shard.studentIndex.sync(shard.students);
+            shard.teacherIndex.sync(shard.teachers);
+            shard.courseIndex.sync(shard.courses);
+            shard.studentPositions.resize(shard.students.size());
+        }
+        for (size_t position = 0; position < studentLayout.size(); ++position) {
+            const auto& place = studentLayout[position];
+            shardStore->state(place.first).studentPositions[place.second] = position;
+        }
+        shardStore->start();
+    }
+    
+    // Stops the shard threads and gathers the records back in file order.
+    // Call once no request is being served.
+    void stopShards() {
+        if (!shardStore) return;
+        shardStore->stop();
+        gatherRecords(students, &CampusShard::students, studentLayout);
+        gatherRecords(teachers, &CampusShard::teachers, teacherLayout);
+        gatherRecords(courses, &CampusShard::courses, courseLayout);
+        gatherRecords(classrooms, &CampusShard::classrooms, classroomLayout);
+        shardStore.reset();
+        studentIndex.reset();
+        teacherIndex.reset();
+        courseIndex.reset();
+        classroomIndex.reset();
+        syncIndexes();
+        touchModel();
+    }
+    
+    size_t getShardCount() const { return shardStore ? shardStore->size() : 1; }
+    
+    // Coroutine versions of the core operations. Each hops onto the task
+    // executor and shares the model the way daemon requests do, so many can
+    // run at once; save and report files are written through persistence
+    // without holding a thread while the I/O is in flight. Parameters are
+    // taken by value, since the caller may be gone by the time they run.
+    // Locks are never held across a co_await: the coroutine may resume on
+    // another thread. Menu code uses them through syncWait(tasks, ...).
+    // Not while sharded: the records are in the shards then.
+    Task<std::optional<Student>> findStudentAsync(int id) {
+        co_await tasks.schedule();
+        ensureIndexed();
+        std::shared_lock<std::shared_mutex> lock(modelMutex);
+        Student* student = findStudentById(id);
+        if (!student) co_return std::nullopt;
+        std::lock_guard<std::mutex> roster(studentLocks.forId(id));
+        co_return *student;
+    }
+    
+    Task<std::vector<Student>> searchStudentsAsync(std::string name, size_t limit = SIZE_MAX) {
+        co_await tasks.schedule();
+        std::vector<Student> matches;
+        ensureIndexed();
+        std::shared_lock<std::shared_mutex> lock(modelMutex);
+        for (const Student* student : searchStudentsByName(name, limit, &studentLocks)) {
+            std::lock_guard<std::mutex> roster(studentLocks.forId(student->getId()));
+            matches.push_back(*student);
+        }
+        co_return matches;
+    }
+    
+    Task<OperationResult> enrollAsync(int studentId, int courseId) {
+        co_await tasks.schedule();
+        OperationResult result;
+        ensureIndexed();
+        result.ok = enrollById(studentId, courseId, result.message) == SchoolProtocol::Ok;
+        co_return result;
+    }
+    
+    // Writes every data file from one snapshot; done once all are durable
+    Task<OperationResult> saveAsync() {
+        co_await tasks.schedule();
+        std::shared_ptr<const ModelSnapshot> view = modelSnapshot();
+        std::pair<std::string, std::string> files[] = {
+            {STUDENTS_FILE, serializeRecords(view->students)},
+            {TEACHERS_FILE, serializeRecords(view->teachers)},
+            {COURSES_FILE, serializeRecords(view->courses)},
+            {CLASSROOMS_FILE, serializeRecords(view->classrooms)}
+        };
+        OperationResult result;
+        result.ok = true;
+        for (auto& file : files) {
+            IoResult written = co_await completion<IoResult>(tasks, [this, &file](AsyncFileWriter::Callback done) {
+                persistence.replace(file.first, std::move(file.second), std::move(done));
+            });
+            if (!written.ok) {
+                result.ok = false;
+                result.message = "cannot write " + file.first + ": " + std::strerror(written.error);
+                co_return result;
+            }
+        }
+        result.message = "saved " + std::to_string(view->students.size() + view->teachers.size() +
+                                                   view->courses.size() + view->classrooms.size()) + " records";
+        co_return result;
+    }
+    
+    // kind is a SchoolProtocol::ReportKind; with a path, the report is also
+    // written there before the operation completes
+    Task<OperationResult> reportAsync(uint8_t kind, int id, std::string path = "") {
+        co_await tasks.schedule();
+        OperationResult result;
+        ensureIndexed();
+        result.ok = sharedReport(kind, id, result.message);
+        if (result.ok && !path.empty()) {
+            std::string contents = result.message + "\n";
+            IoResult written = co_await completion<IoResult>(tasks, [this, &path, &contents](AsyncFileWriter::Callback done) {
+                persistence.replace(path, std::move(contents), std::move(done));
+            });
+            if (!written.ok) {
+                result.ok = false;
+                result.message = "cannot write " + path + ": " + std::strerror(written.error);
+            }
+        }
+        co_return result;
+    }
+    
+private:
+    SchoolProtocol::Status answerRequest(uint8_t op, FrameReader& reader, OutputBuffer& body) {
+        switch (op) {
+            case SchoolProtocol::Ping:
+                body.append("pong", 4);
+                return SchoolProtocol::Ok;
+            case SchoolProtocol::LookupStudent:
+            case SchoolProtocol::LookupTeacher:
+            case SchoolProtocol::LookupCourse: {
+                int id = static_cast<int>(reader.u32());
+                if (!reader.ok()) return SchoolProtocol::BadRequest;
+                std::shared_lock<std::shared_mutex> lock(modelMutex);
+                if (writeRecord(op, id, body)) return SchoolProtocol::Ok;
+                writeNotFound(op, id, body);
+                return SchoolProtocol::NotFound;
+            }
+            case SchoolProtocol::SearchStudents: {
+                std::string fragment = reader.str();
+                size_t limit = reader.u16();
+                if (!reader.ok()) return SchoolProtocol::BadRequest;
+                std::shared_lock<std::shared_mutex> lock(modelMutex);
+                body.append('[');
+                for (const Student* student : searchStudentsByName(fragment, limit, &studentLocks)) {
+                    std::lock_guard<std::mutex> stripe(studentLocks.forId(student->getId()));
+                    writeSearchMatch(student->getId(), student->getName(), student->getIsActive(), body);
+                }
+                body.append(']');
+                return SchoolProtocol::Ok;
+            }
+            case SchoolProtocol::Enroll: {
+                int studentId = static_cast<int>(reader.u32());
+                int courseId = static_cast<int>(reader.u32());
+                if (!reader.ok()) return SchoolProtocol::BadRequest;
+                std::string message;
+                SchoolProtocol::Status status = enrollById(studentId, courseId, message);
+                body.append(message);
+                return status;
+            }
+            case SchoolProtocol::Report: {
+                uint8_t kind = reader.u8();
+                int id = static_cast<int>(reader.u32());
+                if (!reader.ok() || kind > SchoolProtocol::CourseReport) return SchoolProtocol::BadRequest;
+                std::string message;
+                bool ok = sharedReport(kind, id, message);
+                body.append(message);
+                return ok ? SchoolProtocol::Ok : SchoolProtocol::NotFound;
+            }
+            case SchoolProtocol::EnrollMany: {
+                std::vector<EnrollmentRequest> picks(reader.u16());
+                for (auto& pick : picks) {
+                    pick.studentId = static_cast<int>(reader.u32());
+                    pick.courseIds.resize(reader.u8());
+                    for (int& courseId : pick.courseIds) courseId = static_cast<int>(reader.u32());
+                    if (!reader.ok()) return SchoolProtocol::BadRequest;
+                }
+                std::vector<EnrollmentResult> results;
+                size_t committed;
+                {
+                    // One thread: the server already runs requests in parallel
+                    std::shared_lock<std::shared_mutex> lock(modelMutex);
+                    committed = enrollStudentsInCourses(picks, results, 1);
+                }
+                for (const auto& result : results) {
+                    body.append(result.message);
+                    body.append('\n');
+                }
+                return committed == picks.size() ? SchoolProtocol::Ok : SchoolProtocol::Rejected;
+            }
+            case SchoolProtocol::Edit: {
+                uint8_t record = reader.u8();
+                int id = static_cast<int>(reader.u32());
+                uint64_t readVersion = reader.u64();
+                std::string field = reader.str();
+                std::string value = reader.str();
+                if (!reader.ok() || record < SchoolProtocol::LookupStudent || record > SchoolProtocol::LookupCourse) {
+                    return SchoolProtocol::BadRequest;
+                }
+                std::string message;
+                SchoolProtocol::Status status = editById(record, id, readVersion, field, value, message);
+                if (status == SchoolProtocol::NotFound) writeNotFound(record, id, body);
+                body.append(message);
+                return status;
+            }
+            default:
+                body.append("unknown op");
+                return SchoolProtocol::BadRequest;
+        }
+    }
+    
+    // One JSON object, same fields as the JSON Lines export
+    bool writeRecord(uint8_t op, int id, OutputBuffer& body) {
+        if (op == SchoolProtocol::LookupStudent) {
+            Student* student = findStudentById(id);
+            if (!student) return false;
+            std::lock_guard<std::mutex> roster(studentLocks.forId(id));
+            writeJson(*student, body);
+        } else if (op == SchoolProtocol::LookupTeacher) {
+            Teacher* teacher = findTeacherById(id);
+            if (!teacher) return false;
+            std::lock_guard<std::mutex> stripe(teacherLocks.forId(id));
+            writeJson(*teacher, body);
+        } else {
+            Course* course = findCourseById(id);
+            if (!course) return false;
+            std::lock_guard<std::mutex> stripe(courseLocks.forId(id));
+            writeJson(*course, body);
+        }
+        return true;
+    }
+    
+    static void writeJson(const Student& student, OutputBuffer& body) {
+        RecordWriter writer = DataExporter::studentWriter(body, RecordWriter::JsonLines);
+        DataExporter::writeStudent(writer, student);
+    }
+    
+    static void writeJson(const Teacher& teacher, OutputBuffer& body) {
+        RecordWriter writer = DataExporter::teacherWriter(body, RecordWriter::JsonLines);
+        DataExporter::writeTeacher(writer, teacher);
+    }
+    
+    static void writeJson(const Course& course, OutputBuffer& body) {
+        RecordWriter writer = DataExporter::courseWriter(body, RecordWriter::JsonLines);
+        DataExporter::writeCourse(writer, course);
+    }
+    
+    static void writeNotFound(uint8_t op, int id, OutputBuffer& body) {
+        body.append(op == SchoolProtocol::LookupStudent ? "student " : op == SchoolProtocol::LookupTeacher ? "teacher " : "course ");
+        body.appendNumber(id);
+        body.append(" not found");
+    }
+    
+    static void writeSearchMatch(int id, const std::string& name, bool active, OutputBuffer& body) {
+        if (body.size() > 1) body.append(',');
+        body.append("{\"id\":", 6);
+        body.appendNumber(id);
+        body.append(",\"name\":", 8);
+        body.appendJsonString(name.data(), name.size());
+        body.append(active ? ",\"active\":true}" : ",\"active\":false}");
+    }
+    
+    // Enrollment by ID under the shared model lock, for daemon workers and
+    // coroutine operations running in parallel
+    SchoolProtocol::Status enrollById(int studentId, int courseId, std::string& message) {
+        std::shared_lock<std::shared_mutex> lock(modelMutex);
+        Student* student = findStudentById(studentId);
+        Course* course = findCourseById(courseId);
+        if (!student || !course) {
+            message = !student ? "student " + std::to_string(studentId) + " not found"
+                               : "course " + std::to_string(courseId) + " not found";
+            return SchoolProtocol::NotFound;
+        }
+        return enrollStudent(*student, *course, message) ? SchoolProtocol::Ok : SchoolProtocol::Rejected;
+    }
+    
+    // The record is looked up under the shared lock, and the edit takes it
+    // again around its commit. Nothing removes records while the daemon
+    // serves, so the pointer stays good.
+    SchoolProtocol::Status editById(uint8_t record, int id, uint64_t readVersion, const std::string& field,
+                                    const std::string& value, std::string& message) {
+        EditOutcome outcome;
+        uint64_t version;
+        if (record == SchoolProtocol::LookupStudent) {
+            Student* student = findShared(&IndustrialSchoolManagementSystem::findStudentById, id);
+            if (!student) return SchoolProtocol::NotFound;
+            outcome = editStudentField(*student, fieldNamed<StudentCsvFormat>(field), value, readVersion, message);
+            version = student->getVersion();
+        } else if (record == SchoolProtocol::LookupTeacher) {
+            Teacher* teacher = findShared(&IndustrialSchoolManagementSystem::findTeacherById, id);
+            if (!teacher) return SchoolProtocol::NotFound;
+            outcome = editTeacherField(*teacher, fieldNamed<TeacherCsvFormat>(field), value, readVersion, message);
+            version = teacher->getVersion();
+        } else {
+            Course* course = findShared(&IndustrialSchoolManagementSystem::findCourseById, id);
+            if (!course) return SchoolProtocol::NotFound;
+            outcome = editCourseField(*course, fieldNamed<CourseCsvFormat>(field), value, readVersion, message);
+            version = course->getVersion();
+        }
+        return editStatus(outcome, version, message);
+    }
+    
+    template <typename Record>
+    Record* findShared(Record* (IndustrialSchoolManagementSystem::*find)(int), int id) {
+        std::shared_lock<std::shared_mutex> lock(modelMutex);
+        return (this->*find)(id);
+    }
+    
+    static SchoolProtocol::Status editStatus(EditOutcome outcome, uint64_t version, std::string& message) {
+        if (outcome != EditOutcome::Committed) return SchoolProtocol::Rejected;
+        message += " (version " + std::to_string(version) + ")";
+        return SchoolProtocol::Ok;
+    }
+    
+    // One of the batch reports, safe alongside parallel enrollments
+    bool sharedReport(uint8_t kind, int id, std::string& message) {
+        static const BatchHandler reports[] = {
+            &IndustrialSchoolManagementSystem::batchReportSummary,
+            &IndustrialSchoolManagementSystem::batchReportStudent,
+            &IndustrialSchoolManagementSystem::batchReportTeacher,
+            &IndustrialSchoolManagementSystem::batchReportCourse
+        };
+        std::string arg = std::to_string(id);
+        if (kind == SchoolProtocol::SummaryReport) {
+            return batchReportSummary(&arg, 1, message); // Takes the shared lock itself
+        }
+        std::shared_lock<std::shared_mutex> lock(modelMutex);
+        if (kind == SchoolProtocol::StudentReport) {
+            std::lock_guard<std::mutex> roster(studentLocks.forId(id));
+            return (this->*reports[kind])(&arg, 1, message);
+        }
+        if (kind == SchoolProtocol::TeacherReport) {
+            std::lock_guard<std::mutex> stripe(teacherLocks.forId(id));
+            return (this->*reports[kind])(&arg, 1, message);
+        }
+        return (this->*reports[kind])(&arg, 1, message);
+    }
+    
+    // Unlike daemon requests, coroutine operations can follow an add: the
+    // first one after it brings the indexes up to date under the exclusive
+    // lock, so lookups under the shared lock stay read-only
+    void ensureIndexed() {
+        {
+            std::shared_lock<std::shared_mutex> lock(modelMutex);
+            if (studentIndex.indexed == students.size() && teacherIndex.indexed == teachers.size() &&
+                courseIndex.indexed == courses.size() && classroomIndex.indexed == classrooms.size()) {
+                return;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(modelMutex);
+        syncIndexes();
+    }
+    
+    // Sharded daemon mode: the same requests, answered by messages to the
+    // shards that own the records. Searches and the summary scatter to every
+    // shard and merge the answers; search results keep file order, as unsharded.
+    SchoolProtocol::Status answerShardedRequest(uint8_t op, FrameReader& reader, OutputBuffer& body) {
+        ShardedStore<CampusShard>& store = *shardStore;
+        switch (op) {
+            case SchoolProtocol::LookupStudent:
+            case SchoolProtocol::LookupTeacher:
+            case SchoolProtocol::LookupCourse: {
+                int id = static_cast<int>(reader.u32());
+                if (!reader.ok()) return SchoolProtocol::BadRequest;
+                bool found = store.ask(store.shardOf(id), [op, id, &body](CampusShard& shard) {
+                    if (op == SchoolProtocol::LookupStudent) {
+                        Student* student = shard.findStudent(id);
+                        if (student) writeJson(*student, body);
+                        return student != nullptr;
+                    }
+                    if (op == SchoolProtocol::LookupTeacher) {
+                        Teacher* teacher = shard.findTeacher(id);
+                        if (teacher) writeJson(*teacher, body);
+                        return teacher != nullptr;
+                    }
+                    Course* course = shard.findCourse(id);
+                    if (course) writeJson(*course, body);
+                    return course != nullptr;
+                });
+                if (found) return SchoolProtocol::Ok;
+                writeNotFound(op, id, body);
+                return SchoolProtocol::NotFound;
+            }
+            case SchoolProtocol::SearchStudents: {
+                std::string fragment = reader.str();
+                size_t limit = reader.u16();
+                if (!reader.ok()) return SchoolProtocol::BadRequest;
+                // Each shard's first limit matches in file order hold every
+                // one of the overall first limit that lives there
+                typedef std::tuple<size_t, int, std::string, bool> Match;
+                std::vector<std::vector<Match>> answers = store.askAll([&fragment, limit](CampusShard& shard) {
+                    std::vector<Match> matches;
+                    for (const Student* student : searchStudents(shard.students, fragment, limit)) {
+                        matches.emplace_back(shard.studentPositions[student - shard.students.data()], student->getId(),
+                                             student->getName(), student->getIsActive());
+                    }
+                    return matches;
+                });
+                std::vector<Match> merged;
+                for (auto& answer : answers) merged.insert(merged.end(), answer.begin(), answer.end());
+                std::sort(merged.begin(), merged.end());
+                body.append('[');
+                for (size_t i = 0; i < merged.size() && i < limit; ++i) {
+                    writeSearchMatch(std::get<1>(merged[i]), std::get<2>(merged[i]), std::get<3>(merged[i]), body);
+                }
+                body.append(']');
+                return SchoolProtocol::Ok;
+            }
+            case SchoolProtocol::Enroll: {
+                auto enrollment = std::make_shared<ShardedEnrollment>();
+                enrollment->request.studentId = static_cast<int>(reader.u32());
+                enrollment->request.courseIds.push_back(static_cast<int>(reader.u32()));
+                if (!reader.ok()) return SchoolProtocol::BadRequest;
+                runShardedEnrollment(enrollment);
+                std::string message;
+                SchoolProtocol::Status status = describeSingleEnrollment(*enrollment, message);
+                body.append(message);
+                return status;
+            }
+            case SchoolProtocol::Report: {
+                uint8_t kind = reader.u8();
+                int id = static_cast<int>(reader.u32());
+                if (!reader.ok() || kind > SchoolProtocol::CourseReport) return SchoolProtocol::BadRequest;
+                std::string message;
+                bool ok = answerShardedReport(kind, id, message);
+                body.append(message);
+                return ok ? SchoolProtocol::Ok : SchoolProtocol::NotFound;
+            }
+            case SchoolProtocol::EnrollMany: {
+                std::vector<std::shared_ptr<ShardedEnrollment>> picks(reader.u16());
+                for (auto& pick : picks) {
+                    pick = std::make_shared<ShardedEnrollment>();
+                    pick->request.studentId = static_cast<int>(reader.u32());
+                    pick->request.courseIds.resize(reader.u8());
+                    for (int& courseId : pick->request.courseIds) courseId = static_cast<int>(reader.u32());
+                    if (!reader.ok()) return SchoolProtocol::BadRequest;
+                }
+                size_t committed = 0;
+                for (const auto& pick : picks) {
+                    runShardedEnrollment(pick);
+                    if (pick->result.committed) committed++;
+                    body.append(pick->result.message);
+                    body.append('\n');
+                }
+                return committed == picks.size() ? SchoolProtocol::Ok : SchoolProtocol::Rejected;
+            }
+            case SchoolProtocol::Edit: {
+                uint8_t record = reader.u8();
+                int id = static_cast<int>(reader.u32());
+                uint64_t readVersion = reader.u64();
+                std::string field = reader.str();
+                std::string value = reader.str();
+                if (!reader.ok() || record < SchoolProtocol::LookupStudent || record > SchoolProtocol::LookupCourse) {
+                    return SchoolProtocol::BadRequest;
+                }
+                std::string message;
+                SchoolProtocol::Status status = store.ask(store.shardOf(id), [&](CampusShard& shard) {
+                    return editInShard(shard, record, id, readVersion, field, value, message);
+                });
+                if (status == SchoolProtocol::NotFound) writeNotFound(record, id, body);
+                body.append(message);
+                return status;
+            }
+            default:
+                return answerRequest(op, reader, body);
+        }
+    }
+    
+    // Runs on the record's shard, the only thread that touches it, so the
+    // commit needs no lock. A seat limit change can promote waitlisted
+    // students from other shards, so those are left to the unsharded daemon.
+    SchoolProtocol::Status editInShard(CampusShard& shard, uint8_t record, int id, uint64_t readVersion,
+                                       const std::string& field, const std::string& value, std::string& message) {
+        SingleOwner owner;
+        EditOutcome outcome;
+        uint64_t version;
+        if (record == SchoolProtocol::LookupStudent) {
+            Student* student = shard.findStudent(id);
+            if (!student) return SchoolProtocol::NotFound;
+            outcome = commitFieldEdit<StudentCsvFormat>(*student, "student", fieldNamed<StudentCsvFormat>(field), value,
+                                                        readVersion, applyStudentField, owner, message);
+            version = student->getVersion();
+        } else if (record == SchoolProtocol::LookupTeacher) {
+            Teacher* teacher = shard.findTeacher(id);
+            if (!teacher) return SchoolProtocol::NotFound;
+            outcome = commitFieldEdit<TeacherCsvFormat>(*teacher, "teacher", fieldNamed<TeacherCsvFormat>(field), value,
+                                                        readVersion, applyTeacherField, owner, message);
+            version = teacher->getVersion();
+        } else {
+            Course* course = shard.findCourse(id);
+            if (!course) return SchoolProtocol::NotFound;
+            int column = fieldNamed<CourseCsvFormat>(field);
+            if (column == CourseCsvFormat::MaxStudents) {
+                message = "course seat limits can't change while the records are sharded";
+                return SchoolProtocol::Rejected;
+            }
+            outcome = commitFieldEdit<CourseCsvFormat>(*course, "course", column, value, readVersion, applyCourseField,
+                                                       owner, message);
+            version = course->getVersion();
+        }
+        return editStatus(outcome, version, message);
+    }
+    
+    // The summary sums every shard's totals. A student or teacher report
+    // asks the record's shard for its course IDs, sums those courses on
+    // every shard, then has the record's shard write the report.
+    bool answerShardedReport(uint8_t kind, int id, std::string& message) {
+        ShardedStore<CampusShard>& store = *shardStore;
+        if (kind == SchoolProtocol::SummaryReport) {
+            ModelTotals totals;
+            for (const ModelTotals& part : store.askAll([](CampusShard& shard) {
+                     return ModelTotals::of(shard.students, shard.teachers, shard.courses, shard.classrooms);
+                 })) {
+                totals.add(part);
+            }
+            message = totals.describe();
+            return true;
+        }
+        size_t home = store.shardOf(id);
+        if (kind == SchoolProtocol::CourseReport) {
+            return store.ask(home, [id, &message](CampusShard& shard) {
+                Course* course = shard.findCourse(id);
+                message = course ? courseReport(*course) : "course " + std::to_string(id) + " not found";
+                return course != nullptr;
+            });
+        }
+        
+        bool isStudent = kind == SchoolProtocol::StudentReport;
+        std::vector<int> courseIds;
+        bool found = store.ask(home, [id, isStudent, &courseIds](CampusShard& shard) {
+            if (isStudent) {
+                Student* student = shard.findStudent(id);
+                if (student) courseIds = student->getEnrolledCourses();
+                return student != nullptr;
+            }
+            Teacher* teacher = shard.findTeacher(id);
+            if (teacher) courseIds = teacher->getAssignedCourses();
+            return teacher != nullptr;
+        });
+        if (!found) {
+            message = (isStudent ? "student " : "teacher ") + std::to_string(id) + " not found";
+            return false;
+        }
+        CourseSums sums;
+        for (const CourseSums& part : store.askAll([&courseIds](CampusShard& shard) {
+                 return CourseSums::of(courseIds, [&shard](int courseId) { return shard.findCourse(courseId); });
+             })) {
+            sums.add(part);
+        }
+        store.ask(home, [id, isStudent, &sums, &message](CampusShard& shard) {
+            message = isStudent ? studentReport(*shard.findStudent(id), sums) : teacherReport(*shard.findTeacher(id), sums);
+        });
+        return true;
+    }
+    
+    // Sends one enrollment on its way (step 1 on the student's shard) and
+    // waits for the last step to finish it
+    void runShardedEnrollment(const std::shared_ptr<ShardedEnrollment>& enrollment) {
+        size_t count = enrollment->request.courseIds.size();
+        enrollment->result.outcomes.assign(count, EnrollmentOutcome::RolledBack);
+        enrollment->claimed.assign(count, 0);
+        enrollment->seats.resize(count);
+        enrollment->enrolled.assign(count, 0);
+        enrollment->capacity.assign(count, 0);
+        std::future<void> done = enrollment->done.get_future();
+        shardStore->post(shardStore->shardOf(enrollment->request.studentId),
+                         [this, enrollment](CampusShard& shard) { beginShardedEnrollment(shard, enrollment); });
+        done.wait();
+    }
+    
+    // Step 1, student's shard: the student-side checks of
+    // enrollStudentInCourses; then every course is asked to prepare
+    void beginShardedEnrollment(CampusShard& shard, const std::shared_ptr<ShardedEnrollment>& enrollment) {
+        const std::vector<int>& ids = enrollment->request.courseIds;
+        Student* student = shard.findStudent(enrollment->request.studentId);
+        enrollment->studentFound = student != nullptr;
+        enrollment->studentActive = student && student->getIsActive();
+        if (!enrollment->studentActive || ids.empty()) return finishShardedEnrollment(*enrollment);
+        
+        for (size_t i = 0; i < ids.size(); ++i) {
+            std::pair<int, int> pair(student->getId(), ids[i]);
+            if (std::find(ids.begin(), ids.begin() + i, ids[i]) != ids.begin() + i) {
+                enrollment->result.outcomes[i] = EnrollmentOutcome::Duplicate;
+            } else if (student->isEnrolledIn(ids[i]) || shard.pendingEnrollments.count(pair)) {
+                enrollment->result.outcomes[i] = EnrollmentOutcome::AlreadyEnrolled;
+            } else {
+                shard.pendingEnrollments.insert(pair);
+                enrollment->claimed[i] = 1;
+            }
+        }
+        enrollment->waiting = ids.size();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            shardStore->post(shardStore->shardOf(ids[i]), [this, enrollment, i](CampusShard& courseShard) {
+                prepareShardedEnrollment(courseShard, enrollment, i);
+            });
+        }
+    }
+    
+    // Step 2, course's shard: the course-side checks, in the same order as
+    // enrollStudentInCourses, and a seat reservation. Enrolled here only
+    // means prepared.
+    void prepareShardedEnrollment(CampusShard& shard, const std::shared_ptr<ShardedEnrollment>& enrollment, size_t i) {
+        Course* course = shard.findCourse(enrollment->request.courseIds[i]);
+        EnrollmentOutcome& outcome = enrollment->result.outcomes[i];
+        if (!course) {
+            outcome = EnrollmentOutcome::CourseNotFound;
+        } else if (outcome == EnrollmentOutcome::Duplicate) {
+            // Already decided on the student's shard
+        } else if (!course->getIsActive()) {
+            outcome = EnrollmentOutcome::CourseInactive;
+        } else if (outcome == EnrollmentOutcome::AlreadyEnrolled || course->isStudentEnrolled(enrollment->request.studentId)) {
+            outcome = EnrollmentOutcome::AlreadyEnrolled;
+        } else if (!(enrollment->seats[i] = course->reserveSeat())) {
+            outcome = EnrollmentOutcome::Full;
+        } else {
+            outcome = EnrollmentOutcome::Enrolled;
+        }
+        if (course) {
+            enrollment->enrolled[i] = course->getCurrentEnrollment();
+            enrollment->capacity[i] = course->getMaxStudents();
+        }
+        if (enrollment->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            shardStore->post(shardStore->shardOf(enrollment->request.studentId),
+                             [this, enrollment](CampusShard& home) { decideShardedEnrollment(home, enrollment); });
+        }
+    }
+    
+    // Step 3, student's shard: commit if every course prepared, otherwise
+    // hand the seats back. The seat counters are lock-free, so releasing a
+    // reservation needs no trip to the course's shard.
+    void decideShardedEnrollment(CampusShard& shard, const std::shared_ptr<ShardedEnrollment>& enrollment) {
+        const std::vector<int>& ids = enrollment->request.courseIds;
+        std::vector<EnrollmentOutcome>& outcomes = enrollment->result.outcomes;
+        bool complete = std::all_of(outcomes.begin(), outcomes.end(),
+                                    [](EnrollmentOutcome outcome) { return outcome == EnrollmentOutcome::Enrolled; });
+        Student* student = shard.findStudent(enrollment->request.studentId);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (enrollment->claimed[i]) shard.pendingEnrollments.erase(std::make_pair(student->getId(), ids[i]));
+            if (complete) {
+                student->enrollInCourse(ids[i]);
+            } else if (outcomes[i] == EnrollmentOutcome::Enrolled) {
+                outcomes[i] = EnrollmentOutcome::RolledBack;
+                enrollment->seats[i].rollback();
+            }
+        }
+        if (!complete) return finishShardedEnrollment(*enrollment);
+        
+        enrollment->result.committed = true;
+        enrollment->waiting = ids.size();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            shardStore->post(shardStore->shardOf(ids[i]), [enrollment, i](CampusShard& courseShard) {
+                Course* course = courseShard.findCourse(enrollment->request.courseIds[i]);
+                course->commitSeat(enrollment->seats[i], enrollment->request.studentId);
+                course->getWaitlist().remove(enrollment->request.studentId);
+                enrollment->enrolled[i] = course->getCurrentEnrollment();
+                if (enrollment->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) finishShardedEnrollment(*enrollment);
+            });
+        }
+    }
+    
+    static void finishShardedEnrollment(ShardedEnrollment& enrollment) {
+        const EnrollmentRequest& request = enrollment.request;
+        if (enrollment.studentFound) {
+            describeEnrollment(request.studentId, enrollment.studentActive, request.courseIds.data(),
+                               request.courseIds.size(), enrollment.result);
+        } else {
+            enrollment.result.message = "student=" + std::to_string(request.studentId) + " committed=false student_not_found=true";
+        }
+        enrollment.done.set_value();
+    }
+    
+    // A single-course enrollment, worded like enrollStudent
+    static SchoolProtocol::Status describeSingleEnrollment(const ShardedEnrollment& enrollment, std::string& message) {
+        std::string studentId = std::to_string(enrollment.request.studentId);
+        std::string courseId = std::to_string(enrollment.request.courseIds[0]);
+        std::string pair = "student " + studentId + " in course " + courseId;
+        if (!enrollment.studentFound) {
+            message = "student " + studentId + " not found";
+            return SchoolProtocol::NotFound;
+        }
+        if (!enrollment.studentActive) {
+            message = "student " + studentId + " is inactive";
+            return SchoolProtocol::Rejected;
+        }
+        switch (enrollment.result.outcomes[0]) {
+            case EnrollmentOutcome::Enrolled:
+                message = "enrolled " + pair + " (" + std::to_string(enrollment.enrolled[0]) + "/" +
+                          std::to_string(enrollment.capacity[0]) + ")";
+                return SchoolProtocol::Ok;
+            case EnrollmentOutcome::CourseNotFound:
+                message = "course " + courseId + " not found";
+                return SchoolProtocol::NotFound;
+            case EnrollmentOutcome::CourseInactive:
+                message = "course " + courseId + " is inactive";
+                break;
+            case EnrollmentOutcome::Full:
+                message = "course " + courseId + " is full (" + std::to_string(enrollment.capacity[0]) + " seats)";
+                break;
+            default:
+                message = pair + " is already enrolled";
+                break;
+        }
+        return SchoolProtocol::Rejected;
+    }
+    
+    template <typename Record>
+    void scatterRecords(std::vector<Record>& records, std::vector<Record> CampusShard::*collection,
+                        std::vector<std::pair<size_t, size_t>>& layout) {
+        layout.clear();
+        for (auto& record : records) {
+            size_t shard = shardStore->shardOf(record.getId());
+            std::vector<Record>& owned = shardStore->state(shard).*collection;
+            layout.emplace_back(shard, owned.size());
+            owned.push_back(std::move(record));
+        }
+        records.clear();
+    }
+    
+    template <typename Record>
+    void gatherRecords(std::vector<Record>& records, std::vector<Record> CampusShard::*collection,
+                       const std::vector<std::pair<size_t, size_t>>& layout) {
+        records.clear();
+        records.reserve(layout.size());
+        for (const auto& place : layout) {
+            records.push_back(std::move((shardStore->state(place.first).*collection)[place.second]));
+        }
+    }
+    
+    void showMainMenu() {
+        clearScreen();
+        std::cout << "🎓 INDUSTRIAL SCHOOL MANAGEMENT SYSTEM v3.0\n";
+        std::cout << "============================================\n\n";
+        
+        displaySystemStatus();
+        
+        std::cout << "\n📋 MAIN MENU:\n";
+        std::cout << "==============\n";
+        std::cout << "1. 👨‍🎓 Student Management\n";
+        std::cout << "2. 👩‍🏫 Teacher Management\n";
+        std::cout << "3. 📚 Course Management\n";
+        std::cout << "4. 🏫 Classroom Management\n";
+        std::cout << "5. 📊 Reports & Analytics\n";
+        std::cout << "6. 🔄 Data Management\n";
+        std::cout << "7. 🎯 Quick Actions\n";
+        std::cout << "8. ⚙️  System Settings\n";
+        std::cout << "9. ℹ️  Help & About\n";
+        std::cout << "0. 🚪 Exit System\n";
+        std::cout << "==============\n";
+    }
+    
+    void processChoice(int choice) {
+        switch (choice) {
+            case 1: studentManagement(); break;
+            case 2: teacherManagement(); break;
+            case 3: courseManagement(); break;
+            case 4: classroomManagement(); break;
+            case 5: reportsAndAnalytics(); break;
+            case 6: dataManagement(); break;
+            case 7: quickActions(); break;
+            case 8: systemSettings(); break;
+            case 9: helpAndAbout(); break;
+            case 0: break;
+            default: 
+                std::cout << "❌ Invalid choice. Please try again.\n";
+                SafeInput::waitForEnter();
+        }
+    }
+    
+    void studentManagement() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "👨‍🎓 STUDENT MANAGEMENT\n";
+            std::cout << "=======================\n\n";
+            
+            std::cout << "Current Students: " << students.size() << "\n";
+            std::cout << "Active Students: " << countActiveStudents() << "\n\n";
+            
+            std::cout << "1. ➕ Add New Student\n";
+            std::cout << "2. 📋 View All Students\n";
+            std::cout << "3. 🔍 Search Student\n";
+            std::cout << "4. ✏️  Edit Student\n";
+            std::cout << "5. ❌ Deactivate Student\n";
+            std::cout << "6. ✅ Reactivate Student\n";
+            std::cout << "7. 📚 Enroll in Course\n";
+            std::cout << "8. 📤 Unenroll from Course\n";
+            std::cout << "9. 📊 Student Report\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n";
+            
+            choice = SafeInput::getInt("Enter your choice (0-9): ", 0, 9);
+            
+            switch (choice) {
+                case 1: addStudent(); break;
+                case 2: viewAllStudents(); break;
+                case 3: searchStudent(); break;
+                case 4: editStudent(); break;
+                case 5: deactivateStudent(); break;
+                case 6: reactivateStudent(); break;
+                case 7: enrollStudentInCourse(); break;
+                case 8: unenrollStudentFromCourse(); break;
+                case 9: generateStudentReport(); break;
+                case 0: break;
+                default: 
+                    std::cout << "❌ Invalid choice.\n";
+                    SafeInput::waitForEnter();
+            }
+        } while (choice != 0);
+    }
+    
+    void addStudent() {
+        clearScreen();
+        std::cout << "➕ ADD NEW STUDENT\n";
+        std::cout << "==================\n\n";
+        
+        // Get and validate student ID
+        int id;
+        while (true) {
+            id = SafeInput::getInt("Enter Student ID (1-999999): ", 1, 999999);
+            if (findStudentById(id) == nullptr) {
+                break;
+            }
+            std::cout << "❌ Student ID " << id << " already exists. Please choose a different ID.\n";
+        }
+        
+        // Get student details with validation
+        std::string name = SafeInput::getString("Enter Student Name: ");
+        if (!InputValidator::isValidName(name)) {
+            std::cout << "❌ Invalid name format.\n";
+            SafeInput::waitForEnter();
+            return;
+        }
+        
+        int age = SafeInput::getInt("Enter Student Age (16-100): ", 16, 100);
+        
+        std::string email = SafeInput::getString("Enter Email (optional): ", false);
+        if (!email.empty() && !InputValidator::isValidEmail(email)) {
+            std::cout << "❌ Invalid email format.\n";
+            SafeInput::waitForEnter();
+            return;
+        }
+        
+        std::string phone = SafeInput::getString("Enter Phone (optional): ", false);
+        if (!phone.empty() && !InputValidator::isValidPhone(phone)) {
+            std::cout << "❌ Invalid phone format.\n";
+            SafeInput::waitForEnter();
+            return;
+        }
+        
+        std::string address = SafeInput::getString("Enter Address (optional): ", false);
+        
+        // Create and add student
+        Student newStudent(id, name, age, email, phone, address);
+        students.push_back(newStudent);
+        touchModel();
+        
+        // Save immediately
+        appendRecord(STUDENTS_FILE, newStudent);
+        std::cout << "\n✅ Student added successfully!\n";
+        newStudent.displayInfo();
+        
+        SafeInput::waitForEnter();
+    }
+    
+    void viewAllStudents() {
+        clearScreen();
+        std::cout << "📋 ALL STUDENTS\n";
+        std::cout << "===============\n\n";
+        
+        if (students.empty()) {
+            std::cout << "No students found.\n";
+            SafeInput::waitForEnter();
+            return;
+        }
+        
+        // Display header
+        std::cout << std::setw(5) << "ID" << " | " 
+                  << std::setw(20) << "Name" << " | "
+                  << std::setw(3) << "Age" << " | "
+                  << std::setw(25) << "Email" << " | "
+                  << std::setw(8) << "Status" << "\n";
+        std::cout << std::string(70, '-') << "\n";
+        
+        // Display students
+        for (const auto& student : students) {
+            student.displaySummary();
+        }
+        
+        std::cout << "\nTotal Students: " << students.size() << "\n";
+        std::cout << "Active Students: " << countActiveStudents() << "\n";
+        
+        SafeInput::waitForEnter();
+    }
+    
+    void searchStudent() {
+        clearScreen();
+        std::cout << "🔍 SEARCH STUDENT\n";
+        std::cout << "=================\n\n";
+        
+        std::cout << "Search by:\n";
+        std::cout << "1. Student ID\n";
+        std::cout << "2. Student Name\n";
+        
+        int searchType = SafeInput::getInt("Enter search type (1-2): ", 1, 2);
+        
+        if (searchType == 1) {
+            int id = SafeInput::getInt("Enter Student ID: ");
+            std::optional<Student> student = syncWait(tasks, findStudentAsync(id));
+            if (student) {
+                std::cout << "\n✅ Student found:\n";
+                student->displayInfo();
+            } else {
+                std::cout << "\n❌ Student with ID " << id << " not found.\n";
+            }
+        } else {
+            std::string name = SafeInput::getString("Enter Student Name (or part of name): ");
+            std::vector<Student> foundStudents = syncWait(tasks, searchStudentsAsync(name));
+            
+            if (foundStudents.empty()) {
+                std::cout << "\n❌ No students found with name containing '" << name << "'.\n";
+            } else {
+                std::cout << "\n✅ Found " << foundStudents.size() << " student(s):\n\n";
+                for (const Student& student : foundStudents) {
+                    student.displayInfo();
+                    std::cout << std::string(50, '-') << "\n";
+                }
+            }
+        }
+        
+        SafeInput::waitForEnter();
+    }
+    
+    // Additional helper methods
+    void clearScreen() {
+        #ifdef _WIN32
+            system("cls");
+        #else
+            system("clear");
+        #endif
+    }
+    
+    void displaySystemStatus() {
+        std::cout << "📊 System Status: ";
+        std::cout << students.size() << " Students | ";
+        std::cout << teachers.size() << " Teachers | ";
+        std::cout << courses.size() << " Courses | ";
+        std::cout << classrooms.size() << " Classrooms\n";
+        
+        if (exportRunning) {
+            std::cout << "📤 Export in progress...\n";
+        } else {
+            std::lock_guard<std::mutex> lock(exportMutex);
+            if (lastExport) {
+                size_t records = 0;
+                for (const auto& file : lastExport->files) records += file.records;
+                std::cout << "📤 Last export: " << lastExport->files.size() << " files, " << records
+                          << " records in " << std::fixed << std::setprecision(1) << lastExport->seconds * 1000.0 << " ms\n";
+            }
+        }
+        
+        IoStats io = persistence.getStats();
+        std::cout << "💾 Persistence (" << persistence.getBackendName() << "): " << io.queueDepth << " queued, "
+                  << io.completed << " written, " << io.failed << " failed, " << std::fixed << std::setprecision(1)
+                  << io.averageMicros / 1000.0 << " ms avg / " << io.maxMicros / 1000.0 << " ms max\n";
+        std::cout << "✏️  Edits: " << editMetrics.describe() << "\n";
+    }
+    
+    template<typename T>
+    static int countActive(const std::vector<T>& records) {
+        return std::count_if(records.begin(), records.end(),
+            [](const T& record) { return record.getIsActive(); });
+    }
+    
+    int countActiveStudents() { return countActive(students); }
+    int countActiveTeachers() { return countActive(teachers); }
+    
+    // Current point-in-time view for exports and saves. Copied under the
+    // exclusive model lock, so it never holds a half-applied edit, and only
+    // when the model has changed since the last copy; until then every
+    // reader shares one. Must not be called with modelMutex held.
+    std::shared_ptr<const ModelSnapshot> modelSnapshot() {
+        std::shared_ptr<const ModelSnapshot> view = snapshots.acquire();
+        if (view && view->version == modelVersion.load(std::memory_order_acquire)) return view;
+        std::unique_lock<std::shared_mutex> lock(modelMutex);
+        view = snapshots.acquire();
+        uint64_t version = modelVersion.load(std::memory_order_acquire);
+        if (view && view->version == version) return view;
+        return snapshots.publish(new ModelSnapshot{students, teachers, courses, classrooms, version});
+    }
+    
+    // Called by every operation that changes the records, right after the
+    // change; concurrent writers call it before releasing their model lock
+    void touchModel() { modelVersion.fetch_add(1, std::memory_order_release); }
+    
+    Student* findStudentById(int id) { return studentIndex.find(students, id); }
+    Teacher* findTeacherById(int id) { return teacherIndex.find(teachers, id); }
+    Course* findCourseById(int id) { return courseIndex.find(courses, id); }
+    Classroom* findClassroomById(int id) { return classroomIndex.find(classrooms, id); }
+    
+    // Case-insensitive substring match, compared in place so no name is
+    // copied. Alongside daemon edits, pass studentLocks: each name is then
+    // compared under its student's stripe.
+    std::vector<Student*> searchStudentsByName(const std::string& name, size_t limit = SIZE_MAX,
+                                               LockStripes* locks = nullptr) {
+        return searchStudents(students, name, limit, locks);
+    }
+    
+    static std::vector<Student*> searchStudents(std::vector<Student>& records, const std::string& name, size_t limit,
+                                                LockStripes* locks = nullptr) {
+        std::vector<Student*> results;
+        auto sameLetter = [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        };
+    
+        for (auto& student : records) {
+            if (results.size() >= limit) break;
+            std::unique_lock<std::mutex> stripe;
+            if (locks) stripe = std::unique_lock<std::mutex>(locks->forId(student.getId()));
+            const std::string& studentName = student.getName();
+            if (name.empty() ||
+                std::search(studentName.begin(), studentName.end(), name.begin(), name.end(), sameLetter) != studentName.end()) {
+                results.push_back(&student);
+            }
+        }
+    
+        return results;
+    }
+    
+    // Record operations shared by the menus and batch mode. Each checks its
+    // preconditions, applies the change to both sides of a relationship and
+    // describes the outcome in message.
+    //
+    // Enrollment is also used by daemon workers in parallel (under the shared
+    // model lock): the seat is claimed lock-free, and only the two rosters
+    // being changed are locked, student stripe first, then course stripe.
+    bool enrollStudent(Student& student, Course& course, std::string& message) {
+        std::string pair = "student " + std::to_string(student.getId()) + " in course " + std::to_string(course.getId());
+        std::lock_guard<std::mutex> studentLock(studentLocks.forId(student.getId()));
+        if (!student.getIsActive()) {
+            message = "student " + std::to_string(student.getId()) + " is inactive";
+        } else if (!course.getIsActive()) {
+            message = "course " + std::to_string(course.getId()) + " is inactive";
+        } else if (student.isEnrolledIn(course.getId())) {
+            message = pair + " is already enrolled";
+        } else {
+            SeatReservation seat = course.reserveSeat();
+            if (!seat) {
+                message = "course " + std::to_string(course.getId()) + " is full (" +
+                          std::to_string(course.getMaxStudents()) + " seats)";
+                return false;
+            }
+            std::lock_guard<std::mutex> courseLock(courseLocks.forId(course.getId()));
+            if (!course.commitSeat(seat, student.getId())) {
+                message = pair + " is already enrolled";
+                return false;
+            }
+            course.getWaitlist().remove(student.getId());
+            student.enrollInCourse(course.getId());
+            touchModel();
+            message = "enrolled " + pair + " (" + std::to_string(course.getCurrentEnrollment()) + "/" +
+                      std::to_string(course.getMaxStudents()) + ")";
+            return true;
+        }
+        return false;
+    }
+    
+    // All-or-nothing enrollment in several courses. Every seat is reserved
+    // first; only if all of them are available is any committed, otherwise
+    // the reservations roll back and the student's courses are unchanged.
+    // Same locking as enrollStudent, so it is safe from parallel workers.
+    bool enrollStudentInCourses(Student& student, const int* courseIds, size_t count, EnrollmentResult& result) {
+        result.outcomes.assign(count, EnrollmentOutcome::RolledBack);
+        result.committed = false;
+        std::lock_guard<std::mutex> studentLock(studentLocks.forId(student.getId()));
+    
+        std::vector<SeatReservation> seats(count);
+        std::vector<Course*> targets(count, nullptr);
+        bool complete = student.getIsActive() && count > 0;
+        for (size_t i = 0; i < count && student.getIsActive(); ++i) {
+            Course* course = findCourseById(courseIds[i]);
+            EnrollmentOutcome& outcome = result.outcomes[i];
+            if (!course) {
+                outcome = EnrollmentOutcome::CourseNotFound;
+            } else if (std::find(courseIds, courseIds + i, courseIds[i]) != courseIds + i) {
+                outcome = EnrollmentOutcome::Duplicate;
+            } else if (!course->getIsActive()) {
+                outcome = EnrollmentOutcome::CourseInactive;
+            } else if (student.isEnrolledIn(course->getId()) || rosterContains(*course, student.getId())) {
+                outcome = EnrollmentOutcome::AlreadyEnrolled;
+            } else if (!(seats[i] = course->reserveSeat())) {
+                outcome = EnrollmentOutcome::Full;
+            } else {
+                targets[i] = course;
+                continue;
+            }
+            complete = false;
+        }
+    
+        // Holding the student's stripe keeps anyone else from adding this
+        // student to these rosters, so every commit below succeeds
+        if (complete) {
+            for (size_t i = 0; i < count; ++i) {
+                std::lock_guard<std::mutex> courseLock(courseLocks.forId(targets[i]->getId()));
+                targets[i]->commitSeat(seats[i], student.getId());
+                targets[i]->getWaitlist().remove(student.getId());
+                student.enrollInCourse(targets[i]->getId());
+                result.outcomes[i] = EnrollmentOutcome::Enrolled;
+            }
+            result.committed = true;
+            touchModel();
+        }
+    
+        describeEnrollment(student.getId(), student.getIsActive(), courseIds, count, result);
+        return result.committed;
+    }
+    
+    static void describeEnrollment(int studentId, bool studentActive, const int* courseIds, size_t count, EnrollmentResult& result) {
+        result.message = "student=" + std::to_string(studentId);
+        result.message += result.committed ? " committed=true" : " committed=false";
+        if (!studentActive) result.message += " student_inactive=true";
+        for (size_t i = 0; i < count; ++i) {
+            result.message += " " + std::to_string(courseIds[i]) + "=" + EnrollmentResult::outcomeName(result.outcomes[i]);
+        }
+    }
+    
+    // Many all-or-nothing enrollments in one call, in arrival (vector)
+    // order. Registration-day bursts run on a work-stealing pool (threads,
+    // 0 = all cores): each request goes to the worker that owns its first
+    // course, so a course's seats are handed out in arrival order, and idle
+    // workers steal the oldest waiting requests from busy ones. A stolen
+    // request can run alongside a later one for the same course, so that
+    // order is kept closely rather than exactly. Returns the number of
+    // requests committed.
+    size_t enrollStudentsInCourses(const std::vector<EnrollmentRequest>& requests,
+                                   std::vector<EnrollmentResult>& results, size_t threads = 0) {
+        syncIndexes();
+        results.assign(requests.size(), EnrollmentResult());
+        std::atomic<size_t> committed(0);
+        auto process = [&](size_t i) {
+            const EnrollmentRequest& request = requests[i];
+            EnrollmentResult& result = results[i];
+            Student* student = findStudentById(request.studentId);
+            if (!student) {
+                result.outcomes.assign(request.courseIds.size(), EnrollmentOutcome::RolledBack);
+                result.message = "student=" + std::to_string(request.studentId) + " committed=false student_not_found=true";
+                return;
+            }
+            if (enrollStudentInCourses(*student, request.courseIds.data(), request.courseIds.size(), result)) committed++;
+        };
+        
+        size_t workers = Parallel::threadCount(threads, requests.size());
+        if (workers == 1) {
+            for (size_t i = 0; i < requests.size(); ++i) process(i);
+        } else {
+            WorkStealingPool pool(workers);
+            pool.run(requests.size(),
+                     [&requests](size_t i) { return requests[i].courseIds.empty() ? 0u : static_cast<unsigned>(requests[i].courseIds[0]); },
+                     [&process](size_t i, size_t) { process(i); });
+        }
+        return committed;
+    }
+    
+    bool rosterContains(Course& course, int studentId) {
+        std::lock_guard<std::mutex> courseLock(courseLocks.forId(course.getId()));
+        return course.isStudentEnrolled(studentId);
+    }
+    
+    // The freed seat goes to the next eligible waitlisted student
+    bool unenrollStudent(Student& student, Course& course, std::string& message) {
+        bool wasEnrolled = course.unenrollStudent(student.getId());
+        wasEnrolled = student.unenrollFromCourse(course.getId()) || wasEnrolled;
+        if (wasEnrolled) touchModel();
+        message = "student " + std::to_string(student.getId()) + (wasEnrolled ? " unenrolled from" : " is not enrolled in") +
+                  " course " + std::to_string(course.getId());
+        if (wasEnrolled) promoteWaitlisted(course, message);
+        return wasEnrolled;
+    }
+    
+    // Waits for a seat in a full course; with seats free it just enrolls.
+    // Ties on priority go to the student enrolled longest, then to whoever
+    // asked first.
+    bool joinWaitlist(Student& student, Course& course, int priority, std::string& message) {
+        std::string pair = "student " + std::to_string(student.getId()) + " for course " + std::to_string(course.getId());
+        if (!student.getIsActive()) {
+            message = "student " + std::to_string(student.getId()) + " is inactive";
+            return false;
+        }
+        if (!course.getIsActive()) {
+            message = "course " + std::to_string(course.getId()) + " is inactive";
+            return false;
+        }
+        if (student.isEnrolledIn(course.getId())) {
+            message = "student " + std::to_string(student.getId()) + " is already enrolled in course " + std::to_string(course.getId());
+            return false;
+        }
+        if (!course.isFull()) return enrollStudent(student, course, message);
+        
+        std::lock_guard<std::mutex> courseLock(courseLocks.forId(course.getId()));
+        Waitlist& waitlist = course.getWaitlist();
+        if (!waitlist.add(student.getId(), priority, seniorityOf(student), static_cast<int64_t>(std::time(nullptr)))) {
+            message = pair + " is already waitlisted";
+            return false;
+        }
+        touchModel();
+        // No position here: working it out is O(n), see Waitlist::position()
+        message = "waitlisted " + pair + " (" + std::to_string(waitlist.size()) + " waiting)";
+        return true;
+    }
+    
+    bool leaveWaitlist(Student& student, Course& course, std::string& message) {
+        std::lock_guard<std::mutex> courseLock(courseLocks.forId(course.getId()));
+        bool removed = course.getWaitlist().remove(student.getId());
+        if (removed) touchModel();
+        message = "student " + std::to_string(student.getId()) + (removed ? " left" : " is not on") +
+                  " the waitlist for course " + std::to_string(course.getId());
+        return removed;
+    }
+    
+    // Fills free seats from the front of the waitlist, O(log n) per student.
+    // Students who left, were deactivated or enrolled meanwhile are skipped
+    // and dropped. A student whose seat went to a concurrent enrollment goes
+    // back in their place. Appends "promoted=..." to message when anyone
+    // moved up.
+    size_t promoteWaitlisted(Course& course, std::string& message) {
+        std::vector<int> promoted;
+        while (course.getIsActive() && !course.isFull()) {
+            WaitlistEntry next;
+            {
+                std::lock_guard<std::mutex> courseLock(courseLocks.forId(course.getId()));
+                if (!course.getWaitlist().pop(next)) break;
+            }
+            Student* student = findStudentById(next.studentId);
+            if (!student || !student->getIsActive() || student->isEnrolledIn(course.getId())) continue;
+            std::string ignored;
+            if (!enrollStudent(*student, course, ignored)) {
+                std::lock_guard<std::mutex> courseLock(courseLocks.forId(course.getId()));
+                course.getWaitlist().restore(next);
+                break;
+            }
+            promoted.push_back(next.studentId);
+        }
+        for (size_t i = 0; i < promoted.size(); ++i) {
+            message += (i == 0 ? "; promoted " : ",") + std::to_string(promoted[i]);
+        }
+        return promoted.size();
+    }
+    
+    // First enrollment date as yyyymmdd; undated students rank last
+    static int seniorityOf(const Student& student) {
+        int date = 0;
+        for (char c : student.getEnrollmentDate()) {
+            if (c >= '0' && c <= '9') date = date * 10 + (c - '0');
+            if (date > 99999999) break;
+        }
+        return date >= 10000101 && date <= 99991231 ? date : 99999999;
+    }
+    
+    // A course has one teacher; assigning a new one releases the previous
+    bool assignTeacher(Teacher& teacher, Course& course, std::string& message) {
+        std::string pair = "teacher " + std::to_string(teacher.getId()) + " to course " + std::to_string(course.getId());
+        if (!teacher.getIsActive()) {
+            message = "teacher " + std::to_string(teacher.getId()) + " is inactive";
+            return false;
+        }
+        if (course.getAssignedTeacherId() == teacher.getId()) {
+            message = pair + " is already assigned";
+            return false;
+        }
+        if (Teacher* previous = course.hasTeacher() ? findTeacherById(course.getAssignedTeacherId()) : nullptr) {
+            previous->unassignFromCourse(course.getId());
+        }
+        course.setAssignedTeacherId(teacher.getId());
+        teacher.assignToCourse(course.getId());
+        touchModel();
+        message = "assigned " + pair;
+        return true;
+    }
+    
+    bool unassignTeacher(Teacher& teacher, Course& course, std::string& message) {
+        bool wasAssigned = course.getAssignedTeacherId() == teacher.getId();
+        if (wasAssigned) course.setAssignedTeacherId(-1);
+        wasAssigned = teacher.unassignFromCourse(course.getId()) || wasAssigned;
+        if (wasAssigned) touchModel();
+        message = "teacher " + std::to_string(teacher.getId()) + (wasAssigned ? " unassigned from" : " is not assigned to") +
+                  " course " + std::to_string(course.getId());
+        return wasAssigned;
+    }
+    
+    // A status change is an edit like any other and installs a new version
+    template <typename Record>
+    bool setActive(Record& record, bool active, const char* entity, std::string& message) {
+        message = std::string(entity) + " " + std::to_string(record.getId());
+        EditOutcome outcome;
+        {
+            std::shared_lock<std::shared_mutex> model(modelMutex);
+            outcome = commitLatest(record.getVersionStamp(), recordLock(record), [this, &record, active] {
+                if (record.getIsActive() == active) return false;
+                record.setIsActive(active);
+                touchModel();
+                return true;
+            }, editMetrics);
+        }
+        if (outcome != EditOutcome::Committed) {
+            message += active ? " is already active" : " is already inactive";
+            return false;
+        }
+        message += active ? " reactivated" : " deactivated";
+        return true;
+    }
+    
+    // A reactivated course may have seats its waitlist couldn't take
+    bool setActive(Course& course, bool active, const char* entity, std::string& message) {
+        bool changed = setActive<Course>(course, active, entity, message);
+        if (changed && active) {
+            std::shared_lock<std::shared_mutex> model(modelMutex);
+            promoteWaitlisted(course, message);
+        }
+        return changed;
+    }
+    
+    // Editable fields are named as in the import/export headers
+    template <typename Format>
+    static int fieldNamed(const std::string& name) {
+        std::vector<std::string> header(1, name);
+        for (int field = 1; field < Format::FieldCount; ++field) {
+            if (Format::mapColumn(header, field) == 0) return field;
+        }
+        return -1;
+    }
+    
+    // Field edits are optimistic. The editor reads the record and its
+    // version holding nothing; the commit validates that version and installs
+    // the change under the record's stripe, held for that step only, or
+    // reports a conflict if another edit got in first. readVersion 0 edits
+    // whatever is current. The shared model lock only keeps adds from moving
+    // the record meanwhile, so edits to different records run in parallel
+    // with each other and with daemon requests.
+    EditOutcome editStudentField(Student& student, int field, const std::string& value, uint64_t readVersion,
+                                 std::string& message) {
+        std::shared_lock<std::shared_mutex> model(modelMutex);
+        return commitFieldEdit<StudentCsvFormat>(student, "student", field, value, readVersion, applyStudentField,
+                                                 recordLock(student), message);
+    }
+    
+    EditOutcome editTeacherField(Teacher& teacher, int field, const std::string& value, uint64_t readVersion,
+                                 std::string& message) {
+        std::shared_lock<std::shared_mutex> model(modelMutex);
+        return commitFieldEdit<TeacherCsvFormat>(teacher, "teacher", field, value, readVersion, applyTeacherField,
+                                                 recordLock(teacher), message);
+    }
+    
+    EditOutcome editCourseField(Course& course, int field, const std::string& value, uint64_t readVersion,
+                                std::string& message) {
+        std::shared_lock<std::shared_mutex> model(modelMutex);
+        EditOutcome outcome = commitFieldEdit<CourseCsvFormat>(course, "course", field, value, readVersion,
+                                                               applyCourseField, recordLock(course), message);
+        if (outcome == EditOutcome::Committed && field == CourseCsvFormat::MaxStudents) {
+            promoteWaitlisted(course, message);
+        }
+        return outcome;
+    }
+    
+    // The stripe a record's edits commit under; for students and courses,
+    // the one that guards its roster too
+    std::mutex& recordLock(const Student& student) { return studentLocks.forId(student.getId()); }
+    std::mutex& recordLock(const Teacher& teacher) { return teacherLocks.forId(teacher.getId()); }
+    std::mutex& recordLock(const Course& course) { return courseLocks.forId(course.getId()); }
+    
+    template <typename Format, typename Record, typename Lock>
+    EditOutcome commitFieldEdit(Record& record, const char* entity, int field, const std::string& value,
+                                uint64_t readVersion, bool (*apply)(Record&, int, const std::string&), Lock& lock,
+                                std::string& message) {
+        std::string name = std::string(entity) + " " + std::to_string(record.getId());
+        if (field < 1 || field >= Format::FieldCount) {
+            message = std::string("unknown ") + entity + " field";
+            return EditOutcome::Invalid;
+        }
+        // The model version moves inside the commit, while the lock is held
+        auto change = [this, &record, field, &value, apply] {
+            if (!apply(record, field, value)) return false;
+            touchModel();
+            return true;
+        };
+        EditOutcome outcome = readVersion ? commitEdit(record.getVersionStamp(), lock, readVersion, change, editMetrics)
+                                          : commitLatest(record.getVersionStamp(), lock, change, editMetrics);
+        if (outcome == EditOutcome::Committed) {
+            message = name + " " + Format::fieldName(field) + " updated";
+        } else if (outcome == EditOutcome::Invalid) {
+            message = std::string("invalid ") + Format::fieldName(field) + " '" + value + "'";
+        } else {
+            message = "conflict: " + name + " is at version " + std::to_string(record.getVersion()) + ", not " +
+                      std::to_string(readVersion);
+        }
+        return outcome;
+    }
+    
+    // The apply steps validate before they change anything, so a refused
+    // value leaves the record as it was
+    static bool applyStudentField(Student& student, int field, const std::string& value) {
+        int age = 0;
+        switch (field) {
+            case StudentCsvFormat::Name: return student.setName(value);
+            case StudentCsvFormat::Age: return parseInt(value, age) && student.setAge(age);
+            case StudentCsvFormat::Email: return student.setEmail(value);
+            case StudentCsvFormat::Phone: return student.setPhone(value);
+            case StudentCsvFormat::Address: student.setAddress(value); return true;
+            default: return false;
+        }
+    }
+    
+    static bool applyTeacherField(Teacher& teacher, int field, const std::string& value) {
+        double salary = 0.0;
+        switch (field) {
+            case TeacherCsvFormat::Name: return teacher.setName(value);
+            case TeacherCsvFormat::Subject: return teacher.setSubject(value);
+            case TeacherCsvFormat::Email: return teacher.setEmail(value);
+            case TeacherCsvFormat::Phone: return teacher.setPhone(value);
+            case TeacherCsvFormat::Department: teacher.setDepartment(value); return true;
+            case TeacherCsvFormat::Salary: return parseDouble(value, salary) && teacher.setSalary(salary);
+            default: return false;
+        }
+    }
+    
+    // Seat limits can't drop below the students already enrolled
+    static bool applyCourseField(Course& course, int field, const std::string& value) {
+        int number = 0;
+        double fee = 0.0;
+        switch (field) {
+            case CourseCsvFormat::Name: return course.setName(value);
+            case CourseCsvFormat::Description: course.setDescription(value); return true;
+            case CourseCsvFormat::Credits: return parseInt(value, number) && course.setCredits(number);
+            case CourseCsvFormat::MaxStudents:
+                return parseInt(value, number) && number >= course.getCurrentEnrollment() && course.setMaxStudents(number);
+            case CourseCsvFormat::Fee: return parseDouble(value, fee) && course.setFee(fee);
+            default: return false;
+        }
+    }
+    
+    static bool parseInt(const std::string& text, int& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+    
+    static bool parseDouble(const std::string& text, double& value) {
+        char* end = nullptr;
+        value = std::strtod(text.c_str(), &end);
+        return !text.empty() && end == text.c_str() + text.size();
+    }
+    
+    static std::string getCurrentDate() {
+        auto time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d");
+        return ss.str();
+    }
+    
+    void loadAllData() {
+        std::cout << "📂 Loading system data...\n";
+        students = Student::loadFromFile(STUDENTS_FILE);
+        teachers = Teacher::loadFromFile(TEACHERS_FILE);
+        courses = Course::loadFromFile(COURSES_FILE);
+        classrooms = Classroom::loadFromFile(CLASSROOMS_FILE);
+        studentIndex.reset();
+        teacherIndex.reset();
+        courseIndex.reset();
+        classroomIndex.reset();
+        touchModel();
+        std::cout << "✅ Data loading completed.\n\n";
+    }
+    
+    template<typename T>
+    static std::string serializeRecords(const std::vector<T>& records) {
+        std::ostringstream out;
+        for (const auto& record : records) record.writeRecord(out);
+        return out.str();
+    }
+    
+    // Queues a replace of each data file with the current records and
+    // returns without waiting; the futures say when each file is on disk
+    std::vector<std::future<IoResult>> saveAllData() {
+        std::cout << "💾 Saving all data...\n";
+        std::vector<std::future<IoResult>> writes;
+        writes.push_back(persistence.replace(STUDENTS_FILE, serializeRecords(students)));
+        writes.push_back(persistence.replace(TEACHERS_FILE, serializeRecords(teachers)));
+        writes.push_back(persistence.replace(COURSES_FILE, serializeRecords(courses)));
+        writes.push_back(persistence.replace(CLASSROOMS_FILE, serializeRecords(classrooms)));
+        return writes;
+    }
+    
+    // Blocks until the writes are durable; false if any failed
+    static bool waitForWrites(std::vector<std::future<IoResult>>& writes, const std::string& what) {
+        int failed = 0;
+        int error = 0;
+        for (auto& write : writes) {
+            IoResult result = write.get();
+            if (!result.ok) {
+                failed++;
+                error = result.error;
+            }
+        }
+        if (failed == 0) {
+            std::cout << "✅ " << what << " successfully.\n";
+        } else {
+            std::cout << "❌ " << failed << " of " << writes.size() << " writes failed: " << std::strerror(error) << "\n";
+        }
+        return failed == 0;
+    }
+    
+    // Adds one record to the end of its data file in the background
+    template<typename T>
+    void appendRecord(const std::string& filename, const T& record) {
+        std::ostringstream line;
+        record.writeRecord(line);
+        persistence.append(filename, line.str(), [filename](const IoResult& result) {
+            if (!result.ok) {
+                std::cerr << "❌ Error: Cannot write to " << filename << ": " << std::strerror(result.error) << "\n";
+            }
+        });
+    }
+    
+    std::vector<std::future<IoResult>> createBackup() {
+        // Create backup directory if it doesn't exist
+        #ifdef _WIN32
+            system(("mkdir " + BACKUP_DIR + " 2>nul").c_str());
+        #else
+            system(("mkdir -p " + BACKUP_DIR).c_str());
+        #endif
+        
+        // Copy files to backup directory with timestamp
+        auto now = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
+        std::string timestamp = ss.str();
+        
+        std::cout << "🔄 Creating backup with timestamp: " << timestamp << "\n";
+        
+        // Each copy runs after the writes already queued on its source
+        std::vector<std::future<IoResult>> copies;
+        for (const std::string& file : {STUDENTS_FILE, TEACHERS_FILE, COURSES_FILE, CLASSROOMS_FILE}) {
+            copies.push_back(persistence.copy(file, BACKUP_DIR + timestamp + "_" + file));
+        }
+        return copies;
+    }
+    
+    // Placeholder methods for other functionalities
+    void teacherManagement() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "👩‍🏫 TEACHER MANAGEMENT\n";
+            std::cout << "========================\n\n";
+            
+            std::cout << "Current Teachers: " << teachers.size() << "\n";
+            std::cout << "Active Teachers: " << countActiveTeachers() << "\n\n";
+            
+            std::cout << "1. ➕ Add New Teacher\n";
+            std::cout << "2. 📋 View All Teachers\n";
+            std::cout << "3. 🔍 Search Teacher\n";
+            std::cout << "4. ✏️  Edit Teacher\n";
+            std::cout << "5. ❌ Deactivate Teacher\n";
+            std::cout << "6. ✅ Reactivate Teacher\n";
+            std::cout << "7. 📚 Assign to Course\n";
+            std::cout << "8. 📤 Unassign from Course\n";
+            std::cout << "9. 📊 Teacher Report\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n\n";
+            
+            choice = SafeInput::getInt("Enter your choice: ");
+            
+            switch (choice) {
+                case 1: addTeacher(); break;
+                case 2: viewAllTeachers(); break;
+                case 3: searchTeacher(); break;
+                case 4: editTeacher(); break;
+                case 5: deactivateTeacher(); break;
+                case 6: reactivateTeacher(); break;
+                case 7: assignTeacherToCourse(); break;
+                case 8: unassignTeacherFromCourse(); break;
+                case 9: generateTeacherReport(); break;
+                case 0: break;
+                default: 
+                    std::cout << "❌ Invalid choice. Please try again.\n";
+                    SafeInput::waitForEnter();
+            }
+        } while (choice != 0);
+    }
+    
+    void addTeacher() {
+        clearScreen();
+        std::cout << "➕ ADD NEW TEACHER\n";
+        std::cout << "==================\n\n";
+        
+        int id = teachers.empty() ? 1 : 
+                 std::max_element(teachers.begin(), teachers.end(),
+                     [](const Teacher& a, const Teacher& b) { return a.getId() < b.getId(); })->getId() + 1;
+        
+        std::string name = SafeInput::getString("Enter teacher name: ");
+        std::string email = SafeInput::getString("Enter email address: ");
+        std::string phone = SafeInput::getString("Enter phone number: ");
+        std::string department = SafeInput::getString("Enter department: ");
+        std::string specialization = SafeInput::getString("Enter specialization: ");
+        
+        Teacher newTeacher(id, name, specialization, email, phone, department);
+        teachers.push_back(newTeacher);
+        touchModel();
+        appendRecord(TEACHERS_FILE, newTeacher);
+        
+        std::cout << "✅ Teacher added successfully! ID: " << id << "\n";
+        SafeInput::waitForEnter();
+    }
+    
+    void viewAllTeachers() {
+        clearScreen();
+        std::cout << "📋 ALL TEACHERS\n";
+        std::cout << "===============\n\n";
+        
+        if (teachers.empty()) {
+            std::cout << "No teachers found.\n";
+            SafeInput::waitForEnter();
+            return;
+        }
+        
+        std::cout << std::setw(5) << "ID" << " | " << std::setw(25) << "Name" << " | " 
                   << std::setw(20) << "Department" << " | " << std::setw(8) << "Status" << "\n";
         std::cout << std::string(65, '-') << "\n";
         
@@ -875,223 +3464,1201 @@ private:
         }
         
         if (results.empty()) {
-            std::cout << "No teachers found matching: " << searchTerm << "\n";
+            std::cout << "No teachers found matching: " << searchTerm << "\n";
+        } else {
+            std::cout << "Found " << results.size() << " teacher(s):\n\n";
+            for (auto* teacher : results) {
+                teacher->displayInfo();
+                std::cout << "\n";
+            }
+        }
+        
+        SafeInput::waitForEnter();
+    }
+    
+    // Additional Course Management Functions
+    void addCourse() {
+        clearScreen();
+        std::cout << "➕ ADD NEW COURSE\n";
+        std::cout << "=================\n\n";
+        
+        int id = courses.empty() ? 1 : 
+                 std::max_element(courses.begin(), courses.end(),
+                     [](const Course& a, const Course& b) { return a.getId() < b.getId(); })->getId() + 1;
+        
+        std::string name = SafeInput::getString("Enter course name: ");
+        std::string description = SafeInput::getString("Enter course description: ");
+        int credits = SafeInput::getInt("Enter number of credits: ");
+        int maxStudents = SafeInput::getInt("Enter maximum students: ");
+        double fee = SafeInput::getDouble("Enter course fee: $");
+        
+        Course newCourse(id, name, description, credits, maxStudents, fee);
+        courses.push_back(newCourse);
+        touchModel();
+        appendRecord(COURSES_FILE, newCourse);
+        
+        std::cout << "✅ Course added successfully! ID: " << id << "\n";
+        SafeInput::waitForEnter();
+    }
+    
+    void viewAllCourses() {
+        clearScreen();
+        std::cout << "📋 ALL COURSES\n";
+        std::cout << "==============\n\n";
+        
+        if (courses.empty()) {
+            std::cout << "No courses found.\n";
+            SafeInput::waitForEnter();
+            return;
+        }
+        
+        std::cout << std::setw(5) << "ID" << " | " << std::setw(25) << "Name" << " | " 
+                  << std::setw(8) << "Credits" << " | " << std::setw(12) << "Enrollment" << " | "
+                  << std::setw(8) << "Status" << "\n";
+        std::cout << std::string(65, '-') << "\n";
+        
+        for (const auto& course : courses) {
+            course.displaySummary();
+        }
+        
+        SafeInput::waitForEnter();
+    }
+    
+    void searchCourse() {
+        clearScreen();
+        std::cout << "🔍 SEARCH COURSE\n";
+        std::cout << "================\n\n";
+        
+        std::string searchTerm = SafeInput::getString("Enter course name to search: ");
+        std::vector<Course*> results;
+        
+        for (auto& course : courses) {
+            std::string name = course.getName();
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            std::transform(searchTerm.begin(), searchTerm.end(), searchTerm.begin(), ::tolower);
+            
+            if (name.find(searchTerm) != std::string::npos) {
+                results.push_back(&course);
+            }
+        }
+        
+        if (results.empty()) {
+            std::cout << "No courses found matching: " << searchTerm << "\n";
+        } else {
+            std::cout << "Found " << results.size() << " course(s):\n\n";
+            for (auto* course : results) {
+                course->displayInfo();
+                std::cout << "\n";
+            }
+        }
+        
+        SafeInput::waitForEnter();
+    }
+    
+    // Reports and Analytics Functions
+    void generateSystemOverviewReport() {
+        clearScreen();
+        std::cout << "📈 SYSTEM OVERVIEW REPORT\n";
+        std::cout << "=========================\n\n";
+        
+        std::shared_ptr<const ModelSnapshot> view = modelSnapshot();
+        const std::vector<Course>& courses = view->courses;
+        std::cout << "📊 SYSTEM STATISTICS\n";
+        std::cout << "====================\n";
+        std::cout << "Total Students: " << view->students.size() << "\n";
+        std::cout << "Active Students: " << countActive(view->students) << "\n";
+        std::cout << "Total Teachers: " << view->teachers.size() << "\n";
+        std::cout << "Active Teachers: " << countActive(view->teachers) << "\n";
+        std::cout << "Total Courses: " << courses.size() << "\n";
+        std::cout << "Active Courses: " << countActive(courses) << "\n";
+        std::cout << "Total Classrooms: " << view->classrooms.size() << "\n\n";
+        
+        // Enrollment statistics
+        int totalEnrollments = 0;
+        double totalRevenue = 0.0;
+        
+        for (const auto& course : courses) {
+            totalEnrollments += course.getCurrentEnrollment();
+            totalRevenue += course.getCurrentEnrollment() * course.getFee();
+        }
+        
+        std::cout << "📚 ENROLLMENT STATISTICS\n";
+        std::cout << "========================\n";
+        std::cout << "Total Enrollments: " << totalEnrollments << "\n";
+        std::cout << "Total Revenue: $" << std::fixed << std::setprecision(2) << totalRevenue << "\n";
+        std::cout << "Average Enrollments per Course: " << 
+            (courses.empty() ? 0.0 : static_cast<double>(totalEnrollments) / courses.size()) << "\n\n";
+        
+        std::cout << "📅 Report Generated: " << getCurrentDate() << " (snapshot version " << view->version
+                  << ", " << snapshots.getLiveVersions() << " in use)\n";
+        SafeInput::waitForEnter();
+    }
+    
+    // Quick Action Functions
+    void quickStudentSearch() {
+        clearScreen();
+        std::cout << "👤 QUICK STUDENT SEARCH\n";
+        std::cout << "=======================\n\n";
+        
+        std::string searchTerm = SafeInput::getString("Enter student name: ");
+        auto results = searchStudentsByName(searchTerm);
+        
+        if (results.empty()) {
+            std::cout << "❌ No students found.\n";
         } else {
-            std::cout << "Found " << results.size() << " teacher(s):\n\n";
-            for (auto* teacher : results) {
-                teacher->displayInfo();
-                std::cout << "\n";
+            std::cout << "✅ Found " << results.size() << " student(s):\n\n";
+            for (auto* student : results) {
+                std::cout << "ID: " << student->getId() << ", Name: " << student->getName() 
+                         << ", Status: " << (student->getIsActive() ? "Active" : "Inactive") << "\n";
             }
         }
         
         SafeInput::waitForEnter();
     }
     
-    // Additional Course Management Functions
-    void addCourse() {
+    void quickCourseLookup() {
         clearScreen();
-        std::cout << "➕ ADD NEW COURSE\n";
-        std::cout << "=================\n\n";
-        
-        int id = courses.empty() ? 1 : 
-                 std::max_element(courses.begin(), courses.end(),
-                     [](const Course& a, const Course& b) { return a.getId() < b.getId(); })->getId() + 1;
+        std::cout << "📚 QUICK COURSE LOOKUP\n";
+        std::cout << "======================\n\n";
         
-        std::string name = SafeInput::getString("Enter course name: ");
-        std::string description = SafeInput::getString("Enter course description: ");
-        int credits = SafeInput::getInt("Enter number of credits: ");
-        int maxStudents = SafeInput::getInt("Enter maximum students: ");
-        double fee = SafeInput::getDouble("Enter course fee: $");
+        int id = SafeInput::getInt("Enter Course ID: ");
+        Course* course = findCourseById(id);
         
-        Course newCourse(id, name, description, credits, maxStudents, fee);
-        courses.push_back(newCourse);
-        newCourse.saveToFile(COURSES_FILE);
+        if (course) {
+            course->displayInfo();
+        } else {
+            std::cout << "❌ Course not found.\n";
+        }
         
-        std::cout << "✅ Course added successfully! ID: " << id << "\n";
         SafeInput::waitForEnter();
     }
     
-    void viewAllCourses() {
+    void quickTeacherSearch() {
         clearScreen();
-        std::cout << "📋 ALL COURSES\n";
-        std::cout << "==============\n\n";
+        std::cout << "👩‍🏫 QUICK TEACHER SEARCH\n";
+        std::cout << "=========================\n\n";
         
-        if (courses.empty()) {
-            std::cout << "No courses found.\n";
-            SafeInput::waitForEnter();
-            return;
+        int id = SafeInput::getInt("Enter Teacher ID: ");
+        Teacher* teacher = findTeacherById(id);
+        
+        if (teacher) {
+            teacher->displayInfo();
+        } else {
+            std::cout << "❌ Teacher not found.\n";
         }
         
-        std::cout << std::setw(5) << "ID" << " | " << std::setw(25) << "Name" << " | " 
-                  << std::setw(8) << "Credits" << " | " << std::setw(12) << "Enrollment" << " | "
-                  << std::setw(8) << "Status" << "\n";
-        std::cout << std::string(65, '-') << "\n";
+        SafeInput::waitForEnter();
+    }
+    
+    void quickStudentEnrollment() {
+        clearScreen();
+        std::cout << "➕ QUICK STUDENT ENROLLMENT\n";
+        std::cout << "===========================\n\n";
         
-        for (const auto& course : courses) {
-            course.displaySummary();
+        enrollStudentInCourse();
+    }
+    
+    // Menu front ends for the shared record operations
+    Student* promptForStudent() {
+        int id = SafeInput::getInt("Enter Student ID: ");
+        Student* student = findStudentById(id);
+        if (!student) std::cout << "❌ Student with ID " << id << " not found.\n";
+        return student;
+    }
+    
+    Teacher* promptForTeacher() {
+        int id = SafeInput::getInt("Enter Teacher ID: ");
+        Teacher* teacher = findTeacherById(id);
+        if (!teacher) std::cout << "❌ Teacher with ID " << id << " not found.\n";
+        return teacher;
+    }
+    
+    Course* promptForCourse() {
+        int id = SafeInput::getInt("Enter Course ID: ");
+        Course* course = findCourseById(id);
+        if (!course) std::cout << "❌ Course with ID " << id << " not found.\n";
+        return course;
+    }
+    
+    // Editable fields listed by their export names; 0 cancels
+    template <typename Format>
+    static int promptForField() {
+        std::cout << "\nFields:\n";
+        for (int field = 1; field < Format::FieldCount; ++field) {
+            std::cout << field << ". " << Format::fieldName(field) << "\n";
+        }
+        std::cout << "0. Cancel\n";
+        return SafeInput::getInt("Select field: ", 0, Format::FieldCount - 1);
+    }
+    
+    static std::string promptForValue(const char* field) {
+        return SafeInput::getString("New " + std::string(field) + ": ", false, 255);
+    }
+    
+    static void showResult(bool ok, const std::string& message) {
+        std::cout << (ok ? "\n✅ " : "\n❌ ") << message << "\n";
+    }
+    
+    static void showTitle(const std::string& title) {
+        std::cout << title << "\n" << std::string(title.size(), '=') << "\n\n";
+    }
+    
+    // The change is committed against the version the operator was shown. If
+    // someone else saved the record meanwhile, the operator sees it as it is
+    // now and decides whether the change still applies.
+    template <typename Format, typename Record>
+    void editInteractively(Record& record,
+                           EditOutcome (IndustrialSchoolManagementSystem::*edit)(Record&, int, const std::string&,
+                                                                                 uint64_t, std::string&)) {
+        record.displayInfo();
+        uint64_t seen = record.getVersion();
+        int field = promptForField<Format>();
+        if (!field) return;
+        std::string value = promptForValue(Format::fieldName(field));
+        std::string message;
+        EditOutcome outcome = (this->*edit)(record, field, value, seen, message);
+        while (outcome == EditOutcome::Conflict) {
+            showResult(false, message);
+            record.displayInfo();
+            if (!SafeInput::getYesNo("Apply your change to this version?")) return;
+            editMetrics.retries.fetch_add(1, std::memory_order_relaxed);
+            outcome = (this->*edit)(record, field, value, record.getVersion(), message);
+        }
+        showResult(outcome == EditOutcome::Committed, message);
+    }
+    
+    void editStudent() {
+        clearScreen();
+        showTitle("✏️  EDIT STUDENT");
+        if (Student* student = promptForStudent()) {
+            editInteractively<StudentCsvFormat>(*student, &IndustrialSchoolManagementSystem::editStudentField);
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void editTeacher() {
+        clearScreen();
+        showTitle("✏️  EDIT TEACHER");
+        if (Teacher* teacher = promptForTeacher()) {
+            editInteractively<TeacherCsvFormat>(*teacher, &IndustrialSchoolManagementSystem::editTeacherField);
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void editCourse() {
+        clearScreen();
+        showTitle("✏️  EDIT COURSE");
+        if (Course* course = promptForCourse()) {
+            editInteractively<CourseCsvFormat>(*course, &IndustrialSchoolManagementSystem::editCourseField);
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    template <typename Record>
+    void changeStatus(Record* (IndustrialSchoolManagementSystem::*prompt)(), const char* entity, bool active) {
+        clearScreen();
+        std::string title = std::string(active ? "REACTIVATE " : "DEACTIVATE ") + entity;
+        std::transform(title.begin(), title.end(), title.begin(), ::toupper);
+        showTitle((active ? "✅ " : "❌ ") + title);
+        if (Record* record = (this->*prompt)()) {
+            std::string message;
+            showResult(setActive(*record, active, entity, message), message);
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void deactivateStudent() { changeStatus(&IndustrialSchoolManagementSystem::promptForStudent, "student", false); }
+    void reactivateStudent() { changeStatus(&IndustrialSchoolManagementSystem::promptForStudent, "student", true); }
+    void deactivateTeacher() { changeStatus(&IndustrialSchoolManagementSystem::promptForTeacher, "teacher", false); }
+    void reactivateTeacher() { changeStatus(&IndustrialSchoolManagementSystem::promptForTeacher, "teacher", true); }
+    void deactivateCourse() { changeStatus(&IndustrialSchoolManagementSystem::promptForCourse, "course", false); }
+    void reactivateCourse() { changeStatus(&IndustrialSchoolManagementSystem::promptForCourse, "course", true); }
+    
+    // Several course IDs are enrolled all-or-nothing
+    void enrollStudentInCourse() {
+        clearScreen();
+        showTitle("📚 ENROLL IN COURSES");
+        Student* student = promptForStudent();
+        if (student) {
+            std::vector<std::string> fields;
+            std::string line = SafeInput::getString("Enter Course ID(s), comma-separated: ");
+            CsvReader::parseRecord(line.data(), line.size(), 0, fields);
+            std::vector<int> courseIds;
+            for (const auto& field : fields) {
+                int id = 0;
+                if (parseInt(field, id)) courseIds.push_back(id);
+                else std::cout << "⚠️  Ignoring '" << field << "'\n";
+            }
+    
+            std::string message;
+            if (courseIds.size() == 1) {
+                Course* course = findCourseById(courseIds[0]);
+                if (!course) {
+                    std::cout << "❌ Course with ID " << courseIds[0] << " not found.\n";
+                } else if (course->isFull() && course->getIsActive() && !student->isEnrolledIn(course->getId())) {
+                    std::cout << "\n⏳ Course " << course->getId() << " is full (" << course->getWaitlist().size() << " waiting).\n";
+                    if (SafeInput::getYesNo("Join the waitlist?")) {
+                        int priority = SafeInput::getInt("Program priority (0 = standard, higher is served first): ", 0, 9);
+                        showResult(joinWaitlist(*student, *course, priority, message), message);
+                    }
+                } else {
+                    showResult(enrollStudent(*student, *course, message), message);
+                }
+            } else if (!courseIds.empty()) {
+                EnrollmentResult result;
+                bool ok = enrollStudentInCourses(*student, courseIds.data(), courseIds.size(), result);
+                if (ok) std::cout << "\n✅ Enrolled in all " << courseIds.size() << " courses\n";
+                else std::cout << "\n❌ No seats taken: every course must be available\n";
+                for (size_t i = 0; i < courseIds.size(); ++i) {
+                    std::cout << "   Course " << courseIds[i] << ": " << EnrollmentResult::outcomeName(result.outcomes[i]) << "\n";
+                }
+            }
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void unenrollStudentFromCourse() {
+        clearScreen();
+        showTitle("📤 UNENROLL FROM COURSE");
+        Student* student = promptForStudent();
+        Course* course = student ? promptForCourse() : nullptr;
+        if (course) {
+            std::string message;
+            showResult(unenrollStudent(*student, *course, message), message);
         }
+        SafeInput::waitForEnter();
+    }
+    
+    void assignTeacherToCourse() {
+        clearScreen();
+        showTitle("📚 ASSIGN TO COURSE");
+        Teacher* teacher = promptForTeacher();
+        Course* course = teacher ? promptForCourse() : nullptr;
+        if (course) {
+            std::string message;
+            showResult(assignTeacher(*teacher, *course, message), message);
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void unassignTeacherFromCourse() {
+        clearScreen();
+        showTitle("📤 UNASSIGN FROM COURSE");
+        Teacher* teacher = promptForTeacher();
+        Course* course = teacher ? promptForCourse() : nullptr;
+        if (course) {
+            std::string message;
+            showResult(unassignTeacher(*teacher, *course, message), message);
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void generateStudentReport() {
+        clearScreen();
+        showTitle("📊 STUDENT REPORT");
+        if (Student* student = promptForStudent()) {
+            student->displayInfo();
+            std::cout << "\n📚 Enrolled Courses:\n";
+            int credits = 0;
+            for (int courseId : student->getEnrolledCourses()) {
+                Course* course = findCourseById(courseId);
+                if (course) credits += course->getCredits();
+                std::cout << "   " << std::setw(5) << courseId << " | " << std::setw(25) << (course ? course->getName() : "(unknown course)")
+                          << " | Attendance: " << std::fixed << std::setprecision(1) << student->getAttendancePercentage(courseId) << "%\n";
+            }
+            std::cout << "\nTotal Credits: " << credits << "\n";
+            std::cout << "Average Attendance: " << std::fixed << std::setprecision(1) << averageAttendance(*student) << "%\n";
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void generateTeacherReport() {
+        clearScreen();
+        showTitle("📊 TEACHER REPORT");
+        if (Teacher* teacher = promptForTeacher()) {
+            teacher->displayInfo();
+            std::cout << "\n📚 Assigned Courses:\n";
+            int studentsTaught = 0;
+            for (int courseId : teacher->getAssignedCourses()) {
+                Course* course = findCourseById(courseId);
+                if (!course) continue;
+                studentsTaught += course->getCurrentEnrollment();
+                std::cout << "   " << std::setw(5) << courseId << " | " << std::setw(25) << course->getName() << " | "
+                          << course->getCurrentEnrollment() << "/" << course->getMaxStudents() << " students\n";
+            }
+            std::cout << "\nTotal Students Taught: " << studentsTaught << "\n";
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void viewCourseEnrollments() {
+        clearScreen();
+        showTitle("👥 COURSE ENROLLMENTS");
+        if (Course* course = promptForCourse()) {
+            std::cout << "\n" << course->getName() << ": " << course->getCurrentEnrollment() << "/"
+                      << course->getMaxStudents() << " students\n\n";
+            for (int studentId : course->getEnrolledStudents()) {
+                if (Student* student = findStudentById(studentId)) student->displaySummary();
+            }
+            const Waitlist& waitlist = course->getWaitlist();
+            if (!waitlist.empty()) {
+                std::cout << "\n⏳ Waitlist: " << waitlist.size() << " students, next in line:\n";
+                for (const auto& entry : waitlist.ordered(10)) {
+                    std::cout << "   " << entry.studentId << " (priority " << entry.priority << ")\n";
+                }
+            }
+        }
+        SafeInput::waitForEnter();
+    }
+    
+    void courseManagement() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "📚 COURSE MANAGEMENT\n";
+            std::cout << "====================\n\n";
+    
+            std::cout << "Current Courses: " << courses.size() << "\n\n";
+    
+            std::cout << "1. ➕ Add New Course\n";
+            std::cout << "2. 📋 View All Courses\n";
+            std::cout << "3. 🔍 Search Course\n";
+            std::cout << "4. ✏️  Edit Course\n";
+            std::cout << "5. ❌ Deactivate Course\n";
+            std::cout << "6. ✅ Reactivate Course\n";
+            std::cout << "7. 👥 View Enrollments\n";
+            std::cout << "8. 📊 Course Statistics\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n\n";
+    
+            choice = SafeInput::getInt("Enter your choice (0-8): ", 0, 8);
+    
+            switch (choice) {
+                case 1: addCourse(); break;
+                case 2: viewAllCourses(); break;
+                case 3: searchCourse(); break;
+                case 4: editCourse(); break;
+                case 5: deactivateCourse(); break;
+                case 6: reactivateCourse(); break;
+                case 7: viewCourseEnrollments(); break;
+                case 8: generateCourseStatistics(); break;
+                case 0: break;
+            }
+        } while (choice != 0);
+    }
+    
+    void classroomManagement() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "🏫 CLASSROOM MANAGEMENT\n";
+            std::cout << "=======================\n\n";
+    
+            std::cout << "Current Classrooms: " << classrooms.size() << "\n\n";
+    
+            std::cout << "1. ➕ Add New Classroom\n";
+            std::cout << "2. 📋 View All Classrooms\n";
+            std::cout << "3. 🔍 Search Classroom\n";
+            std::cout << "4. ✏️  Edit Classroom\n";
+            std::cout << "5. 🚫 Mark Unavailable\n";
+            std::cout << "6. ✅ Mark Available\n";
+            std::cout << "7. 📅 Manage Schedule\n";
+            std::cout << "8. 📊 Utilization Report\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n\n";
+    
+            choice = SafeInput::getInt("Enter your choice (0-8): ", 0, 8);
+    
+            switch (choice) {
+                case 1: addClassroom(); break;
+                case 2: viewAllClassrooms(); break;
+                case 3: searchClassroom(); break;
+                case 4: editClassroom(); break;
+                case 5: markClassroomUnavailable(); break;
+                case 6: markClassroomAvailable(); break;
+                case 7: manageClassroomSchedule(); break;
+                case 8: generateClassroomUtilizationReport(); break;
+                case 0: break;
+            }
+        } while (choice != 0);
+    }
+    
+    void reportsAndAnalytics() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "📊 REPORTS & ANALYTICS\n";
+            std::cout << "======================\n\n";
+    
+            std::cout << "1. 📈 System Overview\n";
+            std::cout << "2. 👨‍🎓 Student Analytics\n";
+            std::cout << "3. 👩‍🏫 Teacher Analytics\n";
+            std::cout << "4. 📚 Course Analytics\n";
+            std::cout << "5. 💰 Financial Summary\n";
+            std::cout << "6. 📅 Enrollment Trends\n";
+            std::cout << "7. 🛠️  Custom Report\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n\n";
+    
+            choice = SafeInput::getInt("Enter your choice (0-7): ", 0, 7);
+    
+            switch (choice) {
+                case 1: generateSystemOverviewReport(); break;
+                case 2: generateStudentAnalytics(); break;
+                case 3: generateTeacherAnalytics(); break;
+                case 4: generateCourseAnalytics(); break;
+                case 5: generateFinancialSummary(); break;
+                case 6: generateEnrollmentTrends(); break;
+                case 7: generateCustomReport(); break;
+                case 0: break;
+            }
+        } while (choice != 0);
+    }
+    
+    void dataManagement() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "🔄 DATA MANAGEMENT\n";
+            std::cout << "==================\n\n";
+    
+            displaySystemStatus();
+            std::cout << "\n";
+    
+            std::cout << "1. 📤 Export Data\n";
+            std::cout << "2. 📥 Import from CSV\n";
+            std::cout << "3. 📥 Import from JSON Lines\n";
+            std::cout << "4. 💾 Save All Data\n";
+            std::cout << "5. 📂 Reload All Data\n";
+            std::cout << "6. 🔄 Restore Backup\n";
+            std::cout << "7. 🧹 Data Cleanup\n";
+            std::cout << "8. 🔎 Data Integrity Check\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n\n";
+    
+            choice = SafeInput::getInt("Enter your choice (0-8): ", 0, 8);
+    
+            switch (choice) {
+                case 1: exportData(); break;
+                case 2: importFromCSV(); break;
+                case 3: importFromJsonLines(); break;
+                case 4: saveAllData(); std::cout << "✅ Save queued.\n"; SafeInput::waitForEnter(); break;
+                case 5: reloadAllData(); SafeInput::waitForEnter(); break;
+                case 6: restoreBackup(); break;
+                case 7: performDataCleanup(); break;
+                case 8: performDataIntegrityCheck(); break;
+                case 0: break;
+            }
+        } while (choice != 0);
+    }
+    
+    void quickActions() {
+        clearScreen();
+        std::cout << "🎯 QUICK ACTIONS\n";
+        std::cout << "================\n\n";
+    
+        std::cout << "1. 👤 Student Search\n";
+        std::cout << "2. 📚 Course Lookup\n";
+        std::cout << "3. 👩‍🏫 Teacher Lookup\n";
+        std::cout << "4. ➕ Enroll Student\n";
+        std::cout << "5. 📅 Today's Summary\n";
+        std::cout << "6. 🩺 System Health Check\n";
+        std::cout << "0. ⬅️  Back to Main Menu\n\n";
+    
+        switch (SafeInput::getInt("Enter your choice (0-6): ", 0, 6)) {
+            case 1: quickStudentSearch(); break;
+            case 2: quickCourseLookup(); break;
+            case 3: quickTeacherSearch(); break;
+            case 4: quickStudentEnrollment(); break;
+            case 5: generateTodaysSummary(); break;
+            case 6: performSystemHealthCheck(); break;
+        }
+    }
+    
+    void systemSettings() {
+        int choice;
+        do {
+            clearScreen();
+            std::cout << "⚙️  SYSTEM SETTINGS\n";
+            std::cout << "==================\n\n";
+    
+            std::cout << "1. 🔧 Configuration\n";
+            std::cout << "2. 📁 File Paths\n";
+            std::cout << "3. 🖥️  Display Preferences\n";
+            std::cout << "4. 🔒 Security\n";
+            std::cout << "5. ⚡ Performance\n";
+            std::cout << "6. ♻️  Reset to Defaults\n";
+            std::cout << "7. 👁️  View Current Settings\n";
+            std::cout << "8. 💾 Save Settings\n";
+            std::cout << "0. ⬅️  Back to Main Menu\n\n";
+    
+            choice = SafeInput::getInt("Enter your choice (0-8): ", 0, 8);
+    
+            switch (choice) {
+                case 1: configurationSettings(); break;
+                case 2: filePathSettings(); break;
+                case 3: displayPreferences(); break;
+                case 4: securitySettings(); break;
+                case 5: performanceSettings(); break;
+                case 6: resetToDefaults(); break;
+                case 7: viewCurrentSettings(); break;
+                case 8: saveSettings(); break;
+                case 0: break;
+            }
+        } while (choice != 0);
+    }
+    
+    void helpAndAbout() {
+        clearScreen();
+        std::cout << "ℹ️  HELP & ABOUT\n";
+        std::cout << "===============\n\n";
+        std::cout << "Industrial School Management System v3.0\n\n";
+        std::cout << "Data files: " << STUDENTS_FILE << ", " << TEACHERS_FILE << ", "
+                  << COURSES_FILE << ", " << CLASSROOMS_FILE << "\n";
+        std::cout << "Everything is saved on exit, with a backup in " << BACKUP_DIR
+                  << " unless config.txt sets backup_enabled=false\n\n";
+        std::cout << "📜 Batch mode (no menus, JSON Lines results on stdout):\n";
+        std::cout << "   IndustrialSchoolSystem --batch commands.csv [--output results.jsonl] [--dry-run]\n\n";
+        std::cout << "   One command per line, e.g.\n";
+        size_t count = 0;
+        const BatchCommand* commands = batchCommands(count);
+        for (size_t i = 0; i < count; ++i) std::cout << "     " << commands[i].usage << "\n";
+#ifdef __linux__
+        std::cout << "\n🔌 Daemon mode (model stays loaded, requests over a Unix socket):\n";
+        std::cout << "   IndustrialSchoolSystem --serve /tmp/school.sock [--workers N]\n";
+        std::cout << "   Lookups, name searches, enrollments and reports; stop with Ctrl+C to save.\n";
+#endif
+        SafeInput::waitForEnter();
+    }
+    
+    // Placeholder implementations for remaining functions
+    void generateCourseStatistics() { std::cout << "Course statistics functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    
+    void generateStudentAnalytics() { std::cout << "Student analytics functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void generateTeacherAnalytics() { std::cout << "Teacher analytics functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void generateCourseAnalytics() { std::cout << "Course analytics functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void generateFinancialSummary() { std::cout << "Financial summary functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void generateEnrollmentTrends() { std::cout << "Enrollment trends functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void generateCustomReport() { std::cout << "Custom report functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void exportData() {
+        std::cout << "\n📤 EXPORT DATA\n";
+        std::cout << "==============\n";
+        std::cout << "1. CSV\n";
+        std::cout << "2. JSON Lines\n";
+        std::cout << "3. CSV and JSON Lines\n";
+        std::cout << "4. Columnar (.smcol, for analytics)\n";
+        std::cout << "0. Cancel\n";
+        
+        int choice = SafeInput::getInt("Select format: ", 0, 4);
+        if (choice == 0) return;
+        std::vector<RecordWriter::Format> formats;
+        if (choice == 1 || choice == 3) formats.push_back(RecordWriter::Csv);
+        if (choice == 2 || choice == 3) formats.push_back(RecordWriter::JsonLines);
         
+        std::string directory = SafeInput::getString("Output directory (blank for " + EXPORT_DIR + "): ", false, 255);
+        if (directory.empty()) directory = EXPORT_DIR;
+        if (directory.back() != '/') directory += '/';
+        startExport(directory, formats, choice == 4);
         SafeInput::waitForEnter();
     }
     
-    void searchCourse() {
-        clearScreen();
-        std::cout << "🔍 SEARCH COURSE\n";
-        std::cout << "================\n\n";
-        
-        std::string searchTerm = SafeInput::getString("Enter course name to search: ");
-        std::vector<Course*> results;
+    void reloadAllData() { persistence.drain(); loadAllData(); }
+    void restoreBackup() { std::cout << "Backup restoration functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    void exportToCSV() {
+        startExport(EXPORT_DIR, {RecordWriter::Csv});
+        SafeInput::waitForEnter();
+    }
+    
+    // Hands the current snapshot to a background writer, so the session can
+    // keep editing while the files are produced
+    void startExport(const std::string& directory, const std::vector<RecordWriter::Format>& formats, bool columnar = false) {
+        if (exportRunning) std::cout << "⏳ Waiting for the previous export to finish...\n";
+        waitForExport();
         
-        for (auto& course : courses) {
-            std::string name = course.getName();
-            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-            std::transform(searchTerm.begin(), searchTerm.end(), searchTerm.begin(), ::tolower);
-            
-            if (name.find(searchTerm) != std::string::npos) {
-                results.push_back(&course);
-            }
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec) {
+            std::cout << "❌ Cannot create export directory " << directory << ": " << ec.message() << "\n";
+            return;
         }
         
-        if (results.empty()) {
-            std::cout << "No courses found matching: " << searchTerm << "\n";
-        } else {
-            std::cout << "Found " << results.size() << " course(s):\n\n";
-            for (auto* course : results) {
-                course->displayInfo();
-                std::cout << "\n";
+        std::shared_ptr<const ModelSnapshot> snapshot = modelSnapshot();
+        exportRunning = true;
+        exportThread = std::thread([this, snapshot, directory, formats, columnar]() {
+            std::unique_ptr<ExportStats> stats(new ExportStats(DataExporter::exportAll(*snapshot, directory, formats)));
+            if (columnar) {
+                ExportStats tables = ColumnarExporter::exportAll(*snapshot, directory);
+                stats->files.insert(stats->files.end(), tables.files.begin(), tables.files.end());
+                stats->seconds += tables.seconds;
+                stats->threads = std::max(stats->threads, tables.threads);
             }
-        }
-        
+            std::lock_guard<std::mutex> lock(exportMutex);
+            lastExport = std::move(stats);
+            exportRunning = false;
+        });
+        std::cout << "📤 Exporting to " << directory << " in the background; the status line shows the result.\n";
+    }
+    
+    void waitForExport() {
+        if (exportThread.joinable()) exportThread.join();
+    }
+    void exportToJsonLines() {
+        startExport(EXPORT_DIR, {RecordWriter::JsonLines});
         SafeInput::waitForEnter();
     }
     
-    // Reports and Analytics Functions
-    void generateSystemOverviewReport() {
-        clearScreen();
-        std::cout << "📈 SYSTEM OVERVIEW REPORT\n";
-        std::cout << "=========================\n\n";
-        
-        std::cout << "📊 SYSTEM STATISTICS\n";
-        std::cout << "====================\n";
-        std::cout << "Total Students: " << students.size() << "\n";
-        std::cout << "Active Students: " << countActiveStudents() << "\n";
-        std::cout << "Total Teachers: " << teachers.size() << "\n";
-        std::cout << "Active Teachers: " << countActiveTeachers() << "\n";
-        std::cout << "Total Courses: " << courses.size() << "\n";
-        std::cout << "Active Courses: " << std::count_if(courses.begin(), courses.end(),
-            [](const Course& c) { return c.getIsActive(); }) << "\n";
-        std::cout << "Total Classrooms: " << classrooms.size() << "\n\n";
+    void exportToColumnar() {
+        startExport(EXPORT_DIR, {}, true);
+        SafeInput::waitForEnter();
+    }
+    
+    void importFromCSV() { importRecords(false); }
+    void importFromJsonLines() { importRecords(true); }
+    
+    void importRecords(bool jsonLines) {
+        std::cout << (jsonLines ? "\n📥 IMPORT FROM JSON LINES\n" : "\n📥 IMPORT FROM CSV\n");
+        std::cout << "=========================\n";
+        std::cout << "1. Students\n";
+        std::cout << "2. Teachers\n";
+        std::cout << "3. Courses\n";
+        std::cout << "4. Classrooms\n";
+        std::cout << "0. Cancel\n";
         
-        // Enrollment statistics
-        int totalEnrollments = 0;
-        double totalRevenue = 0.0;
+        int choice = SafeInput::getInt("Select record type: ", 0, 4);
+        if (choice == 0) return;
+        std::string filename = SafeInput::getString(jsonLines ? "JSON Lines file path: " : "CSV file path: ", true, 255);
         
-        for (const auto& course : courses) {
-            totalEnrollments += course.getCurrentEnrollment();
-            totalRevenue += course.getCurrentEnrollment() * course.getFee();
+        CsvImportStats stats;
+        switch (choice) {
+            case 1: stats = importFile<StudentCsvFormat>(filename, students, jsonLines); break;
+            case 2: stats = importFile<TeacherCsvFormat>(filename, teachers, jsonLines); break;
+            case 3: stats = importFile<CourseCsvFormat>(filename, courses, jsonLines); break;
+            case 4: stats = importFile<ClassroomCsvFormat>(filename, classrooms, jsonLines); break;
         }
-        
-        std::cout << "📚 ENROLLMENT STATISTICS\n";
-        std::cout << "========================\n";
-        std::cout << "Total Enrollments: " << totalEnrollments << "\n";
-        std::cout << "Total Revenue: $" << std::fixed << std::setprecision(2) << totalRevenue << "\n";
-        std::cout << "Average Enrollments per Course: " << 
-            (courses.empty() ? 0.0 : static_cast<double>(totalEnrollments) / courses.size()) << "\n\n";
-        
-        std::cout << "📅 Report Generated: " << getCurrentDate() << "\n";
+        touchModel();
+        stats.display();
         SafeInput::waitForEnter();
     }
     
-    // Quick Action Functions
-    void quickStudentSearch() {
-        clearScreen();
-        std::cout << "👤 QUICK STUDENT SEARCH\n";
-        std::cout << "=======================\n\n";
-        
-        std::string searchTerm = SafeInput::getString("Enter student name: ");
-        auto results = searchStudentsByName(searchTerm);
-        
-        if (results.empty()) {
-            std::cout << "❌ No students found.\n";
-        } else {
-            std::cout << "✅ Found " << results.size() << " student(s):\n\n";
-            for (auto* student : results) {
-                std::cout << "ID: " << student->getId() << ", Name: " << student->getName() 
-                         << ", Status: " << (student->getIsActive() ? "Active" : "Inactive") << "\n";
+    template <typename Format>
+    static CsvImportStats importFile(const std::string& filename, std::vector<typename Format::Record>& records, bool jsonLines) {
+        return jsonLines ? CsvImporter::importJsonLinesFile<Format>(filename, records)
+                         : CsvImporter::importFile<Format>(filename, records);
+    }
+    
+    // Batch mode commands. Handlers get the fields after the command (and
+    // target) name, already trimmed, and report the outcome in message.
+    typedef bool (IndustrialSchoolManagementSystem::*BatchHandler)(const std::string* args, size_t count, std::string& message);
+    
+    struct BatchCommand {
+        const char* name;
+        const char* target; // second field ("student", "summary"), or nullptr
+        size_t minArgs;
+        size_t maxArgs;
+        BatchHandler handler;
+        const char* usage;
+    };
+    
+    struct BatchTotals {
+        size_t count = 0;
+        size_t failed = 0;
+        double micros = 0.0;
+    };
+    
+    static const BatchCommand* batchCommands(size_t& count) {
+        typedef IndustrialSchoolManagementSystem S;
+        static const BatchCommand commands[] = {
+            {"add", "student", 3, 6, &S::batchAddStudent, "add,student,id,name,age[,email,phone,address]"},
+            {"add", "teacher", 3, 7, &S::batchAddTeacher, "add,teacher,id,name,subject[,email,phone,department,salary]"},
+            {"add", "course", 2, 6, &S::batchAddCourse, "add,course,id,name[,description,credits,max_students,fee]"},
+            {"add", "classroom", 3, 5, &S::batchAddClassroom, "add,classroom,id,location,capacity[,building,equipment]"},
+            {"edit", "student", 3, 3, &S::batchEditStudent, "edit,student,id,field,value"},
+            {"edit", "teacher", 3, 3, &S::batchEditTeacher, "edit,teacher,id,field,value"},
+            {"edit", "course", 3, 3, &S::batchEditCourse, "edit,course,id,field,value"},
+            {"deactivate", "student", 1, 1, &S::batchDeactivateStudent, "deactivate,student,id"},
+            {"deactivate", "teacher", 1, 1, &S::batchDeactivateTeacher, "deactivate,teacher,id"},
+            {"deactivate", "course", 1, 1, &S::batchDeactivateCourse, "deactivate,course,id"},
+            {"reactivate", "student", 1, 1, &S::batchReactivateStudent, "reactivate,student,id"},
+            {"reactivate", "teacher", 1, 1, &S::batchReactivateTeacher, "reactivate,teacher,id"},
+            {"reactivate", "course", 1, 1, &S::batchReactivateCourse, "reactivate,course,id"},
+            {"enroll", nullptr, 2, 17, &S::batchEnroll, "enroll,student_id,course_id[,course_id...] (several: all or nothing)"},
+            {"unenroll", nullptr, 2, 2, &S::batchUnenroll, "unenroll,student_id,course_id"},
+            {"waitlist", nullptr, 2, 3, &S::batchWaitlist, "waitlist,student_id,course_id[,priority]"},
+            {"unwaitlist", nullptr, 2, 2, &S::batchUnwaitlist, "unwaitlist,student_id,course_id"},
+            {"burst", nullptr, 1, 2, &S::batchBurst, "burst,requests.csv[,threads] (lines: student_id,course_id[,...])"},
+            {"assign", nullptr, 2, 2, &S::batchAssign, "assign,teacher_id,course_id"},
+            {"unassign", nullptr, 2, 2, &S::batchUnassign, "unassign,teacher_id,course_id"},
+            {"attendance", nullptr, 3, 3, &S::batchAttendance, "attendance,student_id,course_id,present|absent"},
+            {"report", "summary", 0, 0, &S::batchReportSummary, "report,summary"},
+            {"report", "student", 1, 1, &S::batchReportStudent, "report,student,id"},
+            {"report", "teacher", 1, 1, &S::batchReportTeacher, "report,teacher,id"},
+            {"report", "course", 1, 1, &S::batchReportCourse, "report,course,id"},
+            {"report", "waitlist", 1, 1, &S::batchReportWaitlist, "report,waitlist,course_id"},
+            {"report", "edits", 0, 0, &S::batchReportEdits, "report,edits"},
+            {"save", nullptr, 0, 0, &S::batchSave, "save"}
+        };
+        count = sizeof(commands) / sizeof(commands[0]);
+        return commands;
+    }
+    
+    static const BatchCommand* findBatchCommand(const BatchCommand* table, size_t count, const std::vector<std::string>& fields) {
+        for (size_t i = 0; i < count; ++i) {
+            if (fields[0] != table[i].name) continue;
+            if (!table[i].target || (fields.size() > 1 && fields[1] == table[i].target)) return &table[i];
+        }
+        return nullptr;
+    }
+    
+    // Resolves an ID argument through one of the find*ById lookups
+    template <typename Record>
+    Record* lookup(Record* (IndustrialSchoolManagementSystem::*find)(int), const std::string& idText,
+                   const char* entity, std::string& message) {
+        int id = 0;
+        Record* record = parseInt(idText, id) ? (this->*find)(id) : nullptr;
+        if (!record) message = std::string(entity) + " " + idText + " not found";
+        return record;
+    }
+    
+    // New records take the import field order and pass the same checks
+    template <typename Format>
+    bool addRecord(std::vector<typename Format::Record>& records, IdIndex& index,
+                   const std::string* args, size_t count, std::string& message) {
+        std::string fields[Format::FieldCount];
+        bool mapped[Format::FieldCount];
+        for (int field = 0; field < Format::FieldCount; ++field) {
+            mapped[field] = static_cast<size_t>(field) < count;
+            if (mapped[field]) fields[field] = args[field];
+        }
+        CsvImportRow row = {fields, mapped};
+        int id = 0;
+        const char* error = nullptr;
+        if (!parseInt(args[0], id) || !InputValidator::isValidId(id)) error = "invalid id";
+        else if (index.find(records, id)) error = "duplicate id";
+        else error = checkNewRecord<Format>(row);
+        if (error) {
+            message = std::string(Format::entityName()) + " record " + args[0] + ": " + error;
+            return false;
+        }
+        records.push_back(Format::create(row, id));
+        touchModel();
+        message = "added " + args[0] + " to " + Format::entityName();
+        return true;
+    }
+    
+    template <typename Format>
+    static const char* checkNewRecord(const CsvImportRow& row) {
+        int age = 0;
+        if (Format::NameField >= 0 && !InputValidator::isValidName(row[Format::NameField])) return "invalid name";
+        if (Format::AgeField >= 0 && (!row.getInt(Format::AgeField, 0, age) || !InputValidator::isValidAge(age))) return "invalid age";
+        if (Format::EmailField >= 0 && !InputValidator::isValidEmail(row[Format::EmailField])) return "invalid email";
+        if (Format::PhoneField >= 0 && !InputValidator::isValidPhone(row[Format::PhoneField])) return "invalid phone";
+        return Format::checkRow(row);
+    }
+    
+    bool batchAddStudent(const std::string* args, size_t count, std::string& message) {
+        return addRecord<StudentCsvFormat>(students, studentIndex, args, count, message);
+    }
+    
+    bool batchAddTeacher(const std::string* args, size_t count, std::string& message) {
+        return addRecord<TeacherCsvFormat>(teachers, teacherIndex, args, count, message);
+    }
+    
+    bool batchAddCourse(const std::string* args, size_t count, std::string& message) {
+        return addRecord<CourseCsvFormat>(courses, courseIndex, args, count, message);
+    }
+    
+    bool batchAddClassroom(const std::string* args, size_t count, std::string& message) {
+        return addRecord<ClassroomCsvFormat>(classrooms, classroomIndex, args, count, message);
+    }
+    
+    bool batchEditStudent(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        return student && editStudentField(*student, fieldNamed<StudentCsvFormat>(args[1]), args[2], 0, message) == EditOutcome::Committed;
+    }
+    
+    bool batchEditTeacher(const std::string* args, size_t, std::string& message) {
+        Teacher* teacher = lookup(&IndustrialSchoolManagementSystem::findTeacherById, args[0], "teacher", message);
+        return teacher && editTeacherField(*teacher, fieldNamed<TeacherCsvFormat>(args[1]), args[2], 0, message) == EditOutcome::Committed;
+    }
+    
+    bool batchEditCourse(const std::string* args, size_t, std::string& message) {
+        Course* course = lookup(&IndustrialSchoolManagementSystem::findCourseById, args[0], "course", message);
+        return course && editCourseField(*course, fieldNamed<CourseCsvFormat>(args[1]), args[2], 0, message) == EditOutcome::Committed;
+    }
+    
+    bool batchDeactivateStudent(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        return student && setActive(*student, false, "student", message);
+    }
+    
+    bool batchDeactivateTeacher(const std::string* args, size_t, std::string& message) {
+        Teacher* teacher = lookup(&IndustrialSchoolManagementSystem::findTeacherById, args[0], "teacher", message);
+        return teacher && setActive(*teacher, false, "teacher", message);
+    }
+    
+    bool batchDeactivateCourse(const std::string* args, size_t, std::string& message) {
+        Course* course = lookup(&IndustrialSchoolManagementSystem::findCourseById, args[0], "course", message);
+        return course && setActive(*course, false, "course", message);
+    }
+    
+    bool batchReactivateStudent(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        return student && setActive(*student, true, "student", message);
+    }
+    
+    bool batchReactivateTeacher(const std::string* args, size_t, std::string& message) {
+        Teacher* teacher = lookup(&IndustrialSchoolManagementSystem::findTeacherById, args[0], "teacher", message);
+        return teacher && setActive(*teacher, true, "teacher", message);
+    }
+    
+    bool batchReactivateCourse(const std::string* args, size_t, std::string& message) {
+        Course* course = lookup(&IndustrialSchoolManagementSystem::findCourseById, args[0], "course", message);
+        return course && setActive(*course, true, "course", message);
+    }
+    
+    bool batchEnroll(const std::string* args, size_t count, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        if (!student || count == 2) {
+            Course* course = student ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+            return course && enrollStudent(*student, *course, message);
+        }
+        std::vector<int> courseIds(count - 1);
+        for (size_t i = 1; i < count; ++i) {
+            if (!parseInt(args[i], courseIds[i - 1])) {
+                message = "course " + args[i] + " not found";
+                return false;
             }
         }
-        
-        SafeInput::waitForEnter();
+        EnrollmentResult result;
+        bool ok = enrollStudentInCourses(*student, courseIds.data(), courseIds.size(), result);
+        message = result.message;
+        return ok;
     }
     
-    void quickCourseLookup() {
-        clearScreen();
-        std::cout << "📚 QUICK COURSE LOOKUP\n";
-        std::cout << "======================\n\n";
-        
-        int id = SafeInput::getInt("Enter Course ID: ");
-        Course* course = findCourseById(id);
-        
-        if (course) {
-            course->displayInfo();
-        } else {
-            std::cout << "❌ Course not found.\n";
+    bool batchUnenroll(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        Course* course = student ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+        return course && unenrollStudent(*student, *course, message);
+    }
+    
+    bool batchWaitlist(const std::string* args, size_t count, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        Course* course = student ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+        int priority = 0;
+        if (course && count > 2 && !parseInt(args[2], priority)) {
+            message = "invalid priority '" + args[2] + "'";
+            return false;
         }
-        
-        SafeInput::waitForEnter();
+        return course && joinWaitlist(*student, *course, priority, message);
     }
     
-    void quickTeacherSearch() {
-        clearScreen();
-        std::cout << "👩‍🏫 QUICK TEACHER SEARCH\n";
-        std::cout << "=========================\n\n";
-        
-        int id = SafeInput::getInt("Enter Teacher ID: ");
-        Teacher* teacher = findTeacherById(id);
+    bool batchUnwaitlist(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        Course* course = student ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+        return course && leaveWaitlist(*student, *course, message);
+    }
+    
+    bool batchAssign(const std::string* args, size_t, std::string& message) {
+        Teacher* teacher = lookup(&IndustrialSchoolManagementSystem::findTeacherById, args[0], "teacher", message);
+        Course* course = teacher ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+        return course && assignTeacher(*teacher, *course, message);
+    }
+    
+    bool batchUnassign(const std::string* args, size_t, std::string& message) {
+        Teacher* teacher = lookup(&IndustrialSchoolManagementSystem::findTeacherById, args[0], "teacher", message);
+        Course* course = teacher ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+        return course && unassignTeacher(*teacher, *course, message);
+    }
+    
+    bool batchAttendance(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        Course* course = student ? lookup(&IndustrialSchoolManagementSystem::findCourseById, args[1], "course", message) : nullptr;
+        if (!course) return false;
+        if (args[2] != "present" && args[2] != "absent") {
+            message = "attendance must be 'present' or 'absent'";
+            return false;
+        }
+        if (!student->isEnrolledIn(course->getId())) {
+            message = "student " + args[0] + " is not enrolled in course " + args[1];
+            return false;
+        }
+        student->markAttendance(course->getId(), args[2] == "present");
+        touchModel();
+        message = "student " + args[0] + " marked " + args[2] + " in course " + args[1];
+        return true;
+    }
+    
+    // Reports are space-separated key=value pairs in the message field.
+    // The totals are summed in place under the shared lock, alongside
+    // enrollments, rather than from modelSnapshot(): a fresh snapshot copies
+    // every record under the exclusive lock, which is for exports and saves.
+    bool batchReportSummary(const std::string*, size_t, std::string& message) {
+        std::shared_lock<std::shared_mutex> lock(modelMutex);
+        message = ModelTotals::of(students, teachers, courses, classrooms, &courseLocks).describe();
+        return true;
+    }
+    
+    bool batchReportStudent(const std::string* args, size_t, std::string& message) {
+        Student* student = lookup(&IndustrialSchoolManagementSystem::findStudentById, args[0], "student", message);
+        if (!student) return false;
+        CourseSums sums = CourseSums::of(student->getEnrolledCourses(), [this](int id) { return findCourseById(id); }, &courseLocks);
+        message = studentReport(*student, sums);
+        return true;
+    }
+    
+    bool batchReportTeacher(const std::string* args, size_t, std::string& message) {
+        Teacher* teacher = lookup(&IndustrialSchoolManagementSystem::findTeacherById, args[0], "teacher", message);
+        if (!teacher) return false;
+        CourseSums sums = CourseSums::of(teacher->getAssignedCourses(), [this](int id) { return findCourseById(id); }, &courseLocks);
+        message = teacherReport(*teacher, sums);
+        return true;
+    }
+    
+    bool batchReportCourse(const std::string* args, size_t, std::string& message) {
+        Course* course = lookup(&IndustrialSchoolManagementSystem::findCourseById, args[0], "course", message);
+        if (!course) return false;
+        // Daemon enrollments take waitlisted students off, and daemon edits
+        // change the course, under its stripe
+        std::lock_guard<std::mutex> stripe(courseLocks.forId(course->getId()));
+        message = courseReport(*course);
+        return true;
+    }
+    
+    // Totals over a student's or teacher's courses; find returns null for
+    // courses that don't exist (or, in a shard, live elsewhere). With
+    // courseLocks, each course is read under its stripe, as daemon edits
+    // change credits and fees holding only that.
+    struct CourseSums {
+        int credits = 0;
+        double fees = 0.0;
+        int enrolled = 0;
         
-        if (teacher) {
-            teacher->displayInfo();
-        } else {
-            std::cout << "❌ Teacher not found.\n";
+        template <typename Find>
+        static CourseSums of(const std::vector<int>& courseIds, Find find, LockStripes* courseLocks = nullptr) {
+            CourseSums sums;
+            for (int courseId : courseIds) {
+                if (const Course* course = find(courseId)) {
+                    std::unique_lock<std::mutex> stripe;
+                    if (courseLocks) stripe = std::unique_lock<std::mutex>(courseLocks->forId(courseId));
+                    sums.credits += course->getCredits();
+                    sums.fees += course->getFee();
+                    sums.enrolled += course->getCurrentEnrollment();
+                }
+            }
+            return sums;
         }
         
-        SafeInput::waitForEnter();
+        void add(const CourseSums& other) {
+            credits += other.credits;
+            fees += other.fees;
+            enrolled += other.enrolled;
+        }
+    };
+    
+    static std::string studentReport(const Student& student, const CourseSums& courses) {
+        std::ostringstream report;
+        report << "student=" << student.getId() << " active=" << (student.getIsActive() ? "true" : "false")
+               << " courses=" << student.getEnrolledCourses().size() << " credits=" << courses.credits
+               << " attendance=" << std::fixed << std::setprecision(1) << averageAttendance(student)
+               << " fees=" << std::setprecision(2) << courses.fees;
+        return report.str();
     }
     
-    void quickStudentEnrollment() {
-        clearScreen();
-        std::cout << "➕ QUICK STUDENT ENROLLMENT\n";
-        std::cout << "===========================\n\n";
+    static std::string teacherReport(const Teacher& teacher, const CourseSums& courses) {
+        std::ostringstream report;
+        report << "teacher=" << teacher.getId() << " active=" << (teacher.getIsActive() ? "true" : "false")
+               << " courses=" << teacher.getAssignedCourses().size() << " students=" << courses.enrolled;
+        return report.str();
+    }
+    
+    static std::string courseReport(const Course& course) {
+        std::ostringstream report;
+        report << "course=" << course.getId() << " active=" << (course.getIsActive() ? "true" : "false")
+               << " enrolled=" << course.getCurrentEnrollment() << " max_students=" << course.getMaxStudents()
+               << " teacher=" << course.getAssignedTeacherId() << " revenue=" << std::fixed << std::setprecision(2)
+               << course.getCurrentEnrollment() * course.getFee() << " waitlisted=" << course.getWaitlist().size();
+        return report.str();
+    }
+    
+    // The first ten waiting students, in the order they would be promoted
+    bool batchReportWaitlist(const std::string* args, size_t, std::string& message) {
+        Course* course = lookup(&IndustrialSchoolManagementSystem::findCourseById, args[0], "course", message);
+        if (!course) return false;
+        std::ostringstream report;
+        std::vector<WaitlistEntry> next;
+        size_t waiting;
+        {
+            std::lock_guard<std::mutex> waitlist(courseLocks.forId(course->getId()));
+            waiting = course->getWaitlist().size();
+            next = course->getWaitlist().ordered(10);
+        }
+        report << "course=" << course->getId() << " waitlisted=" << waiting << " next=";
+        for (size_t i = 0; i < next.size(); ++i) report << (i ? "," : "") << next[i].studentId;
+        message = report.str();
+        return true;
+    }
+    
+    bool batchReportEdits(const std::string*, size_t, std::string& message) {
+        message = editMetrics.describe();
+        return true;
+    }
+    
+    // Registration-day burst: every line of the file is one all-or-nothing
+    // request, processed together on the work-stealing pool
+    bool batchBurst(const std::string* args, size_t count, std::string& message) {
+        int threads = 0;
+        std::string contents;
+        if (count > 1 && (!parseInt(args[1], threads) || threads < 0)) {
+            message = "invalid thread count '" + args[1] + "'";
+            return false;
+        }
+        if (!CsvReader::readFile(args[0], contents)) {
+            message = "cannot read " + args[0];
+            return false;
+        }
+        std::vector<EnrollmentRequest> requests;
+        std::vector<std::string> fields;
+        for (size_t pos = 0; pos < contents.size();) {
+            pos = CsvReader::parseRecord(contents.data(), contents.size(), pos, fields);
+            if (CsvReader::isBlankRecord(fields) || fields.size() < 2) continue;
+            EnrollmentRequest request;
+            bool valid = parseInt(fields[0], request.studentId);
+            request.courseIds.resize(fields.size() - 1);
+            for (size_t i = 1; i < fields.size() && valid; ++i) valid = parseInt(fields[i], request.courseIds[i - 1]);
+            if (valid) requests.push_back(std::move(request));
+        }
         
-        enrollStudentInCourse();
+        auto start = std::chrono::steady_clock::now();
+        std::vector<EnrollmentResult> results;
+        size_t committed = enrollStudentsInCourses(requests, results, static_cast<size_t>(threads));
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::ostringstream report;
+        report << "requests=" << requests.size() << " committed=" << committed
+               << " rejected=" << requests.size() - committed << " seconds=" << seconds
+               << " requests_per_second=" << std::fixed << std::setprecision(0)
+               << (seconds > 0.0 ? requests.size() / seconds : 0.0);
+        message = report.str();
+        return true;
     }
     
-    // Placeholder implementations for remaining functions
-    void editTeacher() { std::cout << "Teacher editing functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void deactivateTeacher() { std::cout << "Teacher deactivation functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void reactivateTeacher() { std::cout << "Teacher reactivation functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void assignTeacherToCourse() { std::cout << "Teacher assignment functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void unassignTeacherFromCourse() { std::cout << "Teacher unassignment functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateTeacherReport() { std::cout << "Teacher report functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    
-    void editCourse() { std::cout << "Course editing functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void deactivateCourse() { std::cout << "Course deactivation functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void reactivateCourse() { std::cout << "Course reactivation functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void viewCourseEnrollments() { std::cout << "Course enrollment view functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateCourseStatistics() { std::cout << "Course statistics functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    bool batchSave(const std::string*, size_t, std::string& message) {
+        if (batchDryRun) {
+            message = "skipped (dry run)";
+            return true;
+        }
+        OperationResult result = syncWait(tasks, saveAsync());
+        message = result.message;
+        return result.ok;
+    }
     
-    void generateStudentAnalytics() { std::cout << "Student analytics functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateTeacherAnalytics() { std::cout << "Teacher analytics functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateCourseAnalytics() { std::cout << "Course analytics functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateFinancialSummary() { std::cout << "Financial summary functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateEnrollmentTrends() { std::cout << "Enrollment trends functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void generateCustomReport() { std::cout << "Custom report functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void exportData() { std::cout << "Data export functionality coming soon...\n"; SafeInput::waitForEnter(); }
+    // Mean attendance over the student's courses that have sessions
+    static double averageAttendance(const Student& student) {
+        double total = 0.0;
+        size_t tracked = 0;
+        for (const auto& record : student.getAttendance()) {
+            if (record.second.getSessionCount() == 0) continue;
+            total += record.second.getPercentage();
+            tracked++;
+        }
+        return tracked ? total / tracked : 0.0;
+    }
     
-    void reloadAllData() { loadAllData(); }
-    void restoreBackup() { std::cout << "Backup restoration functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void exportToCSV() { std::cout << "CSV export functionality coming soon...\n"; SafeInput::waitForEnter(); }
-    void importFromCSV() { std::cout << "CSV import functionality coming soon...\n"; SafeInput::waitForEnter(); }
     void performDataCleanup() { std::cout << "Data cleanup functionality coming soon...\n"; SafeInput::waitForEnter(); }
     void performDataIntegrityCheck() { std::cout << "Data integrity check functionality coming soon...\n"; SafeInput::waitForEnter(); }
     
@@ -1117,9 +4684,175 @@ private:
     void saveSettings() { std::cout << "Save settings functionality coming soon...\n"; SafeInput::waitForEnter(); }
 };
 
+// Command-line options for main()
+struct CommandLine {
+    std::string batchFile;
+    std::string outputFile;
+    std::string socketPath;
+    bool dryRun = false;
+    size_t workers = 0;
+    bool help = false;
+};
+
+// False on --help or an argument it doesn't know (including an option
+// missing its value); the caller prints the usage
+static bool parseCommandLine(int argc, char* argv[], CommandLine& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--batch" && i + 1 < argc) options.batchFile = argv[++i];
+        else if (arg == "--output" && i + 1 < argc) options.outputFile = argv[++i];
+        else if (arg == "--dry-run") options.dryRun = true;
+#ifdef __linux__
+        else if (arg == "--serve" && i + 1 < argc) options.socketPath = argv[++i];
+        else if (arg == "--workers" && i + 1 < argc) options.workers = std::max(0, std::atoi(argv[++i]));
+#endif
+        else {
+            options.help = arg == "--help";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Serve mode's shard count, the shard_count setting read through Config:
+// 1 when unset. False, with the reason in error, unless it is a whole number
+// from 1 to MAX_SHARDS.
+static const long long MAX_SHARDS = 256;
+
+static bool shardCountSetting(const ConfigSnapshot& config, size_t& shards, std::string& error) {
+    const ConfigValue* value = config.find("shard_count");
+    shards = 1;
+    if (!value) return true;
+    if (!value->isNumber || value->number < 1 || value->number > MAX_SHARDS) {
+        error = "shard_count must be a whole number from 1 to " + std::to_string(MAX_SHARDS) + ", not '" + value->text + "'";
+        return false;
+    }
+    shards = static_cast<size_t>(value->number);
+    return true;
+}
+
+// tests/industrial builds this file with INDUSTRIAL_TESTS and its own main
+#ifndef INDUSTRIAL_TESTS
+
+// Batch mode: results go to stdout (or --output), so the load/save
+// messages the system prints are sent to stderr for the run
+static int runBatchMode(const std::string& commandFile, const std::string& outputFile, bool dryRun) {
+    OutputBuffer out;
+    if (outputFile.empty()) {
+        out.attach(stdout);
+    } else if (!out.open(outputFile)) {
+        std::cerr << "❌ Cannot write " << outputFile << "\n";
+        return 2;
+    }
+    
+    std::streambuf* console = std::cout.rdbuf(std::cerr.rdbuf());
+    size_t failed = 0;
+    bool loaded;
+    {
+        IndustrialSchoolManagementSystem system(false);
+        loaded = system.runBatch(commandFile, out, failed, dryRun);
+        system.setSaveOnExit(loaded && !dryRun);
+    }
+    std::cout.rdbuf(console);
+    
+    if (!loaded) {
+        std::cerr << "❌ Cannot read command file " << commandFile << "\n";
+        return 2;
+    }
+    if (!out.close()) {
+        std::cerr << "❌ Error writing batch results\n";
+        return 2;
+    }
+    return failed > 0 ? 1 : 0;
+}
+
+#ifdef __linux__
+// Daemon mode: keeps the model loaded and answers SchoolProtocol requests
+// on a Unix socket until SIGINT or SIGTERM, then saves like an interactive
+// session. The signals are blocked before any thread starts and collected
+// by a sigwait thread, so no handler runs inside the server. With
+// shard_count > 1 in config.txt the records are split across that many
+// shard threads (see startShards()) for as long as the daemon runs.
+static int runServeMode(const std::string& socketPath, size_t workers) {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    
+    Config* config = Config::getInstance();
+    size_t shards = 1;
+    std::string error;
+    if (!shardCountSetting(*config->snapshot(), shards, error)) {
+        std::cerr << "❌ config.txt: " << error << "\n";
+        return 2;
+    }
+    
+    IndustrialSchoolManagementSystem system(false);
+    if (shards > 1) {
+        system.startShards(shards);
+    } else {
+        system.syncIndexes();
+    }
+    UnixSocketServer server([&system](const char* request, size_t size, std::string& response) {
+        system.handleRequest(request, size, response);
+    }, workers);
+    if (!server.listen(socketPath, error)) {
+        std::cerr << "❌ " << error << "\n";
+        system.setSaveOnExit(false);
+        return 2;
+    }
+    
+    std::thread signalWaiter([&server, signals] {
+        int signal = 0;
+        sigwait(&signals, &signal);
+        server.stop();
+    });
+    std::cout << "🔌 Serving on " << socketPath << " with " << server.getWorkerCount() << " workers";
+    if (system.getShardCount() > 1) std::cout << " and " << system.getShardCount() << " shards";
+    std::cout << " (Ctrl+C to stop)\n";
+    server.run();
+    
+    // run() returns only after stop(), so the waiter has already finished
+    // and no request is still using the shards
+    signalWaiter.join();
+    system.stopShards();
+    std::cout << "👋 Served " << server.getRequestsServed() << " requests over "
+              << server.getConnectionsAccepted() << " connections\n";
+    return 0;
+}
+#endif
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << "                  interactive menus\n"
+              << "       " << program << " --batch FILE [--output FILE] [--dry-run]\n"
+#ifdef __linux__
+              << "       " << program << " --serve SOCKET [--workers N]\n"
+#endif
+              << "Batch mode runs the commands in FILE and prints one JSON Lines result per command;\n"
+              << "--dry-run skips saving. Exit status: 0 all succeeded, 1 some failed, 2 I/O error.\n"
+#ifdef __linux__
+              << "Serve mode answers lookup, search, enroll and report requests on a Unix socket\n"
+              << "(see include/SchoolProtocol.h) until SIGINT or SIGTERM, then saves.\n"
+#endif
+              ;
+}
+
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
+    CommandLine options;
+    if (!parseCommandLine(argc, argv, options)) {
+        printUsage(argv[0]);
+        return options.help ? 0 : 2;
+    }
+    
+    Config::getInstance()->loadFromFile("config.txt");
     try {
+        if (!options.batchFile.empty()) return runBatchMode(options.batchFile, options.outputFile, options.dryRun);
+#ifdef __linux__
+        if (!options.socketPath.empty()) return runServeMode(options.socketPath, options.workers);
+#endif
+        
         IndustrialSchoolManagementSystem system;
         system.run();
     } catch (const std::exception& e) {
@@ -1131,3 +4864,4 @@ int main() {
     
     return 0;
 }
+#endif // INDUSTRIAL_TESTS
@@ -7,14 +7,46 @@
 #include <fstream>
 #include <sstream>
 #include <unordered_map>
+#include <set>
+#include <tuple>
+#include <optional>
 #include <memory>
 #include <algorithm>
-#include <regex>
 #include <iomanip>
 #include <limits>
+#include <climits>
+#include <cstring>
+#include <charconv>
 #include <stdexcept>
 #include <chrono>
 #include <ctime>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include "include/BitUtils.h"
+#include "include/TextValidator.h"
+#include "include/TextNormalizer.h"
+#include "include/Parallel.h"
+#include "include/WorkStealingPool.h"
+#include "include/VersionedSnapshot.h"
+#include "include/Config.h"
+#include "include/OptimisticCommit.h"
+#include "include/ShardedStore.h"
+#include "include/AsyncFileWriter.h"
+#include "include/CoroutineTask.h"
+#include "include/CsvReader.h"
+#include "include/OutputBuffer.h"
+#include "include/JsonLinesReader.h"
+#include "include/ColumnarFile.h"
+#include "include/SchoolProtocol.h"
+#include "include/SeatReservation.h"
+#include "include/Waitlist.h"
+#ifdef __linux__
+#include "include/UnixSocketServer.h"
+#include <signal.h>
+#endif
 
 // Forward declarations
 class Course;
@@ -33,14 +65,12 @@ public:
     
     static bool isValidEmail(const std::string& email) {
         if (email.empty()) return true; // Optional field
-        std::regex emailPattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-        return std::regex_match(email, emailPattern);
+        return TextValidator::isEmail(email);
     }
     
     static bool isValidPhone(const std::string& phone) {
         if (phone.empty()) return true; // Optional field
-        std::regex phonePattern(R"(\+?[\d\s\-\(\)]{10,15})");
-        return std::regex_match(phone, phonePattern);
+        return TextValidator::isPhone(phone);
     }
     
     static bool isValidName(const std::string& name) {
@@ -51,15 +81,19 @@ public:
     }
     
     static std::string sanitizeString(const std::string& input) {
-        std::string result = input;
-        // Remove leading/trailing whitespace
-        result.erase(0, result.find_first_not_of(" \t\n\r"));
-        result.erase(result.find_last_not_of(" \t\n\r") + 1);
-        // Replace multiple spaces with single space
-        std::regex multipleSpaces("\\s+");
-        result = std::regex_replace(result, multipleSpaces, " ");
+        std::string result;
+        sanitizeInto(input, result);
         return result;
     }
+    
+    // Trims and collapses whitespace runs into out, reusing its buffer
+    static void sanitizeInto(const std::string& input, std::string& out) {
+        TextNormalizer::normalizeInto(input, out);
+    }
+    
+    static void sanitizeInPlace(std::string& value) {
+        TextNormalizer::normalizeInPlace(value);
+    }
 };
 
 // Safe input handling class
@@ -84,12 +118,31 @@ public:
         }
     }
     
+    static double getDouble(const std::string& prompt, double min = 0.0, double max = 1e9) {
+        double value;
+        while (true) {
+            std::cout << prompt;
+            if (std::cin >> value) {
+                if (value >= min && value <= max) {
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    return value;
+                } else {
+                    std::cout << "❌ Value must be between " << min << " and " << max << ". Try again.\n";
+                }
+            } else {
+                std::cout << "❌ Invalid input. Please enter a valid number.\n";
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            }
+        }
+    }
+    
     static std::string getString(const std::string& prompt, bool required = true, size_t maxLength = 100) {
         std::string value;
         while (true) {
             std::cout << prompt;
             std::getline(std::cin, value);
-            value = InputValidator::sanitizeString(value);
+            InputValidator::sanitizeInPlace(value);
             
             if (!required && value.empty()) {
                 return value;
@@ -129,6 +182,278 @@ public:
     }
 };
 
+// Candidate records laid out column by column for bulk validation. Columns
+// that a record type doesn't have (e.g. ages for teachers) are left empty.
+struct RecordColumns {
+    std::vector<int> ids;
+    std::vector<std::string> names;
+    std::vector<int> ages;
+    std::vector<std::string> emails;
+    std::vector<std::string> phones;
+    
+    size_t size() const { return ids.size(); }
+    
+    void reserve(size_t rows) {
+        ids.reserve(rows);
+        names.reserve(rows);
+        ages.reserve(rows);
+        emails.reserve(rows);
+        phones.reserve(rows);
+    }
+};
+
+// Runs the interactive InputValidator checks over whole columns in parallel
+// chunks, producing one error bitmask byte per row. Duplicate IDs within the
+// batch are found with a parallel LSD radix sort of (id, row) pairs; every
+// repeat after the first occurrence is flagged.
+class BatchValidator {
+public:
+    enum ErrorFlag : uint8_t {
+        InvalidId    = 1 << 0,
+        InvalidName  = 1 << 1,
+        InvalidAge   = 1 << 2,
+        InvalidEmail = 1 << 3,
+        InvalidPhone = 1 << 4,
+        DuplicateId  = 1 << 5
+    };
+    static const int FLAG_COUNT = 6;
+    
+    struct Report {
+        size_t rows = 0;
+        size_t validRows = 0;
+        size_t flagCounts[FLAG_COUNT] = {};
+        size_t threads = 0;
+        double seconds = 0.0;
+        std::vector<uint8_t> errors; // per-row bitmask, 0 when valid
+        
+        bool isValid(size_t row) const { return errors[row] == 0; }
+        double rowsPerSecond() const { return seconds > 0.0 ? rows / seconds : 0.0; }
+        
+        void display() const {
+            std::cout << "🔎 Batch validation: " << validRows << "/" << rows << " rows valid ("
+                      << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms, "
+                      << threads << " threads)\n";
+            for (int flag = 0; flag < FLAG_COUNT; ++flag) {
+                if (flagCounts[flag] > 0) {
+                    std::cout << "   ❌ " << std::setw(14) << std::left << flagName(flag) << std::right
+                              << flagCounts[flag] << "\n";
+                }
+            }
+        }
+    };
+    
+    static Report validate(const RecordColumns& columns, size_t threadCount = 0, size_t chunkRows = 16384) {
+        auto start = std::chrono::steady_clock::now();
+        Report report;
+        report.rows = columns.size();
+        report.threads = Parallel::threadCount(threadCount, (report.rows + chunkRows - 1) / chunkRows);
+        report.errors.assign(report.rows, 0);
+        
+        bool hasAges = columns.ages.size() == report.rows;
+        bool hasNames = columns.names.size() == report.rows;
+        bool hasEmails = columns.emails.size() == report.rows;
+        bool hasPhones = columns.phones.size() == report.rows;
+        uint8_t* errors = report.errors.data();
+        
+        size_t chunks = (report.rows + chunkRows - 1) / chunkRows;
+        Parallel::forEach(chunks, report.threads, [&](size_t chunk) {
+            size_t end = std::min(report.rows, (chunk + 1) * chunkRows);
+            for (size_t row = chunk * chunkRows; row < end; ++row) {
+                uint8_t mask = 0;
+                if (!InputValidator::isValidId(columns.ids[row])) mask |= InvalidId;
+                if (hasNames && !InputValidator::isValidName(columns.names[row])) mask |= InvalidName;
+                if (hasAges && !InputValidator::isValidAge(columns.ages[row])) mask |= InvalidAge;
+                if (hasEmails && !InputValidator::isValidEmail(columns.emails[row])) mask |= InvalidEmail;
+                if (hasPhones && !InputValidator::isValidPhone(columns.phones[row])) mask |= InvalidPhone;
+                errors[row] = mask;
+            }
+        });
+        
+        markDuplicateIds(columns.ids, report.errors, report.threads);
+        
+        for (uint8_t mask : report.errors) {
+            if (mask == 0) {
+                report.validRows++;
+                continue;
+            }
+            for (int flag = 0; flag < FLAG_COUNT; ++flag) {
+                report.flagCounts[flag] += (mask >> flag) & 1;
+            }
+        }
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+    
+    // Flags DuplicateId on every row whose ID already appeared earlier in the batch
+    static void markDuplicateIds(const std::vector<int>& ids, std::vector<uint8_t>& errors, size_t threadCount = 0) {
+        std::vector<uint64_t> keys(ids.size());
+        for (size_t row = 0; row < ids.size(); ++row) {
+            // Flip the sign bit so negative IDs sort below positive ones
+            uint32_t key = static_cast<uint32_t>(ids[row]) ^ 0x80000000u;
+            keys[row] = (static_cast<uint64_t>(key) << 32) | row;
+        }
+        radixSortByHighWord(keys, Parallel::threadCount(threadCount, (ids.size() + 65535) / 65536));
+        
+        for (size_t i = 1; i < keys.size(); ++i) {
+            if ((keys[i] >> 32) == (keys[i - 1] >> 32)) {
+                errors[static_cast<uint32_t>(keys[i])] |= DuplicateId;
+            }
+        }
+    }
+    
+    static std::string describe(uint8_t mask) {
+        std::string text;
+        for (int flag = 0; flag < FLAG_COUNT; ++flag) {
+            if (mask & (1 << flag)) {
+                if (!text.empty()) text += ", ";
+                text += flagName(flag);
+            }
+        }
+        return text.empty() ? "ok" : text;
+    }
+    
+    static const char* flagName(int flag) {
+        static const char* names[FLAG_COUNT] = {
+            "invalid id", "invalid name", "invalid age", "invalid email", "invalid phone", "duplicate id"
+        };
+        return flag >= 0 && flag < FLAG_COUNT ? names[flag] : "unknown";
+    }
+    
+private:
+    // Stable LSD radix sort on bits 32..63, one byte per pass. Each thread
+    // histograms and scatters its own contiguous slice, so output positions
+    // come from a (bucket, thread) prefix sum. Passes where every key shares
+    // the same byte are skipped, which removes most passes for 20-bit IDs.
+    static void radixSortByHighWord(std::vector<uint64_t>& keys, size_t threadCount) {
+        const size_t n = keys.size();
+        if (n < 2) return;
+        threadCount = std::max<size_t>(1, std::min(threadCount, n));
+        std::vector<uint64_t> buffer(n);
+        std::vector<size_t> counts(threadCount * 256);
+        size_t slice = (n + threadCount - 1) / threadCount;
+        
+        for (int shift = 32; shift < 64; shift += 8) {
+            std::fill(counts.begin(), counts.end(), 0);
+            Parallel::forEach(threadCount, threadCount, [&](size_t t) {
+                size_t* histogram = counts.data() + t * 256;
+                size_t end = std::min(n, (t + 1) * slice);
+                for (size_t i = t * slice; i < end; ++i) histogram[(keys[i] >> shift) & 0xFF]++;
+            });
+            
+            size_t offset = 0;
+            bool singleBucket = false;
+            for (size_t bucket = 0; bucket < 256; ++bucket) {
+                size_t bucketTotal = 0;
+                for (size_t t = 0; t < threadCount; ++t) {
+                    size_t count = counts[t * 256 + bucket];
+                    counts[t * 256 + bucket] = offset;
+                    offset += count;
+                    bucketTotal += count;
+                }
+                if (bucketTotal == n) singleBucket = true;
+            }
+            if (singleBucket) continue;
+            
+            Parallel::forEach(threadCount, threadCount, [&](size_t t) {
+                size_t* positions = counts.data() + t * 256;
+                size_t end = std::min(n, (t + 1) * slice);
+                for (size_t i = t * slice; i < end; ++i) buffer[positions[(keys[i] >> shift) & 0xFF]++] = keys[i];
+            });
+            keys.swap(buffer);
+        }
+    }
+};
+
+// Packed attendance for one (student, course) pair: one bit per session,
+// set when the student was present. Percentages come from popcount.
+class AttendanceBitset {
+private:
+    std::vector<uint64_t> words;
+    uint32_t sessionCount;
+    
+public:
+    AttendanceBitset() : sessionCount(0) {}
+    
+    void record(bool present) {
+        if (sessionCount % 64 == 0) {
+            words.push_back(0);
+        }
+        if (present) {
+            BitUtils::setBit(words.data(), sessionCount);
+        }
+        sessionCount++;
+    }
+    
+    bool wasPresent(uint32_t session) const {
+        return session < sessionCount && BitUtils::testBit(words.data(), session);
+    }
+    
+    uint32_t getSessionCount() const { return sessionCount; }
+    
+    uint32_t getPresentCount() const {
+        return static_cast<uint32_t>(BitUtils::popcountWords(words.data(), words.size()));
+    }
+    
+    double getPercentage() const {
+        if (sessionCount == 0) return 0.0;
+        return (static_cast<double>(getPresentCount()) / sessionCount) * 100.0;
+    }
+    
+    // Format: sessions:hexword,hexword,...
+    std::string serialize() const {
+        std::stringstream ss;
+        ss << sessionCount << ":" << std::hex;
+        for (size_t i = 0; i < words.size(); ++i) {
+            ss << words[i];
+            if (i < words.size() - 1) ss << ",";
+        }
+        return ss.str();
+    }
+    
+    // Returns false, leaving bitset untouched, when data isn't in the
+    // serialize() format, so a corrupt record costs only that course's history
+    static bool deserialize(const std::string& data, AttendanceBitset& bitset) {
+        const char* end = data.data() + data.size();
+        uint32_t sessions = 0;
+        auto parsed = std::from_chars(data.data(), end, sessions);
+        if (parsed.ec != std::errc() || parsed.ptr == end || *parsed.ptr != ':') return false;
+        
+        std::vector<uint64_t> words;
+        const char* cursor = parsed.ptr + 1;
+        while (cursor < end) {
+            if (words.size() == BitUtils::wordsFor(sessions)) return false;
+            uint64_t word = 0;
+            auto hex = std::from_chars(cursor, end, word, 16);
+            if (hex.ec != std::errc() || (hex.ptr != end && *hex.ptr != ',')) return false;
+            words.push_back(word);
+            cursor = hex.ptr == end ? end : hex.ptr + 1;
+        }
+        if (words.size() != BitUtils::wordsFor(sessions)) return false;
+        // Drop any stray bits past the last session so popcount stays exact
+        if (sessions % 64 != 0) {
+            words.back() &= (1ULL << (sessions % 64)) - 1;
+        }
+        bitset.words.swap(words);
+        bitset.sessionCount = sessions;
+        return true;
+    }
+};
+
+// Today as YYYY-MM-DD, formatted at most once per second per thread; bulk
+// imports create records far faster than that
+inline std::string currentDate() {
+    static thread_local std::time_t cachedTime = 0;
+    static thread_local std::string cachedDate;
+    auto time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (time_t != cachedTime || cachedDate.empty()) {
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d");
+        cachedDate = ss.str();
+        cachedTime = time_t;
+    }
+    return cachedDate;
+}
+
 // Enhanced Student class
 class Student {
 private:
@@ -140,14 +465,15 @@ private:
     std::string address;
     std::string enrollmentDate;
     std::vector<int> enrolledCourses;
-    std::unordered_map<std::string, std::vector<bool>> attendance; // Course -> attendance records
-    bool isActive;
+    std::vector<std::pair<int, AttendanceBitset>> attendance; // Course ID -> packed attendance
+    mutable bool isActive; // loaded and stored atomically, so readers need no lock
+    RecordVersion version; // bumped by each committed edit, see commitEdit()
     
 public:
     Student(int id, const std::string& name, int age, const std::string& email = "", 
             const std::string& phone = "", const std::string& address = "")
         : id(id), name(name), age(age), email(email), phone(phone), address(address), isActive(true) {
-        enrollmentDate = getCurrentDate();
+        enrollmentDate = currentDate();
     }
     
     // Getters
@@ -159,12 +485,15 @@ public:
     const std::string& getAddress() const { return address; }
     const std::string& getEnrollmentDate() const { return enrollmentDate; }
     const std::vector<int>& getEnrolledCourses() const { return enrolledCourses; }
-    bool getIsActive() const { return isActive; }
+    const std::vector<std::pair<int, AttendanceBitset>>& getAttendance() const { return attendance; }
+    bool getIsActive() const { return std::atomic_ref<bool>(isActive).load(std::memory_order_acquire); }
+    uint64_t getVersion() const { return version.load(); }
+    RecordVersion& getVersionStamp() { return version; }
     
     // Setters with validation
     bool setName(const std::string& newName) {
         if (InputValidator::isValidName(newName)) {
-            name = InputValidator::sanitizeString(newName);
+            InputValidator::sanitizeInto(newName, name);
             return true;
         }
         return false;
@@ -180,7 +509,7 @@ public:
     
     bool setEmail(const std::string& newEmail) {
         if (InputValidator::isValidEmail(newEmail)) {
-            email = InputValidator::sanitizeString(newEmail);
+            InputValidator::sanitizeInto(newEmail, email);
             return true;
         }
         return false;
@@ -188,17 +517,17 @@ public:
     
     bool setPhone(const std::string& newPhone) {
         if (InputValidator::isValidPhone(newPhone)) {
-            phone = InputValidator::sanitizeString(newPhone);
+            InputValidator::sanitizeInto(newPhone, phone);
             return true;
         }
         return false;
     }
     
     void setAddress(const std::string& newAddress) {
-        address = InputValidator::sanitizeString(newAddress);
+        InputValidator::sanitizeInto(newAddress, address);
     }
     
-    void setIsActive(bool active) { isActive = active; }
+    void setIsActive(bool active) { std::atomic_ref<bool>(isActive).store(active, std::memory_order_release); }
     
     // Course management
     bool enrollInCourse(int courseId) {
@@ -223,39 +552,48 @@ public:
     }
     
     // Attendance management
-    void markAttendance(const std::string& courseName, bool present) {
-        attendance[courseName].push_back(present);
+    void markAttendance(int courseId, bool present) {
+        for (auto& record : attendance) {
+            if (record.first == courseId) {
+                record.second.record(present);
+                return;
+            }
+        }
+        attendance.emplace_back(courseId, AttendanceBitset());
+        attendance.back().second.record(present);
     }
     
-    double getAttendancePercentage(const std::string& courseName) const {
-        auto it = attendance.find(courseName);
-        if (it == attendance.end() || it->second.empty()) return 0.0;
-        
-        int present = std::count(it->second.begin(), it->second.end(), true);
-        return (static_cast<double>(present) / it->second.size()) * 100.0;
+    const AttendanceBitset* getAttendanceRecord(int courseId) const {
+        for (const auto& record : attendance) {
+            if (record.first == courseId) return &record.second;
+        }
+        return nullptr;
     }
     
-    // File operations with error handling
-    bool saveToFile(const std::string& filename) const {
-        std::ofstream file(filename, std::ios::app);
-        if (!file.is_open()) {
-            std::cerr << "❌ Error: Cannot open file " << filename << " for writing.\n";
-            return false;
-        }
-        
+    double getAttendancePercentage(int courseId) const {
+        const AttendanceBitset* record = getAttendanceRecord(courseId);
+        return record ? record->getPercentage() : 0.0;
+    }
+    
+    // One line of the data file
+    void writeRecord(std::ostream& file) const {
         file << id << "|" << name << "|" << age << "|" << email << "|" 
              << phone << "|" << address << "|" << enrollmentDate << "|" 
-             << (isActive ? "1" : "0") << "|";
+             << (getIsActive() ? "1" : "0") << "|";
         
         // Save enrolled courses
         for (size_t i = 0; i < enrolledCourses.size(); ++i) {
             file << enrolledCourses[i];
             if (i < enrolledCourses.size() - 1) file << ",";
         }
-        file << "\n";
+        file << "|";
         
-        file.close();
-        return true;
+        // Save attendance as courseId=sessions:words;...
+        for (size_t i = 0; i < attendance.size(); ++i) {
+            file << attendance[i].first << "=" << attendance[i].second.serialize();
+            if (i < attendance.size() - 1) file << ";";
+        }
+        file << "\n";
     }
     
     static std::vector<Student> loadFromFile(const std::string& filename) {
@@ -292,6 +630,25 @@ public:
                         }
                     }
                     
+                    // Load attendance
+                    if (parts.size() > 9 && !parts[9].empty()) {
+                        std::vector<std::string> records = split(parts[9], ';');
+                        for (const auto& record : records) {
+                            size_t eq = record.find('=');
+                            int courseId = 0;
+                            AttendanceBitset bitset;
+                            const char* idEnd = record.data() + std::min(eq, record.size());
+                            auto parsed = std::from_chars(record.data(), idEnd, courseId);
+                            if (eq == std::string::npos || parsed.ec != std::errc() || parsed.ptr != idEnd ||
+                                !AttendanceBitset::deserialize(record.substr(eq + 1), bitset)) {
+                                std::cerr << "⚠️  Warning: Skipping malformed attendance '" << record << "' on line "
+                                          << lineNumber << " in " << filename << "\n";
+                                continue;
+                            }
+                            student.attendance.emplace_back(courseId, bitset);
+                        }
+                    }
+                    
                     students.push_back(student);
                 }
             } catch (const std::exception& e) {
@@ -315,7 +672,7 @@ public:
         std::cout << "   Phone: " << (phone.empty() ? "Not provided" : phone) << "\n";
         std::cout << "   Address: " << (address.empty() ? "Not provided" : address) << "\n";
         std::cout << "   Enrollment Date: " << enrollmentDate << "\n";
-        std::cout << "   Status: " << (isActive ? "Active" : "Inactive") << "\n";
+        std::cout << "   Status: " << (getIsActive() ? "Active" : "Inactive") << "\n";
         std::cout << "   Enrolled Courses: " << enrolledCourses.size() << "\n";
     }
     
@@ -324,18 +681,10 @@ public:
                   << std::setw(20) << name.substr(0, 20) << " | "
                   << std::setw(3) << age << " | "
                   << std::setw(25) << email.substr(0, 25) << " | "
-                  << std::setw(8) << (isActive ? "Active" : "Inactive") << "\n";
+                  << std::setw(8) << (getIsActive() ? "Active" : "Inactive") << "\n";
     }
     
 private:
-    static std::string getCurrentDate() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d");
-        return ss.str();
-    }
-    
     static std::vector<std::string> split(const std::string& str, char delimiter) {
         std::vector<std::string> tokens;
         std::stringstream ss(str);
@@ -358,8 +707,9 @@ private:
     std::string department;
     std::string hireDate;
     std::vector<int> assignedCourses;
-    bool isActive;
+    mutable bool isActive; // loaded and stored atomically, so readers need no lock
     double salary;
+    RecordVersion version; // bumped by each committed edit, see commitEdit()
     
 public:
     Teacher(int id, const std::string& name, const std::string& subject,
@@ -367,7 +717,7 @@ public:
             const std::string& department = "", double salary = 0.0)
         : id(id), name(name), subject(subject), email(email), phone(phone), 
           department(department), isActive(true), salary(salary) {
-        hireDate = getCurrentDate();
+        hireDate = currentDate();
     }
     
     // Getters
@@ -379,13 +729,15 @@ public:
     const std::string& getDepartment() const { return department; }
     const std::string& getHireDate() const { return hireDate; }
     const std::vector<int>& getAssignedCourses() const { return assignedCourses; }
-    bool getIsActive() const { return isActive; }
+    bool getIsActive() const { return std::atomic_ref<bool>(isActive).load(std::memory_order_acquire); }
     double getSalary() const { return salary; }
+    uint64_t getVersion() const { return version.load(); }
+    RecordVersion& getVersionStamp() { return version; }
     
     // Setters with validation
     bool setName(const std::string& newName) {
         if (InputValidator::isValidName(newName)) {
-            name = InputValidator::sanitizeString(newName);
+            InputValidator::sanitizeInto(newName, name);
             return true;
         }
         return false;
@@ -393,7 +745,7 @@ public:
     
     bool setSubject(const std::string& newSubject) {
         if (!newSubject.empty() && newSubject.length() <= 100) {
-            subject = InputValidator::sanitizeString(newSubject);
+            InputValidator::sanitizeInto(newSubject, subject);
             return true;
         }
         return false;
@@ -401,7 +753,7 @@ public:
     
     bool setEmail(const std::string& newEmail) {
         if (InputValidator::isValidEmail(newEmail)) {
-            email = InputValidator::sanitizeString(newEmail);
+            InputValidator::sanitizeInto(newEmail, email);
             return true;
         }
         return false;
@@ -409,17 +761,17 @@ public:
     
     bool setPhone(const std::string& newPhone) {
         if (InputValidator::isValidPhone(newPhone)) {
-            phone = InputValidator::sanitizeString(newPhone);
+            InputValidator::sanitizeInto(newPhone, phone);
             return true;
         }
         return false;
     }
     
     void setDepartment(const std::string& newDepartment) {
-        department = InputValidator::sanitizeString(newDepartment);
+        InputValidator::sanitizeInto(newDepartment, department);
     }
     
-    void setIsActive(bool active) { isActive = active; }
+    void setIsActive(bool active) { std::atomic_ref<bool>(isActive).store(active, std::memory_order_release); }
     
     bool setSalary(double newSalary) {
         if (newSalary >= 0) {
@@ -451,17 +803,11 @@ public:
         return std::find(assignedCourses.begin(), assignedCourses.end(), courseId) != assignedCourses.end();
     }
     
-    // File operations
-    bool saveToFile(const std::string& filename) const {
-        std::ofstream file(filename, std::ios::app);
-        if (!file.is_open()) {
-            std::cerr << "❌ Error: Cannot open file " << filename << " for writing.\n";
-            return false;
-        }
-        
+    // One line of the data file
+    void writeRecord(std::ostream& file) const {
         file << id << "|" << name << "|" << subject << "|" << email << "|"
              << phone << "|" << department << "|" << hireDate << "|"
-             << (isActive ? "1" : "0") << "|" << salary << "|";
+             << (getIsActive() ? "1" : "0") << "|" << salary << "|";
         
         // Save assigned courses
         for (size_t i = 0; i < assignedCourses.size(); ++i) {
@@ -469,9 +815,6 @@ public:
             if (i < assignedCourses.size() - 1) file << ",";
         }
         file << "\n";
-        
-        file.close();
-        return true;
     }
     
     static std::vector<Teacher> loadFromFile(const std::string& filename) {
@@ -531,7 +874,7 @@ public:
         std::cout << "   Phone: " << (phone.empty() ? "Not provided" : phone) << "\n";
         std::cout << "   Department: " << (department.empty() ? "Not assigned" : department) << "\n";
         std::cout << "   Hire Date: " << hireDate << "\n";
-        std::cout << "   Status: " << (isActive ? "Active" : "Inactive") << "\n";
+        std::cout << "   Status: " << (getIsActive() ? "Active" : "Inactive") << "\n";
         std::cout << "   Salary: $" << std::fixed << std::setprecision(2) << salary << "\n";
         std::cout << "   Assigned Courses: " << assignedCourses.size() << "\n";
     }
@@ -541,18 +884,10 @@ public:
                   << std::setw(20) << name.substr(0, 20) << " | "
                   << std::setw(15) << subject.substr(0, 15) << " | "
                   << std::setw(20) << department.substr(0, 20) << " | "
-                  << std::setw(8) << (isActive ? "Active" : "Inactive") << "\n";
+                  << std::setw(8) << (getIsActive() ? "Active" : "Inactive") << "\n";
     }
     
 private:
-    static std::string getCurrentDate() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d");
-        return ss.str();
-    }
-    
     static std::vector<std::string> split(const std::string& str, char delimiter) {
         std::vector<std::string> tokens;
         std::stringstream ss(str);
@@ -0,0 +1,101 @@
+#include "../include/CoroutineTask.h"
+#include "../include/AsyncFileWriter.h"
+#include "../include/TextValidator.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <unistd.h>
+
+// Operations that mix CPU work with durable I/O: each validates a record,
+// then appends it to one of 32 journal files and waits until the append is
+// on disk. Run as blocking calls on a few threads, each thread holds one
+// operation at a time; run as coroutines on the same threads, an operation
+// waiting for its fsync holds no thread, so all of them can be in flight.
+
+namespace {
+
+const int OPERATIONS = 4000;
+const int JOURNALS = 32;
+const size_t THREADS = 2;
+
+std::string journalPath(int operation) {
+    return "bench_journal_" + std::to_string(::getpid()) + "_" + std::to_string(operation % JOURNALS) + ".log";
+}
+
+// The CPU part: builds and validates the record; empty when invalid
+std::string makeRecord(int operation) {
+    std::string email = "student" + std::to_string(operation) + "@example.com";
+    if (!TextValidator::isEmail(email)) return std::string();
+    return std::to_string(operation) + "|Student " + std::to_string(operation) + "|" + email + "\n";
+}
+
+Task<bool> journalOperation(TaskExecutor& executor, AsyncFileWriter& writer, int operation) {
+    co_await executor.schedule();
+    std::string record = makeRecord(operation);
+    if (record.empty()) co_return false;
+    std::string path = journalPath(operation);
+    IoResult result = co_await completion<IoResult>(executor, [&writer, &path, &record](AsyncFileWriter::Callback done) {
+        writer.append(path, std::move(record), std::move(done));
+    });
+    co_return result.ok;
+}
+
+void removeJournals() {
+    for (int i = 0; i < JOURNALS; ++i) std::remove(journalPath(i).c_str());
+}
+
+void printRow(const char* mode, double seconds, size_t peak, int ok) {
+    std::cout << "  " << std::left << std::setw(24) << mode << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << OPERATIONS / seconds << std::setw(12) << peak << std::setw(8) << ok << "\n";
+}
+
+} // namespace
+
+int main() {
+    typedef std::chrono::steady_clock Clock;
+    AsyncFileWriter writer;
+    std::cout << "🧵 Coroutine pipeline benchmark (" << OPERATIONS << " operations, " << THREADS << " threads, "
+              << writer.getBackendName() << ")\n";
+    std::cout << "  " << std::left << std::setw(24) << "mode" << std::right << std::setw(10) << "ops/s"
+              << std::setw(12) << "in flight" << std::setw(8) << "ok" << "\n";
+
+    {
+        // Blocking: each thread validates, queues the append and waits for it
+        std::atomic<int> next(0);
+        std::atomic<int> ok(0);
+        auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&] {
+                for (int i = next++; i < OPERATIONS; i = next++) {
+                    std::string record = makeRecord(i);
+                    if (!record.empty() && writer.append(journalPath(i), record).get().ok) ok++;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        printRow("blocking threads", std::chrono::duration<double>(Clock::now() - start).count(), THREADS, ok);
+        removeJournals();
+    }
+
+    {
+        TaskExecutor executor(THREADS);
+        auto start = Clock::now();
+        std::vector<std::future<bool>> operations;
+        size_t peak = 0;
+        for (int i = 0; i < OPERATIONS; ++i) {
+            operations.push_back(spawn(executor, journalOperation(executor, writer, i)));
+            peak = std::max(peak, executor.getInFlight());
+        }
+        int ok = 0;
+        for (auto& operation : operations) ok += operation.get() ? 1 : 0;
+        printRow("coroutines", std::chrono::duration<double>(Clock::now() - start).count(), peak, ok);
+        removeJournals();
+    }
+    return 0;
+}
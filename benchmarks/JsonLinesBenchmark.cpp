@@ -0,0 +1,80 @@
+#include "../include/JsonLinesReader.h"
+#include "../include/OutputBuffer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+
+// Student-shaped JSON Lines, as exchanged with the SIS: writing through
+// RecordWriter, building the structural index alone, and the full parse
+// (index plus tape walk) into a handler that only counts fields.
+
+namespace {
+
+struct CountingHandler {
+    size_t fields = 0;
+    size_t records = 0;
+    void beginRecord() {}
+    void field(const char*, size_t, JsonLinesReader::ValueType, const char*, size_t) { fields++; }
+    void endRecord() { records++; }
+    void recordError(size_t, const char*) {}
+};
+
+void writeStudents(OutputBuffer& out, size_t count) {
+    RecordWriter writer(out, RecordWriter::JsonLines, {"id", "name", "age", "email", "phone", "address",
+                                                       "enrollment_date", "active", "course_ids"});
+    std::vector<int> courses = {101, 205, 310};
+    std::string name, email;
+    for (size_t i = 0; i < count; ++i) {
+        name = "Student " + std::to_string(i);
+        email = "student" + std::to_string(i) + "@school.edu";
+        writer.field(static_cast<int>(i)).field(name).field(18 + static_cast<int>(i % 10)).field(email)
+              .field(std::string("555-123-4567")).field(std::string("12 Main St, Springfield"))
+              .field(std::string("2024-09-01")).field(i % 5 != 0).field(courses);
+        writer.endRecord();
+    }
+}
+
+template <typename Work>
+void run(const std::string& label, size_t bytes, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    size_t checksum = work();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << std::left << std::setw(26) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(0) << bytes / seconds / 1e6 << " MB/s  (checksum " << checksum << ")\n";
+}
+
+} // namespace
+
+int main() {
+    const size_t rows = 500000;
+    OutputBuffer out;
+    std::string text;
+
+    std::cout << "📄 JSON Lines benchmark (" << rows << " student records)\n";
+    auto start = std::chrono::steady_clock::now();
+    writeStudents(out, rows);
+    text = out.str();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << std::left << std::setw(26) << "write (RecordWriter)" << std::right << std::setw(10) << std::fixed << std::setprecision(0)
+              << text.size() / seconds / 1e6 << " MB/s  (" << text.size() << " bytes)\n";
+
+    std::vector<uint32_t> index;
+    run("structural index", text.size(), [&] {
+        size_t total = 0;
+        for (size_t begin = 0; begin < text.size(); begin += JsonLinesReader::INDEX_BLOCK_BYTES) {
+            size_t size = std::min<size_t>(JsonLinesReader::INDEX_BLOCK_BYTES, text.size() - begin);
+            JsonLinesReader::buildIndex(text.data() + begin, size, index);
+            total += index.size();
+        }
+        return total;
+    });
+    run("full parse", text.size(), [&] {
+        CountingHandler handler;
+        std::string scratch;
+        JsonLinesReader::parse(text.data(), text.size(), handler, index, scratch);
+        return handler.fields;
+    });
+    return 0;
+}
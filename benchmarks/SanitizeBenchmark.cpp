@@ -0,0 +1,78 @@
+#include "../include/TextNormalizer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <regex>
+#include <chrono>
+
+// Bulk-edit workload for sanitizeString: the original copy + erase +
+// regex_replace against the single-pass normaliser, both returning a new
+// string and writing into a reused field buffer as the setters now do.
+
+namespace {
+
+std::string legacySanitize(const std::string& input) {
+    std::string result = input;
+    result.erase(0, result.find_first_not_of(" \t\n\r"));
+    result.erase(result.find_last_not_of(" \t\n\r") + 1);
+    std::regex multipleSpaces("\\s+");
+    result = std::regex_replace(result, multipleSpaces, " ");
+    return result;
+}
+
+std::vector<std::string> makeEdits(size_t count) {
+    std::vector<std::string> edits;
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0: edits.push_back("  Student Name " + std::to_string(i) + "  "); break;
+            case 1: edits.push_back(std::to_string(i) + " Long Residential Street,   Apartment 12B,\tSpringfield"); break;
+            default: edits.push_back("Department of Computer Science and Engineering " + std::to_string(i)); break;
+        }
+    }
+    return edits;
+}
+
+template <typename Work>
+double run(const std::string& label, size_t count, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    size_t checksum = work();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << std::left << std::setw(30) << label << std::right << std::setw(14)
+              << static_cast<long long>(count / seconds) << " edits/sec  (checksum " << checksum << ")\n";
+    return seconds;
+}
+
+} // namespace
+
+int main() {
+    const size_t rows = 200000;
+    std::vector<std::string> edits = makeEdits(rows);
+
+    std::cout << "🧹 sanitizeString benchmark (" << rows << " field edits)\n";
+    double legacy = run("copy + erase + regex_replace", rows, [&] {
+        size_t total = 0;
+        for (const auto& edit : edits) total += legacySanitize(edit).size();
+        return total;
+    });
+    run("normalize, new string", rows, [&] {
+        size_t total = 0;
+        for (const auto& edit : edits) {
+            std::string result;
+            TextNormalizer::normalizeInto(edit, result);
+            total += result.size();
+        }
+        return total;
+    });
+    double reused = run("normalize, reused buffer", rows, [&] {
+        size_t total = 0;
+        std::string field;
+        for (const auto& edit : edits) {
+            TextNormalizer::normalizeInto(edit, field);
+            total += field.size();
+        }
+        return total;
+    });
+    std::cout << "  Speedup (reused buffer): " << std::fixed << std::setprecision(0) << legacy / reused << "x\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "../include/SeatReservation.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+
+// Enrollment seat claims per second as threads are added: every thread on
+// one course (all CAS traffic on one counter), each thread on its own
+// course (should scale with cores), and a single global mutex guarding a
+// plain count, which is what the counters replace.
+
+namespace {
+
+const size_t CYCLES = 2000000; // per thread: reserve, commit, then free the seat
+
+struct alignas(64) PaddedCourse {
+    SeatCounter seats{1 << 30};
+};
+
+struct LockedCourses {
+    std::mutex mutex;
+    std::vector<int> enrolled;
+};
+
+template <typename Work>
+double run(size_t threads, Work work) {
+    std::vector<std::thread> pool;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) pool.emplace_back(work, t);
+    for (auto& thread : pool) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * CYCLES / seconds / 1e6;
+}
+
+} // namespace
+
+int main() {
+    size_t maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    std::cout << "💺 Seat reservation benchmark (" << CYCLES << " claims per thread, M claims/s)\n";
+    std::cout << "  " << std::left << std::setw(10) << "threads" << std::right << std::setw(14) << "one course"
+              << std::setw(16) << "own courses" << std::setw(16) << "global mutex" << "\n";
+
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        PaddedCourse shared;
+        double contended = run(threads, [&shared](size_t) {
+            for (size_t i = 0; i < CYCLES; ++i) {
+                SeatReservation seat(shared.seats);
+                seat.commit();
+                shared.seats.vacate();
+            }
+        });
+
+        std::vector<PaddedCourse> courses(threads);
+        double spread = run(threads, [&courses](size_t t) {
+            SeatCounter& seats = courses[t].seats;
+            for (size_t i = 0; i < CYCLES; ++i) {
+                SeatReservation seat(seats);
+                seat.commit();
+                seats.vacate();
+            }
+        });
+
+        LockedCourses locked;
+        locked.enrolled.assign(threads, 0);
+        double global = run(threads, [&locked](size_t t) {
+            for (size_t i = 0; i < CYCLES; ++i) {
+                std::lock_guard<std::mutex> lock(locked.mutex);
+                if (locked.enrolled[t] < (1 << 30)) locked.enrolled[t]++;
+                locked.enrolled[t]--;
+            }
+        });
+
+        std::cout << "  " << std::left << std::setw(10) << threads << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << contended << std::setw(16) << spread << std::setw(16) << global << "\n";
+    }
+    return 0;
+}
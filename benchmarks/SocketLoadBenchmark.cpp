@@ -0,0 +1,149 @@
+#include "../include/UnixSocketServer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <unistd.h>
+
+// Load generator for the school daemon. Each connection runs closed-loop
+// (send a request, wait for its response) and records per-request latency.
+//
+//   bench_SocketLoadBenchmark                       in-process echo server
+//   bench_SocketLoadBenchmark SOCKET [CONNS] [REQS] a running --serve daemon
+//
+// Against a daemon the mix is 80% student lookups, 15% name searches and
+// 5% summary reports; against the echo server it measures framing and
+// event-loop overhead alone.
+
+namespace {
+
+struct Workload {
+    std::vector<uint32_t> studentIds;
+    bool daemon = false;
+};
+
+void buildRequest(std::string& frame, const Workload& workload, uint32_t requestId, uint32_t& rng) {
+    frame.clear();
+    rng = rng * 1664525u + 1013904223u;
+    uint32_t roll = (rng >> 8) % 100;
+    if (!workload.daemon || workload.studentIds.empty()) {
+        SchoolProtocol::ping(frame, requestId);
+    } else if (roll < 80) {
+        SchoolProtocol::lookup(frame, requestId, SchoolProtocol::LookupStudent,
+                               workload.studentIds[(rng >> 4) % workload.studentIds.size()]);
+    } else if (roll < 95) {
+        static const char* fragments[] = {"a", "e", "son", "li", "mar"};
+        SchoolProtocol::searchStudents(frame, requestId, fragments[roll % 5], 20);
+    } else {
+        SchoolProtocol::report(frame, requestId, SchoolProtocol::SummaryReport);
+    }
+}
+
+// Latencies in microseconds; empty if the connection failed
+std::vector<double> runConnection(const std::string& path, const Workload& workload, size_t requests, uint32_t seed) {
+    std::vector<double> latencies;
+    UnixSocketClient client;
+    if (!client.connect(path)) return latencies;
+    latencies.reserve(requests);
+    std::string frame, payload;
+    uint32_t rng = seed;
+    for (size_t i = 0; i < requests; ++i) {
+        buildRequest(frame, workload, static_cast<uint32_t>(i), rng);
+        auto start = std::chrono::steady_clock::now();
+        if (!client.call(frame, payload)) break;
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    return latencies;
+}
+
+double percentile(std::vector<double>& values, double fraction) {
+    size_t rank = static_cast<size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+// Up to 65535 ids from an empty-fragment search (matches every student)
+bool fetchStudentIds(const std::string& path, std::vector<uint32_t>& ids) {
+    UnixSocketClient client;
+    std::string frame, payload;
+    SchoolProtocol::searchStudents(frame, 0, "", 0xFFFF);
+    if (!client.connect(path) || !client.call(frame, payload)) return false;
+    uint32_t requestId;
+    SchoolProtocol::Status status;
+    const char* body;
+    size_t length;
+    if (!SchoolProtocol::parseResponse(payload.data(), payload.size(), requestId, status, body, length)) return false;
+    std::string text(body, length);
+    for (size_t pos = text.find("\"id\":"); pos != std::string::npos; pos = text.find("\"id\":", pos + 1)) {
+        ids.push_back(static_cast<uint32_t>(std::strtoul(text.c_str() + pos + 5, nullptr, 10)));
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "";
+    size_t connections = argc > 2 ? std::max(1, std::atoi(argv[2])) : 4;
+    size_t requests = argc > 3 ? std::max(1, std::atoi(argv[3])) : 20000;
+
+    Workload workload;
+    std::unique_ptr<UnixSocketServer> server;
+    std::thread serverThread;
+    if (path.empty()) {
+        path = "/tmp/school_bench_" + std::to_string(::getpid()) + ".sock";
+        server.reset(new UnixSocketServer([](const char* request, size_t size, std::string& response) {
+            FrameReader reader(request, size);
+            SchoolProtocol::response(response, reader.u32(), SchoolProtocol::Ok, "pong", 4);
+        }));
+        std::string error;
+        if (!server->listen(path, error)) {
+            std::cerr << "❌ " << error << "\n";
+            return 1;
+        }
+        serverThread = std::thread([&server] { server->run(); });
+        std::cout << "🔌 Socket load benchmark (in-process echo server, " << server->getWorkerCount() << " workers)\n";
+    } else {
+        workload.daemon = true;
+        if (!fetchStudentIds(path, workload.studentIds)) {
+            std::cerr << "❌ Cannot reach daemon on " << path << "\n";
+            return 1;
+        }
+        std::cout << "🔌 Socket load benchmark (daemon on " << path << ", "
+                  << workload.studentIds.size() << " students)\n";
+    }
+
+    std::vector<std::vector<double>> results(connections);
+    std::vector<std::thread> clients;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c] {
+            results[c] = runConnection(path, workload, requests, static_cast<uint32_t>(c * 2654435761u + 1));
+        });
+    }
+    for (auto& client : clients) client.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (server) {
+        server->stop();
+        serverThread.join();
+    }
+
+    std::vector<double> latencies;
+    for (const auto& connection : results) latencies.insert(latencies.end(), connection.begin(), connection.end());
+    if (latencies.empty()) {
+        std::cerr << "❌ No requests completed\n";
+        return 1;
+    }
+    std::cout << "  " << connections << " connections x " << requests << " requests, "
+              << latencies.size() << " completed in " << std::fixed << std::setprecision(2) << seconds << " s\n"
+              << "  throughput " << std::setprecision(0) << latencies.size() / seconds << " req/s\n"
+              << "  latency    p50 " << std::setprecision(1) << percentile(latencies, 0.50) << " us, p99 "
+              << percentile(latencies, 0.99) << " us\n";
+    return latencies.size() == connections * requests ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#include "../include/TextValidator.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <regex>
+#include <chrono>
+
+// Validations per second: per-call std::regex (the old code path) against
+// the table-driven validators, over a mix of valid and invalid inputs.
+
+namespace {
+
+std::vector<std::string> makeEmails(size_t count) {
+    std::vector<std::string> emails;
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 4) {
+            case 0: emails.push_back("student" + std::to_string(i) + "@school.edu"); break;
+            case 1: emails.push_back("first.last+" + std::to_string(i) + "@dept.university.ac.uk"); break;
+            case 2: emails.push_back("broken" + std::to_string(i) + "@nodot"); break;
+            default: emails.push_back("x" + std::to_string(i) + "@host.c0m"); break;
+        }
+    }
+    return emails;
+}
+
+std::vector<std::string> makePhones(size_t count) {
+    std::vector<std::string> phones;
+    for (size_t i = 0; i < count; ++i) {
+        std::string digits = std::to_string(5550000000ULL + i);
+        phones.push_back(i % 3 == 0 ? "+1 (" + digits.substr(0, 3) + ") " + digits.substr(3) :
+                         i % 3 == 1 ? digits : digits.substr(0, 7));
+    }
+    return phones;
+}
+
+template <typename Check>
+void run(const std::string& label, const std::vector<std::string>& inputs, Check check) {
+    auto start = std::chrono::steady_clock::now();
+    size_t accepted = 0;
+    for (const auto& input : inputs) accepted += check(input);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << std::left << std::setw(24) << label << std::right << std::setw(14)
+              << static_cast<long long>(inputs.size() / seconds) << " validations/sec"
+              << "  (" << accepted << " accepted)\n";
+}
+
+} // namespace
+
+int main() {
+    const size_t rows = 200000;
+    std::vector<std::string> emails = makeEmails(rows);
+    std::vector<std::string> phones = makePhones(rows);
+
+    std::cout << "📏 Validator benchmark (" << rows << " inputs each)\n";
+    run("email: std::regex", emails, [](const std::string& email) {
+        std::regex emailPattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
+        return std::regex_match(email, emailPattern);
+    });
+    run("email: DFA", emails, [](const std::string& email) { return TextValidator::isEmail(email); });
+    run("phone: std::regex", phones, [](const std::string& phone) {
+        std::regex phonePattern(R"(\+?[\d\s\-\(\)]{10,15})");
+        return std::regex_match(phone, phonePattern);
+    });
+    run("phone: DFA", phones, [](const std::string& phone) { return TextValidator::isPhone(phone); });
+    return 0;
+}
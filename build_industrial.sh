@@ -8,12 +8,12 @@ echo "🔨 Compiling Industrial School Management System..."
 rm -f IndustrialSchoolSystem
 
 # Compile the industrial system
-if g++ -std=c++17 -Wall -Wextra -O2 IndustrialSchoolSystem.cpp -o IndustrialSchoolSystem; then
+if g++ -std=c++20 -Wall -Wextra -O2 -pthread IndustrialSchoolSystem.cpp src/Config.cpp -o IndustrialSchoolSystem; then
     echo "✅ Compilation successful!"
     echo "🚀 Executable created: IndustrialSchoolSystem"
     ls -la IndustrialSchoolSystem
 else
     echo "❌ Compilation failed!"
     echo "📋 Trying with debugging info..."
-    g++ -std=c++17 -Wall -Wextra -g IndustrialSchoolSystem.cpp -o IndustrialSchoolSystem 2>&1
+    g++ -std=c++20 -Wall -Wextra -g -pthread IndustrialSchoolSystem.cpp src/Config.cpp -o IndustrialSchoolSystem 2>&1
 fi
@@ -0,0 +1,492 @@
+#ifndef ASYNC_FILE_WRITER_H
+#define ASYNC_FILE_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cerrno>
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <initializer_list>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// Outcome of one queued file operation
+struct IoResult {
+    bool ok = false;
+    int error = 0;       // errno when not ok
+    size_t bytes = 0;
+    double micros = 0.0; // from queued to done
+};
+
+struct IoStats {
+    size_t queueDepth = 0; // queued or in flight
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    double averageMicros = 0.0;
+    double maxMicros = 0.0;
+};
+
+#ifdef __linux__
+// Minimal io_uring over the raw system calls (no liburing): one submission
+// and one completion ring, used by a single thread
+class IoUring {
+private:
+    int fd = -1;
+    unsigned entries = 0;
+    unsigned *sqHead = nullptr, *sqTail = nullptr, *sqMask = nullptr, *sqArray = nullptr;
+    unsigned *cqHead = nullptr, *cqTail = nullptr, *cqMask = nullptr;
+    io_uring_sqe* sqes = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    size_t sqRingBytes = 0, cqRingBytes = 0;
+
+public:
+    ~IoUring() { close(); }
+
+    // False where the kernel lacks io_uring, a sandbox blocks it, or it
+    // can't do what the writer needs: writes at the file position (appends
+    // pass offset -1), and the write and fsync opcodes
+    bool open(unsigned requested) {
+        io_uring_params params = io_uring_params();
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, requested, &params));
+        if (fd < 0) return false;
+        if (!(params.features & IORING_FEAT_RW_CUR_POS) || !supports({IORING_OP_WRITE, IORING_OP_FSYNC})) {
+            close();
+            return false;
+        }
+        entries = params.sq_entries;
+        sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sqRingBytes = cqRingBytes = std::max(sqRingBytes, cqRingBytes);
+        sqRing = mmap(nullptr, sqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cqRing = single ? sqRing : mmap(nullptr, cqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        void* sqeArea = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqeArea == MAP_FAILED) {
+            if (sqeArea != MAP_FAILED) munmap(sqeArea, params.sq_entries * sizeof(io_uring_sqe));
+            close();
+            return false;
+        }
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqes = static_cast<io_uring_sqe*>(sqeArea);
+        return true;
+    }
+
+    void close() {
+        if (sqes) munmap(sqes, entries * sizeof(io_uring_sqe));
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingBytes);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingBytes);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        sqes = nullptr;
+        sqRing = cqRing = MAP_FAILED;
+    }
+
+    unsigned getEntries() const { return entries; }
+
+    // Asks the kernel which opcodes it implements; false if it can't say
+    // (before 5.6, which also lacks IORING_OP_WRITE)
+    bool supports(std::initializer_list<unsigned> opcodes) const {
+        const unsigned slots = 256;
+        std::vector<unsigned char> buffer(sizeof(io_uring_probe) + slots * sizeof(io_uring_probe_op));
+        io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, slots) < 0) return false;
+        for (unsigned opcode : opcodes) {
+            if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) return false;
+        }
+        return true;
+    }
+
+    unsigned freeSlots() const {
+        return entries - (*sqTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE));
+    }
+
+    // Next free submission entry, cleared; the caller checks freeSlots()
+    io_uring_sqe& nextSqe() {
+        unsigned tail = *sqTail;
+        unsigned index = tail & *sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        sqe = io_uring_sqe();
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        return sqe;
+    }
+
+    // Submits count entries and, with wait, blocks for one completion
+    int enter(unsigned count, bool wait) {
+        int result;
+        do {
+            result = static_cast<int>(syscall(__NR_io_uring_enter, fd, count, wait ? 1u : 0u,
+                                              wait ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0));
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    template <typename Handle>
+    void reap(Handle handle) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            handle(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+};
+#endif
+
+// Asynchronous persistence: whole-file replaces (snapshots), appends
+// (journals) and copies (backups) are queued and return at once, with a
+// future and an optional callback for callers that need to know the data is
+// on disk. Operations on the same file run in the order they were queued;
+// different files proceed in parallel. On Linux the writes and fsyncs go
+// through io_uring on one I/O thread; elsewhere, or where io_uring is not
+// available, a small pool of threads does blocking writes instead.
+// Callbacks run on the I/O thread and should be short.
+class AsyncFileWriter {
+public:
+    enum Backend { IoUringBackend, ThreadPoolBackend };
+    typedef std::function<void(const IoResult&)> Callback;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    enum Kind { Replace, Append, Copy };
+
+    struct Op {
+        Kind kind;
+        std::string path;   // file written
+        std::string source; // Copy: file read
+        std::string data;
+        std::promise<IoResult> promise;
+        Callback callback;
+        Clock::time_point queuedAt;
+        int fd = -1;
+        int pending = 0;    // io_uring completions still due
+        int error = 0;
+        size_t written = 0;
+
+        // Operations with the same key run one at a time, in order
+        const std::string& key() const { return kind == Copy ? source : path; }
+    };
+
+    Backend backend = ThreadPoolBackend;
+    std::vector<std::thread> threads;
+    mutable std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable idle;
+    std::deque<std::unique_ptr<Op>> ready;
+    std::unordered_map<std::string, std::deque<std::unique_ptr<Op>>> busy; // key -> ops waiting behind it
+    bool stopping = false;
+    IoStats stats;
+    double totalMicros = 0.0;
+#ifdef __linux__
+    IoUring ring;
+#endif
+
+public:
+    explicit AsyncFileWriter(bool useIoUring = true, size_t poolThreads = 2) {
+#ifdef __linux__
+        if (useIoUring && ring.open(64)) {
+            backend = IoUringBackend;
+            threads.emplace_back([this] { runRing(); });
+            return;
+        }
+#else
+        (void)useIoUring;
+#endif
+        for (size_t i = 0; i < std::max<size_t>(1, poolThreads); ++i) threads.emplace_back([this] { runPool(); });
+    }
+
+    // Finishes everything queued first
+    ~AsyncFileWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    Backend getBackend() const { return backend; }
+    const char* getBackendName() const { return backend == IoUringBackend ? "io_uring" : "thread pool"; }
+
+    // Writes data to path.tmp, syncs it and renames it over path, so readers
+    // see the old file or the new one, never a partial write; then syncs
+    // the directory so the rename survives a crash
+    std::future<IoResult> replace(const std::string& path, std::string data, Callback callback = nullptr) {
+        return enqueue(Replace, path, std::string(), std::move(data), std::move(callback));
+    }
+
+    std::future<IoResult> append(const std::string& path, std::string data, Callback callback = nullptr) {
+        return enqueue(Append, path, std::string(), std::move(data), std::move(callback));
+    }
+
+    // Copies source once every operation queued on it before has finished
+    std::future<IoResult> copy(const std::string& source, const std::string& path, Callback callback = nullptr) {
+        return enqueue(Copy, path, source, std::string(), std::move(callback));
+    }
+
+    // Blocks until nothing is queued or in flight
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return stats.queueDepth == 0; });
+    }
+
+    IoStats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+private:
+    std::future<IoResult> enqueue(Kind kind, const std::string& path, const std::string& source,
+                                  std::string data, Callback callback) {
+        std::unique_ptr<Op> op(new Op());
+        op->kind = kind;
+        op->path = path;
+        op->source = source;
+        op->data = std::move(data);
+        op->callback = std::move(callback);
+        op->queuedAt = Clock::now();
+        std::future<IoResult> result = op->promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.queueDepth++;
+            auto waiting = busy.find(op->key());
+            if (waiting != busy.end()) {
+                waiting->second.push_back(std::move(op));
+                return result;
+            }
+            busy[op->key()];
+            ready.push_back(std::move(op));
+        }
+        work.notify_one();
+        return result;
+    }
+
+    // Reports the result and lets the next operation on the same file go
+    void complete(std::unique_ptr<Op> op) {
+        IoResult result;
+        result.ok = op->error == 0;
+        result.error = op->error;
+        result.bytes = op->data.size();
+        result.micros = std::chrono::duration<double, std::micro>(Clock::now() - op->queuedAt).count();
+        if (op->callback) op->callback(result);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.completed++;
+            if (!result.ok) stats.failed++;
+            totalMicros += result.micros;
+            stats.averageMicros = totalMicros / stats.completed;
+            stats.maxMicros = std::max(stats.maxMicros, result.micros);
+            auto waiting = busy.find(op->key());
+            if (waiting->second.empty()) {
+                busy.erase(waiting);
+            } else {
+                ready.push_back(std::move(waiting->second.front()));
+                waiting->second.pop_front();
+            }
+            stats.queueDepth--;
+        }
+        op->promise.set_value(result); // After the stats, so a waiter sees them
+        work.notify_one();
+        idle.notify_all();
+    }
+
+    // Waits for an operation; null once stopping and everything is done
+    std::unique_ptr<Op> take(bool block) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (block) work.wait(lock, [this] { return !ready.empty() || (stopping && stats.queueDepth == 0); });
+        if (ready.empty()) return nullptr;
+        std::unique_ptr<Op> op = std::move(ready.front());
+        ready.pop_front();
+        return op;
+    }
+
+    bool finished() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stopping && stats.queueDepth == 0;
+    }
+
+    static std::string temporaryPath(const std::string& path) { return path + ".tmp"; }
+
+    // A rename is durable only once the directory holding it is synced
+    static int syncDirectory(const std::string& path) {
+#ifndef _WIN32
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) return errno;
+        int error = ::fsync(fd) != 0 ? errno : 0;
+        ::close(fd);
+        return error;
+#else
+        (void)path;
+        return 0;
+#endif
+    }
+
+    static bool readWhole(const std::string& path, std::string& data) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+
+    // Blocking version of an operation, for the thread pool
+    static void perform(Op& op) {
+        if (op.kind == Copy && !readWhole(op.source, op.data)) {
+            op.error = errno ? errno : ENOENT;
+            return;
+        }
+        std::string target = op.kind == Append ? op.path : temporaryPath(op.path);
+#ifndef _WIN32
+        int fd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (op.kind == Append ? O_APPEND : O_TRUNC), 0644);
+        if (fd < 0) {
+            op.error = errno;
+            return;
+        }
+        for (size_t done = 0; done < op.data.size() && !op.error;) {
+            ssize_t written = ::write(fd, op.data.data() + done, op.data.size() - done);
+            if (written < 0 && errno != EINTR) op.error = errno;
+            if (written > 0) done += static_cast<size_t>(written);
+        }
+        if (!op.error && ::fsync(fd) != 0) op.error = errno;
+        ::close(fd);
+#else
+        std::ofstream file(target, std::ios::binary | (op.kind == Append ? std::ios::app : std::ios::trunc));
+        if (!file.write(op.data.data(), op.data.size()) || !file.flush()) op.error = EIO;
+#endif
+        if (!op.error && op.kind != Append) {
+#ifdef _WIN32
+            std::remove(op.path.c_str()); // rename() doesn't replace here
+#endif
+            if (std::rename(target.c_str(), op.path.c_str()) != 0) op.error = errno ? errno : EIO;
+            else op.error = syncDirectory(op.path);
+        }
+    }
+
+    void runPool() {
+        while (std::unique_ptr<Op> op = take(true)) {
+            perform(*op);
+            complete(std::move(op));
+        }
+    }
+
+#ifdef __linux__
+    // One I/O thread: each operation is a write linked to an fsync, so a
+    // failed write cancels the sync. Opening, renaming (and syncing the
+    // directory after) and reading a copy's source stay synchronous on this
+    // thread.
+    void runRing() {
+        std::unordered_map<Op*, std::unique_ptr<Op>> inFlight;
+        while (true) {
+            unsigned submitted = 0;
+            while (ring.freeSlots() >= 2) {
+                std::unique_ptr<Op> op = take(inFlight.empty() && submitted == 0);
+                if (!op) break;
+                if (!start(*op)) {
+                    complete(std::move(op));
+                    continue;
+                }
+                io_uring_sqe& write = ring.nextSqe();
+                write.opcode = IORING_OP_WRITE;
+                write.fd = op->fd;
+                write.addr = reinterpret_cast<uint64_t>(op->data.data());
+                write.len = static_cast<uint32_t>(op->data.size());
+                write.off = op->kind == Append ? static_cast<uint64_t>(-1) : 0;
+                write.flags = IOSQE_IO_LINK;
+                write.user_data = reinterpret_cast<uint64_t>(op.get());
+                io_uring_sqe& sync = ring.nextSqe();
+                sync.opcode = IORING_OP_FSYNC;
+                sync.fd = op->fd;
+                sync.user_data = reinterpret_cast<uint64_t>(op.get());
+                op->pending = 2;
+                Op* key = op.get();
+                inFlight[key] = std::move(op);
+                submitted += 2;
+            }
+            if (inFlight.empty()) {
+                if (finished()) return;
+                continue;
+            }
+            if (ring.enter(submitted, true) < 0) {
+                // The ring is unusable: fail what it holds and carry on
+                // with blocking writes
+                int error = errno;
+                for (auto& flying : inFlight) {
+                    flying.second->error = error;
+                    finish(std::move(flying.second));
+                }
+                runPool();
+                return;
+            }
+            ring.reap([this, &inFlight](uint64_t userData, int res) {
+                Op* op = reinterpret_cast<Op*>(userData);
+                if (res < 0 && !op->error) op->error = -res;
+                if (res >= 0 && op->pending == 2) op->written = static_cast<size_t>(res);
+                if (--op->pending > 0) return;
+                auto flying = inFlight.find(op);
+                finish(std::move(flying->second));
+                inFlight.erase(flying);
+            });
+        }
+    }
+
+    bool start(Op& op) {
+        if (op.kind == Copy && !readWhole(op.source, op.data)) {
+            op.error = errno ? errno : ENOENT;
+            return false;
+        }
+        std::string target = op.kind == Append ? op.path : temporaryPath(op.path);
+        op.fd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (op.kind == Append ? O_APPEND : O_TRUNC), 0644);
+        if (op.fd < 0) op.error = errno;
+        return op.fd >= 0;
+    }
+
+    void finish(std::unique_ptr<Op> op) {
+        if (!op->error && op->written < op->data.size()) op->error = EIO; // Short write
+        ::close(op->fd);
+        if (!op->error && op->kind != Append) {
+            if (std::rename(temporaryPath(op->path).c_str(), op->path.c_str()) != 0) op->error = errno;
+            else op->error = syncDirectory(op->path);
+        }
+        complete(std::move(op));
+    }
+#endif
+};
+
+#endif // ASYNC_FILE_WRITER_H
@@ -0,0 +1,39 @@
+#ifndef ATTENDANCE_JOURNAL_H
+#define ATTENDANCE_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include "Course.h"
+
+// Append-only log of roll-calls. Each roll-call is validated and recorded on
+// the course, then persisted as one line: courseId|date|rosterIds|presentIds
+class AttendanceJournal {
+private:
+    std::string filename;
+    std::ofstream stream;
+    std::string lineBuffer;
+
+public:
+    explicit AttendanceJournal(const std::string& filename);
+
+    bool isOpen() const { return stream.is_open(); }
+    const std::string& getFilename() const { return filename; }
+
+    // Roll-call for a whole session with a single journal write. A date that
+    // isn't YYYY-MM-DD records nothing; journaled is false when the date was
+    // refused or the line couldn't be written.
+    RollCallResult recordRollCall(Course& course, const std::string& date,
+                                  const std::vector<int>& presentStudentIds);
+
+    // Re-applies every journaled roll-call to the matching courses;
+    // returns the number of roll-calls applied
+    static int replay(const std::string& filename, std::vector<std::shared_ptr<Course>>& courses);
+
+private:
+    void appendIds(const std::vector<int>& ids);
+    static std::vector<int> parseIds(const std::string& field);
+};
+
+#endif // ATTENDANCE_JOURNAL_H
@@ -0,0 +1,81 @@
+#ifndef ATTENDANCE_MATRIX_H
+#define ATTENDANCE_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+// Per-course attendance stored column-wise: one row per session (kept in date
+// order), one bit column per student. Two bit planes are kept per row: which
+// students were recorded that session and which of them were present.
+// Memory is 2 * sessions * ceil(students / 64) words.
+class AttendanceMatrix {
+private:
+    std::vector<std::string> sessionDates;          // sorted; row index = position
+    std::vector<int> columnStudents;                // column -> student ID
+    std::unordered_map<int, size_t> studentColumns; // student ID -> column
+    size_t wordsPerRow;
+    std::vector<uint64_t> presentBits;              // sessions x wordsPerRow
+    std::vector<uint64_t> recordedBits;             // sessions x wordsPerRow
+    uint64_t version;                               // bumped on every change
+
+public:
+    AttendanceMatrix();
+
+    // Dimensions
+    size_t getSessionCount() const { return sessionDates.size(); }
+    size_t getStudentCount() const { return columnStudents.size(); }
+    size_t getWordsPerRow() const { return wordsPerRow; }
+    const std::vector<std::string>& getSessionDates() const { return sessionDates; }
+    const std::vector<int>& getColumnStudents() const { return columnStudents; }
+    size_t sizeInBytes() const;
+    uint64_t getVersion() const { return version; }
+
+    // Index lookups (-1 when absent)
+    int findSession(const std::string& date) const;
+    int findColumn(int studentId) const;
+    size_t sessionFor(const std::string& date);
+    size_t columnFor(int studentId);
+    // Sessions dated within [fromDate, toDate] as a half-open row range
+    std::pair<size_t, size_t> sessionRange(const std::string& fromDate, const std::string& toDate) const;
+
+    // Single cell
+    void record(int studentId, const std::string& date, bool isPresent);
+    bool isRecorded(int studentId, const std::string& date) const;
+    bool wasPresent(int studentId, const std::string& date) const;
+
+    // Whole session: one row write covering every listed student. Present IDs
+    // outside studentIds are skipped and reported through rejectedIds.
+    // Returns the number of distinct students marked present.
+    size_t recordSession(const std::string& date, const std::vector<int>& studentIds,
+                         const std::vector<int>& presentIds, std::vector<int>* rejectedIds = nullptr);
+    void recordSessionRow(size_t session, const std::vector<uint64_t>& recordedRow,
+                          const std::vector<uint64_t>& presentRow);
+    // Adds presences to a session without touching anyone else's cell: the
+    // accepted present IDs are marked recorded and present, nobody is marked
+    // absent. Returns the number of distinct students accepted.
+    size_t recordPresences(const std::string& date, const std::vector<int>& studentIds,
+                           const std::vector<int>& presentIds, std::vector<int>* rejectedIds = nullptr);
+    std::vector<uint64_t> buildRow(const std::vector<int>& studentIds);
+
+    // Raw rows for range structures built on top of the matrix
+    const uint64_t* presentRow(size_t session) const { return presentBits.data() + session * wordsPerRow; }
+    const uint64_t* recordedRow(size_t session) const { return recordedBits.data() + session * wordsPerRow; }
+
+    // Rates
+    double getStudentPercentage(int studentId) const;
+    double getSessionPercentage(const std::string& date) const;
+    std::unordered_map<int, double> getAllStudentPercentages() const;
+
+    // Per-column totals over every session, computed with bit-sliced counters
+    std::vector<uint32_t> presentCountsPerColumn() const;
+    std::vector<uint32_t> recordedCountsPerColumn() const;
+
+private:
+    void growColumns(size_t minColumns);
+    std::vector<uint32_t> columnCounts(const std::vector<uint64_t>& plane) const;
+};
+
+#endif // ATTENDANCE_MATRIX_H
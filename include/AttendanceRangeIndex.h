@@ -0,0 +1,65 @@
+#ifndef ATTENDANCE_RANGE_INDEX_H
+#define ATTENDANCE_RANGE_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AttendanceMatrix.h"
+
+// Fenwick trees over the session rows of an AttendanceMatrix. Each tree node
+// holds a count per student column, so the present/recorded totals for any
+// session window come from O(log sessions) nodes: one entry each for a single
+// student, or whole node rows added together for a cohort.
+//
+// Writers keep it current as they go: bracket each write to one session row
+// with beforeWrite/afterWrite and only the changed cells are applied, in
+// O(log sessions) each; a session appended after the last date adds one node.
+// A new student column or a session inserted out of date order falls back to
+// a full O(sessions * columns) build.
+class AttendanceRangeIndex {
+public:
+    // The row as it was before a write, for afterWrite to diff against
+    struct RowWrite {
+        bool indexCurrent = false;
+        int session = -1;
+        std::vector<uint64_t> recorded;
+        std::vector<uint64_t> present;
+    };
+
+private:
+    size_t sessionCount;
+    size_t columnCount;
+    uint64_t builtVersion;
+    bool built;
+    std::vector<uint32_t> presentTree;  // (sessions + 1) x columns, node 0 unused
+    std::vector<uint32_t> recordedTree;
+
+public:
+    AttendanceRangeIndex();
+
+    void build(const AttendanceMatrix& matrix);
+    // Rebuilds only when the matrix changed since the last build
+    void refresh(const AttendanceMatrix& matrix);
+    bool isCurrent(const AttendanceMatrix& matrix) const;
+    RowWrite beforeWrite(const AttendanceMatrix& matrix, const std::string& date) const;
+    void afterWrite(const AttendanceMatrix& matrix, const std::string& date, const RowWrite& before);
+
+    size_t getSessionCount() const { return sessionCount; }
+    size_t getColumnCount() const { return columnCount; }
+
+    // Totals for one column over sessions [first, last)
+    uint32_t presentInRange(size_t column, size_t first, size_t last) const;
+    uint32_t recordedInRange(size_t column, size_t first, size_t last) const;
+
+    // Totals for every column over sessions [first, last) in one pass
+    void rangeCounts(size_t first, size_t last,
+                     std::vector<uint32_t>& present, std::vector<uint32_t>& recorded) const;
+
+private:
+    uint32_t prefix(const std::vector<uint32_t>& tree, size_t column, size_t count) const;
+    void addPrefix(const std::vector<uint32_t>& tree, size_t count, uint32_t* out, bool subtract) const;
+    void appendSession(const AttendanceMatrix& matrix);
+    void applyDiff(std::vector<uint32_t>& tree, size_t session, const uint64_t* before, const uint64_t* after, size_t words);
+};
+
+#endif // ATTENDANCE_RANGE_INDEX_H
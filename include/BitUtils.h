@@ -0,0 +1,171 @@
+#ifndef BIT_UTILS_H
+#define BIT_UTILS_H
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BIT_UTILS_SSE2 1
+#endif
+
+// Word-array bit kernels shared by the roster bitmaps and attendance bitsets.
+// Everything is inline so the single-file industrial build can use it too.
+// The SSE2 paths process two 64-bit words per step and count bits with a
+// SWAR reduction summed by _mm_sad_epu8; other targets fall back to scalar.
+class BitUtils {
+public:
+    static int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    static uint64_t popcountWords(const uint64_t* words, size_t count) {
+        uint64_t total = 0;
+        size_t i = 0;
+#ifdef BIT_UTILS_SSE2
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 2 <= count; i += 2) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+            acc = _mm_add_epi64(acc, popcount128(v));
+        }
+        total = horizontalSum(acc);
+#endif
+        for (; i < count; ++i) total += popcount64(words[i]);
+        return total;
+    }
+
+    // out = a & b, returns popcount(out)
+    static uint64_t andWords(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count) {
+        return combine<OpAnd>(a, b, out, count);
+    }
+
+    // out = a | b, returns popcount(out)
+    static uint64_t orWords(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count) {
+        return combine<OpOr>(a, b, out, count);
+    }
+
+    // out = a & ~b, returns popcount(out)
+    static uint64_t andNotWords(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count) {
+        return combine<OpAndNot>(a, b, out, count);
+    }
+
+    // popcount(a & b) without materialising the result
+    static uint64_t andCount(const uint64_t* a, const uint64_t* b, size_t count) {
+        return combine<OpAnd>(a, b, nullptr, count);
+    }
+
+    // Adds a 1-bit-per-column row into bit-sliced counters. planes holds
+    // planeCount planes of wordCount words; bit c of plane p is bit p of the
+    // running count for column c. The carry usually dies out in a plane or two.
+    static void bitSlicedAdd(uint64_t* planes, size_t planeCount, size_t wordCount, const uint64_t* row) {
+        size_t i = 0;
+#ifdef BIT_UTILS_SSE2
+        for (; i + 2 <= wordCount; i += 2) {
+            __m128i carry = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+            for (size_t p = 0; p < planeCount; ++p) {
+                __m128i* plane = reinterpret_cast<__m128i*>(planes + p * wordCount + i);
+                __m128i current = _mm_loadu_si128(plane);
+                __m128i nextCarry = _mm_and_si128(current, carry);
+                _mm_storeu_si128(plane, _mm_xor_si128(current, carry));
+                carry = nextCarry;
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(carry, _mm_setzero_si128())) == 0xFFFF) break;
+            }
+        }
+#endif
+        for (; i < wordCount; ++i) {
+            uint64_t carry = row[i];
+            for (size_t p = 0; p < planeCount && carry; ++p) {
+                uint64_t& plane = planes[p * wordCount + i];
+                uint64_t nextCarry = plane & carry;
+                plane ^= carry;
+                carry = nextCarry;
+            }
+        }
+    }
+
+    static size_t wordsFor(size_t bits) { return (bits + 63) / 64; }
+
+    static bool testBit(const uint64_t* words, size_t bit) {
+        return (words[bit >> 6] >> (bit & 63)) & 1ULL;
+    }
+
+    static void setBit(uint64_t* words, size_t bit) {
+        words[bit >> 6] |= (1ULL << (bit & 63));
+    }
+
+    static void clearBit(uint64_t* words, size_t bit) {
+        words[bit >> 6] &= ~(1ULL << (bit & 63));
+    }
+
+private:
+    struct OpAnd {
+        static uint64_t apply(uint64_t a, uint64_t b) { return a & b; }
+#ifdef BIT_UTILS_SSE2
+        static __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+    };
+
+    struct OpOr {
+        static uint64_t apply(uint64_t a, uint64_t b) { return a | b; }
+#ifdef BIT_UTILS_SSE2
+        static __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+    };
+
+    struct OpAndNot {
+        static uint64_t apply(uint64_t a, uint64_t b) { return a & ~b; }
+#ifdef BIT_UTILS_SSE2
+        static __m128i apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+    };
+
+    template <typename Op>
+    static uint64_t combine(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count) {
+        uint64_t total = 0;
+        size_t i = 0;
+#ifdef BIT_UTILS_SSE2
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 2 <= count; i += 2) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i r = Op::apply(va, vb);
+            if (out) _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+            acc = _mm_add_epi64(acc, popcount128(r));
+        }
+        total = horizontalSum(acc);
+#endif
+        for (; i < count; ++i) {
+            uint64_t r = Op::apply(a[i], b[i]);
+            if (out) out[i] = r;
+            total += popcount64(r);
+        }
+        return total;
+    }
+
+#ifdef BIT_UTILS_SSE2
+    // Per-64-bit-lane popcount using only SSE2
+    static __m128i popcount128(__m128i v) {
+        const __m128i m1 = _mm_set1_epi8(0x55);
+        const __m128i m2 = _mm_set1_epi8(0x33);
+        const __m128i m4 = _mm_set1_epi8(0x0F);
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+        v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+        v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+        return _mm_sad_epu8(v, _mm_setzero_si128());
+    }
+
+    static uint64_t horizontalSum(__m128i v) {
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(v)) +
+               static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v)));
+    }
+#endif
+};
+
+#endif // BIT_UTILS_H
@@ -0,0 +1,694 @@
+#ifndef COLUMNAR_FILE_H
+#define COLUMNAR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <algorithm>
+#include "Parallel.h"
+
+// Self-describing columnar file for analytics extracts, one table per file.
+//
+//   "SMSCOL01"
+//   column chunks, row group by row group
+//   footer: table name, schema, and for every row group its row count and,
+//           per column, offset, size, encoding and min/max statistics
+//   u32 footer length, "SMSCOL01"
+//
+// Readers load only the footer, use the statistics to skip row groups that
+// cannot match a predicate, and then read just the column chunks they need.
+// Integers and booleans are bit-packed against the chunk minimum or
+// run-length encoded, whichever is smaller; strings use a per-chunk
+// dictionary (codes encoded like integers) when few values repeat; doubles
+// are stored as-is. All multi-byte values are little-endian.
+class ColumnarFile {
+public:
+    enum Type : uint8_t { Int, Double, String, Bool };
+    enum Encoding : uint8_t { Plain, BitPacked, RunLength, Dictionary };
+
+    static constexpr char MAGIC[8] = {'S', 'M', 'S', 'C', 'O', 'L', '0', '1'};
+    static constexpr size_t DEFAULT_ROW_GROUP_ROWS = 65536;
+    // Readers refuse larger row groups, so a damaged footer can't make them
+    // allocate more than this many values per chunk
+    static constexpr size_t MAX_ROW_GROUP_ROWS = 1 << 20;
+
+    struct Column {
+        std::string name;
+        Type type;
+    };
+
+    // Min/max of one column chunk; ints also hold Bool columns as 0/1
+    struct Stats {
+        int64_t minInt = 0, maxInt = 0;
+        double minDouble = 0.0, maxDouble = 0.0;
+        std::string minString, maxString;
+    };
+
+    struct Chunk {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        Encoding encoding = Plain;
+        Stats stats;
+    };
+
+    struct RowGroup {
+        uint64_t firstRow = 0;
+        uint64_t rows = 0;
+        std::vector<Chunk> chunks;
+    };
+
+    static const char* typeName(Type type) {
+        static const char* const names[] = {"int", "double", "string", "bool"};
+        return type <= Bool ? names[type] : "?";
+    }
+
+    static const char* encodingName(Encoding encoding) {
+        static const char* const names[] = {"plain", "bitpacked", "rle", "dictionary"};
+        return encoding <= Dictionary ? names[encoding] : "?";
+    }
+
+    // Byte-level helpers shared by the writer and the reader
+    static void putU8(std::string& out, uint8_t value) { out += static_cast<char>(value); }
+
+    static void putU32(std::string& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) out += static_cast<char>(value >> (8 * i));
+    }
+
+    static void putU64(std::string& out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) out += static_cast<char>(value >> (8 * i));
+    }
+
+    static void putVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    static size_t varintSize(uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    static void putString(std::string& out, std::string_view text) {
+        putVarint(out, text.size());
+        out.append(text.data(), text.size());
+    }
+
+    // Bounds-checked cursor; any overrun clears ok and yields zeros
+    struct ByteReader {
+        const char* data;
+        size_t size;
+        size_t pos;
+        bool ok;
+
+        ByteReader(const char* data, size_t size) : data(data), size(size), pos(0), ok(true) {}
+
+        bool has(size_t count) {
+            if (size - pos < count) ok = false;
+            return ok;
+        }
+
+        uint8_t u8() { return has(1) ? static_cast<uint8_t>(data[pos++]) : 0; }
+
+        uint32_t u32() {
+            if (!has(4)) return 0;
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(static_cast<uint8_t>(data[pos++])) << (8 * i);
+            return value;
+        }
+
+        uint64_t u64() {
+            if (!has(8)) return 0;
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos++])) << (8 * i);
+            return value;
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = u8();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80) || !ok) return value;
+            }
+            ok = false;
+            return 0;
+        }
+
+        std::string_view string() {
+            uint64_t length = varint();
+            if (!has(length)) return std::string_view();
+            std::string_view text(data + pos, length);
+            pos += length;
+            return text;
+        }
+    };
+
+    // Integer block: encoding byte, then the bit-packed or run-length body
+    static Encoding encodeInts(const int64_t* values, size_t count, std::string& out) {
+        if (count == 0) {
+            putU8(out, BitPacked);
+            putU64(out, 0);
+            putU8(out, 0);
+            return BitPacked;
+        }
+        int64_t minValue = values[0], maxValue = values[0];
+        size_t runBytes = 0;
+        size_t runs = 0;
+        for (size_t i = 0; i < count;) {
+            size_t end = i + 1;
+            while (end < count && values[end] == values[i]) ++end;
+            minValue = std::min(minValue, values[i]);
+            maxValue = std::max(maxValue, values[i]);
+            runs++;
+            i = end;
+        }
+        for (size_t i = 0; i < count;) {
+            size_t end = i + 1;
+            while (end < count && values[end] == values[i]) ++end;
+            runBytes += varintSize(static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(minValue)) + varintSize(end - i);
+            i = end;
+        }
+        unsigned width = bitWidth(static_cast<uint64_t>(maxValue) - static_cast<uint64_t>(minValue));
+        size_t packedBytes = 8 * ((count * width + 63) / 64);
+
+        if (runBytes + varintSize(runs) < packedBytes) {
+            putU8(out, RunLength);
+            putU64(out, static_cast<uint64_t>(minValue));
+            putVarint(out, runs);
+            for (size_t i = 0; i < count;) {
+                size_t end = i + 1;
+                while (end < count && values[end] == values[i]) ++end;
+                putVarint(out, static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(minValue));
+                putVarint(out, end - i);
+                i = end;
+            }
+            return RunLength;
+        }
+
+        putU8(out, BitPacked);
+        putU64(out, static_cast<uint64_t>(minValue));
+        putU8(out, static_cast<uint8_t>(width));
+        std::vector<uint64_t> words((count * width + 63) / 64, 0);
+        for (size_t i = 0; i < count && width > 0; ++i) {
+            uint64_t delta = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(minValue);
+            size_t bit = i * width;
+            size_t word = bit / 64;
+            unsigned offset = bit % 64;
+            words[word] |= delta << offset;
+            if (offset + width > 64) words[word + 1] |= delta >> (64 - offset);
+        }
+        for (uint64_t word : words) putU64(out, word);
+        return BitPacked;
+    }
+
+    // count comes from the footer, so the chunk must be shown to hold that
+    // many values before anything is allocated
+    static bool decodeInts(ByteReader& in, size_t count, std::vector<int64_t>& values) {
+        if (count > MAX_ROW_GROUP_ROWS) return false;
+        uint8_t encoding = in.u8();
+        uint64_t minValue = in.u64();
+        if (encoding == RunLength) {
+            uint64_t runs = in.varint();
+            if (!in.ok || runs > count || !in.has(runs * 2)) return false; // Two varints per run
+            values.resize(count);
+            size_t row = 0;
+            for (uint64_t r = 0; r < runs && in.ok; ++r) {
+                int64_t value = static_cast<int64_t>(minValue + in.varint());
+                uint64_t length = in.varint();
+                if (length > count - row) return false;
+                std::fill(values.begin() + row, values.begin() + row + length, value);
+                row += length;
+            }
+            return in.ok && row == count;
+        }
+        if (encoding != BitPacked) return false;
+        unsigned width = in.u8();
+        if (width > 64) return false;
+        size_t wordCount = (count * width + 63) / 64;
+        if (!in.has(wordCount * 8)) return false;
+        values.resize(count);
+        uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+        std::vector<uint64_t> words(wordCount);
+        for (auto& word : words) word = in.u64();
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t delta = 0;
+            if (width > 0) {
+                size_t bit = i * width;
+                size_t word = bit / 64;
+                unsigned offset = bit % 64;
+                delta = words[word] >> offset;
+                if (offset + width > 64) delta |= words[word + 1] << (64 - offset);
+            }
+            values[i] = static_cast<int64_t>(minValue + (delta & mask));
+        }
+        return in.ok;
+    }
+
+    static unsigned bitWidth(uint64_t value) {
+        return value == 0 ? 0 : 64 - __builtin_clzll(value);
+    }
+};
+
+// Writer input: one table, column by column. String columns hold views
+// into the caller's records, which must outlive the write.
+class ColumnarTable {
+public:
+    struct ColumnData {
+        ColumnarFile::Column column;
+        std::vector<int64_t> ints; // Int and Bool
+        std::vector<double> doubles;
+        std::vector<std::string_view> strings;
+
+        size_t size() const {
+            switch (column.type) {
+                case ColumnarFile::Double: return doubles.size();
+                case ColumnarFile::String: return strings.size();
+                default: return ints.size();
+            }
+        }
+    };
+
+    std::string name;
+    std::vector<ColumnData> columns;
+
+    explicit ColumnarTable(const std::string& name) : name(name) {}
+
+    // Returns the column's index; add every column before filling any
+    size_t addColumn(const std::string& columnName, ColumnarFile::Type type) {
+        columns.emplace_back();
+        columns.back().column = {columnName, type};
+        return columns.size() - 1;
+    }
+
+    void reserve(size_t rows) {
+        for (auto& data : columns) {
+            switch (data.column.type) {
+                case ColumnarFile::Double: data.doubles.reserve(rows); break;
+                case ColumnarFile::String: data.strings.reserve(rows); break;
+                default: data.ints.reserve(rows); break;
+            }
+        }
+    }
+
+    size_t rowCount() const { return columns.empty() ? 0 : columns[0].size(); }
+};
+
+struct ColumnarWriteStats {
+    size_t rows = 0;
+    size_t rowGroups = 0;
+    size_t bytes = 0;
+    size_t threads = 0;
+};
+
+class ColumnarWriter {
+public:
+    // Encodes every (row group, column) chunk in parallel, then writes them
+    // in order followed by the footer
+    static bool write(const std::string& filename, const ColumnarTable& table, ColumnarWriteStats& stats,
+                      std::string& error, size_t rowGroupRows = ColumnarFile::DEFAULT_ROW_GROUP_ROWS,
+                      size_t threadCount = 0) {
+        size_t rows = table.rowCount();
+        for (const auto& data : table.columns) {
+            if (data.size() != rows) {
+                error = "column '" + data.column.name + "' has " + std::to_string(data.size()) +
+                        " values, expected " + std::to_string(rows);
+                return false;
+            }
+        }
+        rowGroupRows = std::clamp<size_t>(rowGroupRows, 1, ColumnarFile::MAX_ROW_GROUP_ROWS);
+        size_t groupCount = (rows + rowGroupRows - 1) / rowGroupRows;
+        size_t columnCount = table.columns.size();
+
+        std::vector<ColumnarFile::RowGroup> groups(groupCount);
+        std::vector<std::string> payloads(groupCount * columnCount);
+        for (size_t g = 0; g < groupCount; ++g) {
+            groups[g].firstRow = g * rowGroupRows;
+            groups[g].rows = std::min(rowGroupRows, rows - groups[g].firstRow);
+            groups[g].chunks.resize(columnCount);
+        }
+        size_t jobs = groupCount * columnCount;
+        stats.threads = Parallel::threadCount(threadCount, jobs);
+        Parallel::forEach(jobs, stats.threads, [&](size_t job) {
+            size_t g = job / columnCount;
+            size_t c = job % columnCount;
+            encodeChunk(table.columns[c], groups[g].firstRow, groups[g].rows, groups[g].chunks[c], payloads[job]);
+        });
+
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error = "cannot open " + filename;
+            return false;
+        }
+        uint64_t offset = sizeof(ColumnarFile::MAGIC);
+        file.write(ColumnarFile::MAGIC, sizeof(ColumnarFile::MAGIC));
+        for (size_t g = 0; g < groupCount; ++g) {
+            for (size_t c = 0; c < columnCount; ++c) {
+                const std::string& payload = payloads[g * columnCount + c];
+                groups[g].chunks[c].offset = offset;
+                groups[g].chunks[c].size = payload.size();
+                file.write(payload.data(), payload.size());
+                offset += payload.size();
+            }
+        }
+
+        std::string footer;
+        writeFooter(table, rows, groups, footer);
+        std::string tail;
+        ColumnarFile::putU32(tail, static_cast<uint32_t>(footer.size()));
+        tail.append(ColumnarFile::MAGIC, sizeof(ColumnarFile::MAGIC));
+        file.write(footer.data(), footer.size());
+        file.write(tail.data(), tail.size());
+        file.close();
+        if (!file) {
+            error = "write failed for " + filename;
+            return false;
+        }
+        stats.rows = rows;
+        stats.rowGroups = groupCount;
+        stats.bytes = offset + footer.size() + tail.size();
+        return true;
+    }
+
+private:
+    static void encodeChunk(const ColumnarTable::ColumnData& data, size_t first, size_t count,
+                            ColumnarFile::Chunk& chunk, std::string& out) {
+        ColumnarFile::Stats& stats = chunk.stats;
+        switch (data.column.type) {
+            case ColumnarFile::Int:
+            case ColumnarFile::Bool: {
+                const int64_t* values = data.ints.data() + first;
+                if (count > 0) {
+                    auto range = std::minmax_element(values, values + count);
+                    stats.minInt = *range.first;
+                    stats.maxInt = *range.second;
+                }
+                chunk.encoding = ColumnarFile::encodeInts(values, count, out);
+                break;
+            }
+            case ColumnarFile::Double: {
+                const double* values = data.doubles.data() + first;
+                if (count > 0) {
+                    auto range = std::minmax_element(values, values + count);
+                    stats.minDouble = *range.first;
+                    stats.maxDouble = *range.second;
+                }
+                chunk.encoding = ColumnarFile::Plain;
+                ColumnarFile::putU8(out, ColumnarFile::Plain);
+                for (size_t i = 0; i < count; ++i) {
+                    uint64_t bits;
+                    std::memcpy(&bits, &values[i], sizeof(bits));
+                    ColumnarFile::putU64(out, bits);
+                }
+                break;
+            }
+            case ColumnarFile::String:
+                encodeStrings(data.strings.data() + first, count, chunk, out);
+                break;
+        }
+    }
+
+    // Dictionary when at most half the values are distinct, plain otherwise
+    static void encodeStrings(const std::string_view* values, size_t count, ColumnarFile::Chunk& chunk, std::string& out) {
+        ColumnarFile::Stats& stats = chunk.stats;
+        std::unordered_map<std::string_view, int64_t> codes;
+        std::vector<std::string_view> dictionary;
+        std::vector<int64_t> rowCodes(count);
+        size_t limit = std::max<size_t>(1, count / 2);
+        bool useDictionary = true;
+        std::string_view minValue, maxValue;
+        for (size_t i = 0; i < count; ++i) {
+            if (i == 0 || values[i] < minValue) minValue = values[i];
+            if (i == 0 || values[i] > maxValue) maxValue = values[i];
+            if (!useDictionary) continue;
+            auto inserted = codes.emplace(values[i], static_cast<int64_t>(dictionary.size()));
+            if (inserted.second) {
+                dictionary.push_back(values[i]);
+                if (dictionary.size() > limit) useDictionary = false;
+            }
+            rowCodes[i] = inserted.first->second;
+        }
+        stats.minString.assign(minValue.data(), minValue.size());
+        stats.maxString.assign(maxValue.data(), maxValue.size());
+
+        if (useDictionary) {
+            chunk.encoding = ColumnarFile::Dictionary;
+            ColumnarFile::putU8(out, ColumnarFile::Dictionary);
+            ColumnarFile::putVarint(out, dictionary.size());
+            for (std::string_view entry : dictionary) ColumnarFile::putString(out, entry);
+            ColumnarFile::encodeInts(rowCodes.data(), count, out);
+        } else {
+            chunk.encoding = ColumnarFile::Plain;
+            ColumnarFile::putU8(out, ColumnarFile::Plain);
+            for (size_t i = 0; i < count; ++i) ColumnarFile::putString(out, values[i]);
+        }
+    }
+
+    static void writeFooter(const ColumnarTable& table, size_t rows,
+                            const std::vector<ColumnarFile::RowGroup>& groups, std::string& footer) {
+        ColumnarFile::putString(footer, table.name);
+        ColumnarFile::putVarint(footer, table.columns.size());
+        for (const auto& data : table.columns) {
+            ColumnarFile::putString(footer, data.column.name);
+            ColumnarFile::putU8(footer, data.column.type);
+        }
+        ColumnarFile::putU64(footer, rows);
+        ColumnarFile::putVarint(footer, groups.size());
+        for (const auto& group : groups) {
+            ColumnarFile::putU64(footer, group.rows);
+            for (size_t c = 0; c < group.chunks.size(); ++c) {
+                const ColumnarFile::Chunk& chunk = group.chunks[c];
+                ColumnarFile::putU64(footer, chunk.offset);
+                ColumnarFile::putU64(footer, chunk.size);
+                ColumnarFile::putU8(footer, chunk.encoding);
+                switch (table.columns[c].column.type) {
+                    case ColumnarFile::Double: {
+                        uint64_t bits[2];
+                        std::memcpy(&bits[0], &chunk.stats.minDouble, 8);
+                        std::memcpy(&bits[1], &chunk.stats.maxDouble, 8);
+                        ColumnarFile::putU64(footer, bits[0]);
+                        ColumnarFile::putU64(footer, bits[1]);
+                        break;
+                    }
+                    case ColumnarFile::String:
+                        ColumnarFile::putString(footer, chunk.stats.minString);
+                        ColumnarFile::putString(footer, chunk.stats.maxString);
+                        break;
+                    default:
+                        ColumnarFile::putU64(footer, static_cast<uint64_t>(chunk.stats.minInt));
+                        ColumnarFile::putU64(footer, static_cast<uint64_t>(chunk.stats.maxInt));
+                        break;
+                }
+            }
+        }
+    }
+};
+
+// Opens a columnar file by its footer; column chunks are read on demand
+class ColumnarReader {
+private:
+    std::ifstream file;
+    std::string tableName;
+    std::vector<ColumnarFile::Column> columns;
+    std::vector<ColumnarFile::RowGroup> groups;
+    uint64_t rowCount;
+    std::string error;
+
+public:
+    ColumnarReader() : rowCount(0) {}
+
+    bool open(const std::string& filename) {
+        const size_t tailSize = 4 + sizeof(ColumnarFile::MAGIC);
+        file.open(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return fail("cannot open " + filename);
+        std::streamoff fileSize = file.tellg();
+        if (fileSize < static_cast<std::streamoff>(sizeof(ColumnarFile::MAGIC) + tailSize)) return fail("file too short");
+
+        std::string head = readAt(0, sizeof(ColumnarFile::MAGIC));
+        std::string tail = readAt(fileSize - tailSize, tailSize);
+        if (head.size() != sizeof(ColumnarFile::MAGIC) || tail.size() != tailSize ||
+            head.compare(0, std::string::npos, ColumnarFile::MAGIC, sizeof(ColumnarFile::MAGIC)) != 0 ||
+            tail.compare(4, std::string::npos, ColumnarFile::MAGIC, sizeof(ColumnarFile::MAGIC)) != 0) {
+            return fail("not a columnar file");
+        }
+        ColumnarFile::ByteReader tailReader(tail.data(), tail.size());
+        uint64_t footerSize = tailReader.u32();
+        if (footerSize > static_cast<uint64_t>(fileSize) - tailSize - sizeof(ColumnarFile::MAGIC)) return fail("bad footer length");
+        std::string footer = readAt(fileSize - tailSize - footerSize, footerSize);
+        return parseFooter(footer, fileSize - tailSize - footerSize);
+    }
+
+    const std::string& getError() const { return error; }
+    const std::string& getTableName() const { return tableName; }
+    const std::vector<ColumnarFile::Column>& getColumns() const { return columns; }
+    const std::vector<ColumnarFile::RowGroup>& getRowGroups() const { return groups; }
+    uint64_t getRowCount() const { return rowCount; }
+
+    int findColumn(const std::string& name) const {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            if (columns[c].name == name) return static_cast<int>(c);
+        }
+        return -1;
+    }
+
+    // Row groups whose [min, max] for an Int/Bool column overlaps [low, high]
+    std::vector<size_t> rowGroupsOverlapping(size_t column, int64_t low, int64_t high) const {
+        std::vector<size_t> matches;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            const ColumnarFile::Stats& stats = groups[g].chunks[column].stats;
+            if (stats.maxInt >= low && stats.minInt <= high) matches.push_back(g);
+        }
+        return matches;
+    }
+
+    std::vector<size_t> rowGroupsOverlapping(size_t column, const std::string& low, const std::string& high) const {
+        std::vector<size_t> matches;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            const ColumnarFile::Stats& stats = groups[g].chunks[column].stats;
+            if (stats.maxString >= low && stats.minString <= high) matches.push_back(g);
+        }
+        return matches;
+    }
+
+    bool readInts(size_t group, size_t column, std::vector<int64_t>& values) {
+        std::string payload;
+        if (!loadChunk(group, column, ColumnarFile::Int, payload)) return false;
+        ColumnarFile::ByteReader in(payload.data(), payload.size());
+        return ColumnarFile::decodeInts(in, groups[group].rows, values) || fail("corrupt integer chunk");
+    }
+
+    bool readDoubles(size_t group, size_t column, std::vector<double>& values) {
+        std::string payload;
+        if (!loadChunk(group, column, ColumnarFile::Double, payload)) return false;
+        ColumnarFile::ByteReader in(payload.data(), payload.size());
+        size_t count = groups[group].rows;
+        if (in.u8() != ColumnarFile::Plain || !in.has(count * 8)) return fail("corrupt double chunk");
+        values.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t bits = in.u64();
+            std::memcpy(&values[i], &bits, sizeof(bits));
+        }
+        return true;
+    }
+
+    bool readStrings(size_t group, size_t column, std::vector<std::string>& values) {
+        std::string payload;
+        if (!loadChunk(group, column, ColumnarFile::String, payload)) return false;
+        ColumnarFile::ByteReader in(payload.data(), payload.size());
+        size_t count = groups[group].rows;
+        uint8_t encoding = in.u8();
+        if (encoding == ColumnarFile::Dictionary) {
+            uint64_t entries = in.varint();
+            if (entries > payload.size()) return fail("corrupt dictionary chunk");
+            std::vector<std::string_view> dictionary(entries);
+            for (auto& entry : dictionary) entry = in.string();
+            std::vector<int64_t> codes;
+            if (!in.ok || !ColumnarFile::decodeInts(in, count, codes)) return fail("corrupt dictionary chunk");
+            values.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                if (codes[i] < 0 || static_cast<size_t>(codes[i]) >= dictionary.size()) return fail("bad dictionary code");
+                values[i].assign(dictionary[codes[i]].data(), dictionary[codes[i]].size());
+            }
+            return true;
+        }
+        if (encoding != ColumnarFile::Plain) return fail("unknown string encoding");
+        if (!in.has(count)) return fail("corrupt string chunk"); // At least a length byte each
+        values.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::string_view text = in.string();
+            values[i].assign(text.data(), text.size());
+        }
+        return in.ok || fail("corrupt string chunk");
+    }
+
+private:
+    bool fail(const std::string& message) {
+        error = message;
+        return false;
+    }
+
+    std::string readAt(uint64_t offset, uint64_t size) {
+        std::string bytes(size, '\0');
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(offset));
+        if (size > 0) file.read(&bytes[0], static_cast<std::streamsize>(size));
+        if (!file) bytes.clear();
+        return bytes;
+    }
+
+    bool loadChunk(size_t group, size_t column, ColumnarFile::Type type, std::string& payload) {
+        if (group >= groups.size() || column >= columns.size()) return fail("no such row group or column");
+        ColumnarFile::Type actual = columns[column].type;
+        bool intLike = type == ColumnarFile::Int && actual == ColumnarFile::Bool;
+        if (actual != type && !intLike) return fail("column '" + columns[column].name + "' is " + ColumnarFile::typeName(actual));
+        const ColumnarFile::Chunk& chunk = groups[group].chunks[column];
+        payload = readAt(chunk.offset, chunk.size);
+        if (payload.size() != chunk.size) return fail("truncated column chunk");
+        return true;
+    }
+
+    bool parseFooter(const std::string& footer, uint64_t dataEnd) {
+        ColumnarFile::ByteReader in(footer.data(), footer.size());
+        tableName = std::string(in.string());
+        uint64_t columnCount = in.varint();
+        if (!in.ok || columnCount > footer.size()) return fail("corrupt footer");
+        columns.resize(columnCount);
+        for (auto& column : columns) {
+            column.name = std::string(in.string());
+            uint8_t type = in.u8();
+            if (type > ColumnarFile::Bool) return fail("unknown column type");
+            column.type = static_cast<ColumnarFile::Type>(type);
+        }
+        rowCount = in.u64();
+        uint64_t groupCount = in.varint();
+        // Each group takes a row count plus at least 17 bytes per column
+        if (!in.ok || groupCount > footer.size() / (8 + 17 * columnCount)) return fail("corrupt footer");
+        groups.resize(groupCount);
+        uint64_t firstRow = 0;
+        for (auto& group : groups) {
+            group.firstRow = firstRow;
+            group.rows = in.u64();
+            if (group.rows > ColumnarFile::MAX_ROW_GROUP_ROWS) return fail("row group too large");
+            firstRow += group.rows;
+            group.chunks.resize(columnCount);
+            for (size_t c = 0; c < columnCount; ++c) {
+                ColumnarFile::Chunk& chunk = group.chunks[c];
+                chunk.offset = in.u64();
+                chunk.size = in.u64();
+                chunk.encoding = static_cast<ColumnarFile::Encoding>(in.u8());
+                if (chunk.offset > dataEnd || chunk.size > dataEnd - chunk.offset) return fail("chunk outside data section");
+                switch (columns[c].type) {
+                    case ColumnarFile::Double: {
+                        uint64_t bits[2] = {in.u64(), in.u64()};
+                        std::memcpy(&chunk.stats.minDouble, &bits[0], 8);
+                        std::memcpy(&chunk.stats.maxDouble, &bits[1], 8);
+                        break;
+                    }
+                    case ColumnarFile::String:
+                        chunk.stats.minString = std::string(in.string());
+                        chunk.stats.maxString = std::string(in.string());
+                        break;
+                    default:
+                        chunk.stats.minInt = static_cast<int64_t>(in.u64());
+                        chunk.stats.maxInt = static_cast<int64_t>(in.u64());
+                        break;
+                }
+            }
+        }
+        if (!in.ok || firstRow != rowCount) return fail("corrupt footer");
+        return true;
+    }
+};
+
+#endif // COLUMNAR_FILE_H
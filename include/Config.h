@@ -1,22 +1,96 @@
-#define CONFIG_H
+#ifndef CONFIG_H
 #define CONFIG_H
 
+#include "VersionedSnapshot.h"
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// One setting, parsed once when its snapshot is built so readers never
+// convert "50" again
+struct ConfigValue {
+    std::string text;
+    bool isNumber = false;
+    long long number = 0;
+    bool isFlag = false;   // true/false, yes/no, on/off, 1/0
+    bool flag = false;
+    std::string path;      // text as a normalised path
+};
+
+// Immutable version of every setting. A new one replaces it on each change;
+// readers holding this one keep a consistent view meanwhile.
+struct ConfigSnapshot {
+    std::unordered_map<std::string, ConfigValue> settings;
+    uint64_t generation = 0;
+    
+    // The settings hot paths ask for, pre-parsed
+    int maxStudentsPerCourse = 50;
+    int maxCoursesPerClassroom = 5;
+    bool backupEnabled = true;
+    
+    const ConfigValue* find(const std::string& key) const;
+};
 
+// Process-wide settings. Reads are lock-free: each thread keeps the snapshot
+// it last used and only swaps it when the generation counter moves. Writers
+// (set, loadFromFile, hot reload) serialise on a mutex, copy the current
+// settings and publish the copy.
 class Config {
 private:
-    static Config* instance;
-    std::unordered_map<std::string, std::string> settings;
+    Versioned<ConfigSnapshot> current;
+    std::atomic<uint64_t> generation{0};
+    std::mutex writeMutex;
+    
+    // Hot reload (Linux, inotify)
+    std::thread watcher;
+    int inotifyFd = -1;
+    int wakeFd = -1;
+    std::string watchedFile;
+    std::atomic<uint64_t> reloads{0};
+    
     Config();
+    const ConfigSnapshot& local() const;
+    void publish(std::unordered_map<std::string, std::string> settings);
+    void watchLoop(const std::string& name);
 
 public:
+    ~Config();
+    Config(const Config&) = delete;
+    Config& operator=(const Config&) = delete;
+    
     static Config* getInstance();
     bool loadFromFile(const std::string& filename);
     std::string get(const std::string& key, const std::string& defaultValue = "");
     void set(const std::string& key, const std::string& value);
     bool saveToFile(const std::string& filename);
     
+    // Puts every setting back as it was in previous, dropping keys set since
+    void restore(const ConfigSnapshot& previous);
+    
+    // Typed reads from the pre-parsed values; defaultValue when the key is
+    // missing or doesn't parse as that type
+    int getInt(const std::string& key, int defaultValue = 0) const;
+    bool getBool(const std::string& key, bool defaultValue = false) const;
+    std::string getPath(const std::string& key, const std::string& defaultValue = "") const;
+    int maxStudentsPerCourse() const { return local().maxStudentsPerCourse; }
+    int maxCoursesPerClassroom() const { return local().maxCoursesPerClassroom; }
+    bool backupEnabled() const { return local().backupEnabled; }
+    
+    // The whole current version, for reading several settings consistently
+    std::shared_ptr<const ConfigSnapshot> snapshot() const { return current.acquire(); }
+    uint64_t getGeneration() const { return generation.load(std::memory_order_acquire); }
+    
+    // Reloads filename whenever it is written or replaced, until stopWatching()
+    // or exit. Keys removed from the file keep their last value. Returns false
+    // where inotify is unavailable.
+    bool watch(const std::string& filename);
+    void stopWatching();
+    uint64_t getReloadCount() const { return reloads.load(std::memory_order_relaxed); }
+    
     // Default configuration values
     static const std::string STUDENTS_FILE;
     static const std::string TEACHERS_FILE;
@@ -25,4 +99,4 @@ public:
     static const std::string REPORTS_DIR;
 };
 
-// CONFIG_H
+#endif // CONFIG_H
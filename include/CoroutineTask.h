@@ -0,0 +1,274 @@
+#ifndef COROUTINE_TASK_H
+#define COROUTINE_TASK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <algorithm>
+
+// A few threads that resume suspended coroutines. An operation that waits
+// for I/O holds no thread while it waits, so thousands can be in flight on
+// an executor with two threads.
+class TaskExecutor {
+private:
+    std::vector<std::thread> threads;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<std::coroutine_handle<>> queue;
+    bool stopping = false;
+    std::atomic<uint64_t> resumed{0};
+    std::atomic<size_t> inFlight{0};
+
+public:
+    explicit TaskExecutor(size_t threadCount = 2) {
+        for (size_t i = 0; i < std::max<size_t>(1, threadCount); ++i) threads.emplace_back([this] { runQueue(); });
+    }
+
+    // Resumes whatever is already queued, then joins. Operations still
+    // suspended on I/O must have finished first.
+    ~TaskExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queue.push_back(handle);
+        }
+        queueReady.notify_one();
+    }
+
+    // co_await executor.schedule() continues on one of the executor's threads
+    auto schedule() {
+        struct Hop {
+            TaskExecutor& executor;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { executor.post(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Hop{*this};
+    }
+
+    size_t getThreadCount() const { return threads.size(); }
+    uint64_t getResumed() const { return resumed.load(std::memory_order_relaxed); }
+
+    // Operations started with spawn() that haven't finished
+    size_t getInFlight() const { return inFlight.load(std::memory_order_relaxed); }
+
+    void operationStarted() { inFlight.fetch_add(1, std::memory_order_relaxed); }
+    void operationFinished() { inFlight.fetch_sub(1, std::memory_order_relaxed); }
+
+private:
+    void runQueue() {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        while (true) {
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            std::coroutine_handle<> handle = queue.front();
+            queue.pop_front();
+            lock.unlock();
+            resumed.fetch_add(1, std::memory_order_relaxed);
+            handle.resume();
+            lock.lock();
+        }
+    }
+};
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // Hands straight on to whoever awaited this task, without a queue
+    auto final_suspend() noexcept {
+        struct Resume {
+            std::coroutine_handle<> next;
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept { return next; }
+            void await_resume() const noexcept {}
+        };
+        return Resume{continuation};
+    }
+
+    void unhandled_exception() { error = std::current_exception(); }
+
+    void rethrow() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+    template <typename U>
+    void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+    T take() {
+        rethrow();
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() {}
+    void take() { rethrow(); }
+};
+
+} // namespace detail
+
+// Lazy coroutine: nothing runs until the task is awaited (or handed to
+// spawn/syncWait), and it finishes on whichever thread last resumed it.
+// Exceptions thrown inside reach the awaiter.
+template <typename T>
+class Task {
+public:
+    typedef detail::TaskPromise<T> promise_type;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        handle.promise().continuation = awaiter;
+        return handle;
+    }
+    T await_resume() { return handle.promise().take(); }
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Eagerly started, self-destroying coroutine that drives a spawned task
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template <typename T>
+Detached drive(TaskExecutor& executor, Task<T> task, std::promise<T> result) {
+    co_await executor.schedule();
+    try {
+        if constexpr (std::is_void<T>::value) {
+            co_await std::move(task);
+            executor.operationFinished();
+            result.set_value();
+        } else {
+            T value = co_await std::move(task);
+            executor.operationFinished();
+            result.set_value(std::move(value));
+        }
+    } catch (...) {
+        executor.operationFinished();
+        result.set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+// Starts task on the executor and returns at once; the future holds its
+// result. The caller's thread is never used to run it.
+template <typename T>
+std::future<T> spawn(TaskExecutor& executor, Task<T> task) {
+    std::promise<T> result;
+    std::future<T> future = result.get_future();
+    executor.operationStarted();
+    detail::drive(executor, std::move(task), std::move(result));
+    return future;
+}
+
+// Synchronous wrapper: runs task on the executor and blocks until it is
+// done. Never call from one of the executor's own threads.
+template <typename T>
+T syncWait(TaskExecutor& executor, Task<T> task) {
+    return spawn(executor, std::move(task)).get();
+}
+
+// Suspends until a callback-style operation completes, then continues on
+// the executor. start(callback) begins the operation; callback(result) may
+// run on any thread, even before start returns.
+template <typename Result, typename Start>
+class CompletionAwaiter {
+private:
+    TaskExecutor& executor;
+    Start start;
+    Result result{};
+
+public:
+    CompletionAwaiter(TaskExecutor& executor, Start start) : executor(executor), start(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The coroutine may be resumed and gone before start returns, so
+        // nothing in the frame is touched after the call
+        Start begin = std::move(start);
+        begin([this, handle](const Result& done) {
+            result = done;
+            executor.post(handle);
+        });
+    }
+    Result await_resume() { return std::move(result); }
+};
+
+template <typename Result, typename Start>
+CompletionAwaiter<Result, Start> completion(TaskExecutor& executor, Start start) {
+    return CompletionAwaiter<Result, Start>(executor, std::move(start));
+}
+
+#endif // COROUTINE_TASK_H
@@ -5,9 +5,22 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include "AttendanceMatrix.h"
+#include "AttendanceRangeIndex.h"
 
 class Student;
 class Teacher;
+class RosterBitmap;
+
+// Outcome of marking one session for a whole class
+struct RollCallResult {
+    int courseId = 0;
+    std::string date;
+    int recorded = 0;            // enrolled students covered by the session
+    int present = 0;
+    std::vector<int> rejectedIds; // present IDs not on the roster
+    bool journaled = false;       // set by AttendanceJournal once the line is written
+};
 
 class Course {
 private:
@@ -18,7 +31,8 @@ private:
     int maxStudents;
     std::vector<std::weak_ptr<Student>> enrolledStudents;
     std::shared_ptr<Teacher> assignedTeacher;
-    std::unordered_map<int, std::unordered_map<std::string, bool>> attendanceRecords; // studentId -> date -> present
+    AttendanceMatrix attendance; // sessions x enrolled students
+    AttendanceRangeIndex attendanceIndex; // date-window queries, updated with every attendance write
 
 public:
     Course(int id, const std::string& name, const std::string& description = "", 
@@ -50,12 +64,26 @@ public:
     bool unenrollStudent(int studentId);
     bool isStudentEnrolled(int studentId) const;
     bool isFull() const { return enrolledStudents.size() >= static_cast<size_t>(maxStudents); }
+    std::vector<int> getEnrolledStudentIds() const;
+    RosterBitmap getRoster() const;
     
     // Attendance management
     void recordAttendance(int studentId, const std::string& date, bool isPresent);
+    void recordSessionAttendance(const std::string& date, const std::vector<int>& presentStudentIds);
+    RollCallResult recordRollCall(const std::string& date, const std::vector<int>& presentStudentIds);
+    RollCallResult recordRollCall(const std::string& date, const std::vector<int>& rosterIds,
+                                  const std::vector<int>& presentStudentIds);
+    // Presence evidence (e.g. card swipes): marks the listed enrolled students
+    // present and leaves every other cell of the session as it was
+    RollCallResult recordPresences(const std::string& date, const std::vector<int>& presentStudentIds);
     bool getAttendance(int studentId, const std::string& date) const;
     double getStudentAttendancePercentage(int studentId) const;
+    double getSessionAttendancePercentage(const std::string& date) const;
     std::unordered_map<int, double> getAllStudentAttendancePercentages() const;
+    // Date-window rates over sessions dated within [fromDate, toDate]
+    double getStudentAttendancePercentage(int studentId, const std::string& fromDate, const std::string& toDate) const;
+    std::unordered_map<int, double> getCohortAttendancePercentages(const std::string& fromDate, const std::string& toDate) const;
+    const AttendanceMatrix& getAttendanceMatrix() const { return attendance; }
     
     // File operations
     void saveToFile(const std::string& filename) const;
@@ -0,0 +1,117 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <initializer_list>
+
+// RFC 4180 parsing over an in-memory buffer: comma separated, CRLF or LF
+// record ends, double-quoted fields that may hold commas, quotes ("") and
+// line breaks. Header-only so the single-file industrial build can use it.
+//
+// For parallel parsing the buffer is first cut into chunks that end on
+// record boundaries (a single quote-aware scan), then each chunk is parsed
+// independently with parseRecord.
+class CsvReader {
+public:
+    static bool readFile(const std::string& filename, std::string& contents) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        contents.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        return contents.empty() || file.read(&contents[0], size).good();
+    }
+
+    // Offsets [0, b1, b2, ..., size] of chunks of roughly targetBytes, each
+    // starting at the beginning of a record
+    static std::vector<size_t> chunkBoundaries(const char* data, size_t size, size_t start, size_t targetBytes) {
+        std::vector<size_t> boundaries(1, start);
+        bool inQuotes = false;
+        size_t nextTarget = start + targetBytes;
+        for (size_t i = start; i < size; ++i) {
+            char c = data[i];
+            if (c == '"') {
+                inQuotes = !inQuotes;
+            } else if (c == '\n' && !inQuotes && i + 1 >= nextTarget && i + 1 < size) {
+                boundaries.push_back(i + 1);
+                nextTarget = i + 1 + targetBytes;
+            }
+        }
+        boundaries.push_back(size);
+        return boundaries;
+    }
+
+    // Parses the record starting at pos into fields (reusing their storage)
+    // and returns the offset of the next record
+    static size_t parseRecord(const char* data, size_t size, size_t pos, std::vector<std::string>& fields) {
+        size_t count = 0;
+        while (true) {
+            if (count == fields.size()) fields.emplace_back();
+            std::string& field = fields[count++];
+            field.clear();
+
+            if (pos < size && data[pos] == '"') {
+                ++pos;
+                while (pos < size) {
+                    char c = data[pos++];
+                    if (c == '"') {
+                        if (pos < size && data[pos] == '"') {
+                            field += '"';
+                            ++pos;
+                        } else {
+                            break;
+                        }
+                    } else {
+                        field += c;
+                    }
+                }
+            }
+
+            // Unquoted text, or anything trailing a closing quote
+            size_t runStart = pos;
+            while (pos < size && data[pos] != ',' && data[pos] != '\n' && data[pos] != '\r') ++pos;
+            field.append(data + runStart, pos - runStart);
+
+            if (pos < size && data[pos] == ',') {
+                ++pos;
+                continue;
+            }
+            if (pos < size && data[pos] == '\r') ++pos;
+            if (pos < size && data[pos] == '\n') ++pos;
+            break;
+        }
+        fields.resize(count);
+        return pos;
+    }
+
+    static bool isBlankRecord(const std::vector<std::string>& fields) {
+        return fields.size() == 1 && fields[0].empty();
+    }
+
+    // Lower-cased with spaces, underscores and hyphens removed, so
+    // "Student ID", "student_id" and "studentId" all compare equal
+    static std::string normalizeHeader(const std::string& name) {
+        std::string normalized;
+        for (char c : name) {
+            if (c == ' ' || c == '_' || c == '-' || c == '\t' || c == '\xEF' || c == '\xBB' || c == '\xBF') continue;
+            normalized += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        return normalized;
+    }
+
+    // Index of the first header column matching any of the (normalised)
+    // names, or -1
+    static int findColumn(const std::vector<std::string>& header, std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            for (size_t i = 0; i < header.size(); ++i) {
+                if (normalizeHeader(header[i]) == name) return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+#endif // CSV_READER_H
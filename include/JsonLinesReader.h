@@ -0,0 +1,478 @@
+#ifndef JSON_LINES_READER_H
+#define JSON_LINES_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define JSON_LINES_READER_SSE2 1
+#endif
+
+// JSON Lines (one object per line) parsed in two stages, simdjson style:
+//
+//  1. Structural index. The input is classified 64 bytes at a time into
+//     quote, backslash, structural ({ } [ ] : ,) and newline bitmasks.
+//     Escaped quotes are dropped, a prefix XOR of the remaining quotes gives
+//     the inside-string mask, and the offsets of every quote and of every
+//     structural character or newline outside a string are collected.
+//     Raw newlines can't occur inside a JSON string, so the mask restarts at
+//     each one: an unterminated quote costs its own line, not the rest.
+//  2. Tape walk. The index is walked one line at a time and each top-level
+//     key/value pair is handed to a handler. Scalars are the text between
+//     two structurals; strings without escapes point into the input, so
+//     only escaped strings are decoded.
+//
+// Handlers provide
+//   void beginRecord();
+//   void field(const char* key, size_t keyLength, JsonLinesReader::ValueType type,
+//              const char* value, size_t valueLength);
+//   void endRecord();
+//   void recordError(size_t line, const char* message); // record is dropped
+// Nested arrays and objects are passed through as their raw JSON text.
+class JsonLinesReader {
+public:
+    enum ValueType { String, Number, True, False, Null, Array, Object };
+
+    static constexpr size_t INDEX_BLOCK_BYTES = 1 << 20;
+
+    // Offsets [0, b1, ..., size] of chunks of roughly targetBytes that start
+    // at the beginning of a line. Raw newlines cannot occur inside JSON
+    // strings, so no quote tracking is needed.
+    static std::vector<size_t> chunkBoundaries(const char* data, size_t size, size_t targetBytes) {
+        std::vector<size_t> boundaries(1, 0);
+        size_t pos = targetBytes;
+        while (pos < size) {
+            const void* newline = std::memchr(data + pos - 1, '\n', size - pos + 1);
+            if (!newline) break;
+            size_t next = static_cast<const char*>(newline) - data + 1;
+            if (next >= size) break;
+            boundaries.push_back(next);
+            pos = next + targetBytes;
+        }
+        boundaries.push_back(size);
+        return boundaries;
+    }
+
+    // Stage 1: offsets of quotes, and of structurals and newlines outside
+    // strings, in ascending order
+    static void buildIndex(const char* data, size_t size, std::vector<uint32_t>& index) {
+        size_t used = 0;
+        uint64_t carryInString = 0; // all ones when the previous block ended inside a string
+        bool carryEscaped = false;  // first byte of the next block follows an odd backslash run
+        char tail[64];
+        for (size_t base = 0; base < size; base += 64) {
+            const char* block = data + base;
+            if (size - base < 64) {
+                std::memset(tail, ' ', sizeof(tail));
+                std::memcpy(tail, block, size - base);
+                block = tail;
+            }
+            BlockMasks masks = classify(block);
+            uint64_t escaped = 0;
+            if (masks.backslash || carryEscaped) escaped = escapedMask(masks.backslash, carryEscaped);
+            uint64_t quotes = masks.quote & ~escaped;
+            uint64_t inString = prefixXor(quotes) ^ carryInString;
+            for (uint64_t newlines = masks.newline; newlines; newlines &= newlines - 1) {
+                uint64_t bit = newlines & (~newlines + 1);
+                if (inString & bit) inString ^= ~(bit | (bit - 1)); // Outside again after it
+                inString &= ~bit;
+            }
+            carryInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+            uint64_t structural = ((masks.structural | masks.newline) & ~inString) | quotes;
+            if (index.size() < used + 64) index.resize(std::max(index.size() * 2, used + 64));
+            uint32_t* out = index.data() + used;
+            used += __builtin_popcountll(structural);
+            while (structural) {
+                *out++ = static_cast<uint32_t>(base + __builtin_ctzll(structural));
+                structural &= structural - 1;
+            }
+        }
+        index.resize(used);
+    }
+
+    // Stage 2 over a whole buffer; returns the number of records delivered
+    template <typename Handler>
+    static size_t parse(const char* data, size_t size, Handler& handler) {
+        std::vector<uint32_t> index;
+        std::string scratch;
+        return parse(data, size, handler, index, scratch);
+    }
+
+    // As above, reusing the caller's index and decode buffers. Large inputs
+    // are indexed a block of lines at a time so the index stays in cache.
+    template <typename Handler>
+    static size_t parse(const char* data, size_t size, Handler& handler,
+                        std::vector<uint32_t>& index, std::string& scratch, size_t firstLine = 1) {
+        std::vector<size_t> blocks = chunkBoundaries(data, size, INDEX_BLOCK_BYTES);
+        size_t records = 0;
+        size_t line = firstLine;
+        for (size_t b = 0; b + 1 < blocks.size(); ++b) {
+            const char* block = data + blocks[b];
+            size_t blockSize = blocks[b + 1] - blocks[b];
+            buildIndex(block, blockSize, index);
+            Walker<Handler> walker = {block, blockSize, index.data(), index.size(), 0, 0, line, handler, scratch, std::string()};
+            records += walker.run();
+            line = walker.line;
+        }
+        return records;
+    }
+
+    // Decodes the body of a JSON string (no surrounding quotes) into out
+    static bool unescape(const char* text, size_t length, std::string& out) {
+        out.clear();
+        size_t i = 0;
+        while (i < length) {
+            const void* backslash = std::memchr(text + i, '\\', length - i);
+            size_t runEnd = backslash ? static_cast<const char*>(backslash) - text : length;
+            out.append(text + i, runEnd - i);
+            if (runEnd == length) break;
+            i = runEnd + 1;
+            if (i >= length) return false;
+            char c = text[i++];
+            switch (c) {
+                case '"': case '\\': case '/': out += c; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t code;
+                    if (!readHex4(text, length, i, code)) return false;
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        uint32_t low;
+                        if (i + 2 > length || text[i] != '\\' || text[i + 1] != 'u') return false;
+                        i += 2;
+                        if (!readHex4(text, length, i, low) || low < 0xDC00 || low > 0xDFFF) return false;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                        return false;
+                    }
+                    appendUtf8(code, out);
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct BlockMasks {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t structural;
+        uint64_t newline;
+    };
+
+    static BlockMasks classify(const char* block) {
+        BlockMasks masks = {0, 0, 0, 0};
+#ifdef JSON_LINES_READER_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i openBrace = _mm_set1_epi8('{');  // '[' | 0x20
+        const __m128i closeBrace = _mm_set1_epi8('}'); // ']' | 0x20
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        for (int part = 0; part < 4; ++part) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + part * 16));
+            __m128i folded = _mm_or_si128(bytes, caseBit);
+            __m128i structural = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, openBrace), _mm_cmpeq_epi8(folded, closeBrace)),
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, colon), _mm_cmpeq_epi8(bytes, comma)));
+            int shift = part * 16;
+            masks.quote |= toMask(_mm_cmpeq_epi8(bytes, quote)) << shift;
+            masks.backslash |= toMask(_mm_cmpeq_epi8(bytes, backslash)) << shift;
+            masks.newline |= toMask(_mm_cmpeq_epi8(bytes, newline)) << shift;
+            masks.structural |= toMask(structural) << shift;
+        }
+#else
+        for (int i = 0; i < 64; ++i) {
+            uint64_t bit = uint64_t(1) << i;
+            switch (block[i]) {
+                case '"': masks.quote |= bit; break;
+                case '\\': masks.backslash |= bit; break;
+                case '\n': masks.newline |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': masks.structural |= bit; break;
+                default: break;
+            }
+        }
+#endif
+        return masks;
+    }
+
+#ifdef JSON_LINES_READER_SSE2
+    static uint64_t toMask(__m128i bytes) {
+        return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(bytes)));
+    }
+#endif
+
+    // Bytes preceded by an odd run of backslashes. Backslashes only appear
+    // in escaped strings, so this rarely-taken path stays scalar.
+    static uint64_t escapedMask(uint64_t backslash, bool& carry) {
+        uint64_t escaped = 0;
+        bool pending = carry;
+        for (int i = 0; i < 64; ++i) {
+            if (pending) {
+                escaped |= uint64_t(1) << i;
+                pending = false;
+            } else if ((backslash >> i) & 1) {
+                pending = true;
+            }
+        }
+        carry = pending;
+        return escaped;
+    }
+
+    // Bit i = XOR of bits 0..i: set from an opening quote up to (not
+    // including) its closing quote
+    static uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    static bool readHex4(const char* text, size_t length, size_t& i, uint32_t& code) {
+        if (i + 4 > length) return false;
+        code = 0;
+        for (int k = 0; k < 4; ++k) {
+            char c = text[i++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(uint32_t code, std::string& out) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static bool isBlank(const char* data, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!isSpace(data[i])) return false;
+        }
+        return true;
+    }
+
+    template <typename Handler>
+    struct Walker {
+        const char* data;
+        size_t size;
+        const uint32_t* index;
+        size_t count;
+        size_t next;      // next unread index entry
+        size_t lineStart; // offset where the current line begins
+        size_t line;
+        Handler& handler;
+        std::string& scratch;
+        std::string keyScratch;
+
+        size_t run() {
+            size_t records = 0;
+            while (true) {
+                skipBlankLines();
+                if (next >= count && isBlank(data, lineStart, size)) break;
+                const char* message = parseLine();
+                if (message) {
+                    handler.recordError(line, message);
+                    skipLine();
+                } else {
+                    records++;
+                }
+                line++;
+            }
+            return records;
+        }
+
+        char at(size_t entry) const { return data[index[entry]]; }
+
+        // Blank lines hold nothing but whitespace before their newline
+        void skipBlankLines() {
+            while (next < count && at(next) == '\n' && isBlank(data, lineStart, index[next])) {
+                lineStart = index[next++] + 1;
+                line++;
+            }
+        }
+
+        // One non-blank line: a single object followed by the newline
+        const char* parseLine() {
+            if (next >= count) {
+                lineStart = size;
+                return "expected an object";
+            }
+            if (at(next) != '{' || !isBlank(data, lineStart, index[next])) return "expected an object";
+            next++;
+
+            handler.beginRecord();
+            if (next < count && at(next) == '}') {
+                next++;
+            } else {
+                while (true) {
+                    const char* key;
+                    size_t keyLength;
+                    if (next + 1 >= count || at(next) != '"' || at(next + 1) != '"') return "expected a key";
+                    if (!stringText(index[next], index[next + 1], keyScratch, key, keyLength)) return "bad escape in key";
+                    next += 2;
+                    if (next >= count || at(next) != ':' || !isBlank(data, index[next - 1] + 1, index[next])) {
+                        return "expected ':'";
+                    }
+                    const char* message = parseValue(key, keyLength);
+                    if (message) return message;
+                    if (next >= count) return "unterminated object";
+                    char c = at(next++);
+                    if (c == '}') break;
+                    if (c != ',') return "expected ',' or '}'";
+                }
+            }
+
+            // Only whitespace may follow the object on its line
+            size_t end = index[next - 1] + 1;
+            if (next < count && at(next) == '\n') {
+                if (!isBlank(data, end, index[next])) return "trailing characters";
+                lineStart = index[next++] + 1;
+            } else if (next >= count) {
+                if (!isBlank(data, end, size)) return "trailing characters";
+                lineStart = size;
+            } else {
+                return "trailing characters";
+            }
+            handler.endRecord();
+            return nullptr;
+        }
+
+        // Value after the ':' at index[next]; leaves next on the ',' or '}'
+        const char* parseValue(const char* key, size_t keyLength) {
+            size_t valueStart = index[next++] + 1;
+            if (next >= count) return "unterminated object";
+            size_t position = index[next];
+            char c = at(next);
+            bool leadingBlank = isBlank(data, valueStart, position);
+
+            if (c == '"' && leadingBlank) {
+                if (next + 1 >= count || at(next + 1) != '"') return "unterminated string";
+                const char* text;
+                size_t length;
+                if (!stringText(position, index[next + 1], scratch, text, length)) return "bad escape in string";
+                handler.field(key, keyLength, String, text, length);
+                next += 2;
+                return checkAfterValue(index[next - 1] + 1);
+            }
+
+            if ((c == '{' || c == '[') && leadingBlank) {
+                // Raw text of the nested value, quotes included
+                int depth = 0;
+                for (; next < count; ++next) {
+                    char s = at(next);
+                    if (s == '\n') return "unterminated value";
+                    if (s == '{' || s == '[') depth++;
+                    else if (s == '}' || s == ']') depth--;
+                    if (depth == 0) break;
+                }
+                if (next >= count) return "unterminated value";
+                size_t end = index[next++] + 1;
+                handler.field(key, keyLength, c == '{' ? Object : Array, data + position, end - position);
+                return checkAfterValue(end);
+            }
+
+            if (c != ',' && c != '}') return "expected a value";
+            size_t begin = valueStart;
+            size_t end = position;
+            while (begin < end && isSpace(data[begin])) ++begin;
+            while (end > begin && isSpace(data[end - 1])) --end;
+            size_t length = end - begin;
+            const char* text = data + begin;
+            ValueType type;
+            if (length == 4 && std::memcmp(text, "true", 4) == 0) type = True;
+            else if (length == 5 && std::memcmp(text, "false", 5) == 0) type = False;
+            else if (length == 4 && std::memcmp(text, "null", 4) == 0) type = Null;
+            else if (isNumber(text, length)) type = Number;
+            else return "expected a value";
+            handler.field(key, keyLength, type, text, length);
+            return nullptr;
+        }
+
+        const char* checkAfterValue(size_t end) {
+            if (next >= count) return "unterminated object";
+            if (!isBlank(data, end, index[next])) return "expected ',' or '}'";
+            return nullptr;
+        }
+
+        // Body of the string between two quote offsets; decoded into buffer
+        // only when it holds an escape
+        bool stringText(size_t open, size_t close, std::string& buffer, const char*& text, size_t& length) {
+            text = data + open + 1;
+            length = close - open - 1;
+            if (!std::memchr(text, '\\', length)) return true;
+            if (!unescape(text, length, buffer)) return false;
+            text = buffer.data();
+            length = buffer.size();
+            return true;
+        }
+
+        static bool isNumber(const char* text, size_t length) {
+            size_t i = 0;
+            if (i < length && text[i] == '-') ++i;
+            size_t digits = i;
+            while (i < length && text[i] >= '0' && text[i] <= '9') ++i;
+            if (i == digits) return false;
+            if (i < length && text[i] == '.') {
+                size_t fraction = ++i;
+                while (i < length && text[i] >= '0' && text[i] <= '9') ++i;
+                if (i == fraction) return false;
+            }
+            if (i < length && (text[i] == 'e' || text[i] == 'E')) {
+                ++i;
+                if (i < length && (text[i] == '+' || text[i] == '-')) ++i;
+                size_t exponent = i;
+                while (i < length && text[i] >= '0' && text[i] <= '9') ++i;
+                if (i == exponent) return false;
+            }
+            return i == length;
+        }
+
+        // Resynchronises on the next newline outside a string
+        void skipLine() {
+            while (next < count && at(next) != '\n') ++next;
+            if (next < count) {
+                lineStart = index[next++] + 1;
+            } else {
+                lineStart = size;
+            }
+        }
+    };
+};
+
+#endif // JSON_LINES_READER_H
@@ -0,0 +1,91 @@
+#ifndef OPTIMISTIC_COMMIT_H
+#define OPTIMISTIC_COMMIT_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+// Version stamp carried by an editable record, counting its committed
+// edits. A plain integer so records stay copyable, but always loaded and
+// stored atomically, so anyone can read it without taking a lock.
+class RecordVersion {
+private:
+    alignas(std::atomic_ref<uint64_t>::required_alignment) mutable uint64_t value = 1;
+
+public:
+    RecordVersion() = default;
+    RecordVersion(const RecordVersion& other) : value(other.load()) {}
+    RecordVersion& operator=(const RecordVersion& other) {
+        install(other.load());
+        return *this;
+    }
+
+    uint64_t load() const { return std::atomic_ref<uint64_t>(value).load(std::memory_order_acquire); }
+
+    // Only by the committer, under the record's lock
+    void install(uint64_t version) { std::atomic_ref<uint64_t>(value).store(version, std::memory_order_release); }
+};
+
+enum class EditOutcome { Committed, Conflict, Invalid };
+
+struct EditMetrics {
+    std::atomic<uint64_t> commits{0};
+    std::atomic<uint64_t> conflicts{0}; // editors' reads found stale at commit
+    std::atomic<uint64_t> retries{0};   // edits re-applied to the newer version
+    std::atomic<uint64_t> invalid{0};   // values the record rejected
+
+    std::string describe() const {
+        return "commits=" + std::to_string(commits.load()) + " conflicts=" + std::to_string(conflicts.load()) +
+               " retries=" + std::to_string(retries.load()) + " invalid=" + std::to_string(invalid.load());
+    }
+};
+
+// Lock for records that only their owning thread ever touches (a shard's)
+struct SingleOwner {
+    void lock() {}
+    void unlock() {}
+};
+
+// Optimistic commit of one edit. The editor read the record at readVersion
+// without holding anything; here, under whatever lock guards the record's
+// writers, the version is validated and, if nobody committed in between,
+// apply() runs (it validates the new value and changes nothing when it
+// refuses it) and the next version is installed. The lock covers only this
+// check-and-install, never the time between reading and writing.
+template <typename Lock, typename Apply>
+EditOutcome commitVersion(RecordVersion& version, Lock& recordLock, uint64_t readVersion, Apply& apply,
+                          EditMetrics& metrics) {
+    std::lock_guard<Lock> lock(recordLock);
+    if (version.load() != readVersion) return EditOutcome::Conflict;
+    if (!apply()) {
+        metrics.invalid.fetch_add(1, std::memory_order_relaxed);
+        return EditOutcome::Invalid;
+    }
+    version.install(readVersion + 1);
+    metrics.commits.fetch_add(1, std::memory_order_relaxed);
+    return EditOutcome::Committed;
+}
+
+template <typename Lock, typename Apply>
+EditOutcome commitEdit(RecordVersion& version, Lock& recordLock, uint64_t readVersion, Apply apply,
+                       EditMetrics& metrics) {
+    EditOutcome outcome = commitVersion(version, recordLock, readVersion, apply, metrics);
+    if (outcome == EditOutcome::Conflict) metrics.conflicts.fetch_add(1, std::memory_order_relaxed);
+    return outcome;
+}
+
+// For edits that don't depend on what the editor saw (batch commands, "set
+// this field to that"): commits against the latest version, re-reading and
+// retrying when another edit gets in between. Nobody's read went stale, so
+// those re-reads count as retries, not conflicts.
+template <typename Lock, typename Apply>
+EditOutcome commitLatest(RecordVersion& version, Lock& recordLock, Apply apply, EditMetrics& metrics) {
+    while (true) {
+        EditOutcome outcome = commitVersion(version, recordLock, version.load(), apply, metrics);
+        if (outcome != EditOutcome::Conflict) return outcome;
+        metrics.retries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#endif // OPTIMISTIC_COMMIT_H
@@ -0,0 +1,272 @@
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <initializer_list>
+
+// Reusable byte buffer for bulk exports. Text is appended in place and
+// numbers are formatted with std::to_chars straight into the buffer, so no
+// per-row std::string is built. When the buffer fills it is flushed to the
+// open file, or, with no file, simply grows (handy for tests and sockets).
+class OutputBuffer {
+private:
+    std::vector<char> buffer;
+    size_t used;
+    size_t flushThreshold;
+    std::FILE* file;
+    bool ownsFile;
+    size_t bytesWritten;
+    bool failed;
+
+public:
+    explicit OutputBuffer(size_t capacity = 1 << 16)
+        : buffer(capacity + MAX_NUMBER_CHARS), used(0), flushThreshold(capacity),
+          file(nullptr), ownsFile(false), bytesWritten(0), failed(false) {}
+
+    ~OutputBuffer() { close(); }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    // Longest to_chars output for any integer or shortest-form double
+    static const size_t MAX_NUMBER_CHARS = 32;
+
+    bool open(const std::string& filename) {
+        close();
+        file = std::fopen(filename.c_str(), "wb");
+        ownsFile = true;
+        failed = file == nullptr;
+        bytesWritten = 0;
+        return !failed;
+    }
+
+    // Writes to a stream the caller owns (stdout, a socket's FILE*);
+    // close() flushes it but leaves it open
+    void attach(std::FILE* stream) {
+        close();
+        file = stream;
+        ownsFile = false;
+        failed = false;
+        bytesWritten = 0;
+    }
+
+    // Flushes and closes; false if any write failed
+    bool close() {
+        if (file) {
+            flush();
+            if (ownsFile ? std::fclose(file) != 0 : std::fflush(file) != 0) failed = true;
+            file = nullptr;
+        }
+        return !failed;
+    }
+
+    void flush() {
+        if (file && used > 0) {
+            if (std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+            bytesWritten += used;
+            used = 0;
+        }
+    }
+
+    bool hasFailed() const { return failed; }
+    size_t getBytesWritten() const { return bytesWritten + used; }
+
+    // Buffered contents when no file is attached
+    std::string str() const { return std::string(buffer.data(), used); }
+    const char* data() const { return buffer.data(); }
+    size_t size() const { return used; }
+    void clear() { used = 0; bytesWritten = 0; }
+
+    void append(char c) {
+        reserve(1);
+        buffer[used++] = c;
+    }
+
+    void append(const char* text, size_t length) {
+        if (length > flushThreshold && file) {
+            flush();
+            if (std::fwrite(text, 1, length, file) != length) failed = true;
+            bytesWritten += length;
+            return;
+        }
+        reserve(length);
+        std::memcpy(buffer.data() + used, text, length);
+        used += length;
+    }
+
+    void append(const char* text) { append(text, std::strlen(text)); }
+    void append(const std::string& text) { append(text.data(), text.size()); }
+
+    template <typename Int>
+    typename std::enable_if<std::is_integral<Int>::value && !std::is_same<Int, bool>::value>::type
+    appendNumber(Int value) {
+        reserve(MAX_NUMBER_CHARS);
+        char* begin = buffer.data() + used;
+        used += std::to_chars(begin, begin + MAX_NUMBER_CHARS, value).ptr - begin;
+    }
+
+    // Shortest text that reads back as the same double
+    void appendNumber(double value) {
+        reserve(MAX_NUMBER_CHARS);
+        char* begin = buffer.data() + used;
+        used += std::to_chars(begin, begin + MAX_NUMBER_CHARS, value).ptr - begin;
+    }
+
+    // RFC 4180: quoted only when the text holds a comma, quote or line break
+    void appendCsvField(const char* text, size_t length) {
+        size_t special = 0;
+        while (special < length && !isCsvSpecial(text[special])) ++special;
+        if (special == length) {
+            append(text, length);
+            return;
+        }
+        append('"');
+        append(text, special);
+        for (size_t i = special; i < length; ++i) {
+            if (text[i] == '"') append('"');
+            append(text[i]);
+        }
+        append('"');
+    }
+
+    // Quoted JSON string; control characters are escaped, UTF-8 passes through
+    void appendJsonString(const char* text, size_t length) {
+        append('"');
+        size_t runStart = 0;
+        for (size_t i = 0; i < length; ++i) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            append(text + runStart, i - runStart);
+            runStart = i + 1;
+            switch (c) {
+                case '"': append("\\\"", 2); break;
+                case '\\': append("\\\\", 2); break;
+                case '\n': append("\\n", 2); break;
+                case '\r': append("\\r", 2); break;
+                case '\t': append("\\t", 2); break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    char escape[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    append(escape, sizeof(escape));
+                }
+            }
+        }
+        append(text + runStart, length - runStart);
+        append('"');
+    }
+
+private:
+    static bool isCsvSpecial(char c) {
+        return c == ',' || c == '"' || c == '\n' || c == '\r';
+    }
+
+    void reserve(size_t length) {
+        if (used + length <= flushThreshold) return;
+        flush();
+        if (used + length > buffer.size()) buffer.resize((used + length) * 2);
+    }
+};
+
+// Writes records as CSV (header row first) or JSON Lines (one object per
+// line, keys from the column list). Fields must be given in column order.
+class RecordWriter {
+public:
+    enum Format { Csv, JsonLines };
+
+private:
+    OutputBuffer& out;
+    Format format;
+    std::vector<const char*> columns;
+    size_t column;
+    size_t records;
+
+public:
+    RecordWriter(OutputBuffer& out, Format format, std::initializer_list<const char*> columnNames)
+        : out(out), format(format), columns(columnNames), column(0), records(0) {
+        if (format == Csv) {
+            for (size_t i = 0; i < columns.size(); ++i) {
+                if (i > 0) out.append(',');
+                out.append(columns[i]);
+            }
+            out.append('\n');
+        }
+    }
+
+    static const char* extension(Format format) {
+        return format == Csv ? ".csv" : ".jsonl";
+    }
+
+    size_t getRecordCount() const { return records; }
+
+    RecordWriter& field(const std::string& value) {
+        return field(value.data(), value.size());
+    }
+
+    RecordWriter& field(const char* value, size_t length) {
+        beginField();
+        if (format == Csv) out.appendCsvField(value, length);
+        else out.appendJsonString(value, length);
+        return *this;
+    }
+
+    RecordWriter& field(bool value) {
+        beginField();
+        out.append(value ? "true" : "false");
+        return *this;
+    }
+
+    // nan and inf have no JSON form; they are written as null (an empty
+    // field in CSV) rather than as text no reader accepts
+    template <typename Number>
+    typename std::enable_if<std::is_arithmetic<Number>::value && !std::is_same<Number, bool>::value, RecordWriter&>::type
+    field(Number value) {
+        beginField();
+        if (std::is_floating_point<Number>::value && !std::isfinite(static_cast<double>(value))) {
+            if (format == JsonLines) out.append("null");
+        } else {
+            out.appendNumber(value);
+        }
+        return *this;
+    }
+
+    // CSV: "1;2;3", JSON: [1,2,3]
+    RecordWriter& field(const std::vector<int>& values) {
+        beginField();
+        char separator = format == Csv ? ';' : ',';
+        if (format == JsonLines) out.append('[');
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) out.append(separator);
+            out.appendNumber(values[i]);
+        }
+        if (format == JsonLines) out.append(']');
+        return *this;
+    }
+
+    void endRecord() {
+        if (format == JsonLines) out.append(column > 0 ? "}\n" : "{}\n");
+        else out.append('\n');
+        column = 0;
+        records++;
+    }
+
+private:
+    void beginField() {
+        if (format == Csv) {
+            if (column > 0) out.append(',');
+        } else {
+            out.append(column == 0 ? "{\"" : ",\"");
+            out.append(column < columns.size() ? columns[column] : "extra");
+            out.append("\":", 2);
+        }
+        column++;
+    }
+};
+
+#endif // OUTPUT_BUFFER_H
@@ -0,0 +1,35 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// Minimal fork-join helpers for the bulk pipelines (validation, import,
+// export). Work items are handed out through an atomic counter, so uneven
+// chunks balance themselves; the calling thread works too.
+class Parallel {
+public:
+    // Threads worth using for itemCount items: the request (or the hardware
+    // concurrency when 0), never more than there are items
+    static size_t threadCount(size_t requested, size_t itemCount) {
+        size_t threads = requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+        return std::max<size_t>(1, std::min(threads, itemCount));
+    }
+
+    template <typename Work>
+    static void forEach(size_t itemCount, size_t threads, Work work) {
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t item = next++; item < itemCount; item = next++) work(item);
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads && t < itemCount; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& thread : pool) thread.join();
+    }
+};
+
+#endif // PARALLEL_H
@@ -9,6 +9,7 @@
 #include "Teacher.h"
 #include "Course.h"
 #include "Classroom.h"
+#include "RosterBitmap.h"
 
 class ReportGenerator {
 private:
@@ -31,6 +32,7 @@ public:
     void generateCourseReport(const Course& course, const std::string& filename = "");
     void generateAllCoursesReport(const std::vector<Course>& courses, const std::string& filename = "");
     void generateCourseEnrollmentReport(const std::vector<Course>& courses, const std::string& filename = "");
+    void generateCourseOverlapReport(const std::vector<Course>& courses, const std::string& filename = "");
     
     // Statistical Reports
     void generateStatisticsReport(const std::vector<Student>& students, 
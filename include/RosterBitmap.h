@@ -0,0 +1,93 @@
+#ifndef ROSTER_BITMAP_H
+#define ROSTER_BITMAP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class Course;
+
+// Compressed set of student IDs (roaring layout). IDs are split into a 16-bit
+// high key and a 16-bit low part; each key owns either a sorted array of low
+// parts (sparse, <= 4096 entries) or a 65536-bit bitmap (dense).
+class RosterBitmap {
+public:
+    RosterBitmap() = default;
+    static RosterBitmap fromIds(const std::vector<int>& ids);
+
+    // Membership
+    bool add(int studentId);
+    bool remove(int studentId);
+    bool contains(int studentId) const;
+
+    size_t cardinality() const;
+    bool empty() const { return containers.empty(); }
+    std::vector<int> toVector() const;
+    size_t sizeInBytes() const;
+
+    // Set algebra
+    static RosterBitmap intersect(const RosterBitmap& a, const RosterBitmap& b);
+    static RosterBitmap unite(const RosterBitmap& a, const RosterBitmap& b);
+    static RosterBitmap difference(const RosterBitmap& a, const RosterBitmap& b);
+    static size_t intersectionCardinality(const RosterBitmap& a, const RosterBitmap& b);
+
+    bool operator==(const RosterBitmap& other) const;
+
+    static const size_t ARRAY_LIMIT = 4096;
+    static const size_t BITMAP_WORDS = 1024;
+
+private:
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> values;   // sorted, used while sparse
+        std::vector<uint64_t> words;    // BITMAP_WORDS long, used while dense
+
+        bool isBitmap() const { return !words.empty(); }
+        bool contains(uint16_t low) const;
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        void toBitmap();
+        void toArray();
+    };
+
+    std::vector<Container> containers; // sorted by key
+
+    Container* findContainer(uint16_t key);
+    const Container* findContainer(uint16_t key) const;
+
+    static Container intersectContainers(const Container& a, const Container& b);
+    static Container uniteContainers(const Container& a, const Container& b);
+    static Container differenceContainers(const Container& a, const Container& b);
+    static size_t intersectionCount(const Container& a, const Container& b);
+};
+
+// Query API over course rosters for reports. Rosters are built once from the
+// courses' enrolled students; departments come from the assigned teacher.
+class RosterQuery {
+private:
+    std::unordered_map<int, RosterBitmap> courseRosters;
+    std::unordered_map<std::string, std::vector<int>> departmentCourses;
+
+public:
+    RosterQuery() = default;
+    explicit RosterQuery(const std::vector<Course>& courses);
+
+    void addCourse(const Course& course);
+    const RosterBitmap& getRoster(int courseId) const;
+    bool hasCourse(int courseId) const;
+
+    std::vector<int> studentsInBoth(int courseA, int courseB) const;
+    std::vector<int> studentsInEither(int courseA, int courseB) const;
+    std::vector<int> studentsInFirstOnly(int courseA, int courseB) const;
+    std::vector<int> studentsInDepartment(const std::string& department) const;
+
+    size_t countInBoth(int courseA, int courseB) const;
+    size_t countInDepartment(const std::string& department) const;
+
+private:
+    RosterBitmap departmentRoster(const std::string& department) const;
+};
+
+#endif // ROSTER_BITMAP_H
@@ -0,0 +1,248 @@
+#ifndef SCHOOL_PROTOCOL_H
+#define SCHOOL_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Length-prefixed binary frames: a u32 little-endian payload length, then
+// the payload. Integers inside a payload are little-endian; strings carry
+// a u16 length prefix.
+class Frame {
+public:
+    static const size_t HEADER_BYTES = 4;
+
+    // Reserves the length prefix; returns where the frame starts
+    static size_t begin(std::string& out) {
+        size_t start = out.size();
+        out.append(HEADER_BYTES, '\0');
+        return start;
+    }
+
+    static void finish(std::string& out, size_t start) {
+        uint32_t length = static_cast<uint32_t>(out.size() - start - HEADER_BYTES);
+        for (size_t i = 0; i < HEADER_BYTES; ++i) out[start + i] = static_cast<char>(length >> (8 * i));
+    }
+
+    // Locates the complete frame starting at pos and advances past it.
+    // False when more bytes are needed, or (with tooLarge set) when the
+    // declared length exceeds maxBytes and the stream can't be trusted.
+    static bool next(const std::string& buffer, size_t& pos, size_t maxBytes,
+                     const char*& payload, size_t& size, bool& tooLarge) {
+        tooLarge = false;
+        if (buffer.size() - pos < HEADER_BYTES) return false;
+        uint32_t length = 0;
+        for (size_t i = 0; i < HEADER_BYTES; ++i) {
+            length |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[pos + i])) << (8 * i);
+        }
+        if (length > maxBytes) {
+            tooLarge = true;
+            return false;
+        }
+        if (buffer.size() - pos - HEADER_BYTES < length) return false;
+        payload = buffer.data() + pos + HEADER_BYTES;
+        size = length;
+        pos += HEADER_BYTES + length;
+        return true;
+    }
+};
+
+// Appends payload fields to a frame under construction
+class FrameWriter {
+private:
+    std::string& out;
+
+public:
+    explicit FrameWriter(std::string& out) : out(out) {}
+
+    FrameWriter& u8(uint8_t value) {
+        out.push_back(static_cast<char>(value));
+        return *this;
+    }
+
+    FrameWriter& u16(uint16_t value) {
+        out.push_back(static_cast<char>(value));
+        out.push_back(static_cast<char>(value >> 8));
+        return *this;
+    }
+
+    FrameWriter& u32(uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<char>(value >> shift));
+        return *this;
+    }
+
+    FrameWriter& u64(uint64_t value) {
+        return u32(static_cast<uint32_t>(value)).u32(static_cast<uint32_t>(value >> 32));
+    }
+
+    // Longer strings are cut at 65535 bytes
+    FrameWriter& str(const char* text, size_t length) {
+        if (length > 0xFFFF) length = 0xFFFF;
+        u16(static_cast<uint16_t>(length));
+        out.append(text, length);
+        return *this;
+    }
+
+    FrameWriter& str(const std::string& text) { return str(text.data(), text.size()); }
+
+    // Unprefixed bytes; only meaningful as the last field
+    FrameWriter& rest(const char* data, size_t length) {
+        out.append(data, length);
+        return *this;
+    }
+};
+
+// Reads payload fields in order. Reading past the end yields zeros and
+// clears ok(), so a request can be decoded first and checked once.
+class FrameReader {
+private:
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool valid;
+
+public:
+    FrameReader(const char* data, size_t size) : data(data), size(size), pos(0), valid(true) {}
+
+    bool ok() const { return valid; }
+    size_t remaining() const { return size - pos; }
+
+    uint8_t u8() { return static_cast<uint8_t>(read(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(read(2)); }
+    uint32_t u32() { return read(4); }
+
+    uint64_t u64() {
+        uint64_t low = read(4);
+        return low | static_cast<uint64_t>(read(4)) << 32;
+    }
+
+    std::string str() {
+        size_t length = u16();
+        if (!valid || length > remaining()) {
+            valid = false;
+            return std::string();
+        }
+        std::string text(data + pos, length);
+        pos += length;
+        return text;
+    }
+
+    // Everything not read yet
+    void rest(const char*& begin, size_t& length) {
+        begin = data + pos;
+        length = size - pos;
+        pos = size;
+    }
+
+private:
+    uint32_t read(size_t bytes) {
+        if (!valid || remaining() < bytes) {
+            valid = false;
+            return 0;
+        }
+        uint32_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+        }
+        pos += bytes;
+        return value;
+    }
+};
+
+// Requests answered by the school daemon (IndustrialSchoolSystem --serve).
+// Request payload: u32 request id, u8 op, then the op's arguments.
+// Response payload: u32 request id, u8 status, then a UTF-8 body (a JSON
+// object or array for lookups and searches, key=value pairs for reports,
+// a message otherwise). Workers answer in parallel, so responses on one
+// connection can arrive out of order; match them by request id.
+class SchoolProtocol {
+public:
+    enum Op : uint8_t {
+        Ping = 1,
+        LookupStudent,   // u32 id
+        LookupTeacher,   // u32 id
+        LookupCourse,    // u32 id
+        SearchStudents,  // str name fragment, u16 limit
+        Enroll,          // u32 student id, u32 course id
+        Report,          // u8 ReportKind, u32 id (ignored for summaries)
+        EnrollMany,      // u16 picks, each: u32 student id, u8 n, n x u32 course id
+        Edit             // u8 record (a Lookup op), u32 id, u64 version read (0: current), str field, str value
+    };
+
+    enum Status : uint8_t { Ok = 0, NotFound, Rejected, BadRequest };
+
+    enum ReportKind : uint8_t { SummaryReport = 0, StudentReport, TeacherReport, CourseReport };
+
+    static void ping(std::string& out, uint32_t requestId) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(Ping);
+        Frame::finish(out, start);
+    }
+
+    static void lookup(std::string& out, uint32_t requestId, Op op, uint32_t id) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(op).u32(id);
+        Frame::finish(out, start);
+    }
+
+    static void searchStudents(std::string& out, uint32_t requestId, const std::string& name, uint16_t limit) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(SearchStudents).str(name).u16(limit);
+        Frame::finish(out, start);
+    }
+
+    static void enroll(std::string& out, uint32_t requestId, uint32_t studentId, uint32_t courseId) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(Enroll).u32(studentId).u32(courseId);
+        Frame::finish(out, start);
+    }
+
+    static void report(std::string& out, uint32_t requestId, ReportKind kind, uint32_t id = 0) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(Report).u8(kind).u32(id);
+        Frame::finish(out, start);
+    }
+
+    // Several all-or-nothing enrollments in one frame: start it with the
+    // pick count, add that many picks, then Frame::finish(out, start).
+    // The response body has one line per pick, in order.
+    static size_t enrollMany(std::string& out, uint32_t requestId, uint16_t picks) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(EnrollMany).u16(picks);
+        return start;
+    }
+
+    static void addPick(std::string& out, uint32_t studentId, const uint32_t* courseIds, uint8_t count) {
+        FrameWriter writer(out);
+        writer.u32(studentId).u8(count);
+        for (uint8_t i = 0; i < count; ++i) writer.u32(courseIds[i]);
+    }
+
+    // Optimistic field edit: commits only if the record is still at version
+    // (0 commits against whatever is current). Field names are the export
+    // headers. A conflict is Rejected and its message names the current
+    // version; an Ok message ends with the record's version after the edit.
+    static void edit(std::string& out, uint32_t requestId, Op record, uint32_t id, uint64_t version,
+                     const std::string& field, const std::string& value) {
+        size_t start = Frame::begin(out);
+        FrameWriter(out).u32(requestId).u8(Edit).u8(record).u32(id).u64(version).str(field).str(value);
+        Frame::finish(out, start);
+    }
+
+    // Response payload only; the server adds the frame header
+    static void response(std::string& out, uint32_t requestId, Status status, const char* body, size_t length) {
+        FrameWriter(out).u32(requestId).u8(status).rest(body, length);
+    }
+
+    static bool parseResponse(const char* payload, size_t size, uint32_t& requestId, Status& status,
+                              const char*& body, size_t& length) {
+        FrameReader reader(payload, size);
+        requestId = reader.u32();
+        status = static_cast<Status>(reader.u8());
+        reader.rest(body, length);
+        return reader.ok();
+    }
+};
+
+#endif // SCHOOL_PROTOCOL_H
@@ -0,0 +1,139 @@
+#ifndef SEAT_RESERVATION_H
+#define SEAT_RESERVATION_H
+
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+
+// Seat accounting for one course, safe to share between threads without a
+// lock. A seat is claimed with a compare-and-swap against the capacity
+// (reserve) and then either kept (commit) or handed back (release).
+// Claimed seats never exceed the capacity, so however many enrollments race
+// for the last seat, exactly one gets it.
+class SeatCounter {
+private:
+    std::atomic<int> capacity;
+    std::atomic<int> claimed;   // reserved + committed
+    std::atomic<int> committed;
+
+public:
+    explicit SeatCounter(int capacity = 0) : capacity(capacity), claimed(0), committed(0) {}
+
+    // Copies are snapshots, for records kept in vectors; never copy a
+    // counter other threads are still using
+    SeatCounter(const SeatCounter& other)
+        : capacity(other.getCapacity()), claimed(other.getClaimed()), committed(other.getCommitted()) {}
+
+    SeatCounter& operator=(const SeatCounter& other) {
+        capacity.store(other.getCapacity(), std::memory_order_relaxed);
+        claimed.store(other.getClaimed(), std::memory_order_relaxed);
+        committed.store(other.getCommitted(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    int getCapacity() const { return capacity.load(std::memory_order_relaxed); }
+    int getClaimed() const { return claimed.load(std::memory_order_acquire); }
+    int getCommitted() const { return committed.load(std::memory_order_acquire); }
+    int getAvailable() const { return getCapacity() - getClaimed(); }
+
+    // Lowering the capacity never revokes seats already claimed
+    void setCapacity(int seats) { capacity.store(seats, std::memory_order_relaxed); }
+
+    // Changes the capacity while reservations race it, refusing (and leaving
+    // it as it was) if more seats than that are claimed. A claim that got in
+    // under the old capacity is either seen here or sees the new one on its
+    // re-check in tryReserve() and backs off. One resize at a time.
+    bool tryResize(int seats) {
+        int previous = capacity.exchange(seats, std::memory_order_seq_cst);
+        if (claimed.load(std::memory_order_seq_cst) <= seats) return true;
+        capacity.store(previous, std::memory_order_seq_cst);
+        return false;
+    }
+
+    bool tryReserve() {
+        int current = claimed.load(std::memory_order_relaxed);
+        do {
+            if (current >= capacity.load(std::memory_order_relaxed)) return false;
+        } while (!claimed.compare_exchange_weak(current, current + 1,
+                                                std::memory_order_seq_cst, std::memory_order_relaxed));
+        if (current >= capacity.load(std::memory_order_seq_cst)) { // Shrunk by tryResize() meanwhile
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    void commit() { committed.fetch_add(1, std::memory_order_release); }
+    void release() { claimed.fetch_sub(1, std::memory_order_release); }
+
+    // A committed seat becomes free again (unenrollment)
+    void vacate() {
+        committed.fetch_sub(1, std::memory_order_release);
+        claimed.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Single-threaded setup, e.g. after loading a roster from disk
+    void reset(int occupied) {
+        claimed.store(occupied, std::memory_order_relaxed);
+        committed.store(occupied, std::memory_order_relaxed);
+    }
+};
+
+// One reserved seat. Rolls the reservation back when it goes out of scope
+// uncommitted, so a multi-course enrollment that fails part-way releases
+// every seat it took.
+class SeatReservation {
+private:
+    SeatCounter* seats;
+
+public:
+    SeatReservation() : seats(nullptr) {}
+    explicit SeatReservation(SeatCounter& counter) : seats(counter.tryReserve() ? &counter : nullptr) {}
+    ~SeatReservation() { rollback(); }
+
+    SeatReservation(const SeatReservation&) = delete;
+    SeatReservation& operator=(const SeatReservation&) = delete;
+
+    SeatReservation(SeatReservation&& other) noexcept : seats(other.seats) { other.seats = nullptr; }
+
+    SeatReservation& operator=(SeatReservation&& other) noexcept {
+        if (this != &other) {
+            rollback();
+            seats = other.seats;
+            other.seats = nullptr;
+        }
+        return *this;
+    }
+
+    bool held() const { return seats != nullptr; }
+    explicit operator bool() const { return held(); }
+
+    void commit() {
+        if (seats) seats->commit();
+        seats = nullptr;
+    }
+
+    void rollback() {
+        if (seats) seats->release();
+        seats = nullptr;
+    }
+};
+
+// Fixed set of mutexes handed out by record ID, for short critical sections
+// on records that have no lock of their own. Stripes sit on separate cache
+// lines so threads working on different records don't contend.
+class LockStripes {
+public:
+    static const size_t COUNT = 64;
+
+private:
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+    };
+    Stripe stripes[COUNT];
+
+public:
+    std::mutex& forId(int id) { return stripes[static_cast<unsigned>(id) % COUNT].mutex; }
+};
+
+#endif // SEAT_RESERVATION_H
@@ -0,0 +1,140 @@
+#ifndef SHARDED_STORE_H
+#define SHARDED_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+
+// Records partitioned by ID hash across shards, shared-nothing: each shard's
+// State is touched only by that shard's thread, which runs the messages in
+// its inbox one at a time, in the order they were posted. Work that spans
+// shards is a chain of messages, each shard doing its part and posting the
+// next step; nothing is locked except the inboxes. Between start() and
+// stop() the states must only be reached through messages.
+template <typename State>
+class ShardedStore {
+public:
+    typedef std::function<void(State&)> Message;
+
+private:
+    struct Shard {
+        State state;
+        std::mutex inboxMutex;
+        std::condition_variable inboxReady;
+        std::deque<Message> inbox;
+        bool stopping = false;
+        std::atomic<uint64_t> handled{0};
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    bool running = false;
+
+public:
+    explicit ShardedStore(size_t count) {
+        for (size_t i = 0; i < std::max<size_t>(1, count); ++i) shards.emplace_back(new Shard());
+    }
+
+    ~ShardedStore() { stop(); }
+
+    ShardedStore(const ShardedStore&) = delete;
+    ShardedStore& operator=(const ShardedStore&) = delete;
+
+    size_t size() const { return shards.size(); }
+
+    // Multiplicative hash, so runs of consecutive IDs spread evenly
+    size_t shardOf(int id) const {
+        uint64_t mixed = static_cast<uint32_t>(id) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>((mixed >> 32) % shards.size());
+    }
+
+    // Direct access for loading and unloading, only while stopped
+    State& state(size_t shard) { return shards[shard]->state; }
+
+    uint64_t getMessagesHandled(size_t shard) const { return shards[shard]->handled; }
+
+    void start() {
+        if (running) return;
+        running = true;
+        for (auto& shard : shards) {
+            shard->stopping = false;
+            Shard* self = shard.get();
+            shard->thread = std::thread([self] { drain(*self); });
+        }
+    }
+
+    // Each shard runs what is left in its inbox, then exits. Call once no
+    // chain is still in flight: a message posted to a shard that has
+    // already stopped never runs.
+    void stop() {
+        if (!running) return;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->inboxMutex);
+            shard->stopping = true;
+            shard->inboxReady.notify_one();
+        }
+        for (auto& shard : shards) shard->thread.join();
+        running = false;
+    }
+
+    void post(size_t shard, Message message) {
+        Shard& target = *shards[shard];
+        std::lock_guard<std::mutex> lock(target.inboxMutex);
+        target.inbox.push_back(std::move(message));
+        target.inboxReady.notify_one();
+    }
+
+    // Runs fn on the shard and waits for its result. Never call from a
+    // shard's own thread; chain with post() there instead.
+    template <typename Fn>
+    auto ask(size_t shard, Fn fn) -> decltype(fn(std::declval<State&>())) {
+        typedef decltype(fn(std::declval<State&>())) Result;
+        auto task = std::make_shared<std::packaged_task<Result(State&)>>(std::move(fn));
+        std::future<Result> answer = task->get_future();
+        post(shard, [task](State& state) { (*task)(state); });
+        return answer.get();
+    }
+
+    // Scatter-gather: runs fn on every shard at once and returns the
+    // answers in shard order
+    template <typename Fn>
+    auto askAll(Fn fn) -> std::vector<decltype(fn(std::declval<State&>()))> {
+        typedef decltype(fn(std::declval<State&>())) Result;
+        std::vector<std::future<Result>> answers;
+        for (size_t i = 0; i < shards.size(); ++i) {
+            auto task = std::make_shared<std::packaged_task<Result(State&)>>(fn);
+            answers.push_back(task->get_future());
+            post(i, [task](State& state) { (*task)(state); });
+        }
+        std::vector<Result> results;
+        for (auto& answer : answers) results.push_back(answer.get());
+        return results;
+    }
+
+private:
+    static void drain(Shard& shard) {
+        std::unique_lock<std::mutex> lock(shard.inboxMutex);
+        while (true) {
+            shard.inboxReady.wait(lock, [&shard] { return shard.stopping || !shard.inbox.empty(); });
+            if (shard.inbox.empty()) return; // Stopping and drained
+            Message message = std::move(shard.inbox.front());
+            shard.inbox.pop_front();
+            lock.unlock();
+            message(shard.state);
+            shard.handled.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+    }
+};
+
+#endif // SHARDED_STORE_H
@@ -0,0 +1,94 @@
+#ifndef SWIPE_INGESTOR_H
+#define SWIPE_INGESTOR_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+#include <cstdint>
+#include <unordered_map>
+
+class Course;
+class Classroom;
+
+struct SwipeIngestStats {
+    size_t bytesRead = 0;
+    size_t rowsRead = 0;
+    size_t rowsMatched = 0;        // swipes inside a scheduled session window
+    size_t rowsUnmatched = 0;      // unknown room or no session at that time
+    size_t rowsMalformed = 0;
+    size_t rejectedSwipes = 0;     // matched swipes from students not enrolled
+    size_t sessionsRecorded = 0;
+    size_t studentsPresent = 0;
+    double seconds = 0.0;
+
+    double rowsPerSecond() const { return seconds > 0.0 ? rowsRead / seconds : 0.0; }
+};
+
+// Derives course attendance from door/card-reader logs. Each CSV row is
+// "timestamp,studentId,room" with timestamps as "YYYY-MM-DD HH:MM[:SS]".
+// A swipe counts as presence for the course scheduled in that room on that
+// weekday when it falls in [start - earlyArrival, end).
+//
+// The file is streamed in fixed-size chunks through a bounded queue, so
+// memory stays at roughly maxChunksInFlight * chunkBytes plus one entry per
+// distinct (session, student). Worker threads parse and join chunks in
+// parallel; the joined sessions are then written with one presence update
+// each, which never marks anyone absent.
+class SwipeIngestor {
+public:
+    struct Slot {
+        int courseIndex;
+        int weekday;      // 1 = Monday ... 7 = Sunday
+        int startMinute;
+        int endMinute;
+    };
+
+private:
+    std::unordered_map<std::string, int> roomClassrooms;       // location or ID -> classroom ID
+    std::unordered_map<int, std::shared_ptr<Classroom>> classrooms;
+    std::unordered_map<int, std::vector<Slot>> classroomSlots;
+    std::vector<std::shared_ptr<Course>> courses;               // courseIndex -> course
+    size_t workerCount;
+    size_t chunkBytes;
+    size_t maxChunksInFlight;
+    int earlyArrivalMinutes;
+
+public:
+    explicit SwipeIngestor(size_t workerCount = 0, size_t chunkBytes = 1 << 20, size_t maxChunksInFlight = 0);
+
+    // Timetable
+    void addClassroom(std::shared_ptr<Classroom> classroom);
+    bool addSlot(int classroomId, int courseId, int weekday, int startMinute, int endMinute);
+    bool addSlot(int classroomId, int courseId, int weekday, const std::string& start, const std::string& end);
+    // Lines of "classroomId,courseId,weekday,HH:MM,HH:MM"; returns slots added
+    int loadTimetable(const std::string& filename);
+    size_t getSlotCount() const;
+
+    void setEarlyArrivalMinutes(int minutes) { earlyArrivalMinutes = minutes; }
+    size_t getWorkerCount() const { return workerCount; }
+
+    // Ingestion. Rows longer than MAX_LINE_BYTES count as malformed and are
+    // skipped without being buffered whole.
+    static constexpr size_t MAX_LINE_BYTES = 4096;
+    SwipeIngestStats ingestFile(const std::string& filename);
+    SwipeIngestStats ingestStream(std::istream& input);
+
+    // Parsing helpers
+    static bool parseTimestamp(const char* begin, const char* end, int& dayNumber, int& minuteOfDay);
+    static bool parseDate(const std::string& date, int& dayNumber); // exactly "YYYY-MM-DD"
+    static int parseClock(const std::string& clock); // "HH:MM" -> minutes, -1 if invalid
+    static int weekdayOf(int dayNumber);
+    static std::string formatDate(int dayNumber);
+
+private:
+    struct SessionHits;
+    struct WorkerState;
+
+    void processChunk(const std::string& chunk, WorkerState& state) const;
+    void processRow(const char* begin, const char* end, WorkerState& state) const;
+    const Slot* findSlot(int classroomId, int weekday, int minuteOfDay) const;
+    void writeSessions(std::vector<WorkerState>& states, SwipeIngestStats& stats);
+};
+
+#endif // SWIPE_INGESTOR_H
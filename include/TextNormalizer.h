@@ -0,0 +1,96 @@
+#ifndef TEXT_NORMALIZER_H
+#define TEXT_NORMALIZER_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TEXT_NORMALIZER_SSE2 1
+#endif
+
+// Single-pass whitespace normalisation with the same result as
+//   trim " \t\n\r" from both ends, then regex_replace(\s+, " ")
+// where \s is space, \t, \n, \v, \f or \r. Output is never longer than the
+// input, so it can be written into a reused buffer or over the input itself.
+// The SSE2 path copies 16-byte blocks that contain no whitespace unchanged.
+class TextNormalizer {
+public:
+    static bool isTrimChar(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool isSpaceChar(char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // Writes the normalised form of src[0, length) to dst and returns its
+    // length. dst needs room for length bytes and may equal src.
+    static size_t normalize(const char* src, size_t length, char* dst) {
+        size_t begin = 0;
+        size_t end = length;
+        while (begin < end && isTrimChar(src[begin])) ++begin;
+        while (end > begin && isTrimChar(src[end - 1])) --end;
+
+        char* out = dst;
+        size_t i = begin;
+        while (i < end) {
+#ifdef TEXT_NORMALIZER_SSE2
+            while (i + 16 <= end) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                int mask = whitespaceMask(block);
+                if (mask == 0) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+                    out += 16;
+                    i += 16;
+                    continue;
+                }
+                size_t run = static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+                std::memmove(out, src + i, run);
+                out += run;
+                i += run;
+                break;
+            }
+            if (i >= end) break;
+#endif
+            char c = src[i];
+            if (isSpaceChar(c)) {
+                *out++ = ' ';
+                do { ++i; } while (i < end && isSpaceChar(src[i]));
+            } else {
+                *out++ = c;
+                ++i;
+            }
+        }
+        return static_cast<size_t>(out - dst);
+    }
+
+    // Normalises into out, reusing its capacity
+    static void normalizeInto(const std::string& input, std::string& out) {
+        if (&input == &out) {
+            normalizeInPlace(out);
+            return;
+        }
+        out.resize(input.size());
+        out.resize(normalize(input.data(), input.size(), &out[0]));
+    }
+
+    static void normalizeInPlace(std::string& text) {
+        if (text.empty()) return;
+        text.resize(normalize(text.data(), text.size(), &text[0]));
+    }
+
+private:
+#ifdef TEXT_NORMALIZER_SSE2
+    // Bit per byte that is ' ' or in '\t'..'\r'
+    static int whitespaceMask(__m128i block) {
+        __m128i space = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+        __m128i control = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)),
+                                        _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1)));
+        return _mm_movemask_epi8(_mm_or_si128(space, control));
+    }
+#endif
+};
+
+#endif // TEXT_NORMALIZER_H
@@ -0,0 +1,111 @@
+#ifndef TEXT_VALIDATOR_H
+#define TEXT_VALIDATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Character classes for the hand-built validators, filled at compile time
+struct TextCharClasses {
+    enum Class : uint8_t {
+        Other = 0,
+        Letter,        // [A-Za-z]
+        DigitOrHyphen, // [0-9-] - allowed in both the local part and the domain
+        Dot,
+        LocalSymbol,   // [_%+] - local part only
+        At,
+        Count
+    };
+
+    uint8_t email[256];
+    bool phoneBody[256]; // [\d\s\-\(\)]
+
+    constexpr TextCharClasses() : email(), phoneBody() {
+        for (int c = 'a'; c <= 'z'; ++c) email[c] = Letter;
+        for (int c = 'A'; c <= 'Z'; ++c) email[c] = Letter;
+        for (int c = '0'; c <= '9'; ++c) {
+            email[c] = DigitOrHyphen;
+            phoneBody[c] = true;
+        }
+        email[static_cast<int>('-')] = DigitOrHyphen;
+        email[static_cast<int>('.')] = Dot;
+        email[static_cast<int>('_')] = LocalSymbol;
+        email[static_cast<int>('%')] = LocalSymbol;
+        email[static_cast<int>('+')] = LocalSymbol;
+        email[static_cast<int>('@')] = At;
+
+        // \s in the regex's classic locale: space, \t, \n, \v, \f, \r
+        phoneBody[static_cast<int>(' ')] = true;
+        for (int c = '\t'; c <= '\r'; ++c) phoneBody[c] = true;
+        phoneBody[static_cast<int>('-')] = true;
+        phoneBody[static_cast<int>('(')] = true;
+        phoneBody[static_cast<int>(')')] = true;
+    }
+};
+
+// Table-driven replacements for the std::regex email and phone checks.
+// They accept exactly the strings matched by
+//   email: [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+//   phone: \+?[\d\s\-\(\)]{10,15}
+// in a single pass with no allocation. Empty input is not special-cased
+// here; callers keep their own "optional field" rules.
+class TextValidator {
+private:
+    // Email DFA states. After '@' the domain is [D]+ "." [A-Za-z]{2,}; since
+    // letters are domain characters too, it is enough to track whether the
+    // text after the last usable dot is still letters-only and how long it is.
+    enum EmailState : uint8_t {
+        Start,        // nothing read
+        Local,        // at least one local-part character
+        DomainStart,  // just read '@'
+        Domain,       // non-empty domain, no suffix candidate
+        SuffixDot,    // candidate separator dot, 0 suffix letters
+        SuffixOne,    // 1 suffix letter
+        SuffixTwo,    // 2+ suffix letters (accepting)
+        Reject,
+        StateCount
+    };
+
+    static constexpr TextCharClasses classes{};
+
+    //                                     Other   Letter     Digit/-    Dot        Symbol  At
+    static constexpr uint8_t emailTransitions[StateCount][TextCharClasses::Count] = {
+        /* Start       */ {Reject, Local,     Local,     Local,     Local,  Reject},
+        /* Local       */ {Reject, Local,     Local,     Local,     Local,  DomainStart},
+        /* DomainStart */ {Reject, Domain,    Domain,    Domain,    Reject, Reject},
+        /* Domain      */ {Reject, Domain,    Domain,    SuffixDot, Reject, Reject},
+        /* SuffixDot   */ {Reject, SuffixOne, Domain,    SuffixDot, Reject, Reject},
+        /* SuffixOne   */ {Reject, SuffixTwo, Domain,    SuffixDot, Reject, Reject},
+        /* SuffixTwo   */ {Reject, SuffixTwo, Domain,    SuffixDot, Reject, Reject},
+        /* Reject      */ {Reject, Reject,    Reject,    Reject,    Reject, Reject},
+    };
+
+public:
+    static bool isEmail(const char* text, size_t length) {
+        uint8_t state = Start;
+        for (size_t i = 0; i < length && state != Reject; ++i) {
+            state = emailTransitions[state][classes.email[static_cast<unsigned char>(text[i])]];
+        }
+        return state == SuffixTwo;
+    }
+
+    static bool isEmail(const std::string& text) {
+        return isEmail(text.data(), text.size());
+    }
+
+    static bool isPhone(const char* text, size_t length) {
+        size_t i = (length > 0 && text[0] == '+') ? 1 : 0;
+        size_t bodyLength = length - i;
+        if (bodyLength < 10 || bodyLength > 15) return false;
+        for (; i < length; ++i) {
+            if (!classes.phoneBody[static_cast<unsigned char>(text[i])]) return false;
+        }
+        return true;
+    }
+
+    static bool isPhone(const std::string& text) {
+        return isPhone(text.data(), text.size());
+    }
+};
+
+#endif // TEXT_VALIDATOR_H
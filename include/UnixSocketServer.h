@@ -0,0 +1,473 @@
+#ifndef UNIX_SOCKET_SERVER_H
+#define UNIX_SOCKET_SERVER_H
+
+#include "SchoolProtocol.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Frame server on a Unix domain socket. One thread runs a level-triggered
+// epoll loop that accepts connections, splits incoming bytes into frames
+// and writes responses; a worker pool runs the handler. Workers hand
+// finished responses back through a queue and an eventfd, so only the
+// loop thread ever touches a connection.
+class UnixSocketServer {
+public:
+    // Appends the response payload for one request payload. Called from
+    // several workers at once. If it throws there is no response to frame,
+    // so the connection is closed instead.
+    typedef std::function<void(const char* request, size_t size, std::string& response)> Handler;
+
+    static const size_t MAX_FRAME_BYTES = 1 << 20;
+
+    // Backpressure: a connection stops being read while this many of its
+    // requests are unanswered or this much of its output is unsent
+    static const size_t MAX_IN_FLIGHT = 256;
+    static const size_t MAX_PENDING_OUTPUT_BYTES = 4 << 20;
+
+private:
+    struct Connection {
+        int fd;
+        std::string input;
+        std::string output;
+        size_t outputPos = 0;
+        size_t inFlight = 0;    // Queued or being handled
+        bool watchingWrites = false;
+        bool readsPaused = false;
+    };
+
+    struct Job {
+        uint64_t connection;
+        std::string request;
+    };
+
+    struct Reply {
+        uint64_t connection;
+        std::string frame;
+    };
+
+    static const uint64_t LISTEN_TAG = 0;
+    static const uint64_t WAKE_TAG = 1;
+
+    Handler handler;
+    size_t workerCount;
+    std::string socketPath;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::unordered_map<uint64_t, Connection> connections;
+    uint64_t nextConnection = WAKE_TAG + 1;
+
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::deque<Job> jobs;
+    bool workersDone = false;
+
+    std::mutex replyMutex;
+    std::vector<Reply> replies;
+    std::atomic<bool> wakePending{false};
+    std::atomic<bool> stopping{false};
+
+    std::atomic<uint64_t> requestsServed{0};
+    std::atomic<uint64_t> connectionsAccepted{0};
+
+public:
+    explicit UnixSocketServer(Handler handler, size_t workerCount = 0)
+        : handler(handler),
+          workerCount(workerCount ? workerCount : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    ~UnixSocketServer() { closeAll(); }
+
+    UnixSocketServer(const UnixSocketServer&) = delete;
+    UnixSocketServer& operator=(const UnixSocketServer&) = delete;
+
+    size_t getWorkerCount() const { return workerCount; }
+    uint64_t getRequestsServed() const { return requestsServed; }
+    uint64_t getConnectionsAccepted() const { return connectionsAccepted; }
+
+    // Binds the socket, replacing a stale one left by a previous run but
+    // refusing to take over one that a live server still answers on
+    bool listen(const std::string& path, std::string& error) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            error = "socket path must be 1-" + std::to_string(sizeof(address.sun_path) - 1) + " characters";
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (listenFd < 0 || epollFd < 0 || wakeFd < 0) return fail("socket setup", error);
+        int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        bool live = probe >= 0 && (::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 || errno == EAGAIN);
+        if (probe >= 0) ::close(probe);
+        if (live) {
+            errno = EADDRINUSE;
+            return fail(path, error);
+        }
+        ::unlink(path.c_str());
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) return fail("bind " + path, error);
+        if (::listen(listenFd, SOMAXCONN) < 0) return fail("listen", error);
+        socketPath = path;
+        watch(listenFd, LISTEN_TAG, EPOLLIN, EPOLL_CTL_ADD);
+        watch(wakeFd, WAKE_TAG, EPOLLIN, EPOLL_CTL_ADD);
+        return true;
+    }
+
+    // Serves until stop(); the workers live for the duration of the call
+    void run() {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < workerCount; ++i) workers.emplace_back(&UnixSocketServer::workerLoop, this);
+
+        epoll_event events[64];
+        while (!stopping) {
+            int count = ::epoll_wait(epollFd, events, 64, -1);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            for (int i = 0; i < count; ++i) {
+                uint64_t tag = events[i].data.u64;
+                if (tag == LISTEN_TAG) acceptConnections();
+                else if (tag == WAKE_TAG) deliverReplies();
+                else serviceConnection(tag, events[i].events);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            workersDone = true;
+        }
+        jobReady.notify_all();
+        for (auto& worker : workers) worker.join();
+        closeAll();
+    }
+
+    // Safe from any thread (or a signal-waiting thread)
+    void stop() {
+        stopping = true;
+        wake();
+    }
+
+private:
+    bool fail(const std::string& what, std::string& error) {
+        error = what + ": " + std::strerror(errno);
+        closeAll();
+        return false;
+    }
+
+    void closeAll() {
+        for (auto& entry : connections) ::close(entry.second.fd);
+        connections.clear();
+        if (listenFd >= 0) ::close(listenFd);
+        if (epollFd >= 0) ::close(epollFd);
+        if (wakeFd >= 0) ::close(wakeFd);
+        listenFd = epollFd = wakeFd = -1;
+        if (!socketPath.empty()) ::unlink(socketPath.c_str());
+        socketPath.clear();
+    }
+
+    void watch(int fd, uint64_t tag, uint32_t events, int operation) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = events;
+        event.data.u64 = tag;
+        ::epoll_ctl(epollFd, operation, fd, &event);
+    }
+
+    void wake() {
+        if (wakePending.exchange(true)) return;
+        uint64_t one = 1;
+        if (wakeFd >= 0 && ::write(wakeFd, &one, sizeof(one)) < 0) {
+            // The counter only saturates if the loop is gone; nothing to do
+        }
+    }
+
+    void acceptConnections() {
+        while (true) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return; // EAGAIN, or out of descriptors until one closes
+            uint64_t id = nextConnection++;
+            connections[id].fd = fd;
+            watch(fd, id, EPOLLIN, EPOLL_CTL_ADD);
+            connectionsAccepted++;
+        }
+    }
+
+    void serviceConnection(uint64_t id, uint32_t events) {
+        auto it = connections.find(id);
+        if (it == connections.end()) return;
+        Connection& connection = it->second;
+        if (events & EPOLLOUT) {
+            if (!flush(id, connection) || !resume(id, connection)) return;
+        }
+        if (connection.readsPaused) {
+            // Not reading, so a hangup would otherwise be reported forever
+            if (events & (EPOLLHUP | EPOLLERR)) drop(id);
+            return;
+        }
+        if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readRequests(id, connection);
+    }
+
+    static bool backedUp(const Connection& connection) {
+        return connection.inFlight >= MAX_IN_FLIGHT ||
+               connection.output.size() - connection.outputPos >= MAX_PENDING_OUTPUT_BYTES;
+    }
+
+    // Sets the epoll interest from the connection's state: reads unless it
+    // is backed up, writes while output waits on a full socket
+    void rearm(uint64_t id, Connection& connection, bool wantWrites) {
+        bool pause = backedUp(connection);
+        if (pause == connection.readsPaused && wantWrites == connection.watchingWrites) return;
+        connection.readsPaused = pause;
+        connection.watchingWrites = wantWrites;
+        uint32_t events = 0;
+        if (!pause) events |= EPOLLIN;
+        if (wantWrites) events |= EPOLLOUT;
+        watch(connection.fd, id, events, EPOLL_CTL_MOD);
+    }
+
+    // Picks a connection back up once it is under the caps, starting with
+    // the frames it buffered while paused; false if it was dropped
+    bool resume(uint64_t id, Connection& connection) {
+        if (!backedUp(connection) && !queueFrames(id, connection)) {
+            drop(id);
+            return false;
+        }
+        rearm(id, connection, connection.watchingWrites);
+        return true;
+    }
+
+    void readRequests(uint64_t id, Connection& connection) {
+        char chunk[65536];
+        bool open = true;
+        // Buffers at most about one frame ahead; a peer that outruns the
+        // workers waits in its socket, and level-triggered epoll comes back
+        while (connection.input.size() < MAX_FRAME_BYTES + sizeof(chunk)) {
+            ssize_t bytes = ::read(connection.fd, chunk, sizeof(chunk));
+            if (bytes > 0) {
+                connection.input.append(chunk, static_cast<size_t>(bytes));
+                continue;
+            }
+            if (bytes < 0 && errno == EINTR) continue;
+            open = bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            break;
+        }
+
+        // Replies still in flight to a closed peer are dropped on arrival
+        if (!queueFrames(id, connection) || !open) {
+            drop(id);
+            return;
+        }
+        rearm(id, connection, connection.watchingWrites);
+    }
+
+    // Queues complete frames with one lock until the connection backs up;
+    // the rest, and a partial frame, stay buffered. False on an oversized frame.
+    bool queueFrames(uint64_t id, Connection& connection) {
+        size_t pos = 0;
+        const char* payload = nullptr;
+        size_t size = 0;
+        bool tooLarge = false;
+        std::vector<Job> batch;
+        while (!backedUp(connection) && Frame::next(connection.input, pos, MAX_FRAME_BYTES, payload, size, tooLarge)) {
+            batch.push_back(Job{id, std::string(payload, size)});
+            connection.inFlight++;
+        }
+        connection.input.erase(0, pos);
+        if (!batch.empty()) {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            for (auto& job : batch) jobs.push_back(std::move(job));
+        }
+        if (batch.size() == 1) jobReady.notify_one();
+        else if (!batch.empty()) jobReady.notify_all();
+        return !tooLarge;
+    }
+
+    void drop(uint64_t id) {
+        auto it = connections.find(id);
+        if (it == connections.end()) return;
+        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+        ::close(it->second.fd);
+        connections.erase(it);
+    }
+
+    // Writes what the socket takes; false if the connection was dropped
+    bool flush(uint64_t id, Connection& connection) {
+        while (connection.outputPos < connection.output.size()) {
+            ssize_t bytes = ::send(connection.fd, connection.output.data() + connection.outputPos,
+                                   connection.output.size() - connection.outputPos, MSG_NOSIGNAL);
+            if (bytes > 0) {
+                connection.outputPos += static_cast<size_t>(bytes);
+            } else if (bytes < 0 && errno == EINTR) {
+                continue;
+            } else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                rearm(id, connection, true);
+                return true;
+            } else {
+                drop(id);
+                return false;
+            }
+        }
+        connection.output.clear();
+        connection.outputPos = 0;
+        rearm(id, connection, false);
+        return true;
+    }
+
+    void deliverReplies() {
+        uint64_t counter;
+        while (::read(wakeFd, &counter, sizeof(counter)) > 0) {}
+        wakePending = false;
+
+        std::vector<Reply> ready;
+        {
+            std::lock_guard<std::mutex> lock(replyMutex);
+            ready.swap(replies);
+        }
+        std::vector<uint64_t> touched;
+        for (auto& reply : ready) {
+            auto it = connections.find(reply.connection);
+            if (it == connections.end()) continue;
+            if (reply.frame.empty()) {
+                drop(reply.connection); // The handler threw
+                continue;
+            }
+            it->second.inFlight--;
+            it->second.output += reply.frame;
+            touched.push_back(reply.connection);
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (uint64_t id : touched) {
+            auto it = connections.find(id);
+            if (it == connections.end()) continue;
+            // Output already waiting on the socket goes out on EPOLLOUT
+            if (!it->second.watchingWrites && !flush(id, it->second)) continue;
+            resume(id, it->second);
+        }
+    }
+
+    void workerLoop() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobReady.wait(lock, [this] { return workersDone || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            Reply reply;
+            reply.connection = job.connection;
+            try {
+                size_t start = Frame::begin(reply.frame);
+                handler(job.request.data(), job.request.size(), reply.frame);
+                Frame::finish(reply.frame, start);
+                requestsServed++;
+            } catch (const std::exception&) {
+                // No response to send; an empty frame tells the loop to close
+                reply.frame.clear();
+            }
+            {
+                std::lock_guard<std::mutex> lock(replyMutex);
+                replies.push_back(std::move(reply));
+            }
+            wake();
+        }
+    }
+};
+
+// Blocking client for tools and tests: send frames, read frames back
+class UnixSocketClient {
+private:
+    int fd;
+    std::string input;
+
+public:
+    UnixSocketClient() : fd(-1) {}
+    ~UnixSocketClient() { close(); }
+
+    UnixSocketClient(const UnixSocketClient&) = delete;
+    UnixSocketClient& operator=(const UnixSocketClient&) = delete;
+
+    bool connect(const std::string& path) {
+        close();
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        input.clear();
+    }
+
+    // One or more whole frames
+    bool send(const std::string& frames) {
+        size_t sent = 0;
+        while (sent < frames.size()) {
+            ssize_t bytes = ::send(fd, frames.data() + sent, frames.size() - sent, MSG_NOSIGNAL);
+            if (bytes < 0 && errno == EINTR) continue;
+            if (bytes <= 0) return false;
+            sent += static_cast<size_t>(bytes);
+        }
+        return true;
+    }
+
+    // Next frame's payload; false if the server closed the connection
+    bool receive(std::string& payload) {
+        char chunk[65536];
+        while (true) {
+            size_t pos = 0;
+            const char* data = nullptr;
+            size_t size = 0;
+            bool tooLarge = false;
+            if (Frame::next(input, pos, UnixSocketServer::MAX_FRAME_BYTES, data, size, tooLarge)) {
+                payload.assign(data, size);
+                input.erase(0, pos);
+                return true;
+            }
+            if (tooLarge) return false;
+            ssize_t bytes = ::read(fd, chunk, sizeof(chunk));
+            if (bytes < 0 && errno == EINTR) continue;
+            if (bytes <= 0) return false;
+            input.append(chunk, static_cast<size_t>(bytes));
+        }
+    }
+
+    bool call(const std::string& frame, std::string& payload) {
+        return send(frame) && receive(payload);
+    }
+};
+
+#endif // UNIX_SOCKET_SERVER_H
@@ -0,0 +1,64 @@
+#ifndef VERSIONED_SNAPSHOT_H
+#define VERSIONED_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+
+// The latest published version of a value that is replaced rather than
+// edited in place (copy-on-write). A reader takes a reference-counted handle
+// and can keep reading that version for as long as it likes; publishing a
+// new version never waits for readers. Each version is freed when its last
+// handle goes away, so old versions are reclaimed without the writer
+// tracking who is still reading them.
+template <typename T>
+class Versioned {
+public:
+    typedef std::shared_ptr<const T> Handle;
+
+private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<Handle> current;
+#else
+    Handle current; // only through std::atomic_load / std::atomic_store
+#endif
+    std::atomic<uint64_t> published{0};
+    // Shared with the deleters, so versions outliving the cell can still
+    // report being freed
+    std::shared_ptr<std::atomic<size_t>> live = std::make_shared<std::atomic<size_t>>(0);
+
+public:
+    // Empty until the first publish
+    Handle acquire() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return current.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&current, std::memory_order_acquire);
+#endif
+    }
+
+    // Takes ownership of value and makes it the current version
+    Handle publish(T* value) {
+        std::shared_ptr<std::atomic<size_t>> counter = live;
+        counter->fetch_add(1, std::memory_order_relaxed);
+        Handle version(value, [counter](const T* old) {
+            delete old;
+            counter->fetch_sub(1, std::memory_order_relaxed);
+        });
+#if defined(__cpp_lib_atomic_shared_ptr)
+        current.store(version, std::memory_order_release);
+#else
+        std::atomic_store_explicit(&current, version, std::memory_order_release);
+#endif
+        published.fetch_add(1, std::memory_order_relaxed);
+        return version;
+    }
+
+    uint64_t getPublished() const { return published.load(std::memory_order_relaxed); }
+
+    // Versions not yet freed: the current one plus any still being read
+    size_t getLiveVersions() const { return live->load(std::memory_order_relaxed); }
+};
+
+#endif // VERSIONED_SNAPSHOT_H
@@ -0,0 +1,143 @@
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+// One waiting student. Served by program priority (higher first), then
+// seniority (earlier first-enrollment date first), then request time, then
+// the order students joined.
+struct WaitlistEntry {
+    int studentId = 0;
+    int priority = 0;        // program tier
+    int seniority = 0;       // first enrollment as yyyymmdd
+    int64_t requestedAt = 0; // seconds since the epoch
+    uint64_t sequence = 0;   // join order, breaks remaining ties
+
+    bool servedBefore(const WaitlistEntry& other) const {
+        if (priority != other.priority) return priority > other.priority;
+        if (seniority != other.seniority) return seniority < other.seniority;
+        if (requestedAt != other.requestedAt) return requestedAt < other.requestedAt;
+        return sequence < other.sequence;
+    }
+};
+
+// Per-course waitlist as an indexed binary heap: the heap keeps the next
+// student at the top and a student ID -> slot index lets anyone leave from
+// the middle. Joining, leaving and promoting are O(log n) and membership
+// is O(1), so popular courses with tens of thousands waiting never rescan.
+class Waitlist {
+private:
+    std::vector<WaitlistEntry> heap;
+    std::unordered_map<int, size_t> slots;
+    uint64_t nextSequence = 0;
+
+public:
+    size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+    bool contains(int studentId) const { return slots.count(studentId) != 0; }
+
+    // Heap order; see ordered() for serving order
+    const std::vector<WaitlistEntry>& entries() const { return heap; }
+
+    // False if the student is already waiting
+    bool add(int studentId, int priority, int seniority, int64_t requestedAt) {
+        WaitlistEntry entry;
+        entry.studentId = studentId;
+        entry.priority = priority;
+        entry.seniority = seniority;
+        entry.requestedAt = requestedAt;
+        entry.sequence = nextSequence;
+        return restore(entry);
+    }
+
+    // Re-inserts a saved entry, keeping its place in the join order
+    bool restore(const WaitlistEntry& entry) {
+        if (contains(entry.studentId)) return false;
+        nextSequence = std::max(nextSequence, entry.sequence + 1);
+        heap.push_back(entry);
+        slots[entry.studentId] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+        return true;
+    }
+
+    bool remove(int studentId) {
+        auto it = slots.find(studentId);
+        if (it == slots.end()) return false;
+        size_t slot = it->second;
+        slots.erase(it);
+        size_t last = heap.size() - 1;
+        if (slot != last) {
+            heap[slot] = heap[last];
+            slots[heap[slot].studentId] = slot;
+        }
+        heap.pop_back();
+        if (slot < heap.size()) {
+            int moved = heap[slot].studentId;
+            siftUp(slot);
+            siftDown(slots[moved]);
+        }
+        return true;
+    }
+
+    const WaitlistEntry* peek() const { return heap.empty() ? nullptr : &heap[0]; }
+
+    bool pop(WaitlistEntry& entry) {
+        if (heap.empty()) return false;
+        entry = heap[0];
+        remove(entry.studentId);
+        return true;
+    }
+
+    // Students ahead of this one, or -1 if not waiting. O(n): for display.
+    long position(int studentId) const {
+        auto it = slots.find(studentId);
+        if (it == slots.end()) return -1;
+        const WaitlistEntry& entry = heap[it->second];
+        return std::count_if(heap.begin(), heap.end(),
+                             [&entry](const WaitlistEntry& other) { return other.servedBefore(entry); });
+    }
+
+    // The first limit entries in serving order
+    std::vector<WaitlistEntry> ordered(size_t limit = SIZE_MAX) const {
+        std::vector<WaitlistEntry> sorted(heap);
+        limit = std::min(limit, sorted.size());
+        auto byService = [](const WaitlistEntry& a, const WaitlistEntry& b) { return a.servedBefore(b); };
+        std::partial_sort(sorted.begin(), sorted.begin() + limit, sorted.end(), byService);
+        sorted.resize(limit);
+        return sorted;
+    }
+
+private:
+    void swapSlots(size_t a, size_t b) {
+        std::swap(heap[a], heap[b]);
+        slots[heap[a].studentId] = a;
+        slots[heap[b].studentId] = b;
+    }
+
+    void siftUp(size_t slot) {
+        while (slot > 0) {
+            size_t parent = (slot - 1) / 2;
+            if (!heap[slot].servedBefore(heap[parent])) return;
+            swapSlots(slot, parent);
+            slot = parent;
+        }
+    }
+
+    void siftDown(size_t slot) {
+        while (true) {
+            size_t best = slot;
+            size_t left = 2 * slot + 1, right = left + 1;
+            if (left < heap.size() && heap[left].servedBefore(heap[best])) best = left;
+            if (right < heap.size() && heap[right].servedBefore(heap[best])) best = right;
+            if (best == slot) return;
+            swapSlots(slot, best);
+            slot = best;
+        }
+    }
+};
+
+#endif // WAITLIST_H
@@ -0,0 +1,130 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// Bounded lock-free queue of item indices with one producer and any number
+// of consumers. The owner and thieves all take from the head, so items
+// leave in the order they arrived; a consumer claims an item by advancing
+// the head with a compare-and-swap.
+class StealQueue {
+private:
+    std::vector<std::atomic<uint32_t>> slots;
+    size_t mask;
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+
+public:
+    explicit StealQueue(size_t capacity) : slots(roundUp(capacity)), mask(slots.size() - 1) {}
+
+    size_t capacity() const { return slots.size(); }
+
+    // Producer only; false when full
+    bool push(uint32_t item) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= slots.size()) return false;
+        slots[t & mask].store(item, std::memory_order_relaxed);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Any thread. A slot read by a consumer that then loses the race may
+    // already hold a newer item; the failed CAS discards it.
+    bool pop(uint32_t& item) {
+        uint64_t h = head.load(std::memory_order_acquire);
+        while (h < tail.load(std::memory_order_acquire)) {
+            item = slots[h & mask].load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel, std::memory_order_acquire)) return true;
+        }
+        return false;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) >= tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t roundUp(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+};
+
+// Runs a burst of work items on a fixed set of workers. The calling thread
+// dispatches items in arrival order to each item's home worker (route),
+// which keeps related items, e.g. one course's requests, on one worker and
+// in order. A worker that runs dry steals the oldest item from the others,
+// so a hot home queue doesn't leave the rest of the pool idle.
+class WorkStealingPool {
+private:
+    size_t workerCount;
+    size_t queueCapacity;
+    std::atomic<uint64_t> steals{0};
+
+public:
+    explicit WorkStealingPool(size_t workers = 0, size_t queueCapacity = 4096)
+        : workerCount(workers ? workers : std::max(1u, std::thread::hardware_concurrency())),
+          queueCapacity(queueCapacity) {}
+
+    size_t getWorkerCount() const { return workerCount; }
+    uint64_t getSteals() const { return steals; }
+
+    // route(item) -> home worker (any size_t, taken modulo the worker
+    // count); work(item, worker) runs each item exactly once
+    template <typename Route, typename Work>
+    void run(size_t itemCount, Route route, Work work) {
+        std::vector<std::unique_ptr<StealQueue>> queues;
+        for (size_t i = 0; i < workerCount; ++i) queues.emplace_back(new StealQueue(queueCapacity));
+        std::atomic<bool> dispatching(true);
+
+        auto worker = [&](size_t self) {
+            uint32_t item;
+            while (true) {
+                if (queues[self]->pop(item)) {
+                    work(item, self);
+                    continue;
+                }
+                // Every other queue once per pass, starting after our own
+                bool found = false;
+                for (size_t i = 1; i < workerCount && !found; ++i) {
+                    found = queues[(self + i) % workerCount]->pop(item);
+                }
+                if (found) {
+                    steals.fetch_add(1, std::memory_order_relaxed);
+                    work(item, self);
+                    continue;
+                }
+                // Nothing anywhere: done once the dispatcher has finished
+                if (!dispatching.load(std::memory_order_acquire)) {
+                    bool drained = true;
+                    for (const auto& queue : queues) drained = drained && queue->empty();
+                    if (drained) return;
+                }
+                std::this_thread::yield();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (size_t i = 0; i < workerCount; ++i) pool.emplace_back(worker, i);
+
+        // A full home queue spills to the next worker rather than stalling
+        for (size_t item = 0; item < itemCount; ++item) {
+            size_t target = route(item) % workerCount;
+            while (!queues[target]->push(static_cast<uint32_t>(item))) {
+                target = (target + 1) % workerCount;
+                if (target == route(item) % workerCount) std::this_thread::yield();
+            }
+        }
+        dispatching.store(false, std::memory_order_release);
+        for (auto& thread : pool) thread.join();
+    }
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,113 @@
+#include "../include/AttendanceJournal.h"
+#include "../include/SwipeIngestor.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <charconv>
+
+AttendanceJournal::AttendanceJournal(const std::string& filename)
+    : filename(filename), stream(filename, std::ios::app) {
+    if (!stream.is_open()) {
+        std::cerr << "Warning: Could not open attendance journal " << filename << std::endl;
+    }
+}
+
+RollCallResult AttendanceJournal::recordRollCall(Course& course, const std::string& date,
+                                                 const std::vector<int>& presentStudentIds) {
+    // The date goes into a '|'-delimited line, so only the plain shape is taken
+    int dayNumber;
+    if (!SwipeIngestor::parseDate(date, dayNumber)) {
+        RollCallResult refused;
+        refused.courseId = course.getId();
+        refused.date = date;
+        return refused;
+    }
+
+    std::vector<int> roster = course.getEnrolledStudentIds();
+    RollCallResult result = course.recordRollCall(date, roster, presentStudentIds);
+
+    // Journal only the present IDs that were accepted; the rejected ones are
+    // sorted once so each check is a binary search
+    std::vector<int> rejected = result.rejectedIds;
+    std::sort(rejected.begin(), rejected.end());
+    std::vector<int> accepted;
+    accepted.reserve(presentStudentIds.size());
+    for (int studentId : presentStudentIds) {
+        if (!std::binary_search(rejected.begin(), rejected.end(), studentId)) {
+            accepted.push_back(studentId);
+        }
+    }
+
+    lineBuffer.clear();
+    lineBuffer += std::to_string(course.getId());
+    lineBuffer += '|';
+    lineBuffer += date;
+    lineBuffer += '|';
+    appendIds(roster);
+    lineBuffer += '|';
+    appendIds(accepted);
+    lineBuffer += '\n';
+
+    if (stream.is_open()) {
+        stream.write(lineBuffer.data(), lineBuffer.size());
+        stream.flush();
+        result.journaled = stream.good();
+    }
+    if (!result.journaled) {
+        std::cerr << "Warning: Roll-call for course " << course.getId() << " on " << date
+                  << " was not written to " << filename << std::endl;
+    }
+    return result;
+}
+
+void AttendanceJournal::appendIds(const std::vector<int>& ids) {
+    char digits[16];
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto converted = std::to_chars(digits, digits + sizeof(digits), ids[i]);
+        lineBuffer.append(digits, converted.ptr);
+        if (i < ids.size() - 1) lineBuffer += ',';
+    }
+}
+
+std::vector<int> AttendanceJournal::parseIds(const std::string& field) {
+    std::vector<int> ids;
+    const char* pos = field.data();
+    const char* end = pos + field.size();
+    while (pos < end) {
+        int value = 0;
+        auto parsed = std::from_chars(pos, end, value);
+        if (parsed.ec == std::errc()) ids.push_back(value);
+        pos = parsed.ptr;
+        while (pos < end && *pos != ',') ++pos;
+        if (pos < end) ++pos;
+    }
+    return ids;
+}
+
+int AttendanceJournal::replay(const std::string& filename, std::vector<std::shared_ptr<Course>>& courses) {
+    std::ifstream file(filename);
+    if (!file.is_open()) return 0;
+
+    int applied = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        std::stringstream ss(line);
+        std::string courseId, date, roster, present;
+        std::getline(ss, courseId, '|');
+        std::getline(ss, date, '|');
+        std::getline(ss, roster, '|');
+        std::getline(ss, present, '|');
+        if (courseId.empty() || date.empty()) continue;
+
+        int id = std::atoi(courseId.c_str());
+        auto it = std::find_if(courses.begin(), courses.end(),
+            [id](const std::shared_ptr<Course>& course) { return course && course->getId() == id; });
+        if (it == courses.end()) continue;
+
+        (*it)->recordRollCall(date, parseIds(roster), parseIds(present));
+        applied++;
+    }
+    return applied;
+}
@@ -0,0 +1,236 @@
+#include "../include/AttendanceMatrix.h"
+#include "../include/BitUtils.h"
+#include <algorithm>
+
+AttendanceMatrix::AttendanceMatrix() : wordsPerRow(0), version(0) {}
+
+size_t AttendanceMatrix::sizeInBytes() const {
+    return (presentBits.size() + recordedBits.size()) * sizeof(uint64_t);
+}
+
+int AttendanceMatrix::findSession(const std::string& date) const {
+    auto it = std::lower_bound(sessionDates.begin(), sessionDates.end(), date);
+    if (it == sessionDates.end() || *it != date) return -1;
+    return static_cast<int>(it - sessionDates.begin());
+}
+
+int AttendanceMatrix::findColumn(int studentId) const {
+    auto it = studentColumns.find(studentId);
+    return it != studentColumns.end() ? static_cast<int>(it->second) : -1;
+}
+
+size_t AttendanceMatrix::sessionFor(const std::string& date) {
+    auto it = std::lower_bound(sessionDates.begin(), sessionDates.end(), date);
+    size_t session = it - sessionDates.begin();
+    if (it != sessionDates.end() && *it == date) return session;
+
+    // Sessions normally arrive in date order, so this is usually an append
+    sessionDates.insert(it, date);
+    version++;
+    presentBits.insert(presentBits.begin() + session * wordsPerRow, wordsPerRow, 0);
+    recordedBits.insert(recordedBits.begin() + session * wordsPerRow, wordsPerRow, 0);
+    return session;
+}
+
+std::pair<size_t, size_t> AttendanceMatrix::sessionRange(const std::string& fromDate, const std::string& toDate) const {
+    size_t first = std::lower_bound(sessionDates.begin(), sessionDates.end(), fromDate) - sessionDates.begin();
+    size_t last = std::upper_bound(sessionDates.begin(), sessionDates.end(), toDate) - sessionDates.begin();
+    return {first, std::max(first, last)};
+}
+
+size_t AttendanceMatrix::columnFor(int studentId) {
+    auto it = studentColumns.find(studentId);
+    if (it != studentColumns.end()) return it->second;
+
+    size_t column = columnStudents.size();
+    growColumns(column + 1);
+    columnStudents.push_back(studentId);
+    studentColumns[studentId] = column;
+    return column;
+}
+
+void AttendanceMatrix::growColumns(size_t minColumns) {
+    size_t neededWords = BitUtils::wordsFor(minColumns);
+    if (neededWords <= wordsPerRow) return;
+
+    // Double the row stride so re-layouts stay amortised O(1) per student
+    size_t newWords = std::max(neededWords, wordsPerRow * 2);
+    size_t sessions = sessionDates.size();
+    std::vector<uint64_t> newPresent(sessions * newWords, 0);
+    std::vector<uint64_t> newRecorded(sessions * newWords, 0);
+    for (size_t s = 0; s < sessions; ++s) {
+        std::copy(presentBits.begin() + s * wordsPerRow, presentBits.begin() + (s + 1) * wordsPerRow,
+                  newPresent.begin() + s * newWords);
+        std::copy(recordedBits.begin() + s * wordsPerRow, recordedBits.begin() + (s + 1) * wordsPerRow,
+                  newRecorded.begin() + s * newWords);
+    }
+    presentBits.swap(newPresent);
+    recordedBits.swap(newRecorded);
+    wordsPerRow = newWords;
+    version++;
+}
+
+void AttendanceMatrix::record(int studentId, const std::string& date, bool isPresent) {
+    size_t column = columnFor(studentId);
+    size_t session = sessionFor(date);
+    uint64_t* present = presentBits.data() + session * wordsPerRow;
+    version++;
+    BitUtils::setBit(recordedBits.data() + session * wordsPerRow, column);
+    if (isPresent) {
+        BitUtils::setBit(present, column);
+    } else {
+        BitUtils::clearBit(present, column);
+    }
+}
+
+bool AttendanceMatrix::isRecorded(int studentId, const std::string& date) const {
+    int column = findColumn(studentId);
+    int session = findSession(date);
+    if (column < 0 || session < 0) return false;
+    return BitUtils::testBit(recordedRow(session), column);
+}
+
+bool AttendanceMatrix::wasPresent(int studentId, const std::string& date) const {
+    int column = findColumn(studentId);
+    int session = findSession(date);
+    if (column < 0 || session < 0) return false;
+    return BitUtils::testBit(presentRow(session), column);
+}
+
+std::vector<uint64_t> AttendanceMatrix::buildRow(const std::vector<int>& studentIds) {
+    for (int studentId : studentIds) columnFor(studentId);
+
+    std::vector<uint64_t> row(wordsPerRow, 0);
+    for (int studentId : studentIds) {
+        BitUtils::setBit(row.data(), studentColumns[studentId]);
+    }
+    return row;
+}
+
+size_t AttendanceMatrix::recordSession(const std::string& date, const std::vector<int>& studentIds,
+                                       const std::vector<int>& presentIds, std::vector<int>* rejectedIds) {
+    std::vector<uint64_t> recordedRow = buildRow(studentIds);
+    std::vector<uint64_t> presentRow(wordsPerRow, 0);
+    // Present students only count when they are part of the recorded set
+    for (int studentId : presentIds) {
+        int column = findColumn(studentId);
+        if (column >= 0 && BitUtils::testBit(recordedRow.data(), column)) {
+            BitUtils::setBit(presentRow.data(), column);
+        } else if (rejectedIds) {
+            rejectedIds->push_back(studentId);
+        }
+    }
+    recordSessionRow(sessionFor(date), recordedRow, presentRow);
+    return BitUtils::popcountWords(presentRow.data(), presentRow.size());
+}
+
+void AttendanceMatrix::recordSessionRow(size_t session, const std::vector<uint64_t>& recordedRow,
+                                        const std::vector<uint64_t>& presentRow) {
+    uint64_t* recorded = recordedBits.data() + session * wordsPerRow;
+    uint64_t* present = presentBits.data() + session * wordsPerRow;
+    size_t words = std::min(wordsPerRow, recordedRow.size());
+    version++;
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t mask = recordedRow[w];
+        uint64_t bits = w < presentRow.size() ? presentRow[w] & mask : 0;
+        recorded[w] |= mask;
+        present[w] = (present[w] & ~mask) | bits;
+    }
+}
+
+size_t AttendanceMatrix::recordPresences(const std::string& date, const std::vector<int>& studentIds,
+                                         const std::vector<int>& presentIds, std::vector<int>* rejectedIds) {
+    std::vector<uint64_t> rosterRow = buildRow(studentIds);
+    std::vector<uint64_t> presentRow(wordsPerRow, 0);
+    for (int studentId : presentIds) {
+        int column = findColumn(studentId);
+        if (column >= 0 && BitUtils::testBit(rosterRow.data(), column)) {
+            BitUtils::setBit(presentRow.data(), column);
+        } else if (rejectedIds) {
+            rejectedIds->push_back(studentId);
+        }
+    }
+    size_t session = sessionFor(date);
+    uint64_t* recorded = recordedBits.data() + session * wordsPerRow;
+    uint64_t* present = presentBits.data() + session * wordsPerRow;
+    version++;
+    for (size_t w = 0; w < wordsPerRow; ++w) {
+        recorded[w] |= presentRow[w];
+        present[w] |= presentRow[w];
+    }
+    return BitUtils::popcountWords(presentRow.data(), presentRow.size());
+}
+
+double AttendanceMatrix::getStudentPercentage(int studentId) const {
+    int column = findColumn(studentId);
+    if (column < 0) return 0.0;
+
+    size_t word = static_cast<size_t>(column) >> 6;
+    uint64_t bit = 1ULL << (column & 63);
+    size_t recordedDays = 0;
+    size_t presentDays = 0;
+    for (size_t s = 0; s < sessionDates.size(); ++s) {
+        size_t offset = s * wordsPerRow + word;
+        recordedDays += (recordedBits[offset] & bit) != 0;
+        presentDays += (presentBits[offset] & bit) != 0;
+    }
+
+    if (recordedDays == 0) return 0.0;
+    return (static_cast<double>(presentDays) / recordedDays) * 100.0;
+}
+
+double AttendanceMatrix::getSessionPercentage(const std::string& date) const {
+    int session = findSession(date);
+    if (session < 0) return 0.0;
+
+    uint64_t recorded = BitUtils::popcountWords(recordedRow(session), wordsPerRow);
+    if (recorded == 0) return 0.0;
+    uint64_t present = BitUtils::popcountWords(presentRow(session), wordsPerRow);
+    return (static_cast<double>(present) / recorded) * 100.0;
+}
+
+std::vector<uint32_t> AttendanceMatrix::columnCounts(const std::vector<uint64_t>& plane) const {
+    size_t sessions = sessionDates.size();
+    size_t planeCount = 1;
+    while ((size_t(1) << planeCount) <= sessions) planeCount++;
+
+    std::vector<uint64_t> counters(planeCount * wordsPerRow, 0);
+    for (size_t s = 0; s < sessions; ++s) {
+        BitUtils::bitSlicedAdd(counters.data(), planeCount, wordsPerRow, plane.data() + s * wordsPerRow);
+    }
+
+    std::vector<uint32_t> counts(columnStudents.size(), 0);
+    for (size_t p = 0; p < planeCount; ++p) {
+        const uint64_t* bits = counters.data() + p * wordsPerRow;
+        for (size_t w = 0; w < wordsPerRow; ++w) {
+            uint64_t word = bits[w];
+            while (word) {
+                size_t column = w * 64 + __builtin_ctzll(word);
+                if (column < counts.size()) counts[column] += uint32_t(1) << p;
+                word &= word - 1;
+            }
+        }
+    }
+    return counts;
+}
+
+std::vector<uint32_t> AttendanceMatrix::presentCountsPerColumn() const {
+    return columnCounts(presentBits);
+}
+
+std::vector<uint32_t> AttendanceMatrix::recordedCountsPerColumn() const {
+    return columnCounts(recordedBits);
+}
+
+std::unordered_map<int, double> AttendanceMatrix::getAllStudentPercentages() const {
+    std::unordered_map<int, double> percentages;
+    std::vector<uint32_t> present = presentCountsPerColumn();
+    std::vector<uint32_t> recorded = recordedCountsPerColumn();
+
+    for (size_t column = 0; column < columnStudents.size(); ++column) {
+        if (recorded[column] == 0) continue;
+        percentages[columnStudents[column]] =
+            (static_cast<double>(present[column]) / recorded[column]) * 100.0;
+    }
+    return percentages;
+}
@@ -0,0 +1,184 @@
+#include "../include/AttendanceRangeIndex.h"
+#include <algorithm>
+
+AttendanceRangeIndex::AttendanceRangeIndex()
+    : sessionCount(0), columnCount(0), builtVersion(0), built(false) {}
+
+bool AttendanceRangeIndex::isCurrent(const AttendanceMatrix& matrix) const {
+    return built && builtVersion == matrix.getVersion() &&
+           sessionCount == matrix.getSessionCount() && columnCount == matrix.getStudentCount();
+}
+
+void AttendanceRangeIndex::refresh(const AttendanceMatrix& matrix) {
+    if (!isCurrent(matrix)) build(matrix);
+}
+
+AttendanceRangeIndex::RowWrite AttendanceRangeIndex::beforeWrite(const AttendanceMatrix& matrix,
+                                                                 const std::string& date) const {
+    RowWrite before;
+    before.indexCurrent = isCurrent(matrix);
+    before.session = matrix.findSession(date);
+    if (before.indexCurrent && before.session >= 0) {
+        size_t words = matrix.getWordsPerRow();
+        before.recorded.assign(matrix.recordedRow(before.session), matrix.recordedRow(before.session) + words);
+        before.present.assign(matrix.presentRow(before.session), matrix.presentRow(before.session) + words);
+    }
+    return before;
+}
+
+void AttendanceRangeIndex::afterWrite(const AttendanceMatrix& matrix, const std::string& date, const RowWrite& before) {
+    int session = matrix.findSession(date);
+    if (!before.indexCurrent || session < 0 || matrix.getStudentCount() != columnCount) {
+        build(matrix);
+    } else if (before.session < 0) {
+        // New session: cheap only when it lands after every existing date
+        if (static_cast<size_t>(session) == sessionCount && matrix.getSessionCount() == sessionCount + 1) {
+            appendSession(matrix);
+        } else {
+            build(matrix);
+        }
+    } else if (matrix.getSessionCount() != sessionCount || matrix.getWordsPerRow() != before.recorded.size()) {
+        build(matrix);
+    } else {
+        size_t words = before.recorded.size();
+        applyDiff(recordedTree, session, before.recorded.data(), matrix.recordedRow(session), words);
+        applyDiff(presentTree, session, before.present.data(), matrix.presentRow(session), words);
+    }
+    builtVersion = matrix.getVersion();
+}
+
+void AttendanceRangeIndex::appendSession(const AttendanceMatrix& matrix) {
+    size_t node = sessionCount + 1;
+    presentTree.resize((node + 1) * columnCount, 0);
+    recordedTree.resize((node + 1) * columnCount, 0);
+    uint32_t* presentNode = presentTree.data() + node * columnCount;
+    uint32_t* recordedNode = recordedTree.data() + node * columnCount;
+
+    const uint64_t* rows[2] = {matrix.presentRow(sessionCount), matrix.recordedRow(sessionCount)};
+    uint32_t* nodes[2] = {presentNode, recordedNode};
+    for (int plane = 0; plane < 2; ++plane) {
+        for (size_t w = 0; w < matrix.getWordsPerRow(); ++w) {
+            uint64_t word = rows[plane][w];
+            while (word) {
+                size_t column = w * 64 + __builtin_ctzll(word);
+                if (column < columnCount) nodes[plane][column] = 1;
+                word &= word - 1;
+            }
+        }
+    }
+
+    // The node also covers the children that end just below it
+    size_t lowBit = node & (~node + 1);
+    for (size_t step = 1; step < lowBit; step <<= 1) {
+        const uint32_t* presentChild = presentTree.data() + (node - step) * columnCount;
+        const uint32_t* recordedChild = recordedTree.data() + (node - step) * columnCount;
+        for (size_t c = 0; c < columnCount; ++c) {
+            presentNode[c] += presentChild[c];
+            recordedNode[c] += recordedChild[c];
+        }
+    }
+    sessionCount = node;
+}
+
+void AttendanceRangeIndex::applyDiff(std::vector<uint32_t>& tree, size_t session,
+                                     const uint64_t* before, const uint64_t* after, size_t words) {
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t changed = before[w] ^ after[w];
+        while (changed) {
+            size_t column = w * 64 + __builtin_ctzll(changed);
+            uint32_t delta = (after[w] >> (column % 64)) & 1 ? 1u : ~0u; // +1 or -1, modulo 2^32
+            changed &= changed - 1;
+            if (column >= columnCount) continue;
+            for (size_t i = session + 1; i <= sessionCount; i += i & (~i + 1)) {
+                tree[i * columnCount + column] += delta;
+            }
+        }
+    }
+}
+
+void AttendanceRangeIndex::build(const AttendanceMatrix& matrix) {
+    sessionCount = matrix.getSessionCount();
+    columnCount = matrix.getStudentCount();
+    presentTree.assign((sessionCount + 1) * columnCount, 0);
+    recordedTree.assign((sessionCount + 1) * columnCount, 0);
+
+    // Leaf values: node i starts as the bits of session i - 1
+    size_t words = matrix.getWordsPerRow();
+    for (size_t s = 0; s < sessionCount; ++s) {
+        const uint64_t* rows[2] = {matrix.presentRow(s), matrix.recordedRow(s)};
+        uint32_t* nodes[2] = {presentTree.data() + (s + 1) * columnCount,
+                              recordedTree.data() + (s + 1) * columnCount};
+        for (int plane = 0; plane < 2; ++plane) {
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t word = rows[plane][w];
+                while (word) {
+                    size_t column = w * 64 + __builtin_ctzll(word);
+                    if (column < columnCount) nodes[plane][column] = 1;
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    // Linear-time construction: push each node into its parent
+    for (size_t i = 1; i <= sessionCount; ++i) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent > sessionCount) continue;
+        uint32_t* presentParent = presentTree.data() + parent * columnCount;
+        uint32_t* recordedParent = recordedTree.data() + parent * columnCount;
+        const uint32_t* presentNode = presentTree.data() + i * columnCount;
+        const uint32_t* recordedNode = recordedTree.data() + i * columnCount;
+        for (size_t c = 0; c < columnCount; ++c) {
+            presentParent[c] += presentNode[c];
+            recordedParent[c] += recordedNode[c];
+        }
+    }
+
+    builtVersion = matrix.getVersion();
+    built = true;
+}
+
+uint32_t AttendanceRangeIndex::prefix(const std::vector<uint32_t>& tree, size_t column, size_t count) const {
+    uint32_t total = 0;
+    for (size_t i = count; i > 0; i &= i - 1) {
+        total += tree[i * columnCount + column];
+    }
+    return total;
+}
+
+uint32_t AttendanceRangeIndex::presentInRange(size_t column, size_t first, size_t last) const {
+    if (column >= columnCount || first >= last) return 0;
+    last = std::min(last, sessionCount);
+    return prefix(presentTree, column, last) - prefix(presentTree, column, std::min(first, last));
+}
+
+uint32_t AttendanceRangeIndex::recordedInRange(size_t column, size_t first, size_t last) const {
+    if (column >= columnCount || first >= last) return 0;
+    last = std::min(last, sessionCount);
+    return prefix(recordedTree, column, last) - prefix(recordedTree, column, std::min(first, last));
+}
+
+void AttendanceRangeIndex::addPrefix(const std::vector<uint32_t>& tree, size_t count, uint32_t* out, bool subtract) const {
+    // Whole node rows are combined with flat loops the compiler vectorises
+    for (size_t i = count; i > 0; i &= i - 1) {
+        const uint32_t* node = tree.data() + i * columnCount;
+        if (subtract) {
+            for (size_t c = 0; c < columnCount; ++c) out[c] -= node[c];
+        } else {
+            for (size_t c = 0; c < columnCount; ++c) out[c] += node[c];
+        }
+    }
+}
+
+void AttendanceRangeIndex::rangeCounts(size_t first, size_t last,
+                                       std::vector<uint32_t>& present, std::vector<uint32_t>& recorded) const {
+    present.assign(columnCount, 0);
+    recorded.assign(columnCount, 0);
+    last = std::min(last, sessionCount);
+    if (first >= last) return;
+
+    addPrefix(presentTree, last, present.data(), false);
+    addPrefix(presentTree, first, present.data(), true);
+    addPrefix(recordedTree, last, recorded.data(), false);
+    addPrefix(recordedTree, first, recorded.data(), true);
+}
@@ -1,5 +1,6 @@
 #include "../include/Classroom.h"
 #include "../include/Course.h"
+#include "../include/Config.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -37,8 +38,10 @@ bool Classroom::isCourseScheduled(int courseId) const {
         });
 }
 
+// Never more courses than the room's capacity or max_courses_per_classroom
 bool Classroom::isFull() const {
-    return scheduledCourses.size() >= static_cast<size_t>(capacity);
+    int limit = std::min(capacity, Config::getInstance()->maxCoursesPerClassroom());
+    return scheduledCourses.size() >= static_cast<size_t>(limit);
 }
 
 void Classroom::saveToFile(const std::string& filename) const {
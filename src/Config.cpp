@@ -2,8 +2,17 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
-
-Config* Config::instance = nullptr;
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <climits>
+#include <filesystem>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 const std::string Config::STUDENTS_FILE = "data/students.txt";
 const std::string Config::TEACHERS_FILE = "data/teachers.txt";
@@ -11,8 +20,43 @@ const std::string Config::COURSES_FILE = "data/courses.txt";
 const std::string Config::CLASSROOMS_FILE = "data/classrooms.txt";
 const std::string Config::REPORTS_DIR = "reports/";
 
+namespace {
+
+ConfigValue parseValue(const std::string& text) {
+    ConfigValue value;
+    value.text = text;
+    const char* end = text.data() + text.size();
+    auto parsed = std::from_chars(text.data(), end, value.number);
+    value.isNumber = !text.empty() && parsed.ec == std::errc() && parsed.ptr == end;
+    
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "true" || lower == "yes" || lower == "on" || lower == "1") {
+        value.isFlag = value.flag = true;
+    } else if (lower == "false" || lower == "no" || lower == "off" || lower == "0") {
+        value.isFlag = true;
+    }
+    
+    if (!text.empty()) value.path = std::filesystem::path(text).lexically_normal().string();
+    return value;
+}
+
+int intOr(const ConfigSnapshot& snapshot, const std::string& key, int defaultValue) {
+    const ConfigValue* value = snapshot.find(key);
+    if (!value || !value->isNumber || value->number < INT_MIN || value->number > INT_MAX) return defaultValue;
+    return static_cast<int>(value->number);
+}
+
+} // namespace
+
+const ConfigValue* ConfigSnapshot::find(const std::string& key) const {
+    auto it = settings.find(key);
+    return it != settings.end() ? &it->second : nullptr;
+}
+
 Config::Config() {
     // Set default values
+    std::unordered_map<std::string, std::string> settings;
     settings["students_file"] = STUDENTS_FILE;
     settings["teachers_file"] = TEACHERS_FILE;
     settings["courses_file"] = COURSES_FILE;
@@ -22,13 +66,42 @@ Config::Config() {
     settings["max_courses_per_classroom"] = "5";
     settings["backup_enabled"] = "true";
     settings["log_level"] = "INFO";
+    publish(std::move(settings));
+}
+
+Config::~Config() {
+    stopWatching();
 }
 
+// Constructed on first use; thread-safe since C++11
 Config* Config::getInstance() {
-    if (instance == nullptr) {
-        instance = new Config();
+    static Config instance;
+    return &instance;
+}
+
+// The calling thread's snapshot, refreshed when a newer one is published.
+// Stays valid until this thread's next call.
+const ConfigSnapshot& Config::local() const {
+    thread_local std::shared_ptr<const ConfigSnapshot> cached;
+    if (!cached || cached->generation != generation.load(std::memory_order_acquire)) {
+        cached = current.acquire();
     }
-    return instance;
+    return *cached;
+}
+
+// Only with writeMutex held (or from the constructor)
+void Config::publish(std::unordered_map<std::string, std::string> settings) {
+    ConfigSnapshot* snapshot = new ConfigSnapshot();
+    for (auto& pair : settings) snapshot->settings.emplace(pair.first, parseValue(pair.second));
+    snapshot->generation = generation.load(std::memory_order_relaxed) + 1;
+    snapshot->maxStudentsPerCourse = intOr(*snapshot, "max_students_per_course", 50);
+    snapshot->maxCoursesPerClassroom = intOr(*snapshot, "max_courses_per_classroom", 5);
+    const ConfigValue* backup = snapshot->find("backup_enabled");
+    snapshot->backupEnabled = backup && backup->isFlag ? backup->flag : true;
+    
+    uint64_t published = snapshot->generation;
+    current.publish(snapshot);
+    generation.store(published, std::memory_order_release);
 }
 
 bool Config::loadFromFile(const std::string& filename) {
@@ -38,6 +111,10 @@ bool Config::loadFromFile(const std::string& filename) {
         return false;
     }
     
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::unordered_map<std::string, std::string> settings;
+    for (const auto& pair : current.acquire()->settings) settings[pair.first] = pair.second.text;
+    
     std::string line;
     while (std::getline(file, line)) {
         if (line.empty() || line[0] == '#') continue;
@@ -51,19 +128,42 @@ bool Config::loadFromFile(const std::string& filename) {
     }
     
     file.close();
+    publish(std::move(settings));
     return true;
 }
 
 std::string Config::get(const std::string& key, const std::string& defaultValue) {
-    auto it = settings.find(key);
-    if (it != settings.end()) {
-        return it->second;
-    }
-    return defaultValue;
+    const ConfigValue* value = local().find(key);
+    return value ? value->text : defaultValue;
 }
 
 void Config::set(const std::string& key, const std::string& value) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::unordered_map<std::string, std::string> settings;
+    for (const auto& pair : current.acquire()->settings) settings[pair.first] = pair.second.text;
     settings[key] = value;
+    publish(std::move(settings));
+}
+
+void Config::restore(const ConfigSnapshot& previous) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::unordered_map<std::string, std::string> settings;
+    for (const auto& pair : previous.settings) settings[pair.first] = pair.second.text;
+    publish(std::move(settings));
+}
+
+int Config::getInt(const std::string& key, int defaultValue) const {
+    return intOr(local(), key, defaultValue);
+}
+
+bool Config::getBool(const std::string& key, bool defaultValue) const {
+    const ConfigValue* value = local().find(key);
+    return value && value->isFlag ? value->flag : defaultValue;
+}
+
+std::string Config::getPath(const std::string& key, const std::string& defaultValue) const {
+    const ConfigValue* value = local().find(key);
+    return value && !value->path.empty() ? value->path : defaultValue;
 }
 
 bool Config::saveToFile(const std::string& filename) {
@@ -76,10 +176,74 @@ bool Config::saveToFile(const std::string& filename) {
     file << "# School Management System Configuration\n";
     file << "# Auto-generated configuration file\n\n";
     
-    for (const auto& pair : settings) {
-        file << pair.first << "=" << pair.second << "\n";
+    for (const auto& pair : current.acquire()->settings) {
+        file << pair.first << "=" << pair.second.text << "\n";
     }
     
     file.close();
     return true;
 }
+
+#ifdef __linux__
+// Watches the file's directory rather than the file, so editors that save by
+// writing a new file and renaming it over the old one are seen too
+bool Config::watch(const std::string& filename) {
+    stopWatching();
+    std::filesystem::path path(filename);
+    std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+    inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0 ||
+        ::inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "Warning: Could not watch config file " << filename << " for changes." << std::endl;
+        stopWatching();
+        return false;
+    }
+    watchedFile = filename;
+    watcher = std::thread(&Config::watchLoop, this, path.filename().string());
+    return true;
+}
+
+void Config::stopWatching() {
+    if (watcher.joinable()) {
+        uint64_t one = 1;
+        ssize_t written = ::write(wakeFd, &one, sizeof(one));
+        (void)written;
+        watcher.join();
+    }
+    if (inotifyFd >= 0) ::close(inotifyFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+    inotifyFd = wakeFd = -1;
+}
+
+void Config::watchLoop(const std::string& name) {
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[1].revents) return;
+        
+        bool changed = false;
+        ssize_t length;
+        while ((length = ::read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (ssize_t offset = 0; offset < length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->len && name == event->name) changed = true;
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (changed && loadFromFile(watchedFile)) reloads.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+#else
+bool Config::watch(const std::string&) {
+    return false;
+}
+
+void Config::stopWatching() {}
+
+void Config::watchLoop(const std::string&) {}
+#endif
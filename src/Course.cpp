@@ -1,6 +1,8 @@
 #include "../include/Course.h"
 #include "../include/Student.h"
 #include "../include/Teacher.h"
+#include "../include/RosterBitmap.h"
+#include "../include/Config.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -8,7 +10,9 @@
 
 Course::Course(int id, const std::string& name, const std::string& description, 
                int credits, int maxStudents)
-    : id(id), name(name), description(description), credits(credits), maxStudents(maxStudents) {}
+    : id(id), name(name), description(description), credits(credits), maxStudents(maxStudents) {
+    attendanceIndex.build(attendance);
+}
 
 void Course::assignTeacher(std::shared_ptr<Teacher> teacher) {
     assignedTeacher = teacher;
@@ -49,44 +53,100 @@ bool Course::isStudentEnrolled(int studentId) const {
         });
 }
 
+std::vector<int> Course::getEnrolledStudentIds() const {
+    std::vector<int> ids;
+    ids.reserve(enrolledStudents.size());
+    for (const auto& studentWeakPtr : enrolledStudents) {
+        auto student = studentWeakPtr.lock();
+        if (student) ids.push_back(student->getId());
+    }
+    return ids;
+}
+
+RosterBitmap Course::getRoster() const {
+    return RosterBitmap::fromIds(getEnrolledStudentIds());
+}
+
 void Course::recordAttendance(int studentId, const std::string& date, bool isPresent) {
-    attendanceRecords[studentId][date] = isPresent;
+    AttendanceRangeIndex::RowWrite before = attendanceIndex.beforeWrite(attendance, date);
+    attendance.record(studentId, date, isPresent);
+    attendanceIndex.afterWrite(attendance, date, before);
+}
+
+void Course::recordSessionAttendance(const std::string& date, const std::vector<int>& presentStudentIds) {
+    recordRollCall(date, presentStudentIds);
+}
+
+RollCallResult Course::recordRollCall(const std::string& date, const std::vector<int>& presentStudentIds) {
+    return recordRollCall(date, getEnrolledStudentIds(), presentStudentIds);
+}
+
+RollCallResult Course::recordRollCall(const std::string& date, const std::vector<int>& rosterIds,
+                                      const std::vector<int>& presentStudentIds) {
+    // Every roster student is recorded for the session in a single row write;
+    // present IDs are validated against the roster in the same pass
+    RollCallResult result;
+    result.courseId = id;
+    result.date = date;
+    result.recorded = static_cast<int>(rosterIds.size());
+    AttendanceRangeIndex::RowWrite before = attendanceIndex.beforeWrite(attendance, date);
+    result.present = static_cast<int>(
+        attendance.recordSession(date, rosterIds, presentStudentIds, &result.rejectedIds));
+    attendanceIndex.afterWrite(attendance, date, before);
+    return result;
+}
+
+RollCallResult Course::recordPresences(const std::string& date, const std::vector<int>& presentStudentIds) {
+    RollCallResult result;
+    result.courseId = id;
+    result.date = date;
+    AttendanceRangeIndex::RowWrite before = attendanceIndex.beforeWrite(attendance, date);
+    result.present = static_cast<int>(
+        attendance.recordPresences(date, getEnrolledStudentIds(), presentStudentIds, &result.rejectedIds));
+    attendanceIndex.afterWrite(attendance, date, before);
+    result.recorded = result.present;
+    return result;
 }
 
 bool Course::getAttendance(int studentId, const std::string& date) const {
-    auto studentIt = attendanceRecords.find(studentId);
-    if (studentIt != attendanceRecords.end()) {
-        auto dateIt = studentIt->second.find(date);
-        if (dateIt != studentIt->second.end()) {
-            return dateIt->second;
-        }
-    }
-    return false;
+    return attendance.wasPresent(studentId, date);
 }
 
 double Course::getStudentAttendancePercentage(int studentId) const {
-    auto studentIt = attendanceRecords.find(studentId);
-    if (studentIt == attendanceRecords.end() || studentIt->second.empty()) {
-        return 0.0;
-    }
-    
-    int totalDays = studentIt->second.size();
-    int presentDays = 0;
-    
-    for (const auto& record : studentIt->second) {
-        if (record.second) presentDays++;
-    }
-    
-    return (static_cast<double>(presentDays) / totalDays) * 100.0;
+    return attendance.getStudentPercentage(studentId);
+}
+
+double Course::getSessionAttendancePercentage(const std::string& date) const {
+    return attendance.getSessionPercentage(date);
 }
 
 std::unordered_map<int, double> Course::getAllStudentAttendancePercentages() const {
-    std::unordered_map<int, double> percentages;
+    return attendance.getAllStudentPercentages();
+}
+
+double Course::getStudentAttendancePercentage(int studentId, const std::string& fromDate, const std::string& toDate) const {
+    int column = attendance.findColumn(studentId);
+    if (column < 0) return 0.0;
     
-    for (const auto& studentRecord : attendanceRecords) {
-        percentages[studentRecord.first] = getStudentAttendancePercentage(studentRecord.first);
-    }
+    auto range = attendance.sessionRange(fromDate, toDate);
+    uint32_t recorded = attendanceIndex.recordedInRange(column, range.first, range.second);
+    if (recorded == 0) return 0.0;
+    uint32_t present = attendanceIndex.presentInRange(column, range.first, range.second);
+    return (static_cast<double>(present) / recorded) * 100.0;
+}
+
+std::unordered_map<int, double> Course::getCohortAttendancePercentages(const std::string& fromDate, const std::string& toDate) const {
+    auto range = attendance.sessionRange(fromDate, toDate);
+    std::vector<uint32_t> present;
+    std::vector<uint32_t> recorded;
+    attendanceIndex.rangeCounts(range.first, range.second, present, recorded);
     
+    std::unordered_map<int, double> percentages;
+    for (int studentId : getEnrolledStudentIds()) {
+        int column = attendance.findColumn(studentId);
+        if (column < 0 || recorded[column] == 0) continue;
+        percentages[studentId] = (static_cast<double>(present[column]) / recorded[column]) * 100.0;
+    }
     return percentages;
 }
 
@@ -103,6 +163,8 @@ std::vector<Course> Course::loadFromFile(const std::string& filename) {
     std::vector<Course> courses;
     std::ifstream file(filename);
     std::string line;
+    // Rows without a seat limit get max_students_per_course
+    int defaultMaxStudents = Config::getInstance()->maxStudentsPerCourse();
     
     while (std::getline(file, line)) {
         if (line.empty()) continue;
@@ -118,7 +180,7 @@ std::vector<Course> Course::loadFromFile(const std::string& filename) {
         
         if (!id.empty() && !name.empty()) {
             int courseCredits = credits.empty() ? 3 : std::stoi(credits);
-            int courseMaxStudents = maxStudents.empty() ? 50 : std::stoi(maxStudents);
+            int courseMaxStudents = maxStudents.empty() ? defaultMaxStudents : std::stoi(maxStudents);
             courses.emplace_back(std::stoi(id), name, description, courseCredits, courseMaxStudents);
         }
     }
@@ -152,9 +214,9 @@ void Course::displayStudentList() const {
 
 void Course::displayAttendanceReport() const {
     std::cout << "📊 Attendance Report for " << name << ":\n";
-    for (const auto& record : attendanceRecords) {
+    for (const auto& record : getAllStudentAttendancePercentages()) {
         std::cout << "  Student ID " << record.first << ": " 
-                  << getStudentAttendancePercentage(record.first) << "%\n";
+                  << record.second << "%\n";
     }
 }
 
@@ -102,6 +102,38 @@ void ReportGenerator::generateAllStudentsReport(const std::vector<Student>& stud
     }
 }
 
+void ReportGenerator::generateCourseOverlapReport(const std::vector<Course>& courses, const std::string& filename) {
+    std::string fname = filename.empty() ? 
+        reportDir + "course_overlap_" + generateTimestamp() + ".txt" : 
+        reportDir + filename;
+    
+    std::ofstream file(fname);
+    if (file.is_open()) {
+        writeHeader(file, "COURSE OVERLAP REPORT");
+        RosterQuery rosters(courses);
+        
+        file << "Shared students between course pairs:\n";
+        file << "====================================\n";
+        int overlappingPairs = 0;
+        for (size_t i = 0; i < courses.size(); ++i) {
+            for (size_t j = i + 1; j < courses.size(); ++j) {
+                size_t shared = rosters.countInBoth(courses[i].getId(), courses[j].getId());
+                if (shared == 0) continue;
+                file << courses[i].getName() << " & " << courses[j].getName() 
+                     << ": " << shared << " student(s)\n";
+                overlappingPairs++;
+            }
+        }
+        if (overlappingPairs == 0) {
+            file << "No overlapping enrollments.\n";
+        }
+        
+        writeFooter(file);
+        file.close();
+        std::cout << "✅ Course overlap report generated: " << fname << std::endl;
+    }
+}
+
 // Statistics implementations
 double Statistics::calculateAverageAge(const std::vector<Student>& students) {
     if (students.empty()) return 0.0;
@@ -0,0 +1,438 @@
+#include "../include/RosterBitmap.h"
+#include "../include/BitUtils.h"
+#include "../include/Course.h"
+#include "../include/Student.h"
+#include "../include/Teacher.h"
+#include <algorithm>
+#include <iterator>
+
+// ---- Container ----
+
+bool RosterBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return BitUtils::testBit(words.data(), low);
+    }
+    return std::binary_search(values.begin(), values.end(), low);
+}
+
+bool RosterBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        if (BitUtils::testBit(words.data(), low)) return false;
+        BitUtils::setBit(words.data(), low);
+        cardinality++;
+        return true;
+    }
+
+    auto it = std::lower_bound(values.begin(), values.end(), low);
+    if (it != values.end() && *it == low) return false;
+    values.insert(it, low);
+    cardinality++;
+    if (cardinality > ARRAY_LIMIT) toBitmap();
+    return true;
+}
+
+bool RosterBitmap::Container::remove(uint16_t low) {
+    if (isBitmap()) {
+        if (!BitUtils::testBit(words.data(), low)) return false;
+        BitUtils::clearBit(words.data(), low);
+        cardinality--;
+        if (cardinality <= ARRAY_LIMIT) toArray();
+        return true;
+    }
+
+    auto it = std::lower_bound(values.begin(), values.end(), low);
+    if (it == values.end() || *it != low) return false;
+    values.erase(it);
+    cardinality--;
+    return true;
+}
+
+void RosterBitmap::Container::toBitmap() {
+    words.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : values) {
+        BitUtils::setBit(words.data(), low);
+    }
+    values.clear();
+    values.shrink_to_fit();
+}
+
+void RosterBitmap::Container::toArray() {
+    values.clear();
+    values.reserve(cardinality);
+    for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        uint64_t word = words[w];
+        while (word) {
+            int bit = __builtin_ctzll(word);
+            values.push_back(static_cast<uint16_t>(w * 64 + bit));
+            word &= word - 1;
+        }
+    }
+    words.clear();
+    words.shrink_to_fit();
+}
+
+// ---- RosterBitmap ----
+
+RosterBitmap RosterBitmap::fromIds(const std::vector<int>& ids) {
+    std::vector<int> sorted;
+    sorted.reserve(ids.size());
+    for (int id : ids) {
+        if (id >= 0) sorted.push_back(id);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Sorted input lets every container be filled by appending
+    RosterBitmap bitmap;
+    for (int id : sorted) {
+        uint16_t key = static_cast<uint16_t>(static_cast<uint32_t>(id) >> 16);
+        if (bitmap.containers.empty() || bitmap.containers.back().key != key) {
+            Container container;
+            container.key = key;
+            bitmap.containers.push_back(std::move(container));
+        }
+        Container& container = bitmap.containers.back();
+        container.values.push_back(static_cast<uint16_t>(id & 0xFFFF));
+        container.cardinality++;
+    }
+    for (auto& container : bitmap.containers) {
+        if (container.cardinality > ARRAY_LIMIT) container.toBitmap();
+    }
+    return bitmap;
+}
+
+RosterBitmap::Container* RosterBitmap::findContainer(uint16_t key) {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& c, uint16_t k) { return c.key < k; });
+    return (it != containers.end() && it->key == key) ? &(*it) : nullptr;
+}
+
+const RosterBitmap::Container* RosterBitmap::findContainer(uint16_t key) const {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& c, uint16_t k) { return c.key < k; });
+    return (it != containers.end() && it->key == key) ? &(*it) : nullptr;
+}
+
+bool RosterBitmap::add(int studentId) {
+    if (studentId < 0) return false;
+    uint16_t key = static_cast<uint16_t>(static_cast<uint32_t>(studentId) >> 16);
+    uint16_t low = static_cast<uint16_t>(studentId & 0xFFFF);
+
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers.end() || it->key != key) {
+        Container container;
+        container.key = key;
+        it = containers.insert(it, std::move(container));
+    }
+    return it->add(low);
+}
+
+bool RosterBitmap::remove(int studentId) {
+    if (studentId < 0) return false;
+    uint16_t key = static_cast<uint16_t>(static_cast<uint32_t>(studentId) >> 16);
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers.end() || it->key != key) return false;
+
+    bool removed = it->remove(static_cast<uint16_t>(studentId & 0xFFFF));
+    if (removed && it->cardinality == 0) containers.erase(it);
+    return removed;
+}
+
+bool RosterBitmap::contains(int studentId) const {
+    if (studentId < 0) return false;
+    const Container* container = findContainer(static_cast<uint16_t>(static_cast<uint32_t>(studentId) >> 16));
+    return container && container->contains(static_cast<uint16_t>(studentId & 0xFFFF));
+}
+
+size_t RosterBitmap::cardinality() const {
+    size_t total = 0;
+    for (const auto& container : containers) total += container.cardinality;
+    return total;
+}
+
+std::vector<int> RosterBitmap::toVector() const {
+    std::vector<int> ids;
+    ids.reserve(cardinality());
+    for (const auto& container : containers) {
+        int base = static_cast<int>(container.key) << 16;
+        if (container.isBitmap()) {
+            for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                uint64_t word = container.words[w];
+                while (word) {
+                    ids.push_back(base + static_cast<int>(w * 64 + __builtin_ctzll(word)));
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (uint16_t low : container.values) ids.push_back(base + low);
+        }
+    }
+    return ids;
+}
+
+size_t RosterBitmap::sizeInBytes() const {
+    size_t bytes = sizeof(*this);
+    for (const auto& container : containers) {
+        bytes += sizeof(Container) + container.values.size() * sizeof(uint16_t) +
+                 container.words.size() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+bool RosterBitmap::operator==(const RosterBitmap& other) const {
+    return cardinality() == other.cardinality() && toVector() == other.toVector();
+}
+
+// ---- Container set algebra ----
+
+RosterBitmap::Container RosterBitmap::intersectContainers(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.isBitmap() && b.isBitmap()) {
+        result.words.assign(BITMAP_WORDS, 0);
+        result.cardinality = static_cast<uint32_t>(
+            BitUtils::andWords(a.words.data(), b.words.data(), result.words.data(), BITMAP_WORDS));
+        if (result.cardinality <= ARRAY_LIMIT) result.toArray();
+        return result;
+    }
+
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        for (uint16_t low : sparse.values) {
+            if (BitUtils::testBit(dense.words.data(), low)) result.values.push_back(low);
+        }
+    } else {
+        std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                              std::back_inserter(result.values));
+    }
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    return result;
+}
+
+RosterBitmap::Container RosterBitmap::uniteContainers(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.isBitmap() && b.isBitmap()) {
+        result.words.assign(BITMAP_WORDS, 0);
+        result.cardinality = static_cast<uint32_t>(
+            BitUtils::orWords(a.words.data(), b.words.data(), result.words.data(), BITMAP_WORDS));
+        return result;
+    }
+
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        result.words = dense.words;
+        result.cardinality = dense.cardinality;
+        for (uint16_t low : sparse.values) {
+            if (!BitUtils::testBit(result.words.data(), low)) {
+                BitUtils::setBit(result.words.data(), low);
+                result.cardinality++;
+            }
+        }
+        return result;
+    }
+
+    result.values.reserve(a.values.size() + b.values.size());
+    std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                   std::back_inserter(result.values));
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    if (result.cardinality > ARRAY_LIMIT) result.toBitmap();
+    return result;
+}
+
+RosterBitmap::Container RosterBitmap::differenceContainers(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.isBitmap()) {
+        result.words.assign(BITMAP_WORDS, 0);
+        if (b.isBitmap()) {
+            result.cardinality = static_cast<uint32_t>(
+                BitUtils::andNotWords(a.words.data(), b.words.data(), result.words.data(), BITMAP_WORDS));
+        } else {
+            result.words = a.words;
+            result.cardinality = a.cardinality;
+            for (uint16_t low : b.values) {
+                if (BitUtils::testBit(result.words.data(), low)) {
+                    BitUtils::clearBit(result.words.data(), low);
+                    result.cardinality--;
+                }
+            }
+        }
+        if (result.cardinality <= ARRAY_LIMIT) result.toArray();
+        return result;
+    }
+
+    if (b.isBitmap()) {
+        for (uint16_t low : a.values) {
+            if (!BitUtils::testBit(b.words.data(), low)) result.values.push_back(low);
+        }
+    } else {
+        std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                            std::back_inserter(result.values));
+    }
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    return result;
+}
+
+size_t RosterBitmap::intersectionCount(const Container& a, const Container& b) {
+    if (a.isBitmap() && b.isBitmap()) {
+        return BitUtils::andCount(a.words.data(), b.words.data(), BITMAP_WORDS);
+    }
+
+    size_t count = 0;
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        for (uint16_t low : sparse.values) {
+            count += BitUtils::testBit(dense.words.data(), low);
+        }
+        return count;
+    }
+
+    auto ia = a.values.begin();
+    auto ib = b.values.begin();
+    while (ia != a.values.end() && ib != b.values.end()) {
+        if (*ia < *ib) ++ia;
+        else if (*ib < *ia) ++ib;
+        else { ++count; ++ia; ++ib; }
+    }
+    return count;
+}
+
+// ---- Bitmap set algebra ----
+
+RosterBitmap RosterBitmap::intersect(const RosterBitmap& a, const RosterBitmap& b) {
+    RosterBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() && j < b.containers.size()) {
+        if (a.containers[i].key < b.containers[j].key) {
+            ++i;
+        } else if (b.containers[j].key < a.containers[i].key) {
+            ++j;
+        } else {
+            Container container = intersectContainers(a.containers[i], b.containers[j]);
+            if (container.cardinality > 0) result.containers.push_back(std::move(container));
+            ++i; ++j;
+        }
+    }
+    return result;
+}
+
+RosterBitmap RosterBitmap::unite(const RosterBitmap& a, const RosterBitmap& b) {
+    RosterBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() || j < b.containers.size()) {
+        if (j == b.containers.size() || (i < a.containers.size() && a.containers[i].key < b.containers[j].key)) {
+            result.containers.push_back(a.containers[i++]);
+        } else if (i == a.containers.size() || b.containers[j].key < a.containers[i].key) {
+            result.containers.push_back(b.containers[j++]);
+        } else {
+            result.containers.push_back(uniteContainers(a.containers[i], b.containers[j]));
+            ++i; ++j;
+        }
+    }
+    return result;
+}
+
+RosterBitmap RosterBitmap::difference(const RosterBitmap& a, const RosterBitmap& b) {
+    RosterBitmap result;
+    size_t j = 0;
+    for (const auto& container : a.containers) {
+        while (j < b.containers.size() && b.containers[j].key < container.key) ++j;
+        if (j < b.containers.size() && b.containers[j].key == container.key) {
+            Container diff = differenceContainers(container, b.containers[j]);
+            if (diff.cardinality > 0) result.containers.push_back(std::move(diff));
+        } else {
+            result.containers.push_back(container);
+        }
+    }
+    return result;
+}
+
+size_t RosterBitmap::intersectionCardinality(const RosterBitmap& a, const RosterBitmap& b) {
+    size_t count = 0;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() && j < b.containers.size()) {
+        if (a.containers[i].key < b.containers[j].key) {
+            ++i;
+        } else if (b.containers[j].key < a.containers[i].key) {
+            ++j;
+        } else {
+            count += intersectionCount(a.containers[i], b.containers[j]);
+            ++i; ++j;
+        }
+    }
+    return count;
+}
+
+// ---- RosterQuery ----
+
+RosterQuery::RosterQuery(const std::vector<Course>& courses) {
+    for (const auto& course : courses) {
+        addCourse(course);
+    }
+}
+
+void RosterQuery::addCourse(const Course& course) {
+    courseRosters[course.getId()] = course.getRoster();
+
+    auto teacher = course.getAssignedTeacher();
+    if (teacher && !teacher->getDepartment().empty()) {
+        auto& ids = departmentCourses[teacher->getDepartment()];
+        if (std::find(ids.begin(), ids.end(), course.getId()) == ids.end()) {
+            ids.push_back(course.getId());
+        }
+    }
+}
+
+const RosterBitmap& RosterQuery::getRoster(int courseId) const {
+    static const RosterBitmap emptyRoster;
+    auto it = courseRosters.find(courseId);
+    return it != courseRosters.end() ? it->second : emptyRoster;
+}
+
+bool RosterQuery::hasCourse(int courseId) const {
+    return courseRosters.find(courseId) != courseRosters.end();
+}
+
+std::vector<int> RosterQuery::studentsInBoth(int courseA, int courseB) const {
+    return RosterBitmap::intersect(getRoster(courseA), getRoster(courseB)).toVector();
+}
+
+std::vector<int> RosterQuery::studentsInEither(int courseA, int courseB) const {
+    return RosterBitmap::unite(getRoster(courseA), getRoster(courseB)).toVector();
+}
+
+std::vector<int> RosterQuery::studentsInFirstOnly(int courseA, int courseB) const {
+    return RosterBitmap::difference(getRoster(courseA), getRoster(courseB)).toVector();
+}
+
+std::vector<int> RosterQuery::studentsInDepartment(const std::string& department) const {
+    return departmentRoster(department).toVector();
+}
+
+size_t RosterQuery::countInBoth(int courseA, int courseB) const {
+    return RosterBitmap::intersectionCardinality(getRoster(courseA), getRoster(courseB));
+}
+
+size_t RosterQuery::countInDepartment(const std::string& department) const {
+    return departmentRoster(department).cardinality();
+}
+
+RosterBitmap RosterQuery::departmentRoster(const std::string& department) const {
+    RosterBitmap result;
+    auto it = departmentCourses.find(department);
+    if (it == departmentCourses.end()) return result;
+
+    for (int courseId : it->second) {
+        result = RosterBitmap::unite(result, getRoster(courseId));
+    }
+    return result;
+}
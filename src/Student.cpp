@@ -1,10 +1,10 @@
 #include "../include/Student.h"
 #include "../include/Course.h"
+#include "../include/TextValidator.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
-#include <regex>
 
 Student::Student(int id, const std::string& name, int age, 
                 const std::string& email, const std::string& phone) 
@@ -103,6 +103,5 @@ bool Student::isValidAge(int age) {
 
 bool Student::isValidEmail(const std::string& email) {
     if (email.empty()) return true; // Email is optional
-    std::regex emailPattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return std::regex_match(email, emailPattern);
+    return TextValidator::isEmail(email);
 }
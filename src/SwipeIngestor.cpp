@@ -0,0 +1,451 @@
+#include "../include/SwipeIngestor.h"
+#include "../include/Course.h"
+#include "../include/Classroom.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <cstring>
+#include <cstdio>
+
+// Present IDs for one (course, day); compacted with sort+unique whenever it
+// doubles so repeated swipes by the same student don't grow it unboundedly
+struct SwipeIngestor::SessionHits {
+    std::vector<int> studentIds;
+    size_t compactAt = 256;
+
+    void add(int studentId) {
+        studentIds.push_back(studentId);
+        if (studentIds.size() >= compactAt) {
+            compact();
+            compactAt = std::max<size_t>(256, studentIds.size() * 2);
+        }
+    }
+
+    void compact() {
+        std::sort(studentIds.begin(), studentIds.end());
+        studentIds.erase(std::unique(studentIds.begin(), studentIds.end()), studentIds.end());
+    }
+};
+
+struct SwipeIngestor::WorkerState {
+    std::unordered_map<uint64_t, SessionHits> sessions; // (courseIndex << 32) | dayNumber
+    size_t rowsRead = 0;
+    size_t rowsMatched = 0;
+    size_t rowsUnmatched = 0;
+    size_t rowsMalformed = 0;
+    std::string roomKey;
+};
+
+namespace {
+
+// Bounded hand-off between the reader and the parser threads
+class ChunkQueue {
+private:
+    std::deque<std::string> chunks;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit ChunkQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(std::string chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return chunks.size() < capacity; });
+        chunks.push_back(std::move(chunk));
+        notEmpty.notify_one();
+    }
+
+    bool pop(std::string& chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return !chunks.empty() || closed; });
+        if (chunks.empty()) return false;
+        chunk = std::move(chunks.front());
+        chunks.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+};
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+int daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - era * 400;
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int daysInMonth(int year, int month) {
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+bool parseDigits(const char*& pos, const char* end, int count, int& value) {
+    if (end - pos < count) return false;
+    value = 0;
+    for (int i = 0; i < count; ++i, ++pos) {
+        if (*pos < '0' || *pos > '9') return false;
+        value = value * 10 + (*pos - '0');
+    }
+    return true;
+}
+
+// "YYYY-MM-DD" at pos, advanced past it
+bool parseCivilDate(const char*& pos, const char* end, int& dayNumber) {
+    int year, month, day;
+    if (!parseDigits(pos, end, 4, year) || pos == end || *pos++ != '-' ||
+        !parseDigits(pos, end, 2, month) || pos == end || *pos++ != '-' ||
+        !parseDigits(pos, end, 2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return false;
+    dayNumber = daysFromCivil(year, month, day);
+    return true;
+}
+
+void trimField(const char*& begin, const char*& end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '"')) ++begin;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '"')) --end;
+}
+
+} // namespace
+
+SwipeIngestor::SwipeIngestor(size_t workerCount, size_t chunkBytes, size_t maxChunksInFlight)
+    : workerCount(workerCount), chunkBytes(std::max<size_t>(chunkBytes, 4096)),
+      maxChunksInFlight(maxChunksInFlight), earlyArrivalMinutes(10) {
+    if (this->workerCount == 0) {
+        this->workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (this->maxChunksInFlight == 0) {
+        this->maxChunksInFlight = this->workerCount * 2;
+    }
+}
+
+void SwipeIngestor::addClassroom(std::shared_ptr<Classroom> classroom) {
+    if (!classroom) return;
+    classrooms[classroom->getId()] = classroom;
+    roomClassrooms[std::to_string(classroom->getId())] = classroom->getId();
+    if (!classroom->getLocation().empty()) {
+        roomClassrooms[classroom->getLocation()] = classroom->getId();
+    }
+}
+
+bool SwipeIngestor::addSlot(int classroomId, int courseId, int weekday, int startMinute, int endMinute) {
+    auto room = classrooms.find(classroomId);
+    if (room == classrooms.end() || weekday < 1 || weekday > 7 ||
+        startMinute < 0 || endMinute > 24 * 60 || startMinute >= endMinute) {
+        return false;
+    }
+
+    // Only courses actually scheduled in the classroom can be joined to it
+    const auto& scheduled = room->second->getScheduledCourses();
+    auto course = std::find_if(scheduled.begin(), scheduled.end(),
+        [courseId](const std::shared_ptr<Course>& c) { return c && c->getId() == courseId; });
+    if (course == scheduled.end()) return false;
+
+    auto known = std::find(courses.begin(), courses.end(), *course);
+    int courseIndex = static_cast<int>(known - courses.begin());
+    if (known == courses.end()) courses.push_back(*course);
+
+    classroomSlots[classroomId].push_back({courseIndex, weekday, startMinute, endMinute});
+    return true;
+}
+
+bool SwipeIngestor::addSlot(int classroomId, int courseId, int weekday, const std::string& start, const std::string& end) {
+    return addSlot(classroomId, courseId, weekday, parseClock(start), parseClock(end));
+}
+
+int SwipeIngestor::loadTimetable(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    int added = 0;
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::stringstream ss(line);
+        std::string classroomId, courseId, weekday, start, end;
+        std::getline(ss, classroomId, ',');
+        std::getline(ss, courseId, ',');
+        std::getline(ss, weekday, ',');
+        std::getline(ss, start, ',');
+        std::getline(ss, end, ',');
+
+        try {
+            if (addSlot(std::stoi(classroomId), std::stoi(courseId), std::stoi(weekday), start, end)) {
+                added++;
+            }
+        } catch (const std::exception&) {
+            // Skip header and malformed lines
+        }
+    }
+    return added;
+}
+
+size_t SwipeIngestor::getSlotCount() const {
+    size_t count = 0;
+    for (const auto& entry : classroomSlots) count += entry.second.size();
+    return count;
+}
+
+SwipeIngestStats SwipeIngestor::ingestFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open swipe log " << filename << std::endl;
+        return SwipeIngestStats();
+    }
+    return ingestStream(file);
+}
+
+SwipeIngestStats SwipeIngestor::ingestStream(std::istream& input) {
+    auto startTime = std::chrono::steady_clock::now();
+    SwipeIngestStats stats;
+
+    ChunkQueue queue(maxChunksInFlight);
+    std::vector<WorkerState> states(workerCount);
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (size_t w = 0; w < workerCount; ++w) {
+        workers.emplace_back([this, &queue, &states, w] {
+            std::string chunk;
+            while (queue.pop(chunk)) processChunk(chunk, states[w]);
+        });
+    }
+
+    // Reader: cut fixed-size blocks at the last newline and carry the tail over
+    std::string carry;
+    std::vector<char> block(chunkBytes);
+    bool firstChunk = true;
+    bool skippingLine = false; // Dropping the rest of an over-long line
+    while (input) {
+        input.read(block.data(), block.size());
+        std::streamsize got = input.gcount();
+        if (got <= 0) break;
+        stats.bytesRead += static_cast<size_t>(got);
+
+        std::string chunk;
+        chunk.reserve(carry.size() + static_cast<size_t>(got));
+        chunk.append(carry);
+        chunk.append(block.data(), static_cast<size_t>(got));
+        carry.clear();
+
+        if (skippingLine) {
+            size_t newline = chunk.find('\n');
+            if (newline == std::string::npos) continue;
+            chunk.erase(0, newline + 1);
+            skippingLine = false;
+        }
+
+        size_t lastNewline = chunk.rfind('\n');
+        if (lastNewline == std::string::npos) {
+            if (chunk.size() > MAX_LINE_BYTES) {
+                // No row is this long; reject it rather than buffer until a newline
+                stats.rowsRead++;
+                stats.rowsMalformed++;
+                skippingLine = true;
+                firstChunk = false;
+                continue;
+            }
+            carry.swap(chunk); // Line longer than a block
+            continue;
+        }
+        carry.assign(chunk, lastNewline + 1, std::string::npos);
+        chunk.resize(lastNewline + 1);
+
+        if (firstChunk) {
+            firstChunk = false;
+            if (!chunk.empty() && (chunk[0] < '0' || chunk[0] > '9')) {
+                chunk.erase(0, chunk.find('\n') + 1); // Header row
+            }
+        }
+        queue.push(std::move(chunk));
+    }
+    if (!carry.empty()) {
+        if (firstChunk && (carry[0] < '0' || carry[0] > '9')) carry.clear();
+        queue.push(std::move(carry));
+    }
+    queue.close();
+    for (auto& worker : workers) worker.join();
+
+    for (const auto& state : states) {
+        stats.rowsRead += state.rowsRead;
+        stats.rowsMatched += state.rowsMatched;
+        stats.rowsUnmatched += state.rowsUnmatched;
+        stats.rowsMalformed += state.rowsMalformed;
+    }
+    writeSessions(states, stats);
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return stats;
+}
+
+void SwipeIngestor::processChunk(const std::string& chunk, WorkerState& state) const {
+    const char* pos = chunk.data();
+    const char* end = pos + chunk.size();
+    while (pos < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(pos, '\n', end - pos));
+        if (!lineEnd) lineEnd = end;
+        if (lineEnd > pos && !(lineEnd - pos == 1 && *pos == '\r')) {
+            processRow(pos, lineEnd, state);
+        }
+        pos = lineEnd + 1;
+    }
+}
+
+void SwipeIngestor::processRow(const char* begin, const char* end, WorkerState& state) const {
+    state.rowsRead++;
+    if (static_cast<size_t>(end - begin) > MAX_LINE_BYTES) {
+        state.rowsMalformed++;
+        return;
+    }
+
+    const char* firstComma = static_cast<const char*>(memchr(begin, ',', end - begin));
+    const char* secondComma = firstComma ? static_cast<const char*>(memchr(firstComma + 1, ',', end - firstComma - 1)) : nullptr;
+    if (!secondComma) {
+        state.rowsMalformed++;
+        return;
+    }
+
+    int dayNumber = 0;
+    int minuteOfDay = 0;
+    const char* idBegin = firstComma + 1;
+    const char* idEnd = secondComma;
+    trimField(idBegin, idEnd);
+    int studentId = 0;
+    auto parsedId = std::from_chars(idBegin, idEnd, studentId);
+    if (!parseTimestamp(begin, firstComma, dayNumber, minuteOfDay) ||
+        parsedId.ec != std::errc() || parsedId.ptr != idEnd) {
+        state.rowsMalformed++;
+        return;
+    }
+
+    const char* roomBegin = secondComma + 1;
+    const char* roomEnd = end;
+    trimField(roomBegin, roomEnd);
+    state.roomKey.assign(roomBegin, roomEnd);
+    auto room = roomClassrooms.find(state.roomKey);
+    const Slot* slot = room != roomClassrooms.end() ? findSlot(room->second, weekdayOf(dayNumber), minuteOfDay) : nullptr;
+    if (!slot) {
+        state.rowsUnmatched++;
+        return;
+    }
+
+    uint64_t key = (static_cast<uint64_t>(slot->courseIndex) << 32) | static_cast<uint32_t>(dayNumber);
+    state.sessions[key].add(studentId);
+    state.rowsMatched++;
+}
+
+const SwipeIngestor::Slot* SwipeIngestor::findSlot(int classroomId, int weekday, int minuteOfDay) const {
+    auto slots = classroomSlots.find(classroomId);
+    if (slots == classroomSlots.end()) return nullptr;
+    for (const Slot& slot : slots->second) {
+        if (slot.weekday == weekday && minuteOfDay >= slot.startMinute - earlyArrivalMinutes &&
+            minuteOfDay < slot.endMinute) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+void SwipeIngestor::writeSessions(std::vector<WorkerState>& states, SwipeIngestStats& stats) {
+    // Merge the per-worker hits; ordered so each course sees its sessions by date.
+    // Swipes only add presences, so a second log for the same day, or a
+    // teacher's roll-call, keeps what it already recorded.
+    std::map<uint64_t, std::vector<int>> merged;
+    for (auto& state : states) {
+        for (auto& entry : state.sessions) {
+            std::vector<int>& ids = merged[entry.first];
+            ids.insert(ids.end(), entry.second.studentIds.begin(), entry.second.studentIds.end());
+        }
+        state.sessions.clear();
+    }
+
+    for (auto& entry : merged) {
+        std::vector<int>& ids = entry.second;
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+        auto& course = courses[entry.first >> 32];
+        int dayNumber = static_cast<int32_t>(entry.first & 0xFFFFFFFFu);
+        RollCallResult result = course->recordPresences(formatDate(dayNumber), ids);
+        stats.sessionsRecorded++;
+        stats.studentsPresent += result.present;
+        stats.rejectedSwipes += result.rejectedIds.size();
+    }
+}
+
+bool SwipeIngestor::parseTimestamp(const char* begin, const char* end, int& dayNumber, int& minuteOfDay) {
+    trimField(begin, end);
+    const char* pos = begin;
+    int hour, minute;
+    if (!parseCivilDate(pos, end, dayNumber) || pos == end || (*pos != ' ' && *pos != 'T')) {
+        return false;
+    }
+    ++pos;
+    if (!parseDigits(pos, end, 2, hour) || pos == end || *pos++ != ':' ||
+        !parseDigits(pos, end, 2, minute) || hour > 23 || minute > 59) {
+        return false;
+    }
+
+    minuteOfDay = hour * 60 + minute;
+    return true;
+}
+
+bool SwipeIngestor::parseDate(const std::string& date, int& dayNumber) {
+    const char* pos = date.data();
+    const char* end = pos + date.size();
+    return parseCivilDate(pos, end, dayNumber) && pos == end;
+}
+
+int SwipeIngestor::parseClock(const std::string& clock) {
+    const char* pos = clock.data();
+    const char* end = pos + clock.size();
+    trimField(pos, end);
+    int hour, minute;
+    if (!parseDigits(pos, end, 2, hour) || pos == end || *pos++ != ':' ||
+        !parseDigits(pos, end, 2, minute) || hour > 24 || minute > 59) {
+        return -1;
+    }
+    return hour * 60 + minute;
+}
+
+int SwipeIngestor::weekdayOf(int dayNumber) {
+    // 1970-01-01 was a Thursday
+    return ((dayNumber % 7) + 7 + 3) % 7 + 1;
+}
+
+std::string SwipeIngestor::formatDate(int dayNumber) {
+    // Inverse of daysFromCivil
+    int z = dayNumber + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int dayOfEra = z - era * 146097;
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int mp = (5 * dayOfYear + 2) / 153;
+    const int day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    const int month = mp < 10 ? mp + 3 : mp - 9;
+    const int year = yearOfEra + era * 400 + (month <= 2);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
@@ -1,10 +1,10 @@
 #include "../include/Teacher.h"
 #include "../include/Course.h"
+#include "../include/TextValidator.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
-#include <regex>
 
 Teacher::Teacher(int id, const std::string& name, const std::string& subject,
                 const std::string& email, const std::string& phone,
@@ -89,6 +89,5 @@ bool Teacher::isValidId(int id) {
 
 bool Teacher::isValidEmail(const std::string& email) {
     if (email.empty()) return true; // Email is optional
-    std::regex emailPattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return std::regex_match(email, emailPattern);
+    return TextValidator::isEmail(email);
 }
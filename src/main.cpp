@@ -4,6 +4,7 @@
 #include "../include/Course.h"
 #include "../include/Classroom.h"
 #include "../include/Reports.h"
+#include "../include/SwipeIngestor.h"
 #include <iostream>
 #include <vector>
 #include <memory>
@@ -23,7 +24,8 @@ public:
     SchoolManagementSystem() {
         config = Config::getInstance();
         config->loadFromFile("config.txt");
-        reportGenerator = ReportGenerator(config->get("reports_dir", "reports/"));
+        config->watch("config.txt");
+        reportGenerator = ReportGenerator(config->getPath("reports_dir", "reports/"));
         loadAllData();
     }
 
@@ -138,6 +140,7 @@ private:
             std::cout << "4. Update Course\n";
             std::cout << "5. Delete Course\n";
             std::cout << "6. View Course Details\n";
+            std::cout << "7. Import Card-Reader Swipes\n";
             std::cout << "0. Back to Main Menu\n";
             
             choice = getIntInput("Enter your choice: ");
@@ -149,6 +152,7 @@ private:
                 case 4: updateCourse(); break;
                 case 5: deleteCourse(); break;
                 case 6: viewCourseDetails(); break;
+                case 7: importSwipeLog(); break;
                 case 0: break;
                 default: std::cout << "❌ Invalid choice!\n";
             }
@@ -253,6 +257,29 @@ private:
     void deleteCourse() { std::cout << "🔨 Delete Course - To be implemented\n"; }
     void viewCourseDetails() { std::cout << "🔨 Course Details - To be implemented\n"; }
     
+    void importSwipeLog() {
+        std::string timetableFile = getStringInput("Timetable file (classroomId,courseId,weekday,HH:MM,HH:MM): ");
+        std::string swipeFile = getStringInput("Swipe log file (timestamp,studentId,room): ");
+        
+        SwipeIngestor ingestor;
+        for (const auto& classroom : classrooms) {
+            ingestor.addClassroom(classroom);
+        }
+        int slots = ingestor.loadTimetable(timetableFile);
+        if (slots == 0) {
+            std::cout << "❌ No timetable slots matched scheduled courses.\n";
+            return;
+        }
+        
+        SwipeIngestStats stats = ingestor.ingestFile(swipeFile);
+        std::cout << "✅ Ingested " << stats.rowsRead << " swipes in " << stats.seconds << "s ("
+                  << static_cast<long long>(stats.rowsPerSecond()) << " rows/sec, "
+                  << ingestor.getWorkerCount() << " threads)\n";
+        std::cout << "   Matched: " << stats.rowsMatched << ", unmatched: " << stats.rowsUnmatched
+                  << ", malformed: " << stats.rowsMalformed << ", not enrolled: " << stats.rejectedSwipes << "\n";
+        std::cout << "   Sessions recorded: " << stats.sessionsRecorded << "\n";
+    }
+    
     void classroomMenu() { std::cout << "🔨 Classroom Management - To be implemented\n"; }
     void settingsMenu() { std::cout << "🔨 System Settings - To be implemented\n"; }
     
@@ -3,7 +3,38 @@
 #include "../include/Teacher.h"
 #include "../include/Course.h"
 #include "../include/Config.h"
+#include "../include/RosterBitmap.h"
+#include "../include/AttendanceMatrix.h"
+#include "../include/AttendanceJournal.h"
+#include "../include/SwipeIngestor.h"
+#include "../include/Classroom.h"
+#include "../include/TextValidator.h"
+#include "../include/TextNormalizer.h"
+#include "../include/CsvReader.h"
+#include "../include/OutputBuffer.h"
+#include "../include/JsonLinesReader.h"
+#include "../include/ColumnarFile.h"
+#include "../include/UnixSocketServer.h"
+#include "../include/SeatReservation.h"
+#include "../include/Waitlist.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/VersionedSnapshot.h"
+#include "../include/ShardedStore.h"
+#include "../include/AsyncFileWriter.h"
+#include "../include/CoroutineTask.h"
+#include "../include/OptimisticCommit.h"
 #include <memory>
+#include <algorithm>
+#include <iterator>
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <regex>
+#include <thread>
+#include <new>
+#include <unistd.h>
+#include <sys/stat.h>
 
 class StudentTests {
 public:
@@ -163,8 +194,1530 @@ public:
     }
 };
 
+class AttendanceMatrixTests {
+public:
+    static void testCourseAttendanceRecording() {
+        Course course(1, "Math 101");
+        
+        course.recordAttendance(1, "2024-01-02", true);
+        course.recordAttendance(1, "2024-01-01", false); // Out of order date
+        course.recordAttendance(1, "2024-01-03", true);
+        course.recordAttendance(2, "2024-01-02", false);
+        course.recordAttendance(1, "2024-01-03", false); // Overwrite
+        
+        ASSERT_TRUE(course.getAttendance(1, "2024-01-02"));
+        ASSERT_FALSE(course.getAttendance(1, "2024-01-03"));
+        ASSERT_FALSE(course.getAttendance(3, "2024-01-02")); // Never recorded
+        ASSERT_EQ(3, static_cast<int>(course.getAttendanceMatrix().getSessionCount()));
+        ASSERT_EQ("2024-01-01", course.getAttendanceMatrix().getSessionDates().front());
+        
+        // Student 1: 1 of 3 sessions, student 2: 0 of 1
+        ASSERT_EQ(33, static_cast<int>(course.getStudentAttendancePercentage(1)));
+        ASSERT_EQ(0, static_cast<int>(course.getStudentAttendancePercentage(2)));
+        ASSERT_EQ(50, static_cast<int>(course.getSessionAttendancePercentage("2024-01-02")));
+        
+        auto all = course.getAllStudentAttendancePercentages();
+        ASSERT_EQ(2, static_cast<int>(all.size()));
+        ASSERT_EQ(33, static_cast<int>(all[1]));
+    }
+    
+    static void testSessionRowWrite() {
+        Course course(1, "Math 101", "", 3, 200);
+        std::vector<std::shared_ptr<Student>> students;
+        std::vector<int> present;
+        for (int id = 1; id <= 150; ++id) {
+            students.push_back(std::make_shared<Student>(id, "Student", 20));
+            course.enrollStudent(students.back());
+            if (id % 3 == 0) present.push_back(id);
+        }
+        present.push_back(999); // Not enrolled, must be ignored
+        
+        course.recordSessionAttendance("2024-02-01", present);
+        ASSERT_EQ(150, static_cast<int>(course.getAttendanceMatrix().getStudentCount()));
+        ASSERT_TRUE(course.getAttendance(3, "2024-02-01"));
+        ASSERT_FALSE(course.getAttendance(4, "2024-02-01"));
+        ASSERT_FALSE(course.getAttendance(999, "2024-02-01"));
+        ASSERT_EQ(33, static_cast<int>(course.getSessionAttendancePercentage("2024-02-01")));
+    }
+    
+    static void testRollCallJournal() {
+        const std::string journalFile = "test_attendance_journal.txt";
+        std::remove(journalFile.c_str());
+        
+        auto course = std::make_shared<Course>(7, "Physics 101");
+        std::vector<std::shared_ptr<Student>> students;
+        for (int id = 1; id <= 5; ++id) {
+            students.push_back(std::make_shared<Student>(id, "Student", 20));
+            course->enrollStudent(students.back());
+        }
+        
+        {
+            AttendanceJournal journal(journalFile);
+            ASSERT_TRUE(journal.isOpen());
+            RollCallResult result = journal.recordRollCall(*course, "2024-04-01", {1, 2, 42, 2});
+            ASSERT_EQ(5, result.recorded);
+            ASSERT_EQ(2, result.present);
+            ASSERT_EQ(1, static_cast<int>(result.rejectedIds.size()));
+            ASSERT_EQ(42, result.rejectedIds[0]);
+            ASSERT_TRUE(result.journaled);
+            journal.recordRollCall(*course, "2024-04-02", {3});
+            
+            // Dates that would break the line format record nothing
+            const char* badDates[] = {"2024-04-03|9", "2024-04-03\n7|x", "2024-13-01", "04/03/2024", ""};
+            for (const char* date : badDates) {
+                result = journal.recordRollCall(*course, date, {4});
+                ASSERT_FALSE(result.journaled);
+                ASSERT_EQ(0, result.recorded);
+            }
+            ASSERT_FALSE(course->getAttendance(4, "2024-13-01"));
+        }
+        
+        // One line per roll-call, replayed into a fresh course
+        std::vector<std::shared_ptr<Course>> courses = {std::make_shared<Course>(7, "Physics 101")};
+        ASSERT_EQ(2, AttendanceJournal::replay(journalFile, courses));
+        ASSERT_TRUE(courses[0]->getAttendance(2, "2024-04-01"));
+        ASSERT_FALSE(courses[0]->getAttendance(3, "2024-04-01"));
+        ASSERT_TRUE(courses[0]->getAttendance(3, "2024-04-02"));
+        ASSERT_EQ(40, static_cast<int>(courses[0]->getSessionAttendancePercentage("2024-04-01")));
+        std::remove(journalFile.c_str());
+        
+        // A journal that never opened, or whose writes fail, says so
+        AttendanceJournal unopened("no_such_dir/attendance_journal.txt");
+        ASSERT_FALSE(unopened.recordRollCall(*course, "2024-04-04", {1}).journaled);
+        if (::access("/dev/full", W_OK) == 0) {
+            AttendanceJournal full("/dev/full");
+            ASSERT_TRUE(full.isOpen());
+            RollCallResult result = full.recordRollCall(*course, "2024-04-05", {1});
+            ASSERT_FALSE(result.journaled);
+            ASSERT_EQ(5, result.recorded);
+        }
+    }
+    
+    static void testSwipeIngestion() {
+        auto course = std::make_shared<Course>(3, "Chemistry", "", 3, 100);
+        std::vector<std::shared_ptr<Student>> students;
+        for (int id = 1; id <= 40; ++id) {
+            students.push_back(std::make_shared<Student>(id, "Student", 20));
+            course->enrollStudent(students.back());
+        }
+        auto room = std::make_shared<Classroom>(12, 5, "B-101", "Science");
+        room->scheduleCourse(course);
+        
+        SwipeIngestor ingestor(3, 4096, 2);
+        ingestor.addClassroom(room);
+        ASSERT_TRUE(ingestor.addSlot(12, 3, 1, "09:00", "10:00")); // Mondays
+        ASSERT_FALSE(ingestor.addSlot(12, 99, 1, "09:00", "10:00")); // Not scheduled there
+        ASSERT_EQ(4, SwipeIngestor::weekdayOf(0)); // 1970-01-01 was a Thursday
+        ASSERT_EQ("2024-04-01", SwipeIngestor::formatDate(19814));
+        
+        // Enough rows to span several chunks; 2024-04-01 and 2024-04-08 are Mondays
+        std::stringstream log;
+        log << "timestamp,student_id,room\n";
+        for (int repeat = 0; repeat < 50; ++repeat) {
+            for (int id = 1; id <= 20; ++id) log << "2024-04-01 08:5" << (id % 10) << ":00," << id << ",B-101\n";
+        }
+        log << "2024-04-08T09:30:00,5,12\n";        // Room by classroom ID
+        log << "2024-04-01 10:15:00,30,B-101\n";    // After the session
+        log << "2024-04-01 09:10:00,31,Gym\n";      // Unknown room
+        log << "2024-04-02 09:10:00,32,B-101\n";    // Tuesday, nothing scheduled
+        log << "2024-04-01 09:10:00,777,B-101\n";   // Not enrolled
+        log << "garbage line\n";
+        
+        SwipeIngestStats stats = ingestor.ingestStream(log);
+        ASSERT_EQ(1006, static_cast<int>(stats.rowsRead));
+        ASSERT_EQ(1002, static_cast<int>(stats.rowsMatched));
+        ASSERT_EQ(3, static_cast<int>(stats.rowsUnmatched));
+        ASSERT_EQ(1, static_cast<int>(stats.rowsMalformed));
+        ASSERT_EQ(1, static_cast<int>(stats.rejectedSwipes));
+        ASSERT_EQ(2, static_cast<int>(stats.sessionsRecorded));
+        ASSERT_EQ(21, static_cast<int>(stats.studentsPresent));
+        
+        ASSERT_TRUE(course->getAttendance(20, "2024-04-01"));
+        ASSERT_FALSE(course->getAttendance(30, "2024-04-01"));
+        ASSERT_TRUE(course->getAttendance(5, "2024-04-08"));
+        ASSERT_FALSE(course->getAttendanceMatrix().isRecorded(30, "2024-04-01")); // No swipe, nothing recorded
+        ASSERT_EQ(100, static_cast<int>(course->getSessionAttendancePercentage("2024-04-01")));
+    }
+    
+    // A second log for the same day adds to the first, and swipes never undo
+    // a teacher's roll-call
+    static void testSwipeFilesUnion() {
+        auto course = std::make_shared<Course>(6, "Biology", "", 3, 100);
+        std::vector<std::shared_ptr<Student>> students;
+        for (int id = 1; id <= 10; ++id) {
+            students.push_back(std::make_shared<Student>(id, "Student", 20));
+            course->enrollStudent(students.back());
+        }
+        auto room = std::make_shared<Classroom>(15, 5, "C-101", "Science");
+        room->scheduleCourse(course);
+        SwipeIngestor ingestor(2, 4096, 2);
+        ingestor.addClassroom(room);
+        ASSERT_TRUE(ingestor.addSlot(15, 6, 1, "09:00", "17:00"));
+        
+        course->recordRollCall("2024-04-01", {9}); // Manual: 9 present, the rest absent
+        std::stringstream morning, afternoon;
+        for (int id = 1; id <= 3; ++id) morning << "2024-04-01 09:1" << id << ":00," << id << ",C-101\n";
+        for (int id = 3; id <= 5; ++id) afternoon << "2024-04-01 14:1" << id << ":00," << id << ",C-101\n";
+        ingestor.ingestStream(morning);
+        SwipeIngestStats stats = ingestor.ingestStream(afternoon);
+        ASSERT_EQ(3, static_cast<int>(stats.studentsPresent));
+        
+        for (int id = 1; id <= 5; ++id) ASSERT_TRUE(course->getAttendance(id, "2024-04-01"));
+        ASSERT_TRUE(course->getAttendance(9, "2024-04-01"));
+        ASSERT_FALSE(course->getAttendance(6, "2024-04-01"));
+        ASSERT_TRUE(course->getAttendanceMatrix().isRecorded(6, "2024-04-01")); // Still the roll-call's absence
+        ASSERT_EQ(60, static_cast<int>(course->getSessionAttendancePercentage("2024-04-01")));
+        ASSERT_EQ(100, static_cast<int>(course->getStudentAttendancePercentage(4, "2024-04-01", "2024-04-01")));
+    }
+    
+    static void testSwipeRejectsBadRows() {
+        int dayNumber = 0, minuteOfDay = 0;
+        std::string leapDay = "2024-02-29 09:00", noSuchDay = "2024-02-31 09:00", notLeap = "2023-02-29 09:00";
+        ASSERT_TRUE(SwipeIngestor::parseTimestamp(leapDay.data(), leapDay.data() + leapDay.size(), dayNumber, minuteOfDay));
+        ASSERT_FALSE(SwipeIngestor::parseTimestamp(noSuchDay.data(), noSuchDay.data() + noSuchDay.size(), dayNumber, minuteOfDay));
+        ASSERT_FALSE(SwipeIngestor::parseTimestamp(notLeap.data(), notLeap.data() + notLeap.size(), dayNumber, minuteOfDay));
+        
+        auto course = std::make_shared<Course>(4, "Physics", "", 3, 100);
+        auto student = std::make_shared<Student>(1, "Student", 20);
+        course->enrollStudent(student);
+        auto room = std::make_shared<Classroom>(13, 5, "B-102", "Science");
+        room->scheduleCourse(course);
+        SwipeIngestor ingestor(2, 4096, 2);
+        ingestor.addClassroom(room);
+        ASSERT_TRUE(ingestor.addSlot(13, 4, 1, "09:00", "10:00"));
+        
+        // A newline-free run far longer than a block, then good rows
+        std::stringstream log;
+        log << "2024-04-01 09:05:00,1," << std::string(64 * 1024, 'x') << "\n";
+        log << "2024-04-01 09:06:00,1,B-102\n";
+        log << "2024-02-31 09:06:00,1,B-102\n";
+        SwipeIngestStats stats = ingestor.ingestStream(log);
+        ASSERT_EQ(3, static_cast<int>(stats.rowsRead));
+        ASSERT_EQ(1, static_cast<int>(stats.rowsMatched));
+        ASSERT_EQ(2, static_cast<int>(stats.rowsMalformed));
+        ASSERT_TRUE(course->getAttendance(1, "2024-04-01"));
+    }
+    
+    static void testDateWindowQueries() {
+        Course course(5, "History", "", 3, 100);
+        std::vector<std::shared_ptr<Student>> students;
+        for (int id = 1; id <= 70; ++id) {
+            students.push_back(std::make_shared<Student>(id, "Student", 20));
+            course.enrollStudent(students.back());
+        }
+        
+        std::vector<std::string> dates;
+        for (int day = 10; day < 47; ++day) {
+            dates.push_back("2024-05-" + std::to_string(day));
+            std::vector<int> present;
+            for (int id = 1; id <= 70; ++id) {
+                if ((id * day) % 3 != 0) present.push_back(id);
+            }
+            course.recordRollCall(dates.back(), present);
+        }
+        
+        // Every window must agree with a direct scan of the matrix
+        const AttendanceMatrix& matrix = course.getAttendanceMatrix();
+        for (size_t first = 0; first < dates.size(); first += 5) {
+            for (size_t last = first; last < dates.size(); last += 7) {
+                auto cohort = course.getCohortAttendancePercentages(dates[first], dates[last]);
+                ASSERT_EQ(70, static_cast<int>(cohort.size()));
+                for (int id = 1; id <= 70; id += 9) {
+                    int present = 0;
+                    for (size_t s = first; s <= last; ++s) present += matrix.wasPresent(id, dates[s]);
+                    double expected = (static_cast<double>(present) / (last - first + 1)) * 100.0;
+                    ASSERT_TRUE(course.getStudentAttendancePercentage(id, dates[first], dates[last]) == expected);
+                    ASSERT_TRUE(cohort[id] == expected);
+                }
+            }
+        }
+        
+        // Index follows later writes; empty windows report nothing
+        course.recordAttendance(2, dates[0], false);
+        ASSERT_EQ(0, static_cast<int>(course.getStudentAttendancePercentage(2, dates[0], dates[0])));
+        ASSERT_TRUE(course.getCohortAttendancePercentages("2025-01-01", "2025-12-31").empty());
+    }
+    
+    static void testRangeIndexPointUpdates() {
+        // Point updates on each write must leave the same trees as a fresh build
+        Course course(6, "Geography", "", 3, 200);
+        std::vector<std::shared_ptr<Student>> students;
+        for (int id = 1; id <= 90; ++id) {
+            students.push_back(std::make_shared<Student>(id, "Student", 20));
+            course.enrollStudent(students.back());
+        }
+        auto agrees = [&course]() {
+            const AttendanceMatrix& matrix = course.getAttendanceMatrix();
+            AttendanceRangeIndex fresh;
+            fresh.build(matrix);
+            const std::vector<std::string>& dates = matrix.getSessionDates();
+            for (size_t first = 0; first < dates.size(); first += 3) {
+                for (size_t last = first; last < dates.size(); last += 4) {
+                    std::vector<uint32_t> present, recorded;
+                    fresh.rangeCounts(first, last + 1, present, recorded);
+                    auto cohort = course.getCohortAttendancePercentages(dates[first], dates[last]);
+                    for (size_t column = 0; column < present.size(); ++column) {
+                        int id = matrix.getColumnStudents()[column];
+                        if (recorded[column] == 0) {
+                            if (cohort.count(id)) return false;
+                        } else if (cohort[id] != (static_cast<double>(present[column]) / recorded[column]) * 100.0) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        };
+        
+        for (int day = 10; day < 30; ++day) {
+            std::vector<int> present;
+            for (int id = 1; id <= 90; ++id) {
+                if ((id + day) % 4 != 0) present.push_back(id);
+            }
+            course.recordRollCall("2024-06-" + std::to_string(day), present); // Appended sessions
+        }
+        ASSERT_TRUE(agrees());
+        
+        course.recordAttendance(7, "2024-06-12", false);   // Cell flipped off
+        course.recordAttendance(8, "2024-06-12", true);    // and on
+        course.recordRollCall("2024-06-15", {1, 2, 3});    // Whole row rewritten
+        ASSERT_TRUE(agrees());
+        
+        course.recordAttendance(5, "2024-06-05", true);    // Session before the first
+        ASSERT_TRUE(agrees());
+        
+        students.push_back(std::make_shared<Student>(91, "Student", 20));
+        course.enrollStudent(students.back());
+        course.recordRollCall("2024-06-30", {91});         // New column
+        course.recordAttendance(91, "2024-06-31", true);
+        ASSERT_TRUE(agrees());
+    }
+    
+    static void testColumnCountsMatchPerStudent() {
+        // Bit-sliced column totals must agree with the per-student scan
+        AttendanceMatrix matrix;
+        for (int day = 0; day < 70; ++day) {
+            std::string date = "2024-03-" + std::to_string(100 + day);
+            for (int id = 1; id <= 130; ++id) {
+                if ((id + day) % 4 != 0) matrix.record(id, date, (id * day) % 5 != 0);
+            }
+        }
+        
+        auto all = matrix.getAllStudentPercentages();
+        ASSERT_EQ(130, static_cast<int>(all.size()));
+        for (int id = 1; id <= 130; ++id) {
+            ASSERT_TRUE(all[id] == matrix.getStudentPercentage(id));
+        }
+    }
+};
+
+class TextValidatorTests {
+private:
+    // Deterministic mutations (0-3 random edits) of known inputs, so both
+    // sides of every accept/reject boundary get exercised
+    static std::vector<std::string> mutateInputs(const std::vector<std::string>& seeds,
+                                                 const std::string& alphabet, size_t count) {
+        std::vector<std::string> inputs;
+        uint32_t seed = 12345;
+        auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return seed >> 16; };
+        for (size_t i = 0; i < count; ++i) {
+            std::string text = seeds[next() % seeds.size()];
+            size_t edits = next() % 4;
+            for (size_t e = 0; e < edits; ++e) {
+                size_t pos = text.empty() ? 0 : next() % text.size();
+                char c = alphabet[next() % alphabet.size()];
+                switch (next() % 3) {
+                    case 0: text.insert(text.begin() + pos, c); break;
+                    case 1: if (!text.empty()) text.erase(pos, 1); break;
+                    default: if (!text.empty()) text[pos] = c; break;
+                }
+            }
+            inputs.push_back(text);
+        }
+        return inputs;
+    }
+
+public:
+    static void testEmailMatchesRegex() {
+        std::regex emailPattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
+        std::vector<std::string> inputs = {
+            "john@school.edu", "a@b.co", "a@b.c", "a@.co", "a@..co", "@b.co", "a@b.c0m",
+            "first.last+tag@sub-domain.example.org", "a@b@c.com", "a@b.com.", "a@b.c.de",
+            "a b@c.com", "a@b.co1", "a@1.23", "%@-.ab", "a@b_c.com", "\xC3\xA9@b.com"
+        };
+        std::vector<std::string> random = mutateInputs(inputs, "aZ09.-_%+@ \xC3", 20000);
+        inputs.insert(inputs.end(), random.begin(), random.end());
+        
+        for (const auto& input : inputs) {
+            ASSERT_TRUE(TextValidator::isEmail(input) == std::regex_match(input, emailPattern));
+        }
+        ASSERT_TRUE(Student::isValidEmail(""));
+        ASSERT_TRUE(Teacher::isValidEmail("teacher@school.edu"));
+        ASSERT_FALSE(Teacher::isValidEmail("teacher@school"));
+    }
+    
+    static void testPhoneMatchesRegex() {
+        std::regex phonePattern(R"(\+?[\d\s\-\(\)]{10,15})");
+        std::vector<std::string> inputs = {
+            "1234567890", "+1234567890", "123456789", "+123456789", "(555) 123-4567",
+            "+1 (555) 123-4567", "1234567890123456", "++1234567890", "12345 67890\t\v\f",
+            "555.123.4567", "+"
+        };
+        std::vector<std::string> random = mutateInputs(inputs, "09 -()+\t\na.", 20000);
+        inputs.insert(inputs.end(), random.begin(), random.end());
+        
+        for (const auto& input : inputs) {
+            ASSERT_TRUE(TextValidator::isPhone(input) == std::regex_match(input, phonePattern));
+        }
+    }
+    
+    static void testNormalizerMatchesRegex() {
+        // Reference: the original trim + regex_replace implementation
+        auto reference = [](const std::string& input) {
+            std::string result = input;
+            result.erase(0, result.find_first_not_of(" \t\n\r"));
+            result.erase(result.find_last_not_of(" \t\n\r") + 1);
+            return std::regex_replace(result, std::regex("\\s+"), " ");
+        };
+        std::vector<std::string> inputs = {
+            "", " ", "\t\n\r ", "  John   Smith  ", "\vabc", "abc\f", " \v abc \f ",
+            "a long line with no double spaces that spans several sse blocks",
+            "tabs\tand\nnewlines\r\nin   the    middle of a fairly long string value",
+            "\xC3\xA9l\xC3\xA8ve   fran\xC3\xA7" "ais"
+        };
+        std::vector<std::string> random = mutateInputs(inputs, "ab  \t\n\r\v\f.\xC3", 20000);
+        inputs.insert(inputs.end(), random.begin(), random.end());
+        
+        std::string buffer;
+        for (const auto& input : inputs) {
+            std::string expected = reference(input);
+            TextNormalizer::normalizeInto(input, buffer);
+            ASSERT_EQ(expected, buffer);
+            std::string inPlace = input;
+            TextNormalizer::normalizeInPlace(inPlace);
+            ASSERT_EQ(expected, inPlace);
+        }
+        
+        // Aliased input and output
+        std::string same = "  a \t b  ";
+        TextNormalizer::normalizeInto(same, same);
+        ASSERT_EQ("a b", same);
+    }
+};
+
+class CsvReaderTests {
+public:
+    static void testQuotedRecords() {
+        std::string csv = "id,name,notes\r\n"
+                          "1,\"Smith, John\",\"said \"\"hi\"\"\"\r\n"
+                          "2,Jane,\"line one\nline two\"\n"
+                          "\n"
+                          "3,,trailing";
+        std::vector<std::string> fields;
+        size_t pos = CsvReader::parseRecord(csv.data(), csv.size(), 0, fields);
+        ASSERT_EQ(3, static_cast<int>(fields.size()));
+        ASSERT_EQ("notes", fields[2]);
+        
+        pos = CsvReader::parseRecord(csv.data(), csv.size(), pos, fields);
+        ASSERT_EQ("Smith, John", fields[1]);
+        ASSERT_EQ("said \"hi\"", fields[2]);
+        
+        pos = CsvReader::parseRecord(csv.data(), csv.size(), pos, fields);
+        ASSERT_EQ("line one\nline two", fields[2]);
+        
+        pos = CsvReader::parseRecord(csv.data(), csv.size(), pos, fields);
+        ASSERT_TRUE(CsvReader::isBlankRecord(fields));
+        
+        pos = CsvReader::parseRecord(csv.data(), csv.size(), pos, fields);
+        ASSERT_EQ(3, static_cast<int>(fields.size()));
+        ASSERT_EQ("", fields[1]);
+        ASSERT_EQ("trailing", fields[2]);
+        ASSERT_EQ(static_cast<int>(csv.size()), static_cast<int>(pos));
+    }
+    
+    static void testChunkBoundaries() {
+        // Quoted newlines must never become chunk boundaries
+        std::string csv;
+        for (int i = 0; i < 500; ++i) {
+            csv += std::to_string(i) + ",\"multi\nline, " + std::to_string(i) + "\",x\n";
+        }
+        std::vector<size_t> boundaries = CsvReader::chunkBoundaries(csv.data(), csv.size(), 0, 700);
+        ASSERT_TRUE(boundaries.size() > 3);
+        ASSERT_EQ(static_cast<int>(csv.size()), static_cast<int>(boundaries.back()));
+        
+        std::vector<std::string> fields;
+        int records = 0;
+        for (size_t c = 0; c + 1 < boundaries.size(); ++c) {
+            size_t pos = boundaries[c];
+            while (pos < boundaries[c + 1]) {
+                pos = CsvReader::parseRecord(csv.data(), boundaries[c + 1], pos, fields);
+                ASSERT_EQ(3, static_cast<int>(fields.size()));
+                ASSERT_EQ(std::to_string(records), fields[0]);
+                records++;
+            }
+        }
+        ASSERT_EQ(500, records);
+    }
+    
+    static void testHeaderMapping() {
+        std::vector<std::string> header = {"\xEF\xBB\xBFStudent ID", "Full Name", "E-mail"};
+        ASSERT_EQ(0, CsvReader::findColumn(header, {"id", "studentid"}));
+        ASSERT_EQ(1, CsvReader::findColumn(header, {"name", "fullname"}));
+        ASSERT_EQ(2, CsvReader::findColumn(header, {"email"}));
+        ASSERT_EQ(-1, CsvReader::findColumn(header, {"phone"}));
+    }
+};
+
+class OutputBufferTests {
+public:
+    static void testCsvRoundTrip() {
+        // Whatever the writer quotes, the reader must give back unchanged
+        std::vector<std::string> names = {"plain", "Smith, John", "said \"hi\"", "two\nlines", ""};
+        OutputBuffer out;
+        RecordWriter writer(out, RecordWriter::Csv, {"id", "name", "score", "courses"});
+        for (size_t i = 0; i < names.size(); ++i) {
+            writer.field(static_cast<int>(i) - 1).field(names[i]).field(0.1 * i).field(std::vector<int>{1, 2});
+            writer.endRecord();
+        }
+        ASSERT_EQ(static_cast<int>(names.size()), static_cast<int>(writer.getRecordCount()));
+        
+        std::string csv = out.str();
+        std::vector<std::string> fields;
+        size_t pos = CsvReader::parseRecord(csv.data(), csv.size(), 0, fields);
+        ASSERT_EQ("courses", fields[3]);
+        for (size_t i = 0; i < names.size(); ++i) {
+            pos = CsvReader::parseRecord(csv.data(), csv.size(), pos, fields);
+            ASSERT_EQ(4, static_cast<int>(fields.size()));
+            ASSERT_EQ(std::to_string(static_cast<int>(i) - 1), fields[0]);
+            ASSERT_EQ(names[i], fields[1]);
+            ASSERT_TRUE(std::stod(fields[2]) == 0.1 * i);
+            ASSERT_EQ("1;2", fields[3]);
+        }
+        ASSERT_EQ(static_cast<int>(csv.size()), static_cast<int>(pos));
+    }
+    
+    static void testJsonLinesEscaping() {
+        OutputBuffer out;
+        RecordWriter writer(out, RecordWriter::JsonLines, {"id", "name", "active", "courses"});
+        writer.field(7).field(std::string("a\"b\\c\nd\x01")).field(true).field(std::vector<int>{3, 4});
+        writer.endRecord();
+        writer.field(8).field(std::string("")).field(false).field(std::vector<int>());
+        writer.endRecord();
+        ASSERT_EQ("{\"id\":7,\"name\":\"a\\\"b\\\\c\\nd\\u0001\",\"active\":true,\"courses\":[3,4]}\n"
+                  "{\"id\":8,\"name\":\"\",\"active\":false,\"courses\":[]}\n", out.str());
+    }
+    
+    static void testNonFiniteNumbers() {
+        OutputBuffer json;
+        RecordWriter jsonWriter(json, RecordWriter::JsonLines, {"a", "b", "c", "d"});
+        jsonWriter.field(std::nan("")).field(INFINITY).field(-INFINITY).field(1.5);
+        jsonWriter.endRecord();
+        ASSERT_EQ("{\"a\":null,\"b\":null,\"c\":null,\"d\":1.5}\n", json.str());
+        
+        OutputBuffer csv;
+        RecordWriter csvWriter(csv, RecordWriter::Csv, {"a", "b"});
+        csvWriter.field(std::nan("")).field(2.5f);
+        csvWriter.endRecord();
+        ASSERT_EQ("a,b\n,2.5\n", csv.str());
+    }
+    
+    static void testFlushToFile() {
+        // A tiny buffer forces many flushes, including oversized appends
+        const std::string filename = "test_output_buffer.tmp";
+        std::string expected;
+        {
+            OutputBuffer out(16);
+            ASSERT_TRUE(out.open(filename));
+            std::string longText(100, 'x');
+            for (int i = 0; i < 1000; ++i) {
+                out.appendNumber(i);
+                out.append(',');
+                out.append(longText);
+                out.append('\n');
+                expected += std::to_string(i) + "," + longText + "\n";
+            }
+            ASSERT_EQ(static_cast<int>(expected.size()), static_cast<int>(out.getBytesWritten()));
+            ASSERT_TRUE(out.close());
+        }
+        std::string contents;
+        ASSERT_TRUE(CsvReader::readFile(filename, contents));
+        std::remove(filename.c_str());
+        ASSERT_EQ(expected, contents);
+    }
+    
+    static void testAttachedStreamStaysOpen() {
+        // Batch mode writes results to stdout; close() must only flush it
+        std::FILE* stream = std::tmpfile();
+        ASSERT_TRUE(stream != nullptr);
+        {
+            OutputBuffer out;
+            out.attach(stream);
+            RecordWriter writer(out, RecordWriter::JsonLines, {"type", "ok"});
+            writer.field(std::string("result")).field(true);
+            writer.endRecord();
+            ASSERT_TRUE(out.close());
+        }
+        ASSERT_EQ(0, std::fputs("after\n", stream) < 0 ? 1 : 0);
+        std::rewind(stream);
+        char line[64] = {};
+        ASSERT_TRUE(std::fgets(line, sizeof(line), stream) != nullptr);
+        ASSERT_EQ(std::string("{\"type\":\"result\",\"ok\":true}\n"), std::string(line));
+        ASSERT_TRUE(std::fgets(line, sizeof(line), stream) != nullptr);
+        ASSERT_EQ(std::string("after\n"), std::string(line));
+        std::fclose(stream);
+    }
+};
+
+class JsonLinesReaderTests {
+public:
+    struct CollectingHandler {
+        std::vector<std::vector<std::string>> records;
+        std::vector<size_t> errorLines;
+        std::vector<std::string> current;
+        
+        void beginRecord() { current.clear(); }
+        void field(const char* key, size_t keyLength, JsonLinesReader::ValueType, const char* value, size_t valueLength) {
+            current.push_back(std::string(key, keyLength) + "=" + std::string(value, valueLength));
+        }
+        void endRecord() { records.push_back(current); }
+        void recordError(size_t line, const char*) { errorLines.push_back(line); }
+    };
+    
+    // Offsets a byte-at-a-time scanner would report
+    static std::vector<uint32_t> scalarIndex(const std::string& text) {
+        std::vector<uint32_t> index;
+        bool inString = false;
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            if (inString) {
+                if (c == '\\' && i + 1 < text.size() && text[i + 1] != '\n') ++i;
+                else if (c == '"') { inString = false; index.push_back(i); }
+                else if (c == '\n') { inString = false; index.push_back(i); }
+            } else if (c == '"') {
+                inString = true;
+                index.push_back(i);
+            } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',' || c == '\n') {
+                index.push_back(i);
+            }
+        }
+        return index;
+    }
+    
+    static void testStructuralIndex() {
+        // Backslash runs and quotes land on every offset of the 64-byte blocks
+        std::string text;
+        for (int i = 0; i < 300; ++i) {
+            text += "{\"k" + std::to_string(i) + "\":\"" + std::string(i % 7, '\\') + std::string(i % 7, '\\') +
+                    "\\\"a,b:{c}[d]\",\"n\":[" + std::to_string(i) + ",1]}\n";
+        }
+        std::vector<uint32_t> index;
+        JsonLinesReader::buildIndex(text.data(), text.size(), index);
+        std::vector<uint32_t> expected = scalarIndex(text);
+        ASSERT_EQ(static_cast<int>(expected.size()), static_cast<int>(index.size()));
+        ASSERT_TRUE(index == expected);
+    }
+    
+    static void testWriterRoundTrip() {
+        std::vector<std::string> names = {"plain", "quote \" inside", "back\\slash\\\\", "tab\tnew\nline",
+                                          "\x01 control", "caf\xC3\xA9", "{not: [json]}", ""};
+        OutputBuffer out;
+        RecordWriter writer(out, RecordWriter::JsonLines, {"id", "name", "courses", "active"});
+        for (size_t i = 0; i < names.size(); ++i) {
+            writer.field(static_cast<int>(i)).field(names[i]).field(std::vector<int>{1, 2}).field(i % 2 == 0);
+            writer.endRecord();
+        }
+        std::string text = out.str();
+        CollectingHandler handler;
+        ASSERT_EQ(static_cast<int>(names.size()), static_cast<int>(JsonLinesReader::parse(text.data(), text.size(), handler)));
+        ASSERT_TRUE(handler.errorLines.empty());
+        for (size_t i = 0; i < names.size(); ++i) {
+            ASSERT_EQ(4, static_cast<int>(handler.records[i].size()));
+            ASSERT_EQ("id=" + std::to_string(i), handler.records[i][0]);
+            ASSERT_EQ("name=" + names[i], handler.records[i][1]);
+            ASSERT_EQ("courses=[1,2]", handler.records[i][2]);
+            ASSERT_EQ(i % 2 == 0 ? "active=true" : "active=false", handler.records[i][3]);
+        }
+    }
+    
+    static void testMalformedLines() {
+        std::string text = "{\"a\": 1}\r\n"
+                           "\n"
+                           "not json\n"
+                           "{\"a\": tru}\n"
+                           "{\"a\": \"\\u00e9\\ud83d\\ude00\", \"b\": null}  \n"
+                           "{\"a\": 2} {\"a\": 3}\n"
+                           "{\"a\": {\"b\": [1, 2]}}";
+        CollectingHandler handler;
+        ASSERT_EQ(3, static_cast<int>(JsonLinesReader::parse(text.data(), text.size(), handler)));
+        ASSERT_EQ("a=1", handler.records[0][0]);
+        ASSERT_EQ("a=\xC3\xA9\xF0\x9F\x98\x80", handler.records[1][0]);
+        ASSERT_EQ("b=null", handler.records[1][1]);
+        ASSERT_EQ("a={\"b\": [1, 2]}", handler.records[2][0]);
+        ASSERT_EQ(3, static_cast<int>(handler.errorLines.size()));
+        ASSERT_EQ(3, static_cast<int>(handler.errorLines[0]));
+        ASSERT_EQ(4, static_cast<int>(handler.errorLines[1]));
+        ASSERT_EQ(6, static_cast<int>(handler.errorLines[2]));
+    }
+    
+    static void testUnterminatedStringLine() {
+        // The open quote must not swallow the lines after it
+        std::string text = "{\"a\": \"oops}\n{\"a\": 1}\n{\"a\": 2}\n{\"a\": 3}\n";
+        CollectingHandler handler;
+        ASSERT_EQ(3, static_cast<int>(JsonLinesReader::parse(text.data(), text.size(), handler)));
+        ASSERT_EQ("a=3", handler.records[2][0]);
+        ASSERT_EQ(1, static_cast<int>(handler.errorLines.size()));
+        ASSERT_EQ(1, static_cast<int>(handler.errorLines[0]));
+        
+        // Unterminated strings ending at every offset of a block, some with a
+        // trailing backslash, one running across whole blocks
+        text.clear();
+        for (int i = 0; i < 130; ++i) {
+            text += "{\"k\": \"" + std::string(i, 'x') + (i % 3 == 0 ? "\\" : "") + "\n";
+            text += "{\"k\": \"" + std::to_string(i) + "\"}\n";
+        }
+        std::vector<uint32_t> index;
+        JsonLinesReader::buildIndex(text.data(), text.size(), index);
+        ASSERT_TRUE(index == scalarIndex(text));
+        CollectingHandler many;
+        ASSERT_EQ(130, static_cast<int>(JsonLinesReader::parse(text.data(), text.size(), many)));
+        ASSERT_EQ(130, static_cast<int>(many.errorLines.size()));
+        ASSERT_EQ("k=129", many.records[129][0]);
+    }
+};
+
+class ColumnarFileTests {
+public:
+    static void testRoundTrip() {
+        const std::string filename = "test_columnar.smcol";
+        std::vector<std::string> departments = {"Math", "Science", "Arts"};
+        std::vector<std::string> names;
+        for (int i = 0; i < 1000; ++i) names.push_back("Name " + std::to_string(i * 7919 % 1000));
+        
+        ColumnarTable table("people");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        size_t name = table.addColumn("name", ColumnarFile::String);
+        size_t department = table.addColumn("department", ColumnarFile::String);
+        size_t cohort = table.addColumn("cohort", ColumnarFile::Int);
+        size_t active = table.addColumn("active", ColumnarFile::Bool);
+        size_t score = table.addColumn("score", ColumnarFile::Double);
+        for (int i = 0; i < 1000; ++i) {
+            table.columns[id].ints.push_back(i - 500);
+            table.columns[name].strings.push_back(names[i]);
+            table.columns[department].strings.push_back(departments[i % 3]);
+            table.columns[cohort].ints.push_back(2020 + i / 300);
+            table.columns[active].ints.push_back(i % 5 != 0);
+            table.columns[score].doubles.push_back(i * 0.25);
+        }
+        
+        ColumnarWriteStats stats;
+        std::string error;
+        ASSERT_TRUE(ColumnarWriter::write(filename, table, stats, error, 256, 2));
+        ASSERT_EQ(4, static_cast<int>(stats.rowGroups));
+        
+        ColumnarReader reader;
+        ASSERT_TRUE(reader.open(filename));
+        ASSERT_EQ("people", reader.getTableName());
+        ASSERT_EQ(1000, static_cast<int>(reader.getRowCount()));
+        ASSERT_EQ(6, static_cast<int>(reader.getColumns().size()));
+        
+        // Low-cardinality strings get a dictionary, long runs get RLE
+        const ColumnarFile::RowGroup& second = reader.getRowGroups()[1];
+        ASSERT_EQ(ColumnarFile::Plain, second.chunks[name].encoding);
+        ASSERT_EQ(ColumnarFile::Dictionary, second.chunks[department].encoding);
+        ASSERT_EQ(ColumnarFile::RunLength, second.chunks[cohort].encoding);
+        ASSERT_EQ(ColumnarFile::BitPacked, second.chunks[active].encoding);
+        ASSERT_EQ(2020, static_cast<int>(second.chunks[cohort].stats.minInt));
+        ASSERT_EQ(2021, static_cast<int>(second.chunks[cohort].stats.maxInt));
+        
+        for (size_t g = 0; g < reader.getRowGroups().size(); ++g) {
+            size_t base = reader.getRowGroups()[g].firstRow;
+            std::vector<int64_t> ids, cohorts, flags;
+            std::vector<std::string> nameValues, departmentValues;
+            std::vector<double> scores;
+            ASSERT_TRUE(reader.readInts(g, id, ids));
+            ASSERT_TRUE(reader.readStrings(g, name, nameValues));
+            ASSERT_TRUE(reader.readStrings(g, department, departmentValues));
+            ASSERT_TRUE(reader.readInts(g, cohort, cohorts));
+            ASSERT_TRUE(reader.readInts(g, active, flags));
+            ASSERT_TRUE(reader.readDoubles(g, score, scores));
+            for (size_t i = 0; i < ids.size(); ++i) {
+                int row = static_cast<int>(base + i);
+                ASSERT_EQ(row - 500, static_cast<int>(ids[i]));
+                ASSERT_EQ(names[row], nameValues[i]);
+                ASSERT_EQ(departments[row % 3], departmentValues[i]);
+                ASSERT_EQ(2020 + row / 300, static_cast<int>(cohorts[i]));
+                ASSERT_EQ(row % 5 != 0 ? 1 : 0, static_cast<int>(flags[i]));
+                ASSERT_TRUE(scores[i] == row * 0.25);
+            }
+        }
+        std::vector<double> wrongType;
+        ASSERT_FALSE(reader.readDoubles(0, id, wrongType));
+        std::remove(filename.c_str());
+    }
+    
+    static void testRowGroupSkipping() {
+        const std::string filename = "test_columnar_skip.smcol";
+        std::vector<std::string> codes;
+        for (int i = 0; i < 400; ++i) codes.push_back("C" + std::to_string(1000 + i));
+        ColumnarTable table("sorted");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        size_t code = table.addColumn("code", ColumnarFile::String);
+        for (int i = 0; i < 400; ++i) {
+            table.columns[id].ints.push_back(i);
+            table.columns[code].strings.push_back(codes[i]);
+        }
+        ColumnarWriteStats stats;
+        std::string error;
+        ASSERT_TRUE(ColumnarWriter::write(filename, table, stats, error, 100));
+        
+        ColumnarReader reader;
+        ASSERT_TRUE(reader.open(filename));
+        std::vector<size_t> groups = reader.rowGroupsOverlapping(id, 150, 260);
+        ASSERT_EQ(2, static_cast<int>(groups.size()));
+        ASSERT_EQ(1, static_cast<int>(groups[0]));
+        ASSERT_EQ(2, static_cast<int>(groups[1]));
+        ASSERT_EQ(0, static_cast<int>(reader.rowGroupsOverlapping(id, 400, 500).size()));
+        groups = reader.rowGroupsOverlapping(code, std::string("C1350"), std::string("C1350"));
+        ASSERT_EQ(1, static_cast<int>(groups.size()));
+        ASSERT_EQ(3, static_cast<int>(groups[0]));
+        std::remove(filename.c_str());
+    }
+    
+    static void testRejectsDamagedFiles() {
+        const std::string filename = "test_columnar_bad.smcol";
+        ColumnarTable table("t");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        for (int i = 0; i < 50; ++i) table.columns[id].ints.push_back(i * i);
+        ColumnarWriteStats stats;
+        std::string error;
+        ASSERT_TRUE(ColumnarWriter::write(filename, table, stats, error));
+        
+        std::string contents;
+        ASSERT_TRUE(CsvReader::readFile(filename, contents));
+        {
+            std::ofstream truncated(filename, std::ios::binary | std::ios::trunc);
+            truncated.write(contents.data(), contents.size() - 3);
+        }
+        ColumnarReader reader;
+        ASSERT_FALSE(reader.open(filename));
+        ASSERT_FALSE(reader.getError().empty());
+        std::remove(filename.c_str());
+        
+        // Mismatched column lengths are refused before anything is written
+        table.addColumn("name", ColumnarFile::String);
+        ASSERT_FALSE(ColumnarWriter::write(filename, table, stats, error));
+        ASSERT_TRUE(error.find("name") != std::string::npos);
+    }
+    
+    static void testRejectsOversizedCounts() {
+        const std::string filename = "test_columnar_counts.smcol";
+        ColumnarTable table("t");
+        size_t id = table.addColumn("id", ColumnarFile::Int);
+        for (int i = 0; i < 50; ++i) table.columns[id].ints.push_back(i * i);
+        ColumnarWriteStats stats;
+        std::string error;
+        ASSERT_TRUE(ColumnarWriter::write(filename, table, stats, error));
+        std::string contents;
+        ASSERT_TRUE(CsvReader::readFile(filename, contents));
+        
+        // Footer: "t", 1 column "id" int, u64 row count, 1 group, u64 group rows
+        auto withRows = [&](uint64_t rows) {
+            std::string patched = contents;
+            size_t footerSize = 0;
+            for (int i = 0; i < 4; ++i) footerSize |= static_cast<size_t>(static_cast<uint8_t>(patched[patched.size() - 12 + i])) << (8 * i);
+            size_t footer = patched.size() - 12 - footerSize;
+            for (int i = 0; i < 8; ++i) {
+                patched[footer + 7 + i] = static_cast<char>(rows >> (8 * i));
+                patched[footer + 16 + i] = static_cast<char>(rows >> (8 * i));
+            }
+            std::ofstream(filename, std::ios::binary | std::ios::trunc).write(patched.data(), patched.size());
+        };
+        
+        withRows(uint64_t(1) << 40); // Refused from the footer alone
+        ColumnarReader huge;
+        ASSERT_FALSE(huge.open(filename));
+        
+        withRows(40000); // Plausible, but more than the chunk holds
+        ColumnarReader tooMany;
+        ASSERT_TRUE(tooMany.open(filename));
+        std::vector<int64_t> values;
+        ASSERT_FALSE(tooMany.readInts(0, id, values));
+        ASSERT_TRUE(values.empty());
+        
+        withRows(50);
+        ColumnarReader intact;
+        ASSERT_TRUE(intact.open(filename));
+        ASSERT_TRUE(intact.readInts(0, id, values));
+        ASSERT_EQ(2401, static_cast<int>(values[49]));
+        std::remove(filename.c_str());
+    }
+};
+
+class SchoolProtocolTests {
+public:
+    static void testFrameRoundTrip() {
+        std::string stream;
+        SchoolProtocol::enroll(stream, 7, 1001, 42);
+        SchoolProtocol::searchStudents(stream, 8, "Smith", 10);
+        
+        // Nothing comes out until a frame is complete
+        std::string partial = stream.substr(0, stream.size() - 1);
+        size_t pos = 0;
+        const char* payload = nullptr;
+        size_t size = 0;
+        bool tooLarge = false;
+        ASSERT_TRUE(Frame::next(partial, pos, 1024, payload, size, tooLarge));
+        ASSERT_FALSE(Frame::next(partial, pos, 1024, payload, size, tooLarge));
+        ASSERT_FALSE(tooLarge);
+        
+        pos = 0;
+        ASSERT_TRUE(Frame::next(stream, pos, 1024, payload, size, tooLarge));
+        FrameReader enroll(payload, size);
+        ASSERT_EQ(7, static_cast<int>(enroll.u32()));
+        ASSERT_EQ(SchoolProtocol::Enroll, static_cast<int>(enroll.u8()));
+        ASSERT_EQ(1001, static_cast<int>(enroll.u32()));
+        ASSERT_EQ(42, static_cast<int>(enroll.u32()));
+        ASSERT_TRUE(enroll.ok());
+        
+        ASSERT_TRUE(Frame::next(stream, pos, 1024, payload, size, tooLarge));
+        FrameReader search(payload, size);
+        search.u32();
+        ASSERT_EQ(SchoolProtocol::SearchStudents, static_cast<int>(search.u8()));
+        ASSERT_EQ("Smith", search.str());
+        ASSERT_EQ(10, static_cast<int>(search.u16()));
+        ASSERT_EQ(0, static_cast<int>(search.remaining()));
+        ASSERT_TRUE(pos == stream.size());
+        
+        // A declared length over the limit is refused, not waited for
+        pos = 0;
+        ASSERT_FALSE(Frame::next(stream, pos, 4, payload, size, tooLarge));
+        ASSERT_TRUE(tooLarge);
+    }
+    
+    static void testReaderOverrun() {
+        std::string payload;
+        FrameWriter(payload).u32(1).u8(SchoolProtocol::LookupStudent).u16(5);
+        FrameReader reader(payload.data(), payload.size());
+        reader.u32();
+        reader.u8();
+        ASSERT_EQ(0, static_cast<int>(reader.u32())); // Only two bytes left
+        ASSERT_FALSE(reader.ok());
+        
+        std::string shortString;
+        FrameWriter(shortString).u16(10).rest("abc", 3);
+        FrameReader strings(shortString.data(), shortString.size());
+        ASSERT_EQ("", strings.str());
+        ASSERT_FALSE(strings.ok());
+    }
+    
+    static void testServerRoundTrip() {
+        UnixSocketServer server([](const char* request, size_t size, std::string& response) {
+            FrameReader reader(request, size);
+            uint32_t requestId = reader.u32();
+            reader.u8();
+            uint32_t id = reader.u32();
+            std::string body = "id=" + std::to_string(id);
+            SchoolProtocol::response(response, requestId, SchoolProtocol::Ok, body.data(), body.size());
+        }, 2);
+        std::string path = "/tmp/school_test_" + std::to_string(::getpid()) + ".sock";
+        std::string error;
+        ASSERT_TRUE(server.listen(path, error));
+        std::thread loop([&server] { server.run(); });
+        
+        // Pipelined requests may be answered in any order
+        UnixSocketClient client;
+        ASSERT_TRUE(client.connect(path));
+        std::string frames;
+        for (uint32_t i = 0; i < 20; ++i) SchoolProtocol::lookup(frames, i, SchoolProtocol::LookupCourse, 100 + i);
+        ASSERT_TRUE(client.send(frames));
+        int matched = 0;
+        for (int i = 0; i < 20; ++i) {
+            std::string payload;
+            ASSERT_TRUE(client.receive(payload));
+            uint32_t requestId;
+            SchoolProtocol::Status status;
+            const char* body;
+            size_t length;
+            ASSERT_TRUE(SchoolProtocol::parseResponse(payload.data(), payload.size(), requestId, status, body, length));
+            if (status == SchoolProtocol::Ok && std::string(body, length) == "id=" + std::to_string(100 + requestId)) matched++;
+        }
+        ASSERT_EQ(20, matched);
+        
+        // A second server refuses to take over a live socket
+        UnixSocketServer intruder([](const char*, size_t, std::string&) {});
+        ASSERT_FALSE(intruder.listen(path, error));
+        
+        server.stop();
+        loop.join();
+        ASSERT_EQ(20, static_cast<int>(server.getRequestsServed()));
+        ASSERT_FALSE(client.receive(frames)); // Connection closed on shutdown
+    }
+    
+    static void testServerBackpressure() {
+        const std::string reply(64 * 1024, 'x');
+        UnixSocketServer server([&reply](const char* request, size_t size, std::string& response) {
+            FrameReader reader(request, size);
+            uint32_t requestId = reader.u32();
+            if (requestId == 0) throw std::bad_alloc();
+            SchoolProtocol::response(response, requestId, SchoolProtocol::Ok, reply.data(), reply.size());
+        }, 2);
+        std::string path = "/tmp/school_test_bp_" + std::to_string(::getpid()) + ".sock";
+        std::string error;
+        ASSERT_TRUE(server.listen(path, error));
+        std::thread loop([&server] { server.run(); });
+        
+        // A client that pipelines without reading stops being read from
+        const uint32_t REQUESTS = 2000;
+        UnixSocketClient flood;
+        ASSERT_TRUE(flood.connect(path));
+        std::string frames;
+        for (uint32_t i = 1; i <= REQUESTS; ++i) SchoolProtocol::lookup(frames, i, SchoolProtocol::LookupCourse, i);
+        ASSERT_TRUE(flood.send(frames));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        ASSERT_TRUE(server.getRequestsServed() < REQUESTS);
+        
+        // Other connections are still served meanwhile
+        UnixSocketClient other;
+        ASSERT_TRUE(other.connect(path));
+        std::string request, payload;
+        SchoolProtocol::lookup(request, 1, SchoolProtocol::LookupCourse, 1);
+        ASSERT_TRUE(other.call(request, payload));
+        
+        // Reading resumes as the client drains its replies
+        uint32_t received = 0;
+        while (received < REQUESTS && flood.receive(payload)) received++;
+        ASSERT_EQ(REQUESTS, received);
+        
+        // A handler that throws closes its connection instead of the server
+        request.clear();
+        SchoolProtocol::lookup(request, 0, SchoolProtocol::LookupCourse, 1);
+        ASSERT_FALSE(other.call(request, payload));
+        ASSERT_TRUE(flood.call(frames.substr(0, frames.size() / REQUESTS), payload));
+        
+        server.stop();
+        loop.join();
+    }
+};
+
+class SeatReservationTests {
+public:
+    static void testReserveCommitRollback() {
+        SeatCounter seats(2);
+        {
+            SeatReservation first(seats);
+            SeatReservation second(seats);
+            SeatReservation third(seats);
+            ASSERT_TRUE(first.held());
+            ASSERT_TRUE(second.held());
+            ASSERT_FALSE(third.held()); // Capacity reached by reservations alone
+            first.commit();
+        } // second rolls back here
+        ASSERT_EQ(1, seats.getCommitted());
+        ASSERT_EQ(1, seats.getAvailable());
+        
+        // Shrinking below the claimed seats only blocks new reservations
+        seats.setCapacity(1);
+        ASSERT_FALSE(seats.tryReserve());
+        seats.vacate();
+        ASSERT_TRUE(seats.tryReserve());
+    }
+    
+    static void testCapacityNeverExceeded() {
+        const int capacity = 100;
+        SeatCounter seats(capacity);
+        std::atomic<int> committed(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&seats, &committed, t] {
+                for (int i = 0; i < 1000; ++i) {
+                    SeatReservation seat(seats);
+                    if (!seat) continue;
+                    if ((i + t) % 3 == 0) continue; // Abandoned: rolled back
+                    seat.commit();
+                    committed++;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        ASSERT_EQ(capacity, committed.load());
+        ASSERT_EQ(capacity, seats.getCommitted());
+        ASSERT_EQ(capacity, seats.getClaimed());
+    }
+    
+    static void testResizeAgainstReservations() {
+        SeatCounter idle(3);
+        ASSERT_TRUE(idle.tryReserve());
+        ASSERT_TRUE(idle.tryReserve());
+        ASSERT_FALSE(idle.tryResize(1)); // Two claimed
+        ASSERT_EQ(3, idle.getCapacity());
+        ASSERT_TRUE(idle.tryResize(2));
+        ASSERT_FALSE(idle.tryReserve());
+        
+        // A shrink that succeeds while claims race it is never overrun
+        for (int round = 0; round < 200; ++round) {
+            SeatCounter seats(100);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&seats] {
+                    while (seats.tryReserve()) seats.commit();
+                });
+            }
+            bool shrunk = seats.tryResize(50);
+            for (auto& thread : threads) thread.join();
+            if (shrunk) {
+                ASSERT_EQ(50, seats.getCommitted());
+            } else {
+                ASSERT_EQ(100, seats.getCommitted());
+            }
+        }
+    }
+};
+
+class WaitlistTests {
+public:
+    static void testServingOrder() {
+        Waitlist waitlist;
+        ASSERT_TRUE(waitlist.add(1, 0, 20240901, 100));
+        ASSERT_TRUE(waitlist.add(2, 0, 20230901, 200)); // More senior
+        ASSERT_TRUE(waitlist.add(3, 1, 20240901, 300)); // Higher program priority
+        ASSERT_TRUE(waitlist.add(4, 0, 20240901, 100)); // Same as 1, joined later
+        ASSERT_FALSE(waitlist.add(1, 5, 20200101, 0));  // Already waiting
+        ASSERT_EQ(2, static_cast<int>(waitlist.position(1)));
+        
+        int expected[] = {3, 2, 1, 4};
+        WaitlistEntry entry;
+        for (int studentId : expected) {
+            ASSERT_TRUE(waitlist.pop(entry));
+            ASSERT_EQ(studentId, entry.studentId);
+        }
+        ASSERT_FALSE(waitlist.pop(entry));
+    }
+    
+    static void testRemoveAndRestore() {
+        Waitlist waitlist;
+        for (int id = 1; id <= 50; ++id) waitlist.add(id, id % 3, 20240000 + id % 7, id);
+        ASSERT_TRUE(waitlist.remove(25));
+        ASSERT_FALSE(waitlist.remove(25));
+        ASSERT_FALSE(waitlist.contains(25));
+        
+        // Entries restored in heap order (as saved) keep their serving order
+        Waitlist reloaded;
+        for (const auto& entry : waitlist.entries()) reloaded.restore(entry);
+        std::vector<WaitlistEntry> before = waitlist.ordered();
+        std::vector<WaitlistEntry> after = reloaded.ordered();
+        ASSERT_EQ(49, static_cast<int>(after.size()));
+        bool same = true;
+        for (size_t i = 0; i < before.size(); ++i) same = same && before[i].studentId == after[i].studentId;
+        ASSERT_TRUE(same);
+        
+        // A newcomer with the lowest rank queues behind every restored entry
+        reloaded.add(100, 0, 99999999, 1 << 30);
+        ASSERT_EQ(49, static_cast<int>(reloaded.position(100)));
+    }
+    
+    static void testLargeWaitlist() {
+        Waitlist waitlist;
+        const int count = 20000;
+        for (int id = 0; id < count; ++id) waitlist.add(id, (id * 7) % 4, 20200000 + (id * 13) % 500, id);
+        for (int id = 0; id < count; id += 3) waitlist.remove(id);
+        
+        WaitlistEntry previous, entry;
+        bool ordered = true;
+        size_t popped = 0;
+        while (waitlist.pop(entry)) {
+            if (popped > 0 && entry.servedBefore(previous)) ordered = false;
+            if (entry.studentId % 3 == 0) ordered = false;
+            previous = entry;
+            popped++;
+        }
+        ASSERT_TRUE(ordered);
+        ASSERT_EQ(count - (count + 2) / 3, static_cast<int>(popped));
+    }
+};
+
+class WorkStealingPoolTests {
+public:
+    static void testStealQueue() {
+        StealQueue queue(3); // Rounded up to 4
+        ASSERT_EQ(4, static_cast<int>(queue.capacity()));
+        ASSERT_TRUE(queue.empty());
+        for (uint32_t i = 0; i < 4; ++i) ASSERT_TRUE(queue.push(i));
+        ASSERT_FALSE(queue.push(4));
+        
+        uint32_t item = 0;
+        ASSERT_TRUE(queue.pop(item));
+        ASSERT_EQ(0, static_cast<int>(item));
+        ASSERT_TRUE(queue.push(4)); // Wraps into the freed slot
+        for (uint32_t expected = 1; expected <= 4; ++expected) {
+            ASSERT_TRUE(queue.pop(item));
+            ASSERT_EQ(static_cast<int>(expected), static_cast<int>(item));
+        }
+        ASSERT_FALSE(queue.pop(item));
+        ASSERT_TRUE(queue.empty());
+    }
+    
+    static void testEveryItemRunsOnce() {
+        // Everything routed to worker 0 with a small queue: the rest of the
+        // pool only gets work by stealing or through spill-over
+        const size_t count = 20000;
+        std::vector<std::atomic<int>> runs(count);
+        for (auto& r : runs) r = 0;
+        WorkStealingPool pool(4, 64);
+        pool.run(count, [](size_t) { return size_t(0); },
+                 [&runs](size_t item, size_t) { runs[item]++; });
+        
+        bool once = true;
+        for (const auto& r : runs) once = once && r.load() == 1;
+        ASSERT_TRUE(once);
+        ASSERT_EQ(4, static_cast<int>(pool.getWorkerCount()));
+    }
+    
+    static void testHomeWorkerOrder() {
+        // One worker: items run in arrival order
+        std::vector<size_t> order;
+        WorkStealingPool pool(1);
+        pool.run(100, [](size_t item) { return item; },
+                 [&order](size_t item, size_t) { order.push_back(item); });
+        ASSERT_EQ(100, static_cast<int>(order.size()));
+        ASSERT_TRUE(std::is_sorted(order.begin(), order.end()));
+        ASSERT_EQ(0, static_cast<int>(pool.getSteals()));
+    }
+};
+
+class VersionedSnapshotTests {
+public:
+    static void testReclaimWhenUnread() {
+        Versioned<std::vector<int>> cell;
+        ASSERT_TRUE(cell.acquire() == nullptr);
+        cell.publish(new std::vector<int>(3, 1));
+        auto reader = cell.acquire();
+        cell.publish(new std::vector<int>(3, 2));
+        
+        // The old version stays intact for the reader that still holds it
+        ASSERT_EQ(2, static_cast<int>(cell.getLiveVersions()));
+        ASSERT_EQ(1, (*reader)[0]);
+        ASSERT_EQ(2, (*cell.acquire())[0]);
+        reader.reset();
+        ASSERT_EQ(1, static_cast<int>(cell.getLiveVersions()));
+        ASSERT_EQ(2, static_cast<int>(cell.getPublished()));
+    }
+    
+    static void testReadersSeeWholeVersions() {
+        // Each version is filled with one value; a reader that ever sees a
+        // mix was handed a version that was still being changed
+        Versioned<std::vector<int>> cell;
+        cell.publish(new std::vector<int>(1000, 0));
+        std::atomic<bool> done(false);
+        std::atomic<int> torn(0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&]() {
+                while (!done) {
+                    auto view = cell.acquire();
+                    for (int value : *view) {
+                        if (value != view->front()) torn++;
+                    }
+                }
+            });
+        }
+        for (int version = 1; version <= 500; ++version) cell.publish(new std::vector<int>(1000, version));
+        done = true;
+        for (auto& reader : readers) reader.join();
+        ASSERT_EQ(0, torn.load());
+        ASSERT_EQ(1, static_cast<int>(cell.getLiveVersions()));
+    }
+};
+
+class ShardedStoreTests {
+public:
+    struct Tally {
+        std::vector<int> ids;
+        long sum = 0;
+    };
+    
+    static void testRoutingAndScatterGather() {
+        ShardedStore<Tally> store(4);
+        ASSERT_EQ(4, static_cast<int>(store.size()));
+        std::vector<int> perShard(4, 0);
+        for (int id = 1; id <= 1000; ++id) {
+            ASSERT_EQ(static_cast<int>(store.shardOf(id)), static_cast<int>(store.shardOf(id)));
+            perShard[store.shardOf(id)]++;
+            store.state(store.shardOf(id)).ids.push_back(id);
+        }
+        // Consecutive IDs spread over every shard
+        ASSERT_TRUE(*std::min_element(perShard.begin(), perShard.end()) > 150);
+        
+        store.start();
+        int owner = static_cast<int>(store.ask(store.shardOf(42), [](Tally& tally) {
+            return std::count(tally.ids.begin(), tally.ids.end(), 42);
+        }));
+        ASSERT_EQ(1, owner);
+        long total = 0;
+        for (long part : store.askAll([](Tally& tally) {
+                 long sum = 0;
+                 for (int id : tally.ids) sum += id;
+                 return sum;
+             })) {
+            total += part;
+        }
+        ASSERT_EQ(500500, static_cast<int>(total));
+        store.stop();
+    }
+    
+    static void testMessageChains() {
+        // Each chain hops through every shard, adding on each; the caller
+        // waits only for the last hop
+        ShardedStore<Tally> store(3);
+        store.start();
+        std::vector<std::future<void>> chains;
+        std::vector<std::shared_ptr<std::promise<void>>> promises;
+        std::function<void(size_t, size_t, std::shared_ptr<std::promise<void>>)> hop;
+        hop = [&store, &hop](size_t shard, size_t left, std::shared_ptr<std::promise<void>> done) {
+            store.post(shard, [&store, &hop, shard, left, done](Tally& tally) {
+                tally.sum++;
+                if (left == 1) {
+                    done->set_value();
+                } else {
+                    hop((shard + 1) % store.size(), left - 1, done);
+                }
+            });
+        };
+        for (int chain = 0; chain < 200; ++chain) {
+            auto done = std::make_shared<std::promise<void>>();
+            chains.push_back(done->get_future());
+            hop(chain % 3, 6, done);
+        }
+        for (auto& chain : chains) chain.wait();
+        store.stop();
+        ASSERT_EQ(400, static_cast<int>(store.state(0).sum));
+        ASSERT_EQ(400, static_cast<int>(store.state(2).sum));
+        ASSERT_EQ(400, static_cast<int>(store.getMessagesHandled(1)));
+    }
+};
+
+class AsyncFileWriterTests {
+public:
+    // A snapshot, then journal appends, then a backup copy of the same file:
+    // each must see the one before it
+    static void checkQueuedInOrder(AsyncFileWriter& writer) {
+        std::string filename = "test_async_" + std::to_string(::getpid()) + ".txt";
+        std::string backup = filename + ".bak";
+        std::vector<std::future<IoResult>> writes;
+        writes.push_back(writer.replace(filename, "header\n"));
+        std::string expected = "header\n";
+        for (int i = 0; i < 50; ++i) {
+            writes.push_back(writer.append(filename, std::to_string(i) + "\n"));
+            expected += std::to_string(i) + "\n";
+        }
+        int copied = 0;
+        writes.push_back(writer.copy(filename, backup, [&copied](const IoResult& result) {
+            if (result.ok) copied = static_cast<int>(result.bytes);
+        }));
+        for (auto& write : writes) ASSERT_TRUE(write.get().ok);
+        ASSERT_EQ(static_cast<int>(expected.size()), copied);
+        
+        std::string contents;
+        std::string copy;
+        ASSERT_TRUE(CsvReader::readFile(filename, contents));
+        ASSERT_TRUE(CsvReader::readFile(backup, copy));
+        std::remove(filename.c_str());
+        std::remove(backup.c_str());
+        ASSERT_EQ(expected, contents);
+        ASSERT_EQ(expected, copy);
+        
+        IoResult missing = writer.append("no_such_directory/file.txt", "x").get();
+        ASSERT_FALSE(missing.ok);
+        ASSERT_EQ(ENOENT, missing.error);
+        IoStats stats = writer.getStats();
+        ASSERT_EQ(0, static_cast<int>(stats.queueDepth));
+        ASSERT_EQ(53, static_cast<int>(stats.completed));
+        ASSERT_EQ(1, static_cast<int>(stats.failed));
+        ASSERT_TRUE(stats.maxMicros >= stats.averageMicros && stats.averageMicros > 0.0);
+    }
+    
+    static void testIoUringBackend() {
+        // Falls back to the pool where io_uring is unavailable
+        AsyncFileWriter writer(true);
+        checkQueuedInOrder(writer);
+    }
+    
+    static void testThreadPoolBackend() {
+        AsyncFileWriter writer(false, 3);
+        ASSERT_TRUE(writer.getBackend() == AsyncFileWriter::ThreadPoolBackend);
+        checkQueuedInOrder(writer);
+    }
+    
+    // Replacing syncs the directory the file is in, wherever that is
+    static void testReplaceInDirectory() {
+        std::string directory = "test_async_dir_" + std::to_string(::getpid());
+        ASSERT_EQ(0, ::mkdir(directory.c_str(), 0755));
+        std::string filename = directory + "/data.txt";
+        for (bool useIoUring : {true, false}) {
+            AsyncFileWriter writer(useIoUring);
+            ASSERT_TRUE(writer.replace(filename, "first\n").get().ok);
+            ASSERT_TRUE(writer.replace(filename, "second\n").get().ok);
+            ASSERT_FALSE(writer.replace(directory + "/missing/data.txt", "x").get().ok);
+            std::string contents;
+            ASSERT_TRUE(CsvReader::readFile(filename, contents));
+            ASSERT_EQ("second\n", contents);
+        }
+        std::remove(filename.c_str());
+        ::rmdir(directory.c_str());
+    }
+};
+
+class CoroutineTaskTests {
+public:
+    static Task<int> addOnExecutor(TaskExecutor& executor, int a, int b) {
+        co_await executor.schedule();
+        co_return a + b;
+    }
+    
+    static Task<int> sumChain(TaskExecutor& executor, int count) {
+        int total = 0;
+        for (int i = 1; i <= count; ++i) total += co_await addOnExecutor(executor, i, 0);
+        co_return total;
+    }
+    
+    static Task<void> failAfterHop(TaskExecutor& executor) {
+        co_await executor.schedule();
+        throw std::runtime_error("operation failed");
+    }
+    
+    static void testNestedTasksAndErrors() {
+        TaskExecutor executor(2);
+        ASSERT_EQ(5050, syncWait(executor, sumChain(executor, 100)));
+        bool caught = false;
+        try {
+            syncWait(executor, failAfterHop(executor));
+        } catch (const std::runtime_error& error) {
+            caught = std::string(error.what()) == "operation failed";
+        }
+        ASSERT_TRUE(caught);
+    }
+    
+    // Each operation waits for a journal append without holding a thread,
+    // so far more are in flight than the executor has threads
+    static Task<IoResult> journalEntry(TaskExecutor& executor, AsyncFileWriter& writer, std::string path, int entry) {
+        co_await executor.schedule();
+        std::string line = std::to_string(entry) + "\n";
+        co_return co_await completion<IoResult>(executor, [&writer, &path, &line](AsyncFileWriter::Callback done) {
+            writer.append(path, std::move(line), std::move(done));
+        });
+    }
+    
+    static void testThousandsInFlight() {
+        std::string filename = "test_coroutines_" + std::to_string(::getpid()) + ".txt";
+        TaskExecutor executor(2);
+        AsyncFileWriter writer;
+        std::vector<std::future<IoResult>> operations;
+        size_t peak = 0;
+        for (int i = 0; i < 2000; ++i) {
+            operations.push_back(spawn(executor, journalEntry(executor, writer, filename, i)));
+            peak = std::max(peak, executor.getInFlight());
+        }
+        int written = 0;
+        for (auto& operation : operations) written += operation.get().ok ? 1 : 0;
+        ASSERT_EQ(2000, written);
+        ASSERT_TRUE(peak > executor.getThreadCount());
+        ASSERT_EQ(0, static_cast<int>(executor.getInFlight()));
+        
+        std::string contents;
+        ASSERT_TRUE(CsvReader::readFile(filename, contents));
+        std::remove(filename.c_str());
+        ASSERT_EQ(2000, static_cast<int>(std::count(contents.begin(), contents.end(), '\n')));
+    }
+};
+
+class OptimisticCommitTests {
+public:
+    static void testStaleVersionConflicts() {
+        RecordVersion version;
+        std::mutex lock;
+        EditMetrics metrics;
+        std::string name = "Alice";
+        uint64_t seen = version.load();
+        
+        // Another editor commits first; the stale edit changes nothing
+        ASSERT_TRUE(commitEdit(version, lock, seen, [&] { name = "Alice Brown"; return true; }, metrics) == EditOutcome::Committed);
+        ASSERT_TRUE(commitEdit(version, lock, seen, [&] { name = "Alicia"; return true; }, metrics) == EditOutcome::Conflict);
+        ASSERT_EQ(std::string("Alice Brown"), name);
+        ASSERT_EQ(2, static_cast<int>(version.load()));
+        
+        // A refused value leaves the version where it was
+        ASSERT_TRUE(commitEdit(version, lock, version.load(), [] { return false; }, metrics) == EditOutcome::Invalid);
+        ASSERT_EQ(2, static_cast<int>(version.load()));
+        ASSERT_EQ(1, static_cast<int>(metrics.commits.load()));
+        ASSERT_EQ(1, static_cast<int>(metrics.conflicts.load()));
+        ASSERT_EQ(1, static_cast<int>(metrics.invalid.load()));
+    }
+    
+    static void testConcurrentEditorsLoseNothing() {
+        // Editors read the value, then commit value + 1 against what they
+        // read; every conflict is retried, so no increment is lost
+        RecordVersion version;
+        std::mutex lock;
+        EditMetrics metrics;
+        int value = 0;
+        std::vector<std::thread> editors;
+        for (int t = 0; t < 4; ++t) {
+            editors.emplace_back([&]() {
+                for (int i = 0; i < 500; ++i) {
+                    while (true) {
+                        uint64_t seen = version.load();
+                        int read = std::atomic_ref<int>(value).load();
+                        EditOutcome outcome = commitEdit(version, lock, seen, [&] { std::atomic_ref<int>(value).store(read + 1); return true; }, metrics);
+                        if (outcome == EditOutcome::Committed) break;
+                        metrics.retries++;
+                    }
+                }
+            });
+        }
+        for (auto& editor : editors) editor.join();
+        ASSERT_EQ(2000, value);
+        ASSERT_EQ(2001, static_cast<int>(version.load()));
+        ASSERT_EQ(2000, static_cast<int>(metrics.commits.load()));
+        ASSERT_EQ(metrics.conflicts.load(), metrics.retries.load());
+        
+        SingleOwner owner;
+        ASSERT_TRUE(commitLatest(version, owner, [&] { value = 0; return true; }, metrics) == EditOutcome::Committed);
+        ASSERT_EQ(2002, static_cast<int>(version.load()));
+    }
+    
+    static void testLatestRereadsAreNotConflicts() {
+        // Blind edits racing each other re-read and retry; no editor's read
+        // went stale, so nothing counts as a conflict
+        RecordVersion version;
+        std::mutex lock;
+        EditMetrics metrics;
+        int value = 0;
+        std::vector<std::thread> editors;
+        for (int t = 0; t < 4; ++t) {
+            editors.emplace_back([&]() {
+                for (int i = 0; i < 500; ++i) {
+                    commitLatest(version, lock, [&] { value++; return true; }, metrics);
+                }
+            });
+        }
+        for (auto& editor : editors) editor.join();
+        ASSERT_EQ(2000, value);
+        ASSERT_EQ(2000, static_cast<int>(metrics.commits.load()));
+        ASSERT_EQ(0, static_cast<int>(metrics.conflicts.load()));
+    }
+};
+
 class ConfigTests {
 public:
+    // Puts the shared settings back, and stops any watch, however a test ends
+    struct RestoreConfig {
+        Config* config = Config::getInstance();
+        std::shared_ptr<const ConfigSnapshot> previous = config->snapshot();
+        ~RestoreConfig() {
+            config->stopWatching();
+            config->restore(*previous);
+        }
+    };
+    
     static void testConfigSingleton() {
         Config* config1 = Config::getInstance();
         Config* config2 = Config::getInstance();
@@ -192,6 +1745,156 @@ public:
         
         ASSERT_EQ("default", config->get("nonexistent_key", "default"));
     }
+    
+    static void testConfigTypedReads() {
+        RestoreConfig restore;
+        Config* config = Config::getInstance();
+        
+        ASSERT_EQ(50, config->maxStudentsPerCourse());
+        ASSERT_EQ(50, config->getInt("max_students_per_course"));
+        ASSERT_TRUE(config->backupEnabled());
+        config->set("typed_flag", "Off");
+        config->set("typed_count", "12x");
+        config->set("typed_dir", "data/./reports/../exports/");
+        ASSERT_FALSE(config->getBool("typed_flag", true));
+        ASSERT_EQ(7, config->getInt("typed_count", 7)); // Doesn't parse, so the default
+        ASSERT_EQ("data/exports/", config->getPath("typed_dir"));
+        
+        // A snapshot keeps its values while newer ones are published
+        std::shared_ptr<const ConfigSnapshot> before = config->snapshot();
+        config->set("max_students_per_course", "60");
+        ASSERT_EQ(60, config->maxStudentsPerCourse());
+        ASSERT_EQ(50, before->maxStudentsPerCourse);
+    }
+    
+    // Limits are read where they apply, so a reload changes them in place
+    static void testConfigConsumers() {
+        RestoreConfig restore;
+        Config* config = Config::getInstance();
+        std::string filename = "test_config_courses_" + std::to_string(::getpid()) + ".txt";
+        std::ofstream(filename) << "9001,Algebra,Intro,3\n9002,Biology,Intro,3,25\n";
+        config->set("max_students_per_course", "40");
+        std::vector<Course> courses = Course::loadFromFile(filename);
+        std::remove(filename.c_str());
+        ASSERT_EQ(2, static_cast<int>(courses.size()));
+        ASSERT_EQ(40, courses[0].getMaxStudents()); // No limit in the row
+        ASSERT_EQ(25, courses[1].getMaxStudents());
+        
+        Classroom room(14, 30, "B-103", "Science");
+        config->set("max_courses_per_classroom", "2");
+        ASSERT_TRUE(room.scheduleCourse(std::make_shared<Course>(9101, "History")));
+        ASSERT_TRUE(room.scheduleCourse(std::make_shared<Course>(9102, "Geography")));
+        ASSERT_FALSE(room.scheduleCourse(std::make_shared<Course>(9103, "Music")));
+        config->set("max_courses_per_classroom", "3");
+        ASSERT_TRUE(room.scheduleCourse(std::make_shared<Course>(9103, "Music")));
+    }
+    
+    static void testConfigHotReload() {
+        RestoreConfig restore;
+        std::string filename = "test_config_" + std::to_string(::getpid()) + ".txt";
+        std::ofstream(filename) << "reload_probe=1\n";
+        Config* config = Config::getInstance();
+        ASSERT_TRUE(config->loadFromFile(filename));
+        ASSERT_TRUE(config->watch(filename));
+        
+        // Written in place, then replaced by a rename, as editors do
+        std::ofstream(filename) << "reload_probe=2\n";
+        for (int i = 0; i < 200 && config->getInt("reload_probe") != 2; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ASSERT_EQ(2, config->getInt("reload_probe"));
+        std::ofstream(filename + ".new") << "reload_probe=3\n";
+        std::rename((filename + ".new").c_str(), filename.c_str());
+        for (int i = 0; i < 200 && config->getInt("reload_probe") != 3; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ASSERT_EQ(3, config->getInt("reload_probe"));
+        ASSERT_TRUE(config->getReloadCount() >= 2);
+        
+        config->stopWatching();
+        std::remove(filename.c_str());
+        restore.config->restore(*restore.previous);
+        ASSERT_EQ(-1, config->getInt("reload_probe", -1));
+    }
+};
+
+class RosterBitmapTests {
+public:
+    static void testRosterMembership() {
+        RosterBitmap roster;
+        
+        ASSERT_TRUE(roster.empty());
+        ASSERT_TRUE(roster.add(42));
+        ASSERT_FALSE(roster.add(42)); // Duplicate
+        ASSERT_TRUE(roster.add(70000)); // Second container
+        ASSERT_TRUE(roster.contains(42));
+        ASSERT_TRUE(roster.contains(70000));
+        ASSERT_FALSE(roster.contains(43));
+        ASSERT_EQ(2, static_cast<int>(roster.cardinality()));
+        
+        ASSERT_TRUE(roster.remove(42));
+        ASSERT_FALSE(roster.remove(42));
+        ASSERT_EQ(1, static_cast<int>(roster.cardinality()));
+    }
+    
+    static void testRosterDenseContainers() {
+        // Cross the array/bitmap threshold in both directions
+        RosterBitmap roster;
+        for (int id = 0; id < 10000; ++id) roster.add(id * 2);
+        ASSERT_EQ(10000, static_cast<int>(roster.cardinality()));
+        ASSERT_TRUE(roster.contains(19998));
+        ASSERT_FALSE(roster.contains(19999));
+        
+        for (int id = 0; id < 9000; ++id) roster.remove(id * 2);
+        ASSERT_EQ(1000, static_cast<int>(roster.cardinality()));
+        ASSERT_TRUE(roster.contains(18000));
+        ASSERT_FALSE(roster.contains(17998));
+    }
+    
+    static void testRosterSetAlgebra() {
+        // Mix sparse and dense containers and compare with std::set_* results
+        std::vector<int> a, b;
+        for (int id = 0; id < 200000; id += 3) a.push_back(id);
+        for (int id = 0; id < 200000; id += 7) b.push_back(id);
+        for (int id = 300000; id < 300050; ++id) b.push_back(id);
+        
+        RosterBitmap ra = RosterBitmap::fromIds(a);
+        RosterBitmap rb = RosterBitmap::fromIds(b);
+        std::sort(b.begin(), b.end());
+        
+        std::vector<int> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        ASSERT_TRUE(RosterBitmap::intersect(ra, rb).toVector() == expected);
+        ASSERT_EQ(static_cast<int>(expected.size()), static_cast<int>(RosterBitmap::intersectionCardinality(ra, rb)));
+        
+        expected.clear();
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        ASSERT_TRUE(RosterBitmap::unite(ra, rb).toVector() == expected);
+        
+        expected.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        ASSERT_TRUE(RosterBitmap::difference(ra, rb).toVector() == expected);
+    }
+    
+    static void testRosterQuery() {
+        auto teacher = std::make_shared<Teacher>(1, "Dr. Smith", "Math", "", "", "Science");
+        auto s1 = std::make_shared<Student>(1, "John", 20);
+        auto s2 = std::make_shared<Student>(2, "Jane", 21);
+        auto s3 = std::make_shared<Student>(3, "Bob", 19);
+        
+        std::vector<Course> courses;
+        courses.emplace_back(1, "Math 101");
+        courses.emplace_back(2, "Physics 101");
+        courses[0].enrollStudent(s1);
+        courses[0].enrollStudent(s2);
+        courses[1].enrollStudent(s2);
+        courses[1].enrollStudent(s3);
+        courses[0].assignTeacher(teacher);
+        
+        RosterQuery query(courses);
+        ASSERT_TRUE(query.studentsInBoth(1, 2) == std::vector<int>({2}));
+        ASSERT_TRUE(query.studentsInEither(1, 2) == std::vector<int>({1, 2, 3}));
+        ASSERT_TRUE(query.studentsInFirstOnly(1, 2) == std::vector<int>({1}));
+        ASSERT_EQ(1, static_cast<int>(query.countInBoth(1, 2)));
+        ASSERT_EQ(2, static_cast<int>(query.countInDepartment("Science")));
+        ASSERT_EQ(0, static_cast<int>(query.countInDepartment("Arts")));
+    }
 };
 
 void runAllTests() {
@@ -214,10 +1917,102 @@ void runAllTests() {
     framework.addTest("Course Teacher Assignment", CourseTests::testCourseTeacherAssignment);
     framework.addTest("Course Student Enrollment", CourseTests::testCourseStudentEnrollment);
     
+    // Attendance Matrix Tests
+    framework.addTest("Course Attendance Recording", AttendanceMatrixTests::testCourseAttendanceRecording);
+    framework.addTest("Session Row Write", AttendanceMatrixTests::testSessionRowWrite);
+    framework.addTest("Column Counts Match Per Student", AttendanceMatrixTests::testColumnCountsMatchPerStudent);
+    framework.addTest("Roll-Call Journal", AttendanceMatrixTests::testRollCallJournal);
+    framework.addTest("Swipe Log Ingestion", AttendanceMatrixTests::testSwipeIngestion);
+    framework.addTest("Swipe Log Bad Rows", AttendanceMatrixTests::testSwipeRejectsBadRows);
+    framework.addTest("Swipe Logs Add Presences", AttendanceMatrixTests::testSwipeFilesUnion);
+    framework.addTest("Date Window Queries", AttendanceMatrixTests::testDateWindowQueries);
+    framework.addTest("Range Index Point Updates", AttendanceMatrixTests::testRangeIndexPointUpdates);
+    
     // Config Tests
     framework.addTest("Config Singleton", ConfigTests::testConfigSingleton);
     framework.addTest("Config Defaults", ConfigTests::testConfigDefaults);
     framework.addTest("Config Set/Get", ConfigTests::testConfigSetGet);
+    framework.addTest("Config Typed Reads", ConfigTests::testConfigTypedReads);
+    framework.addTest("Config Consumers", ConfigTests::testConfigConsumers);
+    framework.addTest("Config Hot Reload", ConfigTests::testConfigHotReload);
+    
+    // Roster Bitmap Tests
+    framework.addTest("Roster Membership", RosterBitmapTests::testRosterMembership);
+    framework.addTest("Roster Dense Containers", RosterBitmapTests::testRosterDenseContainers);
+    framework.addTest("Roster Set Algebra", RosterBitmapTests::testRosterSetAlgebra);
+    framework.addTest("Roster Query", RosterBitmapTests::testRosterQuery);
+    
+    // Text Validator Tests
+    framework.addTest("Email DFA Matches Regex", TextValidatorTests::testEmailMatchesRegex);
+    framework.addTest("Phone DFA Matches Regex", TextValidatorTests::testPhoneMatchesRegex);
+    framework.addTest("Whitespace Normalizer Matches Regex", TextValidatorTests::testNormalizerMatchesRegex);
+    
+    // CSV Reader Tests
+    framework.addTest("CSV Quoted Records", CsvReaderTests::testQuotedRecords);
+    framework.addTest("CSV Chunk Boundaries", CsvReaderTests::testChunkBoundaries);
+    framework.addTest("CSV Header Mapping", CsvReaderTests::testHeaderMapping);
+    
+    // Output Buffer Tests
+    framework.addTest("CSV Writer Round Trip", OutputBufferTests::testCsvRoundTrip);
+    framework.addTest("JSON Lines Escaping", OutputBufferTests::testJsonLinesEscaping);
+    framework.addTest("Non-Finite Numbers", OutputBufferTests::testNonFiniteNumbers);
+    framework.addTest("Output Buffer Flush To File", OutputBufferTests::testFlushToFile);
+    framework.addTest("Output Buffer Attached Stream", OutputBufferTests::testAttachedStreamStaysOpen);
+    
+    // JSON Lines Reader Tests
+    framework.addTest("JSON Structural Index", JsonLinesReaderTests::testStructuralIndex);
+    framework.addTest("JSON Lines Writer Round Trip", JsonLinesReaderTests::testWriterRoundTrip);
+    framework.addTest("JSON Lines Malformed Lines", JsonLinesReaderTests::testMalformedLines);
+    framework.addTest("JSON Lines Unterminated String", JsonLinesReaderTests::testUnterminatedStringLine);
+    
+    // Columnar File Tests
+    framework.addTest("Columnar Round Trip", ColumnarFileTests::testRoundTrip);
+    framework.addTest("Columnar Row Group Skipping", ColumnarFileTests::testRowGroupSkipping);
+    framework.addTest("Columnar Damaged Files", ColumnarFileTests::testRejectsDamagedFiles);
+    framework.addTest("Columnar Oversized Counts", ColumnarFileTests::testRejectsOversizedCounts);
+    
+    // School Protocol Tests
+    framework.addTest("Protocol Frame Round Trip", SchoolProtocolTests::testFrameRoundTrip);
+    framework.addTest("Protocol Reader Overrun", SchoolProtocolTests::testReaderOverrun);
+    framework.addTest("Socket Server Round Trip", SchoolProtocolTests::testServerRoundTrip);
+    framework.addTest("Socket Server Backpressure", SchoolProtocolTests::testServerBackpressure);
+    
+    // Seat Reservation Tests
+    framework.addTest("Seat Reserve Commit Rollback", SeatReservationTests::testReserveCommitRollback);
+    framework.addTest("Seat Capacity Under Contention", SeatReservationTests::testCapacityNeverExceeded);
+    framework.addTest("Seat Resize Against Reservations", SeatReservationTests::testResizeAgainstReservations);
+    
+    // Waitlist Tests
+    framework.addTest("Waitlist Serving Order", WaitlistTests::testServingOrder);
+    framework.addTest("Waitlist Remove And Restore", WaitlistTests::testRemoveAndRestore);
+    framework.addTest("Waitlist Large Queue", WaitlistTests::testLargeWaitlist);
+    
+    // Work Stealing Pool Tests
+    framework.addTest("Steal Queue Push Pop", WorkStealingPoolTests::testStealQueue);
+    framework.addTest("Work Stealing Runs Each Item Once", WorkStealingPoolTests::testEveryItemRunsOnce);
+    framework.addTest("Work Stealing Single Worker Order", WorkStealingPoolTests::testHomeWorkerOrder);
+    
+    // Versioned Snapshot Tests
+    framework.addTest("Snapshot Reclaimed When Unread", VersionedSnapshotTests::testReclaimWhenUnread);
+    framework.addTest("Snapshot Readers See Whole Versions", VersionedSnapshotTests::testReadersSeeWholeVersions);
+    
+    // Sharded Store Tests
+    framework.addTest("Sharded Store Routing And Scatter Gather", ShardedStoreTests::testRoutingAndScatterGather);
+    framework.addTest("Sharded Store Message Chains", ShardedStoreTests::testMessageChains);
+    
+    // Async File Writer Tests
+    framework.addTest("Async Writer io_uring Backend", AsyncFileWriterTests::testIoUringBackend);
+    framework.addTest("Async Writer Thread Pool Backend", AsyncFileWriterTests::testThreadPoolBackend);
+    framework.addTest("Async Writer Replace In Directory", AsyncFileWriterTests::testReplaceInDirectory);
+    
+    // Coroutine Task Tests
+    framework.addTest("Coroutine Nested Tasks And Errors", CoroutineTaskTests::testNestedTasksAndErrors);
+    framework.addTest("Coroutine Thousands In Flight", CoroutineTaskTests::testThousandsInFlight);
+    
+    // Optimistic Commit Tests
+    framework.addTest("Optimistic Commit Stale Version Conflicts", OptimisticCommitTests::testStaleVersionConflicts);
+    framework.addTest("Optimistic Commit Concurrent Editors Lose Nothing", OptimisticCommitTests::testConcurrentEditorsLoseNothing);
+    framework.addTest("Optimistic Commit Latest Re-reads Not Conflicts", OptimisticCommitTests::testLatestRereadsAreNotConflicts);
     
     framework.runAllTests();
     framework.printResults();
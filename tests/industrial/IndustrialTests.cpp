@@ -0,0 +1,888 @@
+// Unit tests for the single-file industrial system. Built on their own (see
+// the test-industrial make target), since its Student and Teacher are not
+// the modular ones.
+#include "../../include/TestFramework.h"
+#include "../../IndustrialSchoolSystem.cpp"
+#include <cstdlib>
+#include <climits>
+#include <unordered_set>
+#include <set>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <future>
+#include <unistd.h>
+
+class AttendanceBitsetTests {
+public:
+    static void testSerializeRoundTrip() {
+        AttendanceBitset bitset;
+        for (int session = 0; session < 130; ++session) bitset.record(session % 3 == 0);
+        std::string data = bitset.serialize();
+        
+        AttendanceBitset copy;
+        ASSERT_TRUE(AttendanceBitset::deserialize(data, copy));
+        ASSERT_EQ(130, static_cast<int>(copy.getSessionCount()));
+        ASSERT_EQ(static_cast<int>(bitset.getPresentCount()), static_cast<int>(copy.getPresentCount()));
+        for (uint32_t session = 0; session < 130; ++session) {
+            ASSERT_TRUE(copy.wasPresent(session) == (session % 3 == 0));
+        }
+        ASSERT_EQ(data, copy.serialize());
+        
+        AttendanceBitset empty;
+        ASSERT_TRUE(AttendanceBitset::deserialize(AttendanceBitset().serialize(), empty));
+        ASSERT_EQ(0, static_cast<int>(empty.getSessionCount()));
+    }
+    
+    static void testMalformedRejected() {
+        AttendanceBitset bitset;
+        bitset.record(true);
+        const char* malformed[] = {"", "3", "x:1", "3:zz", "3:1,2", "70:1", "3:1;", "-1:1", "3:,"};
+        for (const char* data : malformed) {
+            ASSERT_FALSE(AttendanceBitset::deserialize(data, bitset));
+        }
+        ASSERT_EQ(1, static_cast<int>(bitset.getSessionCount())); // Untouched
+    }
+    
+    // A bad attendance field costs that course's history, not the student
+    static void testCorruptAttendanceKeepsStudent() {
+        std::string filename = "test_attendance_students.txt";
+        std::ofstream(filename) << "1001|Alice Smith|20||||2024-01-01|1|3001,3002|3001=zz:1;3002=3:5\n";
+        std::vector<Student> students = Student::loadFromFile(filename);
+        std::remove(filename.c_str());
+        ASSERT_EQ(1, static_cast<int>(students.size()));
+        ASSERT_EQ(1, static_cast<int>(students[0].getAttendance().size()));
+        ASSERT_EQ(3002, students[0].getAttendance()[0].first);
+        ASSERT_EQ(2, static_cast<int>(students[0].getAttendance()[0].second.getPresentCount()));
+    }
+};
+
+class BatchValidatorTests {
+public:
+    // Row-at-a-time reference: the interactive checks plus a seen-set
+    static std::vector<uint8_t> validateSerially(const RecordColumns& columns) {
+        std::vector<uint8_t> errors(columns.size(), 0);
+        std::unordered_set<int> seen;
+        for (size_t row = 0; row < columns.size(); ++row) {
+            uint8_t mask = 0;
+            if (!InputValidator::isValidId(columns.ids[row])) mask |= BatchValidator::InvalidId;
+            if (!InputValidator::isValidName(columns.names[row])) mask |= BatchValidator::InvalidName;
+            if (!InputValidator::isValidAge(columns.ages[row])) mask |= BatchValidator::InvalidAge;
+            if (!InputValidator::isValidEmail(columns.emails[row])) mask |= BatchValidator::InvalidEmail;
+            if (!InputValidator::isValidPhone(columns.phones[row])) mask |= BatchValidator::InvalidPhone;
+            if (!seen.insert(columns.ids[row]).second) mask |= BatchValidator::DuplicateId;
+            errors[row] = mask;
+        }
+        return errors;
+    }
+    
+    static void testMatchesSerialValidator() {
+        // Enough rows for several radix-sort threads, with IDs that differ in
+        // every byte, sign and range boundaries, and repeats across chunks
+        const int boundaries[] = {0, -1, 1, 999999, 1000000, INT_MIN, INT_MAX, 255, 256, 65535, 65536,
+                                  0x01000001, 0x00000001, -0x01000000};
+        RecordColumns columns;
+        uint32_t seed = 12345;
+        for (int row = 0; row < 150000; ++row) {
+            seed = seed * 1103515245u + 12345u;
+            int id;
+            if (row % 97 == 0) {
+                id = boundaries[(seed >> 8) % (sizeof(boundaries) / sizeof(boundaries[0]))];
+            } else if (row % 5 == 0 && row > 0) {
+                id = columns.ids[(seed >> 4) % row]; // Repeat of an earlier row
+            } else {
+                id = static_cast<int>(seed >> 11);
+            }
+            columns.ids.push_back(id);
+            columns.names.push_back(row % 41 == 0 ? "Bad_Name" : "Student " + std::to_string(row % 1000));
+            columns.ages.push_back(14 + static_cast<int>(seed % 90));
+            columns.emails.push_back(row % 53 == 0 ? "not-an-email" : "");
+            columns.phones.push_back(row % 59 == 0 ? "12" : "");
+        }
+        
+        std::vector<uint8_t> expected = validateSerially(columns);
+        size_t expectedValid = std::count(expected.begin(), expected.end(), 0);
+        for (size_t threads : {1, 4}) {
+            BatchValidator::Report report = BatchValidator::validate(columns, threads, 1000);
+            ASSERT_TRUE(report.errors == expected);
+            ASSERT_EQ(static_cast<int>(expectedValid), static_cast<int>(report.validRows));
+            for (int flag = 0; flag < BatchValidator::FLAG_COUNT; ++flag) {
+                size_t count = std::count_if(expected.begin(), expected.end(),
+                                             [flag](uint8_t mask) { return (mask >> flag) & 1; });
+                ASSERT_EQ(static_cast<int>(count), static_cast<int>(report.flagCounts[flag]));
+            }
+        }
+    }
+    
+    // Only repeats are flagged, never the first occurrence
+    static void testDuplicatesAfterFirstOnly() {
+        std::vector<int> ids = {5, INT_MIN, 5, 999999, 5, INT_MIN, -5, 999999};
+        std::vector<uint8_t> errors(ids.size(), 0);
+        BatchValidator::markDuplicateIds(ids, errors, 3);
+        std::vector<uint8_t> expected = {0, 0, BatchValidator::DuplicateId, 0, BatchValidator::DuplicateId,
+                                         BatchValidator::DuplicateId, 0, BatchValidator::DuplicateId};
+        ASSERT_TRUE(errors == expected);
+        
+        ASSERT_EQ("invalid id, duplicate id",
+                  BatchValidator::describe(BatchValidator::InvalidId | BatchValidator::DuplicateId));
+        ASSERT_EQ("ok", BatchValidator::describe(0));
+    }
+};
+
+class CsvImportTests {
+public:
+    static void testInsertThenUpsert() {
+        std::string filename = "test_import_students.csv";
+        std::ofstream(filename) << "id,name,age,email\n"
+                                << "1001,Alice Smith,20,alice@example.com\n"
+                                << "1002,Bob Jones,15,\n"          // Too young
+                                << "1003,Carol White,22,\n"
+                                << "1001,Alice Again,21,\n";       // Repeated ID
+        std::vector<Student> students;
+        CsvImportStats stats = CsvImporter::importFile<StudentCsvFormat>(filename, students, 2);
+        ASSERT_TRUE(stats.ok());
+        ASSERT_EQ(2, static_cast<int>(stats.inserted));
+        ASSERT_EQ(2, static_cast<int>(stats.rejected));
+        ASSERT_EQ(2, static_cast<int>(students.size()));
+        
+        // Same IDs again: one changed, one identical, one new
+        std::ofstream(filename) << "id,name,age,email\n"
+                                << "1001,Alice Smith,21,alice@example.com\n"
+                                << "1003,Carol White,22,\n"
+                                << "1004,Dan Brown,30,\n";
+        stats = CsvImporter::importFile<StudentCsvFormat>(filename, students, 2);
+        std::remove(filename.c_str());
+        ASSERT_EQ(1, static_cast<int>(stats.inserted));
+        ASSERT_EQ(1, static_cast<int>(stats.updated));
+        ASSERT_EQ(1, static_cast<int>(stats.unchanged));
+        ASSERT_EQ(0, static_cast<int>(stats.rejected));
+        ASSERT_EQ(21, students[0].getAge());
+        ASSERT_EQ("alice@example.com", students[0].getEmail());
+    }
+    
+    static void testNonFiniteSalaryRejected() {
+        std::string filename = "test_import_teachers.csv";
+        std::ofstream(filename) << "id,name,subject,salary\n"
+                                << "2001,Ann Lee,Math,nan\n"
+                                << "2002,Ben Ode,Math,inf\n"
+                                << "2003,Cal Ray,Math,-infinity\n"
+                                << "2004,Dee Fox,Math,1e400\n"     // Overflows to inf
+                                << "2005,Eve Kim,Math,-1\n"
+                                << "2006,Fay Lin,Math,52000.50\n";
+        std::vector<Teacher> teachers;
+        CsvImportStats stats = CsvImporter::importFile<TeacherCsvFormat>(filename, teachers, 1);
+        std::remove(filename.c_str());
+        ASSERT_EQ(5, static_cast<int>(stats.rejected));
+        ASSERT_EQ(1, static_cast<int>(teachers.size()));
+        ASSERT_EQ(2006, teachers[0].getId());
+        ASSERT_TRUE(teachers[0].getSalary() == 52000.50);
+    }
+    
+    // Lowering capacity below the current enrollment is refused, counted as
+    // rejected and leaves the course untouched
+    static void testRefusedUpdateNotCounted() {
+        std::vector<Course> courses;
+        courses.emplace_back(3001, "Algebra", "", 3, 30);
+        for (int studentId = 1; studentId <= 5; ++studentId) ASSERT_TRUE(courses[0].enrollStudent(studentId));
+        
+        std::string filename = "test_import_courses.csv";
+        std::ofstream(filename) << "id,name,credits,max_students\n"
+                                << "3001,Algebra II,4,3\n";
+        CsvImportStats stats = CsvImporter::importFile<CourseCsvFormat>(filename, courses, 1);
+        ASSERT_EQ(0, static_cast<int>(stats.updated));
+        ASSERT_EQ(1, static_cast<int>(stats.rejected));
+        ASSERT_EQ(30, courses[0].getMaxStudents());
+        ASSERT_EQ("Algebra", courses[0].getName());
+        
+        std::ofstream(filename) << "id,name,credits,max_students\n"
+                                << "3001,Algebra II,4,5\n";
+        stats = CsvImporter::importFile<CourseCsvFormat>(filename, courses, 1);
+        std::remove(filename.c_str());
+        ASSERT_EQ(1, static_cast<int>(stats.updated));
+        ASSERT_EQ(5, courses[0].getMaxStudents());
+        ASSERT_EQ("Algebra II", courses[0].getName());
+    }
+};
+
+class BatchModeTests {
+public:
+    typedef IndustrialSchoolManagementSystem System;
+    
+    static std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> result;
+        std::stringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) result.push_back(line);
+        return result;
+    }
+    
+    static bool contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+    
+    static void testRunBatchResults() {
+        std::string commandFile = "test_batch_commands.csv";
+        std::ofstream(commandFile) << "# comment lines are skipped\n"
+                                   << "add,student,5001,Test Student,20\n"
+                                   << "add,student,5001,Other Student,21\n"   // Duplicate ID
+                                   << "edit,student,5001,name,Renamed Student\n"
+                                   << "bogus,thing\n"
+                                   << "report,student\n"                      // Missing its ID
+                                   << "save\n";
+        OutputBuffer out;
+        size_t failed = 0;
+        {
+            System system(false);
+            ASSERT_TRUE(system.runBatch(commandFile, out, failed, true));
+            ASSERT_EQ("Renamed Student", system.findStudentById(5001)->getName());
+            size_t unused = 0;
+            ASSERT_FALSE(system.runBatch("no_such_commands.csv", out, unused, true));
+            system.setSaveOnExit(false);
+        }
+        std::remove(commandFile.c_str());
+        
+        std::vector<std::string> results = lines(out.str());
+        ASSERT_TRUE(results.size() >= 7);
+        ASSERT_TRUE(contains(results[0], "\"line\":2,\"command\":\"add student\",\"ok\":true"));
+        ASSERT_TRUE(contains(results[1], "\"ok\":false"));
+        ASSERT_TRUE(contains(results[2], "\"command\":\"edit student\",\"ok\":true"));
+        ASSERT_TRUE(contains(results[3], "\"command\":\"bogus\",\"ok\":false") && contains(results[3], "unknown command"));
+        ASSERT_TRUE(contains(results[4], "\"ok\":false") && contains(results[4], "usage: report,student,id"));
+        ASSERT_TRUE(contains(results[5], "\"command\":\"save\",\"ok\":true") && contains(results[5], "skipped (dry run)"));
+        ASSERT_TRUE(contains(results.back(), "\"type\":\"summary\",\"commands\":6,\"succeeded\":3,\"failed\":3"));
+        ASSERT_EQ(3, static_cast<int>(failed));
+        
+        // Nothing was written by the dry-run save
+        ASSERT_FALSE(std::ifstream("industrial_students.txt").is_open());
+    }
+    
+    static void testCommandTable() {
+        size_t count = 0;
+        const System::BatchCommand* table = System::batchCommands(count);
+        ASSERT_TRUE(count > 0);
+        std::set<std::string> seen;
+        for (size_t i = 0; i < count; ++i) {
+            std::string label = std::string(table[i].name) + "," + (table[i].target ? table[i].target : "");
+            ASSERT_TRUE(seen.insert(label).second);
+            ASSERT_TRUE(table[i].handler != nullptr);
+            ASSERT_TRUE(table[i].minArgs <= table[i].maxArgs);
+            // The usage line starts with the fields that select the command
+            ASSERT_EQ(0, static_cast<int>(std::string(table[i].usage).find(table[i].target ? label : table[i].name)));
+            
+            std::vector<std::string> fields = {table[i].name};
+            if (table[i].target) fields.push_back(table[i].target);
+            ASSERT_TRUE(System::findBatchCommand(table, count, fields) == &table[i]);
+        }
+        ASSERT_TRUE(System::findBatchCommand(table, count, {"report"}) == nullptr);
+        ASSERT_TRUE(System::findBatchCommand(table, count, {"report", "nothing"}) == nullptr);
+        ASSERT_TRUE(System::findBatchCommand(table, count, {"save", "extra"}) != nullptr);
+    }
+    
+    static bool parse(std::vector<std::string> args, CommandLine& options) {
+        std::vector<char*> argv;
+        args.insert(args.begin(), "IndustrialSchoolSystem");
+        for (auto& arg : args) argv.push_back(&arg[0]);
+        options = CommandLine();
+        return parseCommandLine(static_cast<int>(argv.size()), argv.data(), options);
+    }
+    
+    static void testCommandLine() {
+        CommandLine options;
+        ASSERT_TRUE(parse({}, options));
+        ASSERT_TRUE(options.batchFile.empty() && options.socketPath.empty() && !options.dryRun);
+        
+        ASSERT_TRUE(parse({"--batch", "cmds.csv", "--output", "out.jsonl", "--dry-run"}, options));
+        ASSERT_EQ("cmds.csv", options.batchFile);
+        ASSERT_EQ("out.jsonl", options.outputFile);
+        ASSERT_TRUE(options.dryRun);
+        
+        ASSERT_TRUE(parse({"--serve", "school.sock", "--workers", "6"}, options));
+        ASSERT_EQ("school.sock", options.socketPath);
+        ASSERT_EQ(6, static_cast<int>(options.workers));
+        ASSERT_TRUE(parse({"--workers", "-3"}, options));
+        ASSERT_EQ(0, static_cast<int>(options.workers));
+        
+        ASSERT_FALSE(parse({"--batch"}, options)); // Missing its value
+        ASSERT_FALSE(options.help);
+        ASSERT_FALSE(parse({"--verbose"}, options));
+        ASSERT_FALSE(options.help);
+        ASSERT_FALSE(parse({"--help"}, options));
+        ASSERT_TRUE(options.help);
+    }
+};
+
+class EnrollmentTests {
+public:
+    typedef IndustrialSchoolManagementSystem System;
+    
+    // Students 7001.. and one course per capacity, 8001..; IDs clear of
+    // anything the system loads
+    static void populate(System& system, int studentCount, std::vector<int> capacities) {
+        for (int i = 0; i < studentCount; ++i) system.students.emplace_back(7001 + i, "Student " + std::to_string(i), 20);
+        for (size_t i = 0; i < capacities.size(); ++i) {
+            int id = 8001 + static_cast<int>(i);
+            system.courses.emplace_back(id, "Course " + std::to_string(id), "", 3, capacities[i]);
+        }
+        system.syncIndexes();
+    }
+    
+    static void testRollbackWhenLastFull() {
+        System system(false);
+        system.setSaveOnExit(false);
+        populate(system, 2, {5, 5, 1});
+        Student& first = *system.findStudentById(7001);
+        Student& second = *system.findStudentById(7002);
+        EnrollmentResult result;
+        const int last[] = {8003};
+        ASSERT_TRUE(system.enrollStudentInCourses(first, last, 1, result));
+        
+        const int courses[] = {8001, 8002, 8003};
+        ASSERT_FALSE(system.enrollStudentInCourses(second, courses, 3, result));
+        ASSERT_FALSE(result.committed);
+        ASSERT_TRUE(result.outcomes[0] == EnrollmentOutcome::RolledBack);
+        ASSERT_TRUE(result.outcomes[1] == EnrollmentOutcome::RolledBack);
+        ASSERT_TRUE(result.outcomes[2] == EnrollmentOutcome::Full);
+        ASSERT_TRUE(second.getEnrolledCourses().empty());
+        ASSERT_EQ(0, system.findCourseById(8001)->getCurrentEnrollment());
+        ASSERT_EQ(0, system.findCourseById(8002)->getCurrentEnrollment());
+        ASSERT_EQ(1, system.findCourseById(8003)->getCurrentEnrollment());
+        
+        // The rolled-back reservations gave their seats back
+        for (int seat = 0; seat < 5; ++seat) ASSERT_TRUE(system.findCourseById(8001)->reserveSeat().held());
+        ASSERT_TRUE(system.enrollStudentInCourses(second, courses, 2, result));
+        ASSERT_EQ(2, static_cast<int>(second.getEnrolledCourses().size()));
+    }
+    
+    static void testDuplicateCourseIds() {
+        System system(false);
+        system.setSaveOnExit(false);
+        populate(system, 1, {5, 5});
+        Student& student = *system.findStudentById(7001);
+        EnrollmentResult result;
+        const int courses[] = {8001, 8002, 8001};
+        ASSERT_FALSE(system.enrollStudentInCourses(student, courses, 3, result));
+        ASSERT_TRUE(result.outcomes[0] == EnrollmentOutcome::RolledBack);
+        ASSERT_TRUE(result.outcomes[2] == EnrollmentOutcome::Duplicate);
+        ASSERT_TRUE(student.getEnrolledCourses().empty());
+        ASSERT_EQ(0, system.findCourseById(8001)->getCurrentEnrollment());
+        ASSERT_EQ(0, system.findCourseById(8002)->getCurrentEnrollment());
+        ASSERT_TRUE(result.message.find("8001=duplicate") != std::string::npos);
+    }
+    
+    static void testWaitlistPromotion() {
+        System system(false);
+        system.setSaveOnExit(false);
+        populate(system, 4, {1});
+        Course& course = *system.findCourseById(8001);
+        std::string message;
+        ASSERT_TRUE(system.joinWaitlist(*system.findStudentById(7001), course, 0, message)); // Seat free: enrolls
+        ASSERT_EQ(1, course.getCurrentEnrollment());
+        ASSERT_TRUE(system.joinWaitlist(*system.findStudentById(7002), course, 0, message));
+        ASSERT_TRUE(system.joinWaitlist(*system.findStudentById(7003), course, 5, message));
+        ASSERT_TRUE(system.joinWaitlist(*system.findStudentById(7004), course, 9, message));
+        ASSERT_TRUE(message.find("(3 waiting)") != std::string::npos);
+        
+        // The highest priority left; the next one gets the seat, the other keeps waiting
+        system.findStudentById(7004)->setIsActive(false);
+        ASSERT_TRUE(system.unenrollStudent(*system.findStudentById(7001), course, message));
+        ASSERT_TRUE(message.find("promoted 7003") != std::string::npos);
+        ASSERT_TRUE(system.findStudentById(7003)->isEnrolledIn(8001));
+        ASSERT_EQ(1, static_cast<int>(course.getWaitlist().size()));
+        ASSERT_TRUE(course.getWaitlist().contains(7002));
+    }
+    
+    static bool hasStudent(const ModelSnapshot& view, int id) {
+        return std::any_of(view.students.begin(), view.students.end(), [id](const Student& s) { return s.getId() == id; });
+    }
+    
+    // Each change moves the snapshot on by itself; no caller has to remember to
+    static void testSnapshotFollowsChanges() {
+        System system(false);
+        system.setSaveOnExit(false);
+        populate(system, 1, {5});
+        std::shared_ptr<const ModelSnapshot> before = system.modelSnapshot();
+        ASSERT_TRUE(system.modelSnapshot() == before); // Unchanged: shared
+        
+        std::string message;
+        ASSERT_TRUE(system.enrollStudent(*system.findStudentById(7001), *system.findCourseById(8001), message));
+        std::shared_ptr<const ModelSnapshot> enrolled = system.modelSnapshot();
+        ASSERT_TRUE(enrolled != before);
+        ASSERT_EQ(1, enrolled->courses.back().getCurrentEnrollment());
+        
+        const std::string args[] = {"7100", "Added Student", "20"};
+        ASSERT_TRUE(system.batchAddStudent(args, 3, message));
+        ASSERT_TRUE(hasStudent(*system.modelSnapshot(), 7100));
+        
+        // Reloading from the (empty) data files replaces everything
+        system.reloadAllData();
+        ASSERT_FALSE(hasStudent(*system.modelSnapshot(), 7100));
+        ASSERT_FALSE(hasStudent(*system.modelSnapshot(), 7001));
+    }
+    
+    // A summary sums the live records; it never pays for a snapshot copy
+    static void testSummaryWithoutSnapshot() {
+        System system(false);
+        system.setSaveOnExit(false);
+        populate(system, 2, {5});
+        std::shared_ptr<const ModelSnapshot> before = system.modelSnapshot();
+        std::string message;
+        ASSERT_TRUE(system.enrollStudent(*system.findStudentById(7001), *system.findCourseById(8001), message));
+        ASSERT_TRUE(system.sharedReport(SchoolProtocol::SummaryReport, 0, message));
+        ASSERT_TRUE(message.find("enrollments=1") != std::string::npos);
+        ASSERT_TRUE(system.snapshots.acquire() == before); // Nothing copied
+    }
+    
+    // Overlapping all-or-nothing requests from several threads: no course
+    // overfills, and every student ends with all or none of their courses
+    static void testConcurrentOverlapping() {
+        System system(false);
+        system.setSaveOnExit(false);
+        const int STUDENTS = 400;
+        populate(system, STUDENTS, {30, 500, 100});
+        auto request = [](int i) {
+            // Everyone shares B, then half ask for A and half for C; once A
+            // and C fill, B's reservation has to roll back
+            return std::vector<int>{8002, i % 2 == 0 ? 8001 : 8003};
+        };
+        std::atomic<int> next(0);
+        std::atomic<int> committed(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i; (i = next++) < STUDENTS;) {
+                    std::vector<int> courses = request(i);
+                    EnrollmentResult result;
+                    if (system.enrollStudentInCourses(*system.findStudentById(7001 + i), courses.data(), courses.size(), result)) {
+                        committed++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        
+        int counts[3] = {0, 0, 0};
+        int enrolled = 0;
+        for (int i = 0; i < STUDENTS; ++i) {
+            const std::vector<int>& courses = system.findStudentById(7001 + i)->getEnrolledCourses();
+            ASSERT_TRUE(courses.empty() || courses.size() == 2);
+            if (courses.empty()) continue;
+            enrolled++;
+            for (int id : request(i)) {
+                ASSERT_TRUE(system.findStudentById(7001 + i)->isEnrolledIn(id));
+                counts[id - 8001]++;
+            }
+        }
+        ASSERT_EQ(committed.load(), enrolled);
+        for (int c = 0; c < 3; ++c) {
+            Course& course = *system.findCourseById(8001 + c);
+            ASSERT_EQ(counts[c], course.getCurrentEnrollment());
+            ASSERT_EQ(counts[c], static_cast<int>(course.getEnrolledStudents().size()));
+            ASSERT_TRUE(course.getCurrentEnrollment() <= course.getMaxStudents());
+        }
+        ASSERT_EQ(30, counts[0]);
+        ASSERT_EQ(100, counts[2]);
+        ASSERT_EQ(130, counts[1]);
+        
+        // B's rolled-back reservations all came back
+        std::vector<SeatReservation> rest;
+        while (rest.size() < 500) {
+            rest.push_back(system.findCourseById(8002)->reserveSeat());
+            if (!rest.back().held()) break;
+        }
+        ASSERT_EQ(500 - 130 + 1, static_cast<int>(rest.size()));
+    }
+};
+
+class ShardedDaemonTests {
+public:
+    typedef IndustrialSchoolManagementSystem System;
+    
+    // One request straight through handleRequest(), as a server worker would
+    static SchoolProtocol::Status call(System& system, const std::string& frame, std::string& body) {
+        std::string response;
+        system.handleRequest(frame.data() + Frame::HEADER_BYTES, frame.size() - Frame::HEADER_BYTES, response);
+        uint32_t requestId;
+        SchoolProtocol::Status status = SchoolProtocol::BadRequest;
+        const char* data = nullptr;
+        size_t length = 0;
+        if (SchoolProtocol::parseResponse(response.data(), response.size(), requestId, status, data, length)) {
+            body.assign(data, length);
+        }
+        return status;
+    }
+    
+    static std::string enrollMany(std::vector<std::pair<uint32_t, std::vector<uint32_t>>> picks) {
+        std::string frame;
+        size_t start = SchoolProtocol::enrollMany(frame, 1, static_cast<uint16_t>(picks.size()));
+        for (auto& pick : picks) {
+            SchoolProtocol::addPick(frame, pick.first, pick.second.data(), static_cast<uint8_t>(pick.second.size()));
+        }
+        Frame::finish(frame, start);
+        return frame;
+    }
+    
+    static void testShardCountSetting() {
+        ConfigSnapshot config;
+        size_t shards = 0;
+        std::string error;
+        ASSERT_TRUE(shardCountSetting(config, shards, error));
+        ASSERT_EQ(1, static_cast<int>(shards)); // Unset
+        
+        ConfigValue& value = config.settings["shard_count"];
+        value.text = "4";
+        value.isNumber = true;
+        value.number = 4;
+        ASSERT_TRUE(shardCountSetting(config, shards, error));
+        ASSERT_EQ(4, static_cast<int>(shards));
+        
+        const long long invalid[] = {0, -2, MAX_SHARDS + 1};
+        for (long long number : invalid) {
+            value.text = std::to_string(number);
+            value.number = number;
+            ASSERT_FALSE(shardCountSetting(config, shards, error));
+        }
+        value.text = "four";
+        value.isNumber = false;
+        ASSERT_FALSE(shardCountSetting(config, shards, error));
+        ASSERT_TRUE(error.find("'four'") != std::string::npos);
+    }
+    
+    // The enrollment message chain gives the answers the shared model gives,
+    // and leaves the same rosters behind once the shards stop
+    static void testEnrollmentChain() {
+        std::vector<std::string> frames;
+        std::string frame;
+        SchoolProtocol::enroll(frame, 1, 7001, 8001);
+        frames.push_back(frame);                                    // Enrolled (1/2)
+        frames.push_back(frame);                                    // Already enrolled
+        frame.clear();
+        SchoolProtocol::enroll(frame, 1, 9999, 8001);
+        frames.push_back(frame);                                    // No such student
+        frame.clear();
+        SchoolProtocol::enroll(frame, 1, 7002, 9999);
+        frames.push_back(frame);                                    // No such course
+        frames.push_back(enrollMany({{7002, {8002, 8003}},          // Committed
+                                     {7003, {8002, 8001}},          // Takes 8001's last seat
+                                     {7004, {8003, 8001}},          // 8001 full: 8003 rolls back
+                                     {7005, {8002, 8002}}}));       // Duplicate
+        
+        std::vector<std::pair<SchoolProtocol::Status, std::string>> answers[2];
+        int enrollment[2][3];
+        for (int sharded = 0; sharded < 2; ++sharded) {
+            System system(false);
+            system.setSaveOnExit(false);
+            EnrollmentTests::populate(system, 8, {2, 5, 5});
+            if (sharded) system.startShards(4);
+            for (const std::string& request : frames) {
+                std::string body;
+                SchoolProtocol::Status status = call(system, request, body);
+                answers[sharded].emplace_back(status, body);
+            }
+            system.stopShards();
+            for (int c = 0; c < 3; ++c) enrollment[sharded][c] = system.findCourseById(8001 + c)->getCurrentEnrollment();
+            ASSERT_TRUE(system.findStudentById(7004)->getEnrolledCourses().empty());
+            ASSERT_TRUE(system.findStudentById(7005)->getEnrolledCourses().empty());
+            ASSERT_EQ(2, static_cast<int>(system.findStudentById(7002)->getEnrolledCourses().size()));
+        }
+        
+        ASSERT_EQ(static_cast<int>(answers[0].size()), static_cast<int>(answers[1].size()));
+        for (size_t i = 0; i < answers[0].size(); ++i) {
+            ASSERT_TRUE(answers[0][i].first == answers[1][i].first);
+            ASSERT_EQ(answers[0][i].second, answers[1][i].second);
+        }
+        ASSERT_TRUE(answers[1][0].first == SchoolProtocol::Ok);
+        ASSERT_TRUE(answers[1][1].first == SchoolProtocol::Rejected);
+        ASSERT_TRUE(answers[1][2].first == SchoolProtocol::NotFound);
+        ASSERT_TRUE(answers[1][3].first == SchoolProtocol::NotFound);
+        ASSERT_TRUE(answers[1][4].first == SchoolProtocol::Rejected); // Not every pick committed
+        std::vector<std::string> results = BatchModeTests::lines(answers[1][4].second);
+        ASSERT_EQ(4, static_cast<int>(results.size()));
+        ASSERT_EQ("student=7004 committed=false 8003=rolled_back 8001=full", results[2]);
+        ASSERT_TRUE(results[3].find("8002=duplicate") != std::string::npos);
+        for (int c = 0; c < 3; ++c) ASSERT_EQ(enrollment[0][c], enrollment[1][c]);
+        ASSERT_EQ(2, enrollment[1][0]);
+        ASSERT_EQ(1, enrollment[1][2]);
+    }
+    
+    // Parallel single enrollments into one course never overfill it
+    static void testConcurrentShardedEnroll() {
+        System system(false);
+        system.setSaveOnExit(false);
+        const int STUDENTS = 64;
+        EnrollmentTests::populate(system, STUDENTS, {10});
+        system.startShards(4);
+        std::atomic<int> next(0);
+        std::atomic<int> accepted(0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&] {
+                for (int i; (i = next++) < STUDENTS;) {
+                    std::string frame, body;
+                    SchoolProtocol::enroll(frame, 1, 7001 + i, 8001);
+                    if (call(system, frame, body) == SchoolProtocol::Ok) accepted++;
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        system.stopShards();
+        ASSERT_EQ(10, accepted.load());
+        Course& course = *system.findCourseById(8001);
+        ASSERT_EQ(10, course.getCurrentEnrollment());
+        ASSERT_EQ(10, static_cast<int>(course.getEnrolledStudents().size()));
+        for (int studentId : course.getEnrolledStudents()) {
+            ASSERT_TRUE(system.findStudentById(studentId)->isEnrolledIn(8001));
+        }
+    }
+    
+    // Searches answer in file order, sharded or not, even when that isn't ID order
+    static void testSearchKeepsFileOrder() {
+        std::string frame;
+        SchoolProtocol::searchStudents(frame, 1, "match", 10);
+        std::string bodies[2];
+        for (int sharded = 0; sharded < 2; ++sharded) {
+            System system(false);
+            system.setSaveOnExit(false);
+            for (int id = 7050; id > 7000; --id) {
+                system.students.emplace_back(id, (id % 3 ? "Match " : "Other ") + std::to_string(id), 20);
+            }
+            system.syncIndexes();
+            if (sharded) system.startShards(4);
+            ASSERT_TRUE(call(system, frame, bodies[sharded]) == SchoolProtocol::Ok);
+        }
+        ASSERT_EQ(bodies[0], bodies[1]);
+        ASSERT_TRUE(bodies[1].find("7049") < bodies[1].find("7048")); // 7050 is "Other"
+        ASSERT_TRUE(bodies[1].find("7036") != std::string::npos);     // The tenth match
+        ASSERT_TRUE(bodies[1].find("7034") == std::string::npos);
+    }
+};
+
+class EditTests {
+public:
+    typedef IndustrialSchoolManagementSystem System;
+    
+    static std::string edit(SchoolProtocol::Op record, uint32_t id, uint64_t version, const std::string& field,
+                            const std::string& value) {
+        std::string frame;
+        SchoolProtocol::edit(frame, 1, record, id, version, field, value);
+        return frame;
+    }
+    
+    // Serves a script to std::cin, running an action on the first read, i.e.
+    // after the menu has shown the record and noted its version
+    class ScriptedInput : public std::streambuf {
+    public:
+        ScriptedInput(const std::string& script, std::function<void()> first) : script(script), first(first) {}
+        
+    protected:
+        int_type underflow() override {
+            if (first) {
+                std::function<void()> run;
+                run.swap(first);
+                run();
+                setg(&script[0], &script[0], &script[0] + script.size());
+            }
+            return gptr() < egptr() ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+        }
+        
+    private:
+        std::string script;
+        std::function<void()> first;
+    };
+    
+    // Puts std::cin and std::cout back however the test ends
+    struct Redirect {
+        std::streambuf* in;
+        std::streambuf* out;
+        Redirect(std::streambuf* input, std::streambuf* output)
+            : in(std::cin.rdbuf(input)), out(std::cout.rdbuf(output)) {}
+        ~Redirect() {
+            std::cin.rdbuf(in);
+            std::cout.rdbuf(out);
+            std::cin.clear();
+        }
+    };
+    
+    static void testEditOp() {
+        System system(false);
+        system.setSaveOnExit(false);
+        EnrollmentTests::populate(system, 2, {5});
+        Student* student = system.findStudentById(7001);
+        uint64_t read = student->getVersion();
+        uint64_t model = system.modelVersion.load();
+        
+        std::string body;
+        ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupStudent, 7001, read, "name", "Renamed"),
+                                             body) == SchoolProtocol::Ok);
+        ASSERT_TRUE(body.find("(version " + std::to_string(read + 1) + ")") != std::string::npos);
+        ASSERT_EQ("Renamed", student->getName());
+        ASSERT_TRUE(system.modelVersion.load() > model);
+        
+        // The version read is stale now; one 2^32 past the current one must
+        // not pass for it either
+        const uint64_t stale[] = {read, (uint64_t(1) << 32) + student->getVersion()};
+        for (uint64_t version : stale) {
+            body.clear();
+            ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupStudent, 7001, version, "name", "Lost"),
+                                                 body) == SchoolProtocol::Rejected);
+            ASSERT_TRUE(body.find("conflict") != std::string::npos);
+        }
+        ASSERT_EQ("Renamed", student->getName());
+        
+        body.clear();
+        ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupStudent, 7001, 0, "shoe_size", "9"),
+                                             body) == SchoolProtocol::Rejected);
+        ASSERT_TRUE(body.find("unknown student field") != std::string::npos);
+        body.clear();
+        ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupStudent, 9999, 0, "name", "Nobody"),
+                                             body) == SchoolProtocol::NotFound);
+        body.clear();
+        ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupCourse, 8001, 0, "maxstudents", "40"),
+                                             body) == SchoolProtocol::Ok);
+        ASSERT_EQ(40, system.findCourseById(8001)->getMaxStudents());
+    }
+    
+    // Seat limits stay with the unsharded daemon; other course fields edit
+    // on their shard
+    static void testShardedSeatLimitRefused() {
+        System system(false);
+        system.setSaveOnExit(false);
+        EnrollmentTests::populate(system, 2, {5});
+        system.startShards(2);
+        std::string body;
+        ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupCourse, 8001, 0, "maxstudents", "40"),
+                                             body) == SchoolProtocol::Rejected);
+        ASSERT_TRUE(body.find("seat limits") != std::string::npos);
+        body.clear();
+        ASSERT_TRUE(ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupCourse, 8001, 0, "name", "Renamed"),
+                                             body) == SchoolProtocol::Ok);
+        system.stopShards();
+        ASSERT_EQ(5, system.findCourseById(8001)->getMaxStudents());
+        ASSERT_EQ("Renamed", system.findCourseById(8001)->getName());
+    }
+    
+    // Edits commit under the record's stripe: one goes through while a
+    // daemon request holds the shared model lock, and blind edits racing on
+    // one record alongside lookups and searches retry without conflicts
+    static void testEditsAlongsideRequests() {
+        System system(false);
+        system.setSaveOnExit(false);
+        EnrollmentTests::populate(system, 4, {5});
+        std::future<std::string> edited;
+        bool done;
+        {
+            std::shared_lock<std::shared_mutex> request(system.modelMutex);
+            edited = std::async(std::launch::async, [&system] {
+                std::string body;
+                ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupCourse, 8001, 0, "fee", "120"), body);
+                return body;
+            });
+            done = edited.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+        }
+        ASSERT_TRUE(done);
+        ASSERT_TRUE(edited.get().find("updated") != std::string::npos);
+        
+        uint64_t commits = system.editMetrics.commits.load();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&system, t] {
+                std::string name = std::string("Editor ") + static_cast<char>('A' + t);
+                for (int i = 0; i < 200; ++i) {
+                    std::string body, frame;
+                    ShardedDaemonTests::call(system, edit(SchoolProtocol::LookupStudent, 7001, 0, "name", name), body);
+                    SchoolProtocol::lookup(frame, 1, SchoolProtocol::LookupStudent, 7001);
+                    ShardedDaemonTests::call(system, frame, body);
+                    frame.clear();
+                    SchoolProtocol::searchStudents(frame, 1, "editor", 10);
+                    ShardedDaemonTests::call(system, frame, body);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        ASSERT_EQ(commits + 800, system.editMetrics.commits.load());
+        ASSERT_EQ(0, static_cast<int>(system.editMetrics.conflicts.load()));
+        ASSERT_TRUE(system.findStudentById(7001)->getName().rfind("Editor ", 0) == 0);
+    }
+    
+    // Someone else renames the student while the operator types; the
+    // operator sees the conflict and either re-applies or drops the change
+    static void testMenuConflict() {
+        const char* answers[] = {"y", "n"};
+        for (const char* answer : answers) {
+            System system(false);
+            system.setSaveOnExit(false);
+            EnrollmentTests::populate(system, 1, {});
+            Student* student = system.findStudentById(7001);
+            uint64_t retries = system.editMetrics.retries.load();
+            ScriptedInput input("1\nMine\n" + std::string(answer) + "\n", [&system, student] {
+                std::string message;
+                system.editStudentField(*student, StudentCsvFormat::Name, "Theirs", 0, message);
+            });
+            std::ostringstream output;
+            {
+                Redirect redirect(&input, output.rdbuf());
+                system.editInteractively<StudentCsvFormat>(*student, &System::editStudentField);
+            }
+            ASSERT_TRUE(output.str().find("conflict") != std::string::npos);
+            bool retried = std::string(answer) == "y";
+            ASSERT_EQ(retried ? "Mine" : "Theirs", student->getName());
+            ASSERT_EQ(retries + (retried ? 1 : 0), system.editMetrics.retries.load());
+        }
+    }
+};
+
+int main() {
+    std::cout << "🧪 Industrial School Management System - Unit Test Suite\n";
+    std::cout << "========================================================\n\n";
+    
+    // The system reads and writes its data files in the working directory
+    char directory[] = "/tmp/industrial_tests_XXXXXX";
+    if (!::mkdtemp(directory) || ::chdir(directory) != 0) {
+        std::cerr << "❌ Cannot create a scratch directory\n";
+        return 2;
+    }
+    
+    TestFramework framework;
+    
+    // Attendance Bitset Tests
+    framework.addTest("Attendance Bitset Round Trip", AttendanceBitsetTests::testSerializeRoundTrip);
+    framework.addTest("Attendance Bitset Malformed Rejected", AttendanceBitsetTests::testMalformedRejected);
+    framework.addTest("Corrupt Attendance Keeps Student", AttendanceBitsetTests::testCorruptAttendanceKeepsStudent);
+    
+    // Batch Validator Tests
+    framework.addTest("Batch Validator Matches Serial", BatchValidatorTests::testMatchesSerialValidator);
+    framework.addTest("Batch Validator Duplicates", BatchValidatorTests::testDuplicatesAfterFirstOnly);
+    
+    // CSV Import Tests
+    framework.addTest("CSV Import Insert Then Upsert", CsvImportTests::testInsertThenUpsert);
+    framework.addTest("CSV Import Non-Finite Salary", CsvImportTests::testNonFiniteSalaryRejected);
+    framework.addTest("CSV Import Refused Update", CsvImportTests::testRefusedUpdateNotCounted);
+    
+    // Batch Mode Tests
+    framework.addTest("Batch Run Results", BatchModeTests::testRunBatchResults);
+    framework.addTest("Batch Command Table", BatchModeTests::testCommandTable);
+    framework.addTest("Command Line Parsing", BatchModeTests::testCommandLine);
+    
+    // Enrollment Tests
+    framework.addTest("Enrollment Rollback When Last Full", EnrollmentTests::testRollbackWhenLastFull);
+    framework.addTest("Enrollment Duplicate Course IDs", EnrollmentTests::testDuplicateCourseIds);
+    framework.addTest("Enrollment Concurrent Overlapping", EnrollmentTests::testConcurrentOverlapping);
+    framework.addTest("Waitlist Promotion", EnrollmentTests::testWaitlistPromotion);
+    framework.addTest("Snapshot Follows Changes", EnrollmentTests::testSnapshotFollowsChanges);
+    framework.addTest("Summary Without Snapshot", EnrollmentTests::testSummaryWithoutSnapshot);
+    
+    // Sharded Daemon Tests
+    framework.addTest("Shard Count Setting", ShardedDaemonTests::testShardCountSetting);
+    framework.addTest("Sharded Enrollment Chain", ShardedDaemonTests::testEnrollmentChain);
+    framework.addTest("Sharded Concurrent Enroll", ShardedDaemonTests::testConcurrentShardedEnroll);
+    framework.addTest("Sharded Search File Order", ShardedDaemonTests::testSearchKeepsFileOrder);
+    
+    // Edit Tests
+    framework.addTest("Edit Op", EditTests::testEditOp);
+    framework.addTest("Sharded Seat Limit Refused", EditTests::testShardedSeatLimitRefused);
+    framework.addTest("Edit Menu Conflict", EditTests::testMenuConflict);
+    framework.addTest("Edits Alongside Requests", EditTests::testEditsAlongsideRequests);
+    
+    framework.runAllTests();
+    framework.printResults();
+    return 0;
+}